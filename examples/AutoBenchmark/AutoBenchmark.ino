@@ -22,6 +22,9 @@ void setup() {
 
   // ace_time primitives
 
+  SERIAL_PORT_MONITOR.print(F("sizeof(acetime_t): "));
+  SERIAL_PORT_MONITOR.println(sizeof(acetime_t));
+
   SERIAL_PORT_MONITOR.print(F("sizeof(LocalDate): "));
   SERIAL_PORT_MONITOR.println(sizeof(LocalDate));
 
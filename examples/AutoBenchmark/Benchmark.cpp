@@ -19,7 +19,7 @@ const uint32_t COUNT = 100000;
 const uint32_t COUNT = 100000;
 #elif !defined(ARDUINO)
 // Linux or MacOS
-const uint32_t COUNT = 100000;
+const uint32_t COUNT = 1000000;
 #else
 // A generic Arduino board that we have not looked at.
 const uint32_t COUNT = 10000;
@@ -51,6 +51,10 @@ const char EMPTY_LOOP_LABEL[] PROGMEM =
   "| Empty loop                                       | ";
 const char LOCAL_DATE_FOR_EPOCH_DAYS_LABEL[] PROGMEM =
   "| LocalDate::forEpochDays()                        | ";
+const char LOCAL_DATE_FOR_EPOCH_DAYS_ARRAY_LABEL[] PROGMEM =
+  "| LocalDate::forEpochDays() (array)                | ";
+const char LOCAL_DATE_EXTRACT_YEAR_MONTH_DAYS_LABEL[] PROGMEM =
+  "| LocalDate::extractYearMonthDays() (array)        | ";
 const char LOCAL_DATE_TO_EPOCH_DAYS_LABEL[] PROGMEM =
   "| LocalDate::toEpochDays()                         | ";
 const char LOCAL_DATE_DAY_OF_WEEK_LABEL[] PROGMEM =
@@ -60,6 +64,14 @@ const char OFFSET_DATE_TIME_FOR_EPOCH_SECONDS_LABEL[] PROGMEM =
   "| OffsetDateTime::forEpochSeconds()                | ";
 const char OFFSET_DATE_TIME_TO_EPOCH_SECONDS_LABEL[] PROGMEM =
   "| OffsetDateTime::toEpochSeconds()                 | ";
+const char OFFSET_DATE_TIME_FOR_DATE_STRING_LABEL[] PROGMEM =
+  "| OffsetDateTime::forDateString()                  | ";
+const char OFFSET_DATE_TIME_FOR_ISO8601_LABEL[] PROGMEM =
+  "| OffsetDateTime::forIso8601()                     | ";
+const char OFFSET_DATE_TIME_PRINT_TO_LABEL[] PROGMEM =
+  "| OffsetDateTime::printTo()                        | ";
+const char OFFSET_DATE_TIME_FORMAT_TO_LABEL[] PROGMEM =
+  "| OffsetDateTime::formatTo()                       | ";
 
 const char DATE_TIME_TO_EPOCH_DAYS_LABEL[] PROGMEM =
   "| ZonedDateTime::toEpochDays()                     | ";
@@ -76,6 +88,30 @@ const char DATE_TIME_FOR_EPOCH_SECONDS_EXTENDED_NO_CACHE[] PROGMEM =
 const char DATE_TIME_FOR_EPOCH_SECONDS_EXTENDED_CACHED[] PROGMEM =
   "| ZonedDateTime::forEpochSeconds(Extended cached)  | ";
 
+const char DATE_TIME_FOR_EPOCH_SECONDS_EXTENDED_BATCH[] PROGMEM =
+  "| ZonedDateTime::forEpochSeconds(Extended batch)   | ";
+
+const char EXTENDED_GET_UTC_OFFSET_CACHED[] PROGMEM =
+  "| ExtendedZoneProcessor::getUtcOffset(cached)      | ";
+const char EXTENDED_GET_OFFSET_DATE_TIME_CACHED[] PROGMEM =
+  "| ExtendedZoneProcessor::getOffsetDateTime(cached) | ";
+const char BASIC_GET_OFFSET_DATE_TIME_CACHED[] PROGMEM =
+  "| BasicZoneProcessor::getOffsetDateTime(cached)    | ";
+const char EXTENDED_GET_UTC_OFFSET_NEXT_YEAR[] PROGMEM =
+  "| ExtendedZoneProcessor::getUtcOffset(next year)   | ";
+const char EXTENDED_GET_UTC_OFFSET_PREV_YEAR[] PROGMEM =
+  "| ExtendedZoneProcessor::getUtcOffset(prev year)   | ";
+const char FLAT_GET_UTC_OFFSET[] PROGMEM =
+  "| FlatZoneProcessor::getUtcOffset()                | ";
+const char TZIF_GET_UTC_OFFSET[] PROGMEM =
+  "| TzifZoneProcessor::getUtcOffset()                | ";
+const char TZIF_GET_UTC_OFFSET_FOOTER[] PROGMEM =
+  "| TzifZoneProcessor::getUtcOffset(footer)          | ";
+const char REGISTRAR_FOR_ID_LINEAR[] PROGMEM =
+  "| ZoneRegistrar::getZoneInfoForId(linear)          | ";
+const char REGISTRAR_FOR_ID_BINARY[] PROGMEM =
+  "| ZoneRegistrar::getZoneInfoForId(binary)          | ";
+
 // The compiler is extremelly good about removing code that does nothing. This
 // volatile variable is used to create side-effects that prevent the compiler
 // from optimizing out the code that's being tested. Each disableOptimization()
@@ -197,6 +233,79 @@ static void runLocalDateForEpochDays() {
   SERIAL_PORT_MONITOR.println(FPSTR(COL_DIVIDER));
 }
 
+// Number of elements in the arrays of the (array) benchmarks.
+static const uint8_t kArraySize = 16;
+
+static acetime_t epochDaysArray[kArraySize];
+static int16_t yearsArray[kArraySize];
+static uint8_t monthsArray[kArraySize];
+static uint8_t daysArray[kArraySize];
+
+// Fill epochDaysArray with dates spread over a few decades, starting from
+// millis().
+static void fillEpochDaysArray() {
+  unsigned long fakeEpochDays = millis();
+  for (uint8_t i = 0; i < kArraySize; i++) {
+    epochDaysArray[i] = fakeEpochDays + 997 * i;
+  }
+}
+
+// Consume the output arrays, so that the compiler cannot optimize them away.
+static void disableOptimizationArray() {
+  for (uint8_t i = 0; i < kArraySize; i++) {
+    guard ^= yearsArray[i];
+    guard ^= monthsArray[i];
+    guard ^= daysArray[i];
+  }
+}
+
+// Time of the fill and consume steps of the (array) benchmarks, which is
+// subtracted from their results.
+static unsigned long runArrayEmptyLoop() {
+  return runLambda(COUNT / kArraySize, []() {
+    fillEpochDaysArray();
+    disableOptimizationArray();
+  });
+}
+
+// LocalDate::forEpochDays() on each element of an array. The result is the
+// time per element.
+static void runLocalDateForEpochDaysArray() {
+  unsigned long forEpochDaysMillis = runLambda(COUNT / kArraySize, []() {
+    fillEpochDaysArray();
+    for (uint8_t i = 0; i < kArraySize; i++) {
+      LocalDate localDate = LocalDate::forEpochDays(epochDaysArray[i]);
+      yearsArray[i] = localDate.year();
+      monthsArray[i] = localDate.month();
+      daysArray[i] = localDate.day();
+    }
+    disableOptimizationArray();
+  });
+  unsigned long emptyLoopMillis = runArrayEmptyLoop();
+  long elapsedMillis = forEpochDaysMillis - emptyLoopMillis;
+
+  SERIAL_PORT_MONITOR.print(FPSTR(LOCAL_DATE_FOR_EPOCH_DAYS_ARRAY_LABEL));
+  printMicrosPerIteration(elapsedMillis);
+  SERIAL_PORT_MONITOR.println(FPSTR(COL_DIVIDER));
+}
+
+// LocalDate::extractYearMonthDays() on the same array as
+// runLocalDateForEpochDaysArray(). The result is the time per element.
+static void runLocalDateExtractYearMonthDays() {
+  unsigned long extractMillis = runLambda(COUNT / kArraySize, []() {
+    fillEpochDaysArray();
+    LocalDate::extractYearMonthDays(epochDaysArray, yearsArray, monthsArray,
+        daysArray, kArraySize);
+    disableOptimizationArray();
+  });
+  unsigned long emptyLoopMillis = runArrayEmptyLoop();
+  long elapsedMillis = extractMillis - emptyLoopMillis;
+
+  SERIAL_PORT_MONITOR.print(FPSTR(LOCAL_DATE_EXTRACT_YEAR_MONTH_DAYS_LABEL));
+  printMicrosPerIteration(elapsedMillis);
+  SERIAL_PORT_MONITOR.println(FPSTR(COL_DIVIDER));
+}
+
 // LocalDate::toEpochDays()
 static void runLocalDateToEpochDays() {
   unsigned long localDateToEpochDaysMillis = runLambda(COUNT, []() {
@@ -279,6 +388,107 @@ static void runOffsetDateTimeToEpochSeconds() {
   SERIAL_PORT_MONITOR.println(FPSTR(COL_DIVIDER));
 }
 
+// The input of the date string parsers. The seconds are changed on every
+// iteration so that the compiler cannot hoist the parsing out of the loop.
+static char dateString[] = "2018-08-31T13:48:01-07:00";
+const size_t DATE_STRING_LENGTH = sizeof(dateString) - 1;
+
+// OffsetDateTime::forDateString()
+static void runOffsetDateTimeForDateString() {
+  unsigned long forDateStringMillis = runLambda(COUNT, []() {
+    dateString[18] = '0' + (millis() & 0x7);
+    OffsetDateTime odt = OffsetDateTime::forDateString(dateString);
+    disableOptimization(odt);
+  });
+  unsigned long emptyLoopMillis = runLambda(COUNT, []() {
+    dateString[18] = '0' + (millis() & 0x7);
+    disableOptimization(dateString[18]);
+  });
+  long elapsedMillis = forDateStringMillis - emptyLoopMillis;
+
+  SERIAL_PORT_MONITOR.print(FPSTR(OFFSET_DATE_TIME_FOR_DATE_STRING_LABEL));
+  printMicrosPerIteration(elapsedMillis);
+  SERIAL_PORT_MONITOR.println(FPSTR(COL_DIVIDER));
+}
+
+// OffsetDateTime::forIso8601()
+static void runOffsetDateTimeForIso8601() {
+  unsigned long forIso8601Millis = runLambda(COUNT, []() {
+    dateString[18] = '0' + (millis() & 0x7);
+    OffsetDateTime odt = OffsetDateTime::forIso8601(
+        dateString, DATE_STRING_LENGTH);
+    disableOptimization(odt);
+  });
+  unsigned long emptyLoopMillis = runLambda(COUNT, []() {
+    dateString[18] = '0' + (millis() & 0x7);
+    disableOptimization(dateString[18]);
+  });
+  long elapsedMillis = forIso8601Millis - emptyLoopMillis;
+
+  SERIAL_PORT_MONITOR.print(FPSTR(OFFSET_DATE_TIME_FOR_ISO8601_LABEL));
+  printMicrosPerIteration(elapsedMillis);
+  SERIAL_PORT_MONITOR.println(FPSTR(COL_DIVIDER));
+}
+
+// A Print which writes into a fixed buffer, for comparing printTo() with
+// formatTo() on the same destination.
+class BufferPrint: public Print {
+  public:
+    size_t write(uint8_t c) override {
+      if (mPos < sizeof(mBuffer) - 1) mBuffer[mPos++] = c;
+      return 1;
+    }
+
+    void clear() { mPos = 0; }
+
+    char mBuffer[32];
+    uint8_t mPos = 0;
+};
+
+static BufferPrint bufferPrint;
+static char formatBuffer[32];
+
+// OffsetDateTime::printTo()
+static void runOffsetDateTimePrintTo() {
+  unsigned long printToMillis = runLambda(COUNT, []() {
+    OffsetDateTime odt = OffsetDateTime::forComponents(
+        2018, 8, 31, 13, 48, millis() & 0x7, TimeOffset::forHour(-7));
+    bufferPrint.clear();
+    odt.printTo(bufferPrint);
+    disableOptimization(bufferPrint.mBuffer[18]);
+  });
+  unsigned long emptyLoopMillis = runLambda(COUNT, []() {
+    OffsetDateTime odt = OffsetDateTime::forComponents(
+        2018, 8, 31, 13, 48, millis() & 0x7, TimeOffset::forHour(-7));
+    disableOptimization(odt.second());
+  });
+  long elapsedMillis = printToMillis - emptyLoopMillis;
+
+  SERIAL_PORT_MONITOR.print(FPSTR(OFFSET_DATE_TIME_PRINT_TO_LABEL));
+  printMicrosPerIteration(elapsedMillis);
+  SERIAL_PORT_MONITOR.println(FPSTR(COL_DIVIDER));
+}
+
+// OffsetDateTime::formatTo()
+static void runOffsetDateTimeFormatTo() {
+  unsigned long formatToMillis = runLambda(COUNT, []() {
+    OffsetDateTime odt = OffsetDateTime::forComponents(
+        2018, 8, 31, 13, 48, millis() & 0x7, TimeOffset::forHour(-7));
+    odt.formatTo(formatBuffer, sizeof(formatBuffer));
+    disableOptimization(formatBuffer[18]);
+  });
+  unsigned long emptyLoopMillis = runLambda(COUNT, []() {
+    OffsetDateTime odt = OffsetDateTime::forComponents(
+        2018, 8, 31, 13, 48, millis() & 0x7, TimeOffset::forHour(-7));
+    disableOptimization(odt.second());
+  });
+  long elapsedMillis = formatToMillis - emptyLoopMillis;
+
+  SERIAL_PORT_MONITOR.print(FPSTR(OFFSET_DATE_TIME_FORMAT_TO_LABEL));
+  printMicrosPerIteration(elapsedMillis);
+  SERIAL_PORT_MONITOR.println(FPSTR(COL_DIVIDER));
+}
+
 // ZonedDateTime::forEpochSeconds(seconds)
 static void runZonedDateTimeForEpochSeconds() {
   unsigned long forEpochSecondsMillis = runLambda(COUNT, []() {
@@ -463,6 +673,273 @@ static void runZonedDateTimeForEpochSecondsExtendedZoneManagerCached() {
   SERIAL_PORT_MONITOR.println(FPSTR(COL_DIVIDER));
 }
 
+// Number of elements converted by each call to the batch
+// ZonedDateTime::forEpochSeconds().
+static const uint8_t kBatchSize = 16;
+
+// ZonedDateTime::forEpochSeconds(array, tz, array, n) using an
+// ExtendedZoneManager, on sorted input one minute apart. The result is the
+// time per element, so it can be compared to the (Extended cached) row.
+static void runZonedDateTimeForEpochSecondsExtendedBatch() {
+  ExtendedZoneManager<2> manager(
+      kExtendedZoneRegistrySize, kExtendedZoneRegistry);
+  TimeZone tzLosAngeles = manager.createForZoneInfo(
+      &zonedbx::kZoneAmerica_Los_Angeles);
+  acetime_t epochSeconds[kBatchSize];
+  ZonedDateTime dateTimes[kBatchSize];
+
+  unsigned long forEpochSecondsMillis = runLambda(COUNT / kBatchSize,
+      [&tzLosAngeles, &epochSeconds, &dateTimes]() {
+    unsigned long fakeEpochSeconds = millis();
+    for (uint8_t i = 0; i < kBatchSize; i++) {
+      epochSeconds[i] = fakeEpochSeconds + 60 * i;
+    }
+    ZonedDateTime::forEpochSeconds(epochSeconds, tzLosAngeles, dateTimes,
+        kBatchSize);
+    disableOptimization(dateTimes[kBatchSize - 1]);
+  });
+  unsigned long emptyLoopMillis = runLambda(COUNT / kBatchSize,
+      [&epochSeconds]() {
+    unsigned long fakeEpochSeconds = millis();
+    for (uint8_t i = 0; i < kBatchSize; i++) {
+      epochSeconds[i] = fakeEpochSeconds + 60 * i;
+    }
+    disableOptimization((uint32_t) epochSeconds[kBatchSize - 1]);
+  });
+  long elapsedMillis = forEpochSecondsMillis - emptyLoopMillis;
+
+  SERIAL_PORT_MONITOR.print(FPSTR(DATE_TIME_FOR_EPOCH_SECONDS_EXTENDED_BATCH));
+  printMicrosPerIteration(elapsedMillis);
+  SERIAL_PORT_MONITOR.println(FPSTR(COL_DIVIDER));
+}
+
+// Number of seconds to advance on each iteration of the cached
+// ExtendedZoneProcessor benchmarks, so that successive lookups land on
+// different Transitions within the same year.
+static const acetime_t kSecondsStep = 7 * 24 * 3600L + 3607;
+static const acetime_t kOneYear = 365 * 24 * 3600L;
+
+// ExtendedZoneProcessor::getUtcOffset(seconds) after the Transitions of the
+// year have been cached. Measures the lookup in TransitionStorage.
+static void runExtendedZoneProcessorGetUtcOffsetCached() {
+  ExtendedZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles);
+  acetime_t startSeconds = LocalDateTime::forComponents(
+      2019, 1, 1, 0, 0, 0).toEpochSeconds();
+  acetime_t seconds = startSeconds;
+  processor.getUtcOffset(seconds);
+
+  unsigned long getUtcOffsetMillis = runLambda(COUNT,
+      [&processor, &seconds, startSeconds]() {
+    seconds += kSecondsStep;
+    if (seconds >= startSeconds + kOneYear) seconds = startSeconds;
+    TimeOffset offset = processor.getUtcOffset(seconds);
+    disableOptimization((uint32_t) offset.toMinutes());
+  });
+  unsigned long emptyLoopMillis = runLambda(COUNT,
+      [&seconds, startSeconds]() {
+    seconds += kSecondsStep;
+    if (seconds >= startSeconds + kOneYear) seconds = startSeconds;
+    disableOptimization((uint32_t) seconds);
+  });
+  long elapsedMillis = getUtcOffsetMillis - emptyLoopMillis;
+
+  SERIAL_PORT_MONITOR.print(FPSTR(EXTENDED_GET_UTC_OFFSET_CACHED));
+  printMicrosPerIteration(elapsedMillis);
+  SERIAL_PORT_MONITOR.println(FPSTR(COL_DIVIDER));
+}
+
+// ExtendedZoneProcessor::getOffsetDateTime(ldt) after the Transitions of the
+// year have been cached. Measures the lookup in TransitionStorage using the
+// startDateTime.
+static void runExtendedZoneProcessorGetOffsetDateTimeCached() {
+  ExtendedZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles);
+  acetime_t startSeconds = LocalDateTime::forComponents(
+      2019, 1, 1, 0, 0, 0).toEpochSeconds();
+  acetime_t seconds = startSeconds;
+  processor.getUtcOffset(seconds);
+
+  unsigned long getOffsetDateTimeMillis = runLambda(COUNT,
+      [&processor, &seconds, startSeconds]() {
+    seconds += kSecondsStep;
+    if (seconds >= startSeconds + kOneYear) seconds = startSeconds;
+    LocalDateTime ldt = LocalDateTime::forEpochSeconds(seconds);
+    OffsetDateTime odt = processor.getOffsetDateTime(ldt);
+    disableOptimization(odt);
+  });
+  unsigned long emptyLoopMillis = runLambda(COUNT,
+      [&seconds, startSeconds]() {
+    seconds += kSecondsStep;
+    if (seconds >= startSeconds + kOneYear) seconds = startSeconds;
+    LocalDateTime ldt = LocalDateTime::forEpochSeconds(seconds);
+    OffsetDateTime odt = OffsetDateTime::forLocalDateTimeAndOffset(
+        ldt, TimeOffset());
+    disableOptimization(odt);
+  });
+  long elapsedMillis = getOffsetDateTimeMillis - emptyLoopMillis;
+
+  SERIAL_PORT_MONITOR.print(FPSTR(EXTENDED_GET_OFFSET_DATE_TIME_CACHED));
+  printMicrosPerIteration(elapsedMillis);
+  SERIAL_PORT_MONITOR.println(FPSTR(COL_DIVIDER));
+}
+
+// BasicZoneProcessor::getOffsetDateTime(localDateTime) with the Transitions
+// already cached.
+static void runBasicZoneProcessorGetOffsetDateTimeCached() {
+  BasicZoneProcessor processor(&zonedb::kZoneAmerica_Los_Angeles);
+  acetime_t startSeconds = LocalDateTime::forComponents(
+      2019, 1, 2, 0, 0, 0).toEpochSeconds();
+  acetime_t seconds = startSeconds;
+  processor.getUtcOffset(seconds);
+
+  unsigned long getOffsetDateTimeMillis = runLambda(COUNT,
+      [&processor, &seconds, startSeconds]() {
+    seconds += kSecondsStep;
+    if (seconds >= startSeconds + kOneYear - 86400) seconds = startSeconds;
+    LocalDateTime ldt = LocalDateTime::forEpochSeconds(seconds);
+    OffsetDateTime odt = processor.getOffsetDateTime(ldt);
+    disableOptimization(odt);
+  });
+  unsigned long emptyLoopMillis = runLambda(COUNT,
+      [&seconds, startSeconds]() {
+    seconds += kSecondsStep;
+    if (seconds >= startSeconds + kOneYear - 86400) seconds = startSeconds;
+    LocalDateTime ldt = LocalDateTime::forEpochSeconds(seconds);
+    OffsetDateTime odt = OffsetDateTime::forLocalDateTimeAndOffset(
+        ldt, TimeOffset());
+    disableOptimization(odt);
+  });
+  long elapsedMillis = getOffsetDateTimeMillis - emptyLoopMillis;
+
+  SERIAL_PORT_MONITOR.print(FPSTR(BASIC_GET_OFFSET_DATE_TIME_CACHED));
+  printMicrosPerIteration(elapsedMillis);
+  SERIAL_PORT_MONITOR.println(FPSTR(COL_DIVIDER));
+}
+
+// ExtendedZoneProcessor::getUtcOffset(seconds) where each iteration moves to
+// the next (yearStep = 1) or previous (yearStep = -1) year, cycling through
+// 2001 to 2049. Moving to the next year rolls the window forward if
+// ACE_TIME_EXTENDED_ZONE_PROCESSOR_INCREMENTAL is enabled, while moving to
+// the previous year always rebuilds the Transitions from scratch.
+static void runExtendedZoneProcessorGetUtcOffsetYearly(const char* label,
+    int8_t yearStep) {
+  ExtendedZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles);
+  int16_t year = 2001;
+
+  unsigned long getUtcOffsetMillis = runLambda(COUNT,
+      [&processor, &year, yearStep]() {
+    year += yearStep;
+    if (year >= 2050) year = 2001;
+    if (year < 2001) year = 2049;
+    acetime_t seconds = LocalDate::forComponents(year, 6, 1).toEpochSeconds();
+    TimeOffset offset = processor.getUtcOffset(seconds);
+    disableOptimization((uint32_t) offset.toMinutes());
+  });
+  unsigned long emptyLoopMillis = runLambda(COUNT, [&year, yearStep]() {
+    year += yearStep;
+    if (year >= 2050) year = 2001;
+    if (year < 2001) year = 2049;
+    acetime_t seconds = LocalDate::forComponents(year, 6, 1).toEpochSeconds();
+    disableOptimization((uint32_t) seconds);
+  });
+  long elapsedMillis = getUtcOffsetMillis - emptyLoopMillis;
+
+  SERIAL_PORT_MONITOR.print(FPSTR(label));
+  printMicrosPerIteration(elapsedMillis);
+  SERIAL_PORT_MONITOR.println(FPSTR(COL_DIVIDER));
+}
+
+#if ! defined(ARDUINO_ARCH_AVR)
+// FlatZoneProcessor::getUtcOffset(seconds), alternating between 2 years,
+// which would force the ExtendedZoneProcessor to recalculate its cache on
+// every iteration. Too big for the 2kB of RAM on an AVR.
+static void runFlatZoneProcessorGetUtcOffset() {
+  static FlatZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles);
+  acetime_t offset = 0;
+  processor.getUtcOffset(0);
+
+  unsigned long getUtcOffsetMillis = runLambda(COUNT, [&offset]() {
+    offset = (offset) ? 0 : kTwoYears;
+    unsigned long fakeEpochSeconds = millis() + offset;
+    TimeOffset utcOffset = processor.getUtcOffset(fakeEpochSeconds);
+    disableOptimization((uint32_t) utcOffset.toMinutes());
+  });
+  unsigned long emptyLoopMillis = runLambda(COUNT, [&offset]() {
+    offset = (offset) ? 0 : kTwoYears;
+    unsigned long fakeEpochSeconds = millis() + offset;
+    disableOptimization(fakeEpochSeconds);
+  });
+  long elapsedMillis = getUtcOffsetMillis - emptyLoopMillis;
+
+  SERIAL_PORT_MONITOR.print(FPSTR(FLAT_GET_UTC_OFFSET));
+  printMicrosPerIteration(elapsedMillis);
+  SERIAL_PORT_MONITOR.println(FPSTR(COL_DIVIDER));
+}
+#endif
+
+#if defined(__linux__) || defined(__APPLE__)
+// TzifZoneProcessor::getUtcOffset(seconds) for America/Los_Angeles from the
+// zoneinfo files of the OS, alternating between 2 years. The 'start' of 2040
+// is after the last transition of the "slim" files and of most "fat" files,
+// so the footer cache is recalculated on every iteration.
+static void runTzifZoneProcessorGetUtcOffset(const char* label,
+    acetime_t start) {
+  static TzifZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles);
+  if (! processor.isLoaded()) return;
+  acetime_t offset = 0;
+
+  unsigned long getUtcOffsetMillis = runLambda(COUNT, [&offset, start]() {
+    offset = (offset) ? 0 : kTwoYears;
+    unsigned long fakeEpochSeconds = start + millis() + offset;
+    TimeOffset utcOffset = processor.getUtcOffset(fakeEpochSeconds);
+    disableOptimization((uint32_t) utcOffset.toMinutes());
+  });
+  unsigned long emptyLoopMillis = runLambda(COUNT, [&offset, start]() {
+    offset = (offset) ? 0 : kTwoYears;
+    unsigned long fakeEpochSeconds = start + millis() + offset;
+    disableOptimization(fakeEpochSeconds);
+  });
+  long elapsedMillis = getUtcOffsetMillis - emptyLoopMillis;
+
+  SERIAL_PORT_MONITOR.print(FPSTR(label));
+  printMicrosPerIteration(elapsedMillis);
+  SERIAL_PORT_MONITOR.println(FPSTR(COL_DIVIDER));
+}
+#endif
+
+#if ! defined(ARDUINO_ARCH_AVR)
+// ZoneRegistrar::getZoneInfoForId() over the full zonedbx::kZoneRegistry,
+// with or without the kZoneRegistryById index.
+static void runZoneRegistrarGetZoneInfoForId(const char* label,
+    const extended::ZoneInfo* const* zoneRegistryById) {
+  static const uint32_t kZoneIds[] = {
+    0xb7f7e8f2, // America/Los_Angeles
+    0x1e2a7654, // America/New_York
+    0x5c6a84ae, // Europe/London
+    0x11111111, // not found
+  };
+  ExtendedZoneRegistrar registrar(zonedbx::kZoneRegistrySize,
+      zonedbx::kZoneRegistry, zoneRegistryById);
+  uint8_t index = 0;
+
+  unsigned long getZoneInfoMillis = runLambda(COUNT, [&index, &registrar]() {
+    index = (index + 1) & 0x03;
+    uint32_t zoneId = kZoneIds[index];
+    const extended::ZoneInfo* zoneInfo = registrar.getZoneInfoForId(zoneId);
+    disableOptimization((uint32_t) (zoneInfo != nullptr));
+  });
+  unsigned long emptyLoopMillis = runLambda(COUNT, [&index]() {
+    index = (index + 1) & 0x03;
+    uint32_t zoneId = kZoneIds[index];
+    disableOptimization(zoneId);
+  });
+  long elapsedMillis = getZoneInfoMillis - emptyLoopMillis;
+
+  SERIAL_PORT_MONITOR.print(FPSTR(label));
+  printMicrosPerIteration(elapsedMillis);
+  SERIAL_PORT_MONITOR.println(FPSTR(COL_DIVIDER));
+}
+#endif
+
 void runBenchmarks() {
   SERIAL_PORT_MONITOR.println(FPSTR(TOP));
   SERIAL_PORT_MONITOR.println(FPSTR(HEADER));
@@ -472,11 +949,17 @@ void runBenchmarks() {
   SERIAL_PORT_MONITOR.println(FPSTR(ROW_DIVIDER));
 
   runLocalDateForEpochDays();
+  runLocalDateForEpochDaysArray();
+  runLocalDateExtractYearMonthDays();
   runLocalDateToEpochDays();
   runLocalDateDaysOfWeek();
 
   runOffsetDateTimeForEpochSeconds();
   runOffsetDateTimeToEpochSeconds();
+  runOffsetDateTimeForDateString();
+  runOffsetDateTimeForIso8601();
+  runOffsetDateTimePrintTo();
+  runOffsetDateTimeFormatTo();
 
   runZonedDateTimeToEpochSeconds();
   runZonedDateTimeToEpochDays();
@@ -486,6 +969,28 @@ void runBenchmarks() {
   runZonedDateTimeForEpochSecondsBasicZoneManagerCached();
   runZonedDateTimeForEpochSecondsExtendedZoneManager();
   runZonedDateTimeForEpochSecondsExtendedZoneManagerCached();
+  runZonedDateTimeForEpochSecondsExtendedBatch();
+
+  runExtendedZoneProcessorGetUtcOffsetCached();
+  runExtendedZoneProcessorGetOffsetDateTimeCached();
+  runBasicZoneProcessorGetOffsetDateTimeCached();
+  runExtendedZoneProcessorGetUtcOffsetYearly(
+      EXTENDED_GET_UTC_OFFSET_NEXT_YEAR, 1);
+  runExtendedZoneProcessorGetUtcOffsetYearly(
+      EXTENDED_GET_UTC_OFFSET_PREV_YEAR, -1);
+#if ! defined(ARDUINO_ARCH_AVR)
+  runFlatZoneProcessorGetUtcOffset();
+#endif
+#if defined(__linux__) || defined(__APPLE__)
+  runTzifZoneProcessorGetUtcOffset(TZIF_GET_UTC_OFFSET, 0);
+  runTzifZoneProcessorGetUtcOffset(TZIF_GET_UTC_OFFSET_FOOTER,
+      LocalDate::forComponents(2040, 1, 1).toEpochSeconds());
+#endif
+#if ! defined(ARDUINO_ARCH_AVR)
+  runZoneRegistrarGetZoneInfoForId(REGISTRAR_FOR_ID_LINEAR, nullptr);
+  runZoneRegistrarGetZoneInfoForId(REGISTRAR_FOR_ID_BINARY,
+      zonedbx::kZoneRegistryById);
+#endif
 
   SERIAL_PORT_MONITOR.println(FPSTR(BOTTOM));
 
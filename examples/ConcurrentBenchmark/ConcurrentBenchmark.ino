@@ -0,0 +1,139 @@
+/*
+ * A program to measure how the throughput of TimeZone::getUtcOffset() scales
+ * with the number of threads, comparing an ExtendedZoneManager protected by a
+ * global mutex against the ConcurrentZoneManager.
+ *
+ * This runs only on Linux or MacOS, using UnixHostDuino.
+ */
+
+#include <Arduino.h>
+#include <AceTime.h>
+
+using namespace ace_time;
+
+#if ! defined(ARDUINO)
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+// Number of getUtcOffset() calls per thread.
+static const uint32_t kCount = 200000;
+
+static const uint8_t kNumZones = 8;
+static const extended::ZoneInfo* const kZoneInfos[kNumZones] = {
+  &zonedbx::kZoneAmerica_Los_Angeles,
+  &zonedbx::kZoneAmerica_Denver,
+  &zonedbx::kZoneAmerica_Chicago,
+  &zonedbx::kZoneAmerica_New_York,
+  &zonedbx::kZoneEurope_London,
+  &zonedbx::kZoneEurope_Paris,
+  &zonedbx::kZoneAsia_Tokyo,
+  &zonedbx::kZoneAustralia_Sydney,
+};
+
+// Spread the lookups over 2 years, so that the ZoneProcessors must sometimes
+// recalculate their transitions.
+static const acetime_t kStartSeconds = 568080000; // 2018-01-01
+static const acetime_t kTwoYears = 2 * 365 * 86400;
+
+static ExtendedZoneManager<kNumZones> lockedManager(
+    zonedbx::kZoneRegistrySize, zonedbx::kZoneRegistry);
+static std::mutex lockedManagerMutex;
+
+static ConcurrentZoneManager<kNumZones> concurrentManager(
+    zonedbx::kZoneRegistrySize, zonedbx::kZoneRegistry);
+
+volatile int32_t guard;
+
+/** Perform kCount lookups, calling LOOKUP(timeZone, epochSeconds). */
+template <typename LOOKUP>
+static void runThread(const TimeZone* timeZones, uint8_t threadIndex,
+    LOOKUP lookup) {
+  // Simple linear congruential generator, different for each thread.
+  uint32_t random = 12345 + threadIndex;
+  int32_t sum = 0;
+  for (uint32_t i = 0; i < kCount; i++) {
+    random = random * 1103515245 + 12345;
+    const TimeZone& tz = timeZones[(random >> 8) % kNumZones];
+    acetime_t epochSeconds = kStartSeconds + (random >> 4) % kTwoYears;
+    sum += lookup(tz, epochSeconds);
+  }
+  guard = sum;
+}
+
+/**
+ * Run numThreads threads concurrently, and return the total throughput in
+ * lookups per microsecond.
+ */
+template <typename LOOKUP>
+static double runThreads(const TimeZone* timeZones, uint8_t numThreads,
+    LOOKUP lookup) {
+  std::thread threads[32];
+  auto start = std::chrono::steady_clock::now();
+  for (uint8_t t = 0; t < numThreads; t++) {
+    threads[t] = std::thread(runThread<LOOKUP>, timeZones, t, lookup);
+  }
+  for (uint8_t t = 0; t < numThreads; t++) {
+    threads[t].join();
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  double micros = std::chrono::duration<double, std::micro>(elapsed).count();
+  return numThreads * kCount / micros;
+}
+
+static void runBenchmarks() {
+  TimeZone lockedZones[kNumZones];
+  TimeZone concurrentZones[kNumZones];
+  for (uint8_t z = 0; z < kNumZones; z++) {
+    lockedZones[z] = lockedManager.createForZoneInfo(kZoneInfos[z]);
+    concurrentZones[z] = concurrentManager.createForZoneInfo(kZoneInfos[z]);
+  }
+
+  auto lockedLookup = [](const TimeZone& tz, acetime_t epochSeconds) {
+    std::lock_guard<std::mutex> lock(lockedManagerMutex);
+    return (int32_t) tz.getUtcOffset(epochSeconds).toMinutes();
+  };
+  auto concurrentLookup = [](const TimeZone& tz, acetime_t epochSeconds) {
+    return (int32_t) tz.getUtcOffset(epochSeconds).toMinutes();
+  };
+
+  unsigned maxThreads = std::thread::hardware_concurrency();
+  if (maxThreads == 0) maxThreads = 1;
+  if (maxThreads > 32) maxThreads = 32;
+
+  SERIAL_PORT_MONITOR.println(
+      F("+---------+-------------------------+-------------------------+"));
+  SERIAL_PORT_MONITOR.println(
+      F("| threads |     locked (lookups/us) | concurrent (lookups/us) |"));
+  SERIAL_PORT_MONITOR.println(
+      F("|---------+-------------------------+-------------------------|"));
+  for (unsigned numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+    double locked = runThreads(lockedZones, numThreads, lockedLookup);
+    double concurrent = runThreads(concurrentZones, numThreads,
+        concurrentLookup);
+    char line[80];
+    snprintf(line, sizeof(line), "| %7u | %23.2f | %23.2f |",
+        numThreads, locked, concurrent);
+    SERIAL_PORT_MONITOR.println(line);
+  }
+  SERIAL_PORT_MONITOR.println(
+      F("+---------+-------------------------+-------------------------+"));
+  SERIAL_PORT_MONITOR.print(F("Number of lookups per thread: "));
+  SERIAL_PORT_MONITOR.println(kCount);
+}
+
+#endif
+
+void setup() {
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // Wait until SERIAL_PORT_MONITOR is ready
+
+#if ! defined(ARDUINO)
+  runBenchmarks();
+  exit(0);
+#endif
+}
+
+void loop() {
+}
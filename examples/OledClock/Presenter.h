@@ -174,7 +174,7 @@ class Presenter {
       mOled.println();
 
       // week day
-      mOled.print(DateStrings().dayOfWeekLongString(dateTime.dayOfWeek()));
+      mOled.print(DateStrings::dayOfWeekLongName(dateTime.dayOfWeek()));
       mOled.clearToEOL();
     }
 
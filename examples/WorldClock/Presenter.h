@@ -134,7 +134,7 @@ class Presenter {
       mOled.println();
       mOled.println();
 
-      mOled.print(DateStrings().dayOfWeekShortString(dateTime.dayOfWeek()));
+      mOled.print(DateStrings::dayOfWeekShortName(dateTime.dayOfWeek()));
       mOled.print(' ');
       printPad2(mOled, dateTime.month(), ' ');
       mOled.print('/');
@@ -217,7 +217,7 @@ class Presenter {
 
       // week day
       mOled.println();
-      mOled.print(DateStrings().dayOfWeekLongString(dateTime.dayOfWeek()));
+      mOled.print(DateStrings::dayOfWeekLongName(dateTime.dayOfWeek()));
       mOled.clearToEOL();
 
       // abbreviation and place name
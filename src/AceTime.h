@@ -16,6 +16,7 @@
 #include "ace_time/common/compat.h"
 #include "ace_time/common/common.h"
 #include "ace_time/common/DateStrings.h"
+#include "ace_time/common/BufferWriter.h"
 #include "ace_time/internal/ZoneContext.h"
 #include "ace_time/internal/ZoneInfo.h"
 #include "ace_time/internal/ZonePolicy.h"
@@ -25,7 +26,9 @@
 #include "ace_time/zonedbx/zone_policies.h"
 #include "ace_time/zonedbx/zone_infos.h"
 #include "ace_time/zonedbx/zone_registry.h"
+#include "ace_time/zonedbx/precomputed.h"
 #include "ace_time/ZoneRegistrar.h"
+#include "ace_time/MappedZoneDb.h"
 #include "ace_time/LocalDate.h"
 #include "ace_time/local_date_mutation.h"
 #include "ace_time/LocalTime.h"
@@ -33,16 +36,32 @@
 #include "ace_time/TimeOffset.h"
 #include "ace_time/time_offset_mutation.h"
 #include "ace_time/OffsetDateTime.h"
+#include "ace_time/Instant.h"
+#include "ace_time/ResolvedDateTime.h"
+#include "ace_time/ZoneStats.h"
 #include "ace_time/ZoneProcessor.h"
 #include "ace_time/BasicZoneProcessor.h"
 #include "ace_time/ExtendedZoneProcessor.h"
+#include "ace_time/ExtendedZoneProcessorN.h"
+#include "ace_time/ZoneTransitionIterator.h"
+#include "ace_time/PrecomputedZone.h"
+#include "ace_time/CompiledZone.h"
+#include "ace_time/FlatZoneProcessor.h"
+#include "ace_time/internal/PosixTz.h"
+#include "ace_time/TzifZoneProcessor.h"
+#include "ace_time/PosixZoneProcessor.h"
 #include "ace_time/ZoneProcessorCache.h"
 #include "ace_time/ZoneManager.h"
+// thread_local and threads are available only on Linux or MacOS
+#if ! defined(ARDUINO)
+  #include "ace_time/ConcurrentZoneManager.h"
+#endif
 #include "ace_time/TimeZoneData.h"
 #include "ace_time/TimeZone.h"
 #include "ace_time/BasicZone.h"
 #include "ace_time/ExtendedZone.h"
 #include "ace_time/ZonedDateTime.h"
+#include "ace_time/DateTimeFormatter.h"
 #include "ace_time/zoned_date_time_mutation.h"
 #include "ace_time/TimePeriod.h"
 #include "ace_time/time_period_mutation.h"
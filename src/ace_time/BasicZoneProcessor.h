@@ -25,10 +25,12 @@ class BasicZoneProcessorTest_setZoneInfo;
 class BasicZoneProcessorTest_createAbbreviation;
 class BasicZoneProcessorTest_calcStartDayOfMonth;
 class BasicZoneProcessorTest_calcRuleOffsetCode;
+class BasicZoneProcessorTest_getOffsetDateTime_allZones;
 
 namespace ace_time {
 
-template<uint8_t SIZE, uint8_t TYPE, typename ZS, typename ZI, typename ZIB>
+template<uint8_t SIZE, uint8_t TYPE, typename ZS, typename ZI, typename ZIB,
+    uint8_t EVICTION>
 class ZoneProcessorCacheImpl;
 
 namespace basic {
@@ -223,24 +225,27 @@ class BasicZoneProcessor: public ZoneProcessor {
      * The Transitions calculated by BasicZoneProcessor contain only the
      * epochSeconds when each transition occurs. They do not contain the local
      * date/time components of the transition. This design reduces the amount
-     * of memory required by BasicZoneProcessor, but this means that the
-     * information needed to implement this method correctly does not exist.
+     * of memory required by BasicZoneProcessor, but it means that the local
+     * start time of each Transition must be calculated on the fly from the
+     * UTC offsets before and after the Transition.
      *
-     * The implementation is somewhat of a hack:
+     * The localDateTime is converted to epochSeconds as if it were UTC (the
+     * "local seconds"), and findMatchForDateTime() searches the Transitions
+     * of its year once. There are 3 cases:
      *
-     * 0) Use the localDateTime to extract the offset, *assuming* that the
-     * localDatetime is UTC. This will get us within 12-14h of the correct
-     * UTC offset.
-     * 1) Use (localDateTime, offset0) to determine offset1.
-     * 2) Use (localdateTime, offset1) to determine offset2.
-     * 3) Finally, check if offset1 and offset2 are equal. If they are
-     * we reached equilibrium so we can just return (localDateTime, offset1).
-     * If they are not equal, then we have a cycle because the localDateTime
-     * occurred in a DST gap (STD->DST transition) or overlap (DST->STD
-     * transition). We arbitrarily pick the offset of the *later* epochSeconds
-     * since that seems to match closely to what most people would expect to
-     * happen in a gap or overlap (e.g. In the gap of 2am->3am, a 2:30am would
-     * get shifted to 3:30am.)
+     * 1) The local seconds is at or after the local start time of the
+     * Transition using both the previous and the current UTC offset. The
+     * current offset is used.
+     * 2) The local seconds falls in a DST gap (STD->DST transition). The
+     * localDateTime is shifted forward by the size of the gap (e.g. 2:30am
+     * becomes 3:30am), which is equivalent to using the previous offset to
+     * calculate the epochSeconds, then the current offset for the result.
+     * 3) The local seconds falls in a DST overlap (DST->STD transition). If
+     * the local seconds (interpreted as UTC) is at or after the UTC start time
+     * of the Transition, the current offset is used, otherwise the previous
+     * offset is used. This reproduces the result of the iterative algorithm
+     * used by earlier versions, which picked the later offset for zones east of
+     * UTC and the earlier offset for zones west of UTC.
      *
      * The code is written slightly ackwardly to try to encourage the compiler
      * to perform Return Value Optimization. For example, I use only a single
@@ -252,36 +257,32 @@ class BasicZoneProcessor: public ZoneProcessor {
       OffsetDateTime odt;
       bool success = init(ldt.localDate());
       if (success) {
-        // 0) Use the UTC epochSeconds to get intial guess of offset.
-        acetime_t epochSeconds0 = ldt.toEpochSeconds();
-        auto offset0 = getUtcOffset(epochSeconds0);
-
-        // 1) Use offset0 to get the next epochSeconds and offset.
-        odt = OffsetDateTime::forLocalDateTimeAndOffset(ldt, offset0);
-        acetime_t epochSeconds1 = odt.toEpochSeconds();
-        auto offset1 = getUtcOffset(epochSeconds1);
-
-        // 2) Use offset1 to get the next epochSeconds and offset.
-        odt = OffsetDateTime::forLocalDateTimeAndOffset(ldt, offset1);
-        acetime_t epochSeconds2 = odt.toEpochSeconds();
-        auto offset2 = getUtcOffset(epochSeconds2);
-
-        // If offset1 and offset2 are equal, then we have an equilibrium
-        // and odt(1) must equal odt(2), so we can just return the last odt.
-        if (offset1.toOffsetCode() == offset2.toOffsetCode()) {
-          // pass
+        acetime_t localSeconds = ldt.toEpochSeconds();
+        int8_t prevOffsetCode;
+        const basic::Transition* transition =
+            findMatchForDateTime(localSeconds, &prevOffsetCode);
+        int8_t offsetCode = transition->offsetCode;
+        acetime_t startEpochSeconds = transition->startEpochSeconds;
+
+        // The previous offset differs only for a real Transition, so
+        // startEpochSeconds is never kMinEpochSeconds below.
+        if (prevOffsetCode < offsetCode
+            && localSeconds
+                < startEpochSeconds + (acetime_t) 900 * offsetCode) {
+          // DST gap, shift the local time forward.
+          odt = OffsetDateTime::forEpochSeconds(
+              localSeconds - (acetime_t) 900 * prevOffsetCode,
+              TimeOffset::forOffsetCode(offsetCode));
         } else {
-          // Pick the later epochSeconds and offset
-          acetime_t epochSeconds;
-          TimeOffset offset;
-          if (epochSeconds1 > epochSeconds2) {
-            epochSeconds = epochSeconds1;
-            offset = offset1;
-          } else {
-            epochSeconds = epochSeconds2;
-            offset = offset2;
+          // DST overlap
+          if (prevOffsetCode > offsetCode
+              && localSeconds
+                  < startEpochSeconds + (acetime_t) 900 * prevOffsetCode
+              && localSeconds < startEpochSeconds) {
+            offsetCode = prevOffsetCode;
           }
-          odt = OffsetDateTime::forEpochSeconds(epochSeconds, offset);
+          odt = OffsetDateTime::forLocalDateTimeAndOffset(
+              ldt, TimeOffset::forOffsetCode(offsetCode));
         }
       } else {
         odt = OffsetDateTime::forError();
@@ -290,6 +291,34 @@ class BasicZoneProcessor: public ZoneProcessor {
       return odt;
     }
 
+    ResolvedDateTime resolveLocalDateTime(const LocalDateTime& ldt,
+        uint8_t policy) const override {
+      if (ldt.isError() || ! init(ldt.localDate())) {
+        return ResolvedDateTime::forError();
+      }
+
+      acetime_t localSeconds = ldt.toEpochSeconds();
+      int8_t prevOffsetCode;
+      const basic::Transition* transition =
+          findMatchForDateTime(localSeconds, &prevOffsetCode);
+      int8_t offsetCode = transition->offsetCode;
+
+      // The local seconds is in the gap or overlap if it is before the local
+      // start time using the larger of the 2 offsets.
+      int8_t maxOffsetCode = (prevOffsetCode > offsetCode)
+          ? prevOffsetCode : offsetCode;
+      if (prevOffsetCode == offsetCode
+          || localSeconds >= transition->startEpochSeconds
+              + (acetime_t) 900 * maxOffsetCode) {
+        return ResolvedDateTime::forUnique(
+            ldt, TimeOffset::forOffsetCode(offsetCode));
+      }
+      return ResolvedDateTime::forTransition(ldt,
+          TimeOffset::forOffsetCode(prevOffsetCode),
+          TimeOffset::forOffsetCode(offsetCode),
+          transition->startEpochSeconds, policy);
+    }
+
     void printTo(Print& printer) const override;
 
     void printShortTo(Print& printer) const override;
@@ -372,8 +401,10 @@ class BasicZoneProcessor: public ZoneProcessor {
     friend class ::BasicZoneProcessorTest_createAbbreviation;
     friend class ::BasicZoneProcessorTest_calcStartDayOfMonth;
     friend class ::BasicZoneProcessorTest_calcRuleOffsetCode;
+    friend class ::BasicZoneProcessorTest_getOffsetDateTime_allZones;
 
-    template<uint8_t SIZE, uint8_t TYPE, typename ZS, typename ZI, typename ZIB>
+    template<uint8_t SIZE, uint8_t TYPE, typename ZS, typename ZI, typename ZIB,
+        uint8_t EVICTION>
     friend class ZoneProcessorCacheImpl; // setZoneInfo()
 
     /** Maximum size of Transition cache across supported zones. */
@@ -381,10 +412,10 @@ class BasicZoneProcessor: public ZoneProcessor {
 
     /**
      * The smallest Transition.startEpochSeconds which represents -Infinity.
-     * Can't use INT32_MIN because that is used internally to indicate
+     * Can't use ACETIME_T_MIN because that is used internally to indicate
      * "invalid".
      */
-    static const acetime_t kMinEpochSeconds = INT32_MIN + 1;
+    static const acetime_t kMinEpochSeconds = ACETIME_T_MIN + 1;
 
     // Disable copy constructor and assignment operator.
     BasicZoneProcessor(const BasicZoneProcessor&) = delete;
@@ -445,7 +476,11 @@ class BasicZoneProcessor: public ZoneProcessor {
       if (ld.month() == 1 && ld.day() == 1) {
         year--;
       }
-      if (isFilled(year)) return true;
+      if (isFilled(year)) {
+        statsHit();
+        return true;
+      }
+      uint16_t startMicros = statsRebuildStart();
 
       mYear = year;
       mNumTransitions = 0; // clear cache
@@ -460,6 +495,7 @@ class BasicZoneProcessor: public ZoneProcessor {
       calcAbbreviations();
 
       mIsFilled = true;
+      statsRebuildEnd(startMicros);
       return true;
     }
 
@@ -890,6 +926,34 @@ class BasicZoneProcessor: public ZoneProcessor {
       return closestMatch;
     }
 
+    /**
+     * Search the cache and find the Transition which applies to the given
+     * local seconds, i.e. a LocalDateTime converted to epochSeconds as if it
+     * were UTC. A Transition matches if the local seconds is at or after its
+     * local start time using the smaller of the UTC offsets before and after
+     * the Transition, so the Transition of a DST gap or overlap is matched
+     * over its entire duration. The offsetCode of the previous Transition is
+     * returned in prevOffsetCode.
+     */
+    const basic::Transition* findMatchForDateTime(acetime_t localSeconds,
+        int8_t* prevOffsetCode) const {
+      const basic::Transition* closestMatch = &mPrevTransition;
+      const basic::Transition* prev = &mPrevTransition;
+      *prevOffsetCode = mPrevTransition.offsetCode;
+      for (uint8_t i = 0; i < mNumTransitions; i++) {
+        const basic::Transition* m = &mTransitions[i];
+        int8_t minOffsetCode = (prev->offsetCode < m->offsetCode)
+            ? prev->offsetCode : m->offsetCode;
+        if (m->startEpochSeconds + (acetime_t) 900 * minOffsetCode
+            <= localSeconds) {
+          closestMatch = m;
+          *prevOffsetCode = prev->offsetCode;
+        }
+        prev = m;
+      }
+      return closestMatch;
+    }
+
     basic::ZoneInfoBroker mZoneInfo;
 
     mutable int16_t mYear = 0; // maybe create LocalDate::kInvalidYear?
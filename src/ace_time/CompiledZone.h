@@ -0,0 +1,234 @@
+/*
+ * MIT License
+ * Copyright (c) 2019 Brian T. Park
+ */
+
+#ifndef ACE_TIME_COMPILED_ZONE_H
+#define ACE_TIME_COMPILED_ZONE_H
+
+#include <stdint.h>
+#include <stddef.h> // size_t
+#include <string.h> // memcpy(), strncmp(), strncpy()
+#include "common/common.h"
+#include "TimeOffset.h"
+#include "LocalDate.h"
+#include "LocalDateTime.h"
+#include "OffsetDateTime.h"
+#include "ResolvedDateTime.h"
+#include "ExtendedZoneProcessor.h"
+#include "PrecomputedZone.h"
+
+namespace ace_time {
+
+/**
+ * A PrecomputedZone whose table is compiled at run time from the Transitions
+ * of every year in the range of the ZoneContext of an extended::ZoneInfo
+ * (e.g. 2000 until 2050). Unlike a ZoneProcessor, all query methods are pure
+ * const functions which do not modify any hidden state, so a single
+ * CompiledZone can be used by multiple threads concurrently, and by multiple
+ * TimeZone objects through TimeZone::forCompiledZone().
+ *
+ * The CompiledZone is owned by the application, which normally creates it
+ * once at initialization time (statically, or in an array of CompiledZones)
+ * and keeps it alive for as long as the TimeZone objects which refer to it.
+ * No heap allocation is performed. The CompiledZone can be copied by value,
+ * and the copy is an independent table with the same content.
+ *
+ * Queries outside of the range of the table return an error (e.g.
+ * TimeOffset::forError()). The range ends at the first year whose Transitions
+ * do not fit into kMaxEntries, which does not happen with the zones in the
+ * current zonedbx database. A CompiledZone consumes about 1kB of RAM, so it
+ * is intended for Linux or MacOS, or the larger 32-bit microcontrollers. If
+ * the set of zones is known at build time, the tables can be generated by
+ * tools/PrecomputedGenerator instead, and used through a
+ * PrecomputedZone without any run time initialization.
+ */
+class CompiledZone: public PrecomputedZone {
+  public:
+    /**
+     * Maximum number of entries in the table. This is enough for 2
+     * transitions per year over 50 years, plus the occasional change of the
+     * standard offset.
+     */
+    static const uint16_t kMaxEntries = 128;
+
+    /** Maximum number of distinct abbreviations in the table. */
+    static const uint8_t kMaxAbbrevs = 8;
+
+    /** Constructor for an empty CompiledZone, whose isError() is true. */
+    CompiledZone() {
+      attachBuffers();
+    }
+
+    /**
+     * Constructor which compiles the given zoneInfo, using a temporary
+     * ExtendedZoneProcessor on the stack to calculate the Transitions.
+     *
+     * @param zoneInfo pointer to an extended::ZoneInfo, can be nullptr
+     */
+    explicit CompiledZone(const extended::ZoneInfo* zoneInfo) {
+      attachBuffers();
+      ExtendedZoneProcessor processor(zoneInfo);
+      compile(processor);
+    }
+
+    /** Copy constructor. The copy refers to its own buffers. */
+    CompiledZone(const CompiledZone& that): PrecomputedZone() {
+      attachBuffers();
+      copyFrom(that);
+    }
+
+    /** Assignment operator. The copy refers to its own buffers. */
+    CompiledZone& operator=(const CompiledZone& that) {
+      if (this != &that) copyFrom(that);
+      return *this;
+    }
+
+    /** Return the number of distinct abbreviations in the table. */
+    uint8_t getNumAbbrevs() const { return mNumAbbrevs; }
+
+    /** Return the abbreviation at index i, for i < getNumAbbrevs(). */
+    const char* getAbbrevAt(uint8_t i) const { return mAbbrevsBuffer[i]; }
+
+  private:
+    friend class FlatZoneProcessor; // compile()
+
+    /**
+     * Fill the table with the Transitions of each year of the ZoneContext,
+     * calculated by the given processor, stopping at the first year which
+     * does not fit. Consecutive Transitions with the same offsets and
+     * abbreviation are merged.
+     */
+    void compile(const ExtendedZoneProcessor& processor) {
+      mZoneInfo = (const extended::ZoneInfo*) processor.getZoneInfo();
+      mNumEntries = 0;
+      mNumAbbrevs = 0;
+      mTableStartSeconds = 0;
+      mTableUntilSeconds = 0;
+      if (! mZoneInfo) return;
+
+      int16_t startYear = processor.mZoneInfo.startYear();
+      int16_t untilYear = processor.mZoneInfo.untilYear();
+      mTableStartSeconds = LocalDate::forComponents(startYear, 1, 1)
+          .toEpochSeconds();
+      mTableUntilSeconds = mTableStartSeconds;
+
+      for (int16_t year = startYear; year < untilYear; year++) {
+        acetime_t yearUntilSeconds = LocalDate::forComponents(year + 1, 1, 1)
+            .toEpochSeconds();
+        uint16_t numEntries = mNumEntries;
+        if (! addYear(processor, year, mTableUntilSeconds, yearUntilSeconds)) {
+          mNumEntries = numEntries;
+          break;
+        }
+        mTableUntilSeconds = yearUntilSeconds;
+      }
+    }
+
+    /**
+     * Add the Transitions which are in effect in [startSeconds, untilSeconds)
+     * of the given year. Return false if the table is full.
+     */
+    bool addYear(const ExtendedZoneProcessor& processor, int16_t year,
+        acetime_t startSeconds, acetime_t untilSeconds) {
+      if (! processor.init(LocalDate::forComponents(year, 1, 1))) return false;
+
+      if (! addEntry(processor.findTransition(startSeconds))) return false;
+      auto& storage = processor.mTransitionStorage;
+      extended::Transition** begin = storage.getActivePoolBegin();
+      extended::Transition** end = storage.getActivePoolEnd();
+      for (extended::Transition** iter = begin; iter != end; ++iter) {
+        const extended::Transition* t = *iter;
+        if (t->startEpochSeconds <= startSeconds) continue;
+        if (t->startEpochSeconds >= untilSeconds) continue;
+        if (! addEntry(t)) return false;
+      }
+      return true;
+    }
+
+    /** Append the transition to the table. Return false if full. */
+    bool addEntry(const extended::Transition* t) {
+      if (t == nullptr) return false;
+
+      int16_t abbrevIndex = findOrAddAbbrev(t->abbrev);
+      if (abbrevIndex < 0) return false;
+
+      if (mNumEntries > 0) {
+        uint16_t last = mNumEntries - 1;
+        if (mOffsetCodes[last] == t->offsetCode
+            && mDeltaCodes[last] == t->deltaCode
+            && mAbbrevIndexes[last] == abbrevIndex) {
+          return true;
+        }
+      }
+      if (mNumEntries >= kMaxEntries) return false;
+
+      mStartEpochSecondsBuffer[mNumEntries] = t->startEpochSeconds;
+      mOffsetCodesBuffer[mNumEntries] = t->offsetCode;
+      mDeltaCodesBuffer[mNumEntries] = t->deltaCode;
+      mAbbrevIndexesBuffer[mNumEntries] = abbrevIndex;
+      mNumEntries++;
+      return true;
+    }
+
+    /**
+     * Return the index of the abbreviation in mAbbrevsBuffer, adding it if
+     * necessary. Return -1 if mAbbrevsBuffer is full.
+     */
+    int16_t findOrAddAbbrev(const char* abbrev) {
+      for (uint8_t i = 0; i < mNumAbbrevs; i++) {
+        if (strncmp(mAbbrevsBuffer[i], abbrev,
+            extended::Transition::kAbbrevSize) == 0) {
+          return i;
+        }
+      }
+      if (mNumAbbrevs >= kMaxAbbrevs) return -1;
+
+      strncpy(mAbbrevsBuffer[mNumAbbrevs], abbrev,
+          extended::Transition::kAbbrevSize);
+      mAbbrevsBuffer[mNumAbbrevs][extended::Transition::kAbbrevSize - 1] = '\0';
+      return mNumAbbrevs++;
+    }
+
+    /** Point the columns of the PrecomputedZone to the buffers. */
+    void attachBuffers() {
+      mStartEpochSeconds = mStartEpochSecondsBuffer;
+      mOffsetCodes = mOffsetCodesBuffer;
+      mDeltaCodes = mDeltaCodesBuffer;
+      mAbbrevIndexes = mAbbrevIndexesBuffer;
+      for (uint8_t i = 0; i < kMaxAbbrevs; i++) {
+        mAbbrevPointers[i] = mAbbrevsBuffer[i];
+      }
+      mAbbrevs = mAbbrevPointers;
+    }
+
+    /** Copy the content of the table of 'that' into the buffers. */
+    void copyFrom(const CompiledZone& that) {
+      mZoneInfo = that.mZoneInfo;
+      mTableStartSeconds = that.mTableStartSeconds;
+      mTableUntilSeconds = that.mTableUntilSeconds;
+      mNumEntries = that.mNumEntries;
+      mNumAbbrevs = that.mNumAbbrevs;
+      memcpy(mStartEpochSecondsBuffer, that.mStartEpochSecondsBuffer,
+          sizeof(mStartEpochSecondsBuffer));
+      memcpy(mOffsetCodesBuffer, that.mOffsetCodesBuffer,
+          sizeof(mOffsetCodesBuffer));
+      memcpy(mDeltaCodesBuffer, that.mDeltaCodesBuffer,
+          sizeof(mDeltaCodesBuffer));
+      memcpy(mAbbrevIndexesBuffer, that.mAbbrevIndexesBuffer,
+          sizeof(mAbbrevIndexesBuffer));
+      memcpy(mAbbrevsBuffer, that.mAbbrevsBuffer, sizeof(mAbbrevsBuffer));
+    }
+
+    acetime_t mStartEpochSecondsBuffer[kMaxEntries];
+    int8_t mOffsetCodesBuffer[kMaxEntries];
+    int8_t mDeltaCodesBuffer[kMaxEntries];
+    uint8_t mAbbrevIndexesBuffer[kMaxEntries];
+    char mAbbrevsBuffer[kMaxAbbrevs][extended::Transition::kAbbrevSize];
+    const char* mAbbrevPointers[kMaxAbbrevs];
+    uint8_t mNumAbbrevs = 0;
+};
+
+}
+
+#endif
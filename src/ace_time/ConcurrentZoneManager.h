@@ -0,0 +1,92 @@
+/*
+ * MIT License
+ * Copyright (c) 2019 Brian T. Park
+ */
+
+#ifndef ACE_TIME_CONCURRENT_ZONE_MANAGER_H
+#define ACE_TIME_CONCURRENT_ZONE_MANAGER_H
+
+#include "ZoneProcessorCache.h"
+#include "ZoneManager.h"
+
+namespace ace_time {
+
+/**
+ * A ZoneProcessorCache which gives each thread its own instance of the ZSC
+ * cache, stored in a thread_local variable. The TimeZone objects created by
+ * a ZoneManager which uses this cache can be shared by multiple threads,
+ * because each thread looks up the ZoneProcessor in its own cache, so the
+ * mutable state of the ZoneProcessors is never shared.
+ *
+ * The thread_local cache belongs to the ZSC type, not to the instance of
+ * this class. All instances with the same ZSC share the same per-thread
+ * caches, which is harmless because the caches are keyed by the ZoneInfo.
+ *
+ * This requires C++11 threads, so it is intended for Linux or MacOS.
+ *
+ * @tparam ZSC type of the per-thread cache (e.g.
+ *    ExtendedZoneProcessorCache<SIZE>)
+ */
+template<typename ZSC>
+class ThreadLocalZoneProcessorCache: public ZoneProcessorCache {
+  public:
+    ThreadLocalZoneProcessorCache() {}
+
+    uint8_t getType() override { return localCache().getType(); }
+
+    ZoneProcessor* getZoneProcessor(const void* zoneInfo) override {
+      return localCache().getZoneProcessor(zoneInfo);
+    }
+
+    /** Return the statistics of the cache of the calling thread. */
+    ZoneProcessorCacheStats getStats() const {
+      return localCache().getStats();
+    }
+
+    /** Reset the statistics of the cache of the calling thread. */
+    void resetStats() { localCache().resetStats(); }
+
+  private:
+    // disable copy constructor and assignment operator
+    ThreadLocalZoneProcessorCache(const ThreadLocalZoneProcessorCache&) =
+        delete;
+    ThreadLocalZoneProcessorCache& operator=(
+        const ThreadLocalZoneProcessorCache&) = delete;
+
+    /** Return the cache of the calling thread, creating it if necessary. */
+    static ZSC& localCache() {
+      static thread_local ZSC cache;
+      return cache;
+    }
+};
+
+/**
+ * An ExtendedZoneManager whose TimeZone objects can be used concurrently by
+ * multiple threads without a lock. Each thread holds SIZE
+ * ExtendedZoneProcessors in a thread_local cache, so the memory consumption
+ * is proportional to the number of threads which use the TimeZones. The
+ * ZoneRegistrar is read-only, so the createForXxx() methods are thread-safe.
+ *
+ * The getStats() method returns the statistics of the calling thread.
+ *
+ * @tparam SIZE size of the ExtendedZoneProcessorCache of each thread
+ * @tparam EVICTION eviction policy of the ExtendedZoneProcessorCache
+ */
+template<uint16_t SIZE,
+    uint8_t EVICTION = ZoneProcessorCache::kEvictionRoundRobin>
+class ConcurrentZoneManager: public ZoneManager<extended::ZoneInfo,
+    ExtendedZoneRegistrar, ThreadLocalZoneProcessorCache<
+        ExtendedZoneProcessorCache<SIZE, EVICTION>>> {
+  public:
+    ConcurrentZoneManager(uint16_t registrySize,
+        const extended::ZoneInfo* const* zoneRegistry,
+        const extended::ZoneInfo* const* zoneRegistryById = nullptr):
+        ZoneManager<extended::ZoneInfo, ExtendedZoneRegistrar,
+            ThreadLocalZoneProcessorCache<
+                ExtendedZoneProcessorCache<SIZE, EVICTION>>>(
+            registrySize, zoneRegistry, zoneRegistryById) {}
+};
+
+}
+
+#endif
@@ -0,0 +1,300 @@
+/*
+ * MIT License
+ * Copyright (c) 2019 Brian T. Park
+ */
+
+#include <Print.h>
+#include "common/util.h"
+#include "common/DateStrings.h"
+#include "common/BufferWriter.h"
+#include "DateTimeFormatter.h"
+
+namespace ace_time {
+
+using common::BufferWriter;
+
+namespace {
+
+/** Adapts a Print to the sink interface of format(). */
+class PrintSink {
+  public:
+    explicit PrintSink(Print& printer):
+        mPrinter(printer) {}
+
+    void writeChar(char c) { mPrinter.print(c); }
+
+    void writePad2(uint8_t value) { common::printPad2(mPrinter, value); }
+
+    void writeString(const char* s) { mPrinter.print(s); }
+
+    void writeString(const __FlashStringHelper* s) { mPrinter.print(s); }
+
+    void writeAbbrev(const TimeZone& tz, acetime_t epochSeconds) {
+      tz.printAbbrevTo(mPrinter, epochSeconds);
+    }
+
+  private:
+    Print& mPrinter;
+};
+
+/** Adapts a BufferWriter to the sink interface of format(). */
+class BufferSink {
+  public:
+    explicit BufferSink(BufferWriter& writer):
+        mWriter(writer) {}
+
+    void writeChar(char c) { mWriter.writeChar(c); }
+
+    void writePad2(uint8_t value) { mWriter.writePad2(value); }
+
+    void writeString(const char* s) { mWriter.writeString(s); }
+
+    void writeString(const __FlashStringHelper* s) { mWriter.writeString(s); }
+
+    void writeAbbrev(const TimeZone& tz, acetime_t epochSeconds) {
+      tz.formatAbbrevTo(mWriter, epochSeconds);
+    }
+
+  private:
+    BufferWriter& mWriter;
+};
+
+/** Write a number from 0 to 999 as 3 digits into the sink. */
+template <typename S>
+void writePad3(S& sink, uint16_t value) {
+  sink.writeChar('0' + value / 100);
+  sink.writePad2(value % 100);
+}
+
+}
+
+void DateTimeFormatter::compile(const char* pattern) {
+  mNumOps = 0;
+  bool ok = true;
+  for (const char* s = pattern; ok && *s; s++) {
+    uint8_t c = *s;
+    if (c != '%') {
+      if (c >= kOpEscape) ok = addOp(kOpEscape);
+      ok = ok && addOp(c);
+      continue;
+    }
+
+    c = *++s;
+    switch (c) {
+      case 'Y': ok = addOp(kOpYear); break;
+      case 'y': ok = addOp(kOpYearOfCentury); break;
+      case 'm': ok = addOp(kOpMonth); break;
+      case 'B': ok = addOp(kOpMonthLong); break;
+      case 'b':
+      case 'h': ok = addOp(kOpMonthShort); break;
+      case 'd': ok = addOp(kOpDay); break;
+      case 'e': ok = addOp(kOpDaySpace); break;
+      case 'j': ok = addOp(kOpDayOfYear); break;
+      case 'A': ok = addOp(kOpWeekdayLong); break;
+      case 'a': ok = addOp(kOpWeekdayShort); break;
+      case 'u': ok = addOp(kOpWeekdayNumber); break;
+      case 'H': ok = addOp(kOpHour); break;
+      case 'I': ok = addOp(kOpHour12); break;
+      case 'p': ok = addOp(kOpAmPm); break;
+      case 'M': ok = addOp(kOpMinute); break;
+      case 'S': ok = addOp(kOpSecond); break;
+      case 'z': ok = addOp(kOpOffset); break;
+      case 'Z': ok = addOp(kOpAbbrev); break;
+      case 'N': ok = addOp(kOpNanos); break;
+      case '3':
+      case '6':
+      case '9':
+        if (*++s == 'N') {
+          ok = addOp((c == '3') ? kOpMillis
+              : (c == '6') ? kOpMicros : kOpNanos);
+        } else {
+          ok = false;
+        }
+        break;
+      case 'F':
+        ok = addOp(kOpYear) && addOp('-') && addOp(kOpMonth) && addOp('-')
+            && addOp(kOpDay);
+        break;
+      case 'T':
+        ok = addOp(kOpHour) && addOp(':') && addOp(kOpMinute) && addOp(':')
+            && addOp(kOpSecond);
+        break;
+      case 'R':
+        ok = addOp(kOpHour) && addOp(':') && addOp(kOpMinute);
+        break;
+      case 'n': ok = addOp('\n'); break;
+      case 't': ok = addOp('\t'); break;
+      case '%': ok = addOp('%'); break;
+      case ':':
+        if (*++s == 'z') {
+          ok = addOp(kOpOffsetColon);
+          break;
+        }
+        // fall through
+      default:
+        // Unknown conversion, or '%' at the end of the pattern.
+        ok = false;
+        break;
+    }
+  }
+  if (! ok) mNumOps = kInvalidNumOps;
+}
+
+template <typename S>
+void DateTimeFormatter::format(S& sink, const ZonedDateTime& dateTime,
+    uint32_t nanos) const {
+  if (isError()) return;
+  if (dateTime.isError()) {
+    sink.writeString(F("<Invalid ZonedDateTime>"));
+    return;
+  }
+
+  for (uint8_t i = 0; i < mNumOps; i++) {
+    uint8_t op = mOps[i];
+    switch (op) {
+      case kOpEscape:
+        sink.writeChar(mOps[++i]);
+        break;
+      case kOpYear:
+        sink.writePad2(dateTime.year() / 100);
+        sink.writePad2(dateTime.year() % 100);
+        break;
+      case kOpYearOfCentury:
+        sink.writePad2(dateTime.year() % 100);
+        break;
+      case kOpMonth:
+        sink.writePad2(dateTime.month());
+        break;
+      case kOpMonthLong:
+        sink.writeString(DateStrings::monthLongName(dateTime.month()));
+        break;
+      case kOpMonthShort:
+        sink.writeString(DateStrings::monthShortName(dateTime.month()));
+        break;
+      case kOpDay:
+        sink.writePad2(dateTime.day());
+        break;
+      case kOpDaySpace:
+        if (dateTime.day() < 10) {
+          sink.writeChar(' ');
+          sink.writeChar('0' + dateTime.day());
+        } else {
+          sink.writePad2(dateTime.day());
+        }
+        break;
+      case kOpDayOfYear:
+      {
+        const LocalDate& ld = dateTime.localDateTime().localDate();
+        uint16_t dayOfYear = ld.toEpochDays()
+            - LocalDate::forComponents(ld.year(), 1, 1).toEpochDays() + 1;
+        sink.writeChar('0' + dayOfYear / 100);
+        sink.writePad2(dayOfYear % 100);
+        break;
+      }
+      case kOpWeekdayLong:
+        sink.writeString(DateStrings::dayOfWeekLongName(dateTime.dayOfWeek()));
+        break;
+      case kOpWeekdayShort:
+        sink.writeString(DateStrings::dayOfWeekShortName(dateTime.dayOfWeek()));
+        break;
+      case kOpWeekdayNumber:
+        sink.writeChar('0' + dateTime.dayOfWeek());
+        break;
+      case kOpHour:
+        sink.writePad2(dateTime.hour());
+        break;
+      case kOpHour12:
+      {
+        uint8_t hour = dateTime.hour() % 12;
+        sink.writePad2(hour == 0 ? 12 : hour);
+        break;
+      }
+      case kOpAmPm:
+        sink.writeString((dateTime.hour() < 12) ? "AM" : "PM");
+        break;
+      case kOpMinute:
+        sink.writePad2(dateTime.minute());
+        break;
+      case kOpSecond:
+        sink.writePad2(dateTime.second());
+        break;
+      case kOpOffset:
+      case kOpOffsetColon:
+      {
+        int8_t hour;
+        int8_t minute;
+        TimeOffset offset = dateTime.timeOffset();
+        offset.toHourMinute(hour, minute);
+        if (offset.toOffsetCode() < 0) {
+          sink.writeChar('-');
+          hour = -hour;
+          minute = -minute;
+        } else {
+          sink.writeChar('+');
+        }
+        sink.writePad2(hour);
+        if (op == kOpOffsetColon) sink.writeChar(':');
+        sink.writePad2(minute);
+        break;
+      }
+      case kOpAbbrev:
+        sink.writeAbbrev(dateTime.timeZone(), dateTime.toEpochSeconds());
+        break;
+      case kOpMillis:
+        writePad3(sink, nanos / 1000000);
+        break;
+      case kOpMicros:
+        writePad3(sink, nanos / 1000000);
+        writePad3(sink, nanos / 1000 % 1000);
+        break;
+      case kOpNanos:
+        writePad3(sink, nanos / 1000000);
+        writePad3(sink, nanos / 1000 % 1000);
+        writePad3(sink, nanos % 1000);
+        break;
+      default:
+        sink.writeChar(op);
+        break;
+    }
+  }
+}
+
+void DateTimeFormatter::printTo(Print& printer, const ZonedDateTime& dateTime)
+    const {
+  PrintSink sink(printer);
+  format(sink, dateTime, 0);
+}
+
+size_t DateTimeFormatter::formatTo(char* buf, size_t len,
+    const ZonedDateTime& dateTime) const {
+  BufferWriter writer(buf, len);
+  formatTo(writer, dateTime);
+  return writer.finish();
+}
+
+void DateTimeFormatter::formatTo(BufferWriter& writer,
+    const ZonedDateTime& dateTime) const {
+  BufferSink sink(writer);
+  format(sink, dateTime, 0);
+}
+
+void DateTimeFormatter::printTo(Print& printer, const Instant& instant,
+    const TimeZone& timeZone) const {
+  PrintSink sink(printer);
+  format(sink, ZonedDateTime::forInstant(instant, timeZone), instant.nanos());
+}
+
+size_t DateTimeFormatter::formatTo(char* buf, size_t len,
+    const Instant& instant, const TimeZone& timeZone) const {
+  BufferWriter writer(buf, len);
+  formatTo(writer, instant, timeZone);
+  return writer.finish();
+}
+
+void DateTimeFormatter::formatTo(BufferWriter& writer, const Instant& instant,
+    const TimeZone& timeZone) const {
+  BufferSink sink(writer);
+  format(sink, ZonedDateTime::forInstant(instant, timeZone), instant.nanos());
+}
+
+}
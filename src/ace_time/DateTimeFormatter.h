@@ -0,0 +1,202 @@
+/*
+ * MIT License
+ * Copyright (c) 2019 Brian T. Park
+ */
+
+#ifndef ACE_TIME_DATE_TIME_FORMATTER_H
+#define ACE_TIME_DATE_TIME_FORMATTER_H
+
+#include <stdint.h>
+#include <stddef.h> // size_t
+#include "ZonedDateTime.h"
+
+class Print;
+
+namespace ace_time {
+
+namespace common {
+class BufferWriter;
+}
+
+/**
+ * Formats a ZonedDateTime using a strftime(3) style pattern, for example
+ * "%a %d %b %Y %H:%M %Z" which produces "Fri 31 Aug 2018 13:48 PDT". The
+ * pattern is compiled once by forPattern() into a compact list of opcodes, so
+ * that printTo() and formatTo() do not parse the pattern again on every call.
+ * The pattern string does not need to outlive the formatter.
+ *
+ * The following conversion specifications are supported:
+ *
+ *    * %Y: year (e.g. "2018")
+ *    * %y: year of the century, 2 digits (e.g. "18")
+ *    * %m: month, 2 digits (01-12)
+ *    * %B: full month name (e.g. "August")
+ *    * %b, %h: abbreviated month name (e.g. "Aug")
+ *    * %d: day of the month, 2 digits (01-31)
+ *    * %e: day of the month, padded with a space (" 1"-"31")
+ *    * %j: day of the year, 3 digits (001-366)
+ *    * %A: full weekday name (e.g. "Friday")
+ *    * %a: abbreviated weekday name (e.g. "Fri")
+ *    * %u: ISO 8601 weekday, Monday=1, Sunday=7
+ *    * %H: hour, 2 digits (00-23)
+ *    * %I: hour of the 12-hour clock, 2 digits (01-12)
+ *    * %p: "AM" or "PM"
+ *    * %M: minute, 2 digits (00-59)
+ *    * %S: second, 2 digits (00-59)
+ *    * %3N, %6N, %N: fraction of the second in milliseconds, microseconds and
+ *      nanoseconds, 3, 6 and 9 digits, as in GNU date(1), from the Instant
+ *      overloads (always zeros for a ZonedDateTime)
+ *    * %z: UTC offset as +hhmm (e.g. "-0700")
+ *    * %:z: UTC offset as +hh:mm (e.g. "-07:00")
+ *    * %Z: time zone abbreviation from TimeZone::printAbbrevTo() (e.g. "PDT")
+ *    * %F: same as "%Y-%m-%d"
+ *    * %T: same as "%H:%M:%S"
+ *    * %R: same as "%H:%M"
+ *    * %n, %t, %%: newline, tab and '%'
+ *
+ * Month and weekday names are in English and come from DateStrings. The
+ * Instant overloads format the ZonedDateTime of the Instant in the given
+ * TimeZone, so "%F %T.%3N %Z" prints "2018-08-31 13:48:01.250 PDT". Any
+ * other conversion, or a pattern which needs more than kMaxOps opcodes,
+ * produces a formatter whose isError() returns true, and which prints
+ * nothing.
+ *
+ * Example:
+ *
+ * @code
+ * static const DateTimeFormatter formatter =
+ *     DateTimeFormatter::forPattern("%a %d %b %Y %H:%M %Z");
+ *
+ * void loop() {
+ *   ...
+ *   formatter.printTo(Serial, zonedDateTime);
+ * }
+ * @endcode
+ */
+class DateTimeFormatter {
+  public:
+    /**
+     * Maximum number of opcodes in the compiled pattern. Each conversion
+     * takes one opcode (%F, %T and %R take 5, 5 and 3), and each literal
+     * character takes one (two for non-ASCII characters).
+     */
+    static const uint8_t kMaxOps = 32;
+
+    /** Compile the strftime(3) style pattern. */
+    static DateTimeFormatter forPattern(const char* pattern) {
+      DateTimeFormatter formatter;
+      formatter.compile(pattern);
+      return formatter;
+    }
+
+    /** Return an instance whose isError() returns true. */
+    static DateTimeFormatter forError() {
+      DateTimeFormatter formatter;
+      formatter.mNumOps = kInvalidNumOps;
+      return formatter;
+    }
+
+    /** Default constructor, with an empty pattern. */
+    DateTimeFormatter():
+        mNumOps(0) {}
+
+    /** Return true if the pattern was invalid. */
+    bool isError() const { return mNumOps == kInvalidNumOps; }
+
+    /**
+     * Print the ZonedDateTime using the pattern. Print
+     * "<Invalid ZonedDateTime>" if dateTime is an error.
+     */
+    void printTo(Print& printer, const ZonedDateTime& dateTime) const;
+
+    /**
+     * Write the same characters as printTo() into the buffer of size len,
+     * terminated by NUL. Return the number of characters written, or 0 if
+     * the buffer is too small, leaving an empty string.
+     */
+    size_t formatTo(char* buf, size_t len, const ZonedDateTime& dateTime)
+        const;
+
+    /** Write the same characters as formatTo(char*, size_t) into writer. */
+    void formatTo(common::BufferWriter& writer, const ZonedDateTime& dateTime)
+        const;
+
+    /**
+     * Print the Instant as seen from the TimeZone using the pattern,
+     * including the fraction of the second for %3N, %6N and %N. Print
+     * "<Invalid ZonedDateTime>" if instant is an error.
+     */
+    void printTo(Print& printer, const Instant& instant,
+        const TimeZone& timeZone) const;
+
+    /**
+     * Write the same characters as printTo(Print&, const Instant&, const
+     * TimeZone&) into the buffer of size len, terminated by NUL. Return the
+     * number of characters written, or 0 if the buffer is too small.
+     */
+    size_t formatTo(char* buf, size_t len, const Instant& instant,
+        const TimeZone& timeZone) const;
+
+    /** Write the same characters as the Instant formatTo() into writer. */
+    void formatTo(common::BufferWriter& writer, const Instant& instant,
+        const TimeZone& timeZone) const;
+
+    // Use default copy constructor and assignment operator.
+    DateTimeFormatter(const DateTimeFormatter&) = default;
+    DateTimeFormatter& operator=(const DateTimeFormatter&) = default;
+
+  private:
+    /** Sentinel mNumOps for an invalid pattern. */
+    static const uint8_t kInvalidNumOps = 0xFF;
+
+    // Opcodes. Every byte below kOpEscape is a literal ASCII character, and
+    // a kOpEscape is followed by a literal non-ASCII byte.
+    static const uint8_t kOpEscape = 0x80;
+    static const uint8_t kOpYear = 0x81;
+    static const uint8_t kOpYearOfCentury = 0x82;
+    static const uint8_t kOpMonth = 0x83;
+    static const uint8_t kOpMonthLong = 0x84;
+    static const uint8_t kOpMonthShort = 0x85;
+    static const uint8_t kOpDay = 0x86;
+    static const uint8_t kOpDaySpace = 0x87;
+    static const uint8_t kOpDayOfYear = 0x88;
+    static const uint8_t kOpWeekdayLong = 0x89;
+    static const uint8_t kOpWeekdayShort = 0x8A;
+    static const uint8_t kOpWeekdayNumber = 0x8B;
+    static const uint8_t kOpHour = 0x8C;
+    static const uint8_t kOpHour12 = 0x8D;
+    static const uint8_t kOpAmPm = 0x8E;
+    static const uint8_t kOpMinute = 0x8F;
+    static const uint8_t kOpSecond = 0x90;
+    static const uint8_t kOpOffset = 0x91;
+    static const uint8_t kOpOffsetColon = 0x92;
+    static const uint8_t kOpAbbrev = 0x93;
+    static const uint8_t kOpMillis = 0x94;
+    static const uint8_t kOpMicros = 0x95;
+    static const uint8_t kOpNanos = 0x96;
+
+    /** Compile the pattern into mOps, or set the error state. */
+    void compile(const char* pattern);
+
+    /**
+     * Run the opcodes against dateTime and the fraction of its second in
+     * nanos, writing into the sink, which is either a Print or a BufferWriter
+     * wrapped by an adapter in the .cpp file.
+     */
+    template <typename S>
+    void format(S& sink, const ZonedDateTime& dateTime, uint32_t nanos) const;
+
+    /** Append the opcode, returning false if mOps is full. */
+    bool addOp(uint8_t op) {
+      if (mNumOps >= kMaxOps) return false;
+      mOps[mNumOps++] = op;
+      return true;
+    }
+
+    uint8_t mOps[kMaxOps];
+    uint8_t mNumOps;
+};
+
+}
+
+#endif
@@ -10,6 +10,20 @@
 
 namespace ace_time {
 
+#if ACE_TIME_USE_MAPPED_ZONEDB
+const uint8_t ExtendedZoneProcessor::kAnchorEra[mapped::kZoneEraSize] = {
+  0, 0, 0, 0, /*zonePolicy*/
+  0, 0, 0, 0, /*format*/
+  0 /*offsetCode*/,
+  0 /*deltaCode*/,
+  (uint8_t) LocalDate::kInvalidYearTiny /*untilYearTiny*/,
+  1 /*untilMonth*/,
+  1 /*untilDay*/,
+  0 /*untilTimeCode*/,
+  'w' /*untilTimeModifier*/,
+  0 /*reserved*/
+};
+#else
 const extended::ZoneEra ExtendedZoneProcessor::kAnchorEra ACE_TIME_PROGMEM = {
   nullptr /*zonePolicy*/,
   nullptr /*format*/,
@@ -21,6 +35,7 @@ const extended::ZoneEra ExtendedZoneProcessor::kAnchorEra ACE_TIME_PROGMEM = {
   0 /*untilTimeCode*/,
   'w' /*untilTimeModifier*/
 };
+#endif
 
 void ExtendedZoneProcessor::printTo(Print& printer) const {
   printer.print(ExtendedZone(mZoneInfo.zoneInfo()).name());
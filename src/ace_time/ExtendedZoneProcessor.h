@@ -21,6 +21,35 @@
 
 #define ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG 0
 
+/**
+ * Set to 1 to make TransitionStorage copy the start times of the Active pool
+ * into contiguous, sorted arrays of keys, so that findTransition() and
+ * findTransitionForDateTime() use a branchless binary search instead of a
+ * linear scan through the Transition pointers. This costs 8 bytes of RAM per
+ * Transition. The Active pool rarely holds more than 5 Transitions, which is
+ * too few for the binary search to beat the linear scan (see
+ * examples/AutoBenchmark), so it is disabled by default.
+ */
+#ifndef ACE_TIME_TRANSITION_STORAGE_BINARY_SEARCH
+#define ACE_TIME_TRANSITION_STORAGE_BINARY_SEARCH 0
+#endif
+
+/**
+ * Set to 1 to make ExtendedZoneProcessor::init() slide the window of the
+ * previous year forward when the year increases by one (e.g. a clock ticking
+ * across Dec 31), instead of rebuilding it from scratch. Only the Transitions
+ * of the new year are calculated; the Transitions which overlap the previous
+ * window are reused. Enabled by default except on AVR, where the extra flash
+ * memory is more valuable than the shorter latency.
+ */
+#ifndef ACE_TIME_EXTENDED_ZONE_PROCESSOR_INCREMENTAL
+  #if defined(ARDUINO_ARCH_AVR)
+    #define ACE_TIME_EXTENDED_ZONE_PROCESSOR_INCREMENTAL 0
+  #else
+    #define ACE_TIME_EXTENDED_ZONE_PROCESSOR_INCREMENTAL 1
+  #endif
+#endif
+
 class ExtendedZoneProcessorTest_compareEraToYearMonth;
 class ExtendedZoneProcessorTest_compareEraToYearMonth2;
 class ExtendedZoneProcessorTest_createMatch;
@@ -40,6 +69,8 @@ class ExtendedZoneProcessorTest_processActiveTransition;
 class ExtendedZoneProcessorTest_fixTransitionTimes_generateStartUntilTimes;
 class ExtendedZoneProcessorTest_createAbbreviation;
 class ExtendedZoneProcessorTest_setZoneInfo;
+class ExtendedZoneProcessorTest_rollForward;
+class ExtendedZoneProcessorTest_rollForward_allZones;
 class TransitionStorageTest_getFreeAgent;
 class TransitionStorageTest_getFreeAgent2;
 class TransitionStorageTest_addFreeAgentToActivePool;
@@ -51,7 +82,8 @@ class TransitionStorageTest_resetCandidatePool;
 
 namespace ace_time {
 
-template<uint8_t SIZE, uint8_t TYPE, typename ZS, typename ZI, typename ZIB>
+template<uint8_t SIZE, uint8_t TYPE, typename ZS, typename ZI, typename ZIB,
+    uint8_t EVICTION>
 class ZoneProcessorCacheImpl;
 
 namespace extended {
@@ -496,6 +528,41 @@ class TransitionStorage {
       mIndexFree = iActive;
     }
 
+    /**
+     * Remove the Transition at the given index of the Active pool, shifting
+     * the following Transitions down by one, and return it to the Free pool.
+     * This assumes that the Candidate pool is empty.
+     */
+    void removeActive(uint8_t index) {
+      if (index >= mIndexFree) return;
+      Transition* removed = mTransitions[index];
+      for (uint8_t i = index + 1; i < mIndexFree; i++) {
+        mTransitions[i - 1] = mTransitions[i];
+      }
+      mIndexFree--;
+      mTransitions[mIndexFree] = removed;
+      mIndexPrior = mIndexFree;
+      mIndexCandidates = mIndexFree;
+    }
+
+    /**
+     * Copy the startEpochSeconds and startDateTime of the Transitions in the
+     * Active pool into the search key arrays used by findTransition() and
+     * findTransitionForDateTime(). Must be called after the startDateTime and
+     * startEpochSeconds of the Active pool have been calculated, and before
+     * the first search. Does nothing if
+     * ACE_TIME_TRANSITION_STORAGE_BINARY_SEARCH is 0.
+     */
+    void buildSearchKeys() {
+    #if ACE_TIME_TRANSITION_STORAGE_BINARY_SEARCH
+      for (uint8_t i = 0; i < mIndexFree; i++) {
+        const Transition* t = mTransitions[i];
+        mStartEpochSeconds[i] = t->startEpochSeconds;
+        mStartDateTimeKeys[i] = packDateTuple(t->startDateTime);
+      }
+    #endif
+    }
+
     /**
      * Return the Transition matching the given epochSeconds. Return nullptr if
      * no matching Transition found. If a zone does not have any transition
@@ -509,6 +576,10 @@ class TransitionStorage {
         logging::println( "findTransition(): mIndexFree: %d", mIndexFree);
       }
 
+    #if ACE_TIME_TRANSITION_STORAGE_BINARY_SEARCH
+      int8_t i = searchKeys(mStartEpochSeconds, mIndexFree, epochSeconds);
+      return (i < 0) ? nullptr : mTransitions[i];
+    #else
       const Transition* match = nullptr;
       for (uint8_t i = 0; i < mIndexFree; i++) {
         const Transition* candidate = mTransitions[i];
@@ -516,6 +587,7 @@ class TransitionStorage {
         match = candidate;
       }
       return match;
+    #endif
     }
 
     /**
@@ -552,6 +624,11 @@ class TransitionStorage {
       // minutes, the comparision (startTime < localDate) will still be valid.
       DateTuple localDate = { ldt.yearTiny(), ldt.month(), ldt.day(),
           (int8_t) (ldt.hour() * 4 + ldt.minute() / 15), 'w' };
+    #if ACE_TIME_TRANSITION_STORAGE_BINARY_SEARCH
+      int8_t i = searchKeys(mStartDateTimeKeys, mIndexFree,
+          packDateTuple(localDate));
+      return (i < 0) ? nullptr : mTransitions[i];
+    #else
       const Transition* match = nullptr;
       for (uint8_t i = 0; i < mIndexFree; i++) {
         const Transition* candidate = mTransitions[i];
@@ -559,6 +636,49 @@ class TransitionStorage {
         match = candidate;
       }
       return match;
+    #endif
+    }
+
+    /**
+     * Find the Transitions on both sides of the given local seconds (a
+     * LocalDateTime converted to epochSeconds as if it were UTC) using a
+     * single scan of the Active pool. If the local seconds is unique, both
+     * earlier and later are set to the matching Transition. If it falls in a
+     * DST gap or overlap, earlier is set to the Transition before, and later
+     * to the Transition after the gap or overlap. Both are set to nullptr if
+     * the local seconds is before the first Transition.
+     *
+     * The local start and until times are calculated from startEpochSeconds
+     * instead of comparing the startDateTime and untilDateTime, because a
+     * DateTuple is not always normalized (e.g. a transition at 24:00 in
+     * Africa/Cairo).
+     */
+    void findTransitionsForDateTime(acetime_t localSeconds,
+        const Transition** earlier, const Transition** later) const {
+      int8_t i = -1;
+      for (uint8_t j = 0; j < mIndexFree; j++) {
+        const Transition* t = mTransitions[j];
+        if (t->startEpochSeconds + offsetSeconds(t) > localSeconds) break;
+        i = j;
+      }
+      if (i < 0) {
+        *earlier = nullptr;
+        *later = nullptr;
+        return;
+      }
+
+      const Transition* match = mTransitions[i];
+      *earlier = match;
+      *later = match;
+      if (i > 0 && localSeconds < match->startEpochSeconds
+          + offsetSeconds(mTransitions[i - 1])) {
+        // overlap: the previous Transition has not ended yet
+        *earlier = mTransitions[i - 1];
+      } else if (i + 1 < mIndexFree && localSeconds
+          >= mTransitions[i + 1]->startEpochSeconds + offsetSeconds(match)) {
+        // gap: the match has ended, but the next has not started
+        *later = mTransitions[i + 1];
+      }
     }
 
     /** Verify that the indexes are valid. Used only for debugging. */
@@ -611,12 +731,57 @@ class TransitionStorage {
     /** Return the transition at position i. */
     Transition* getTransition(uint8_t i) { return mTransitions[i]; }
 
+    /** Return the total UTC offset of the Transition in seconds. */
+    static acetime_t offsetSeconds(const Transition* t) {
+      return (acetime_t) 900 * (t->offsetCode + t->deltaCode);
+    }
+
+  #if ACE_TIME_TRANSITION_STORAGE_BINARY_SEARCH
+    /**
+     * Pack the (yearTiny, month, day, timeCode) fields of the DateTuple into a
+     * uint32_t which sorts in the same order as operator<(), ignoring the
+     * modifier. The signed fields are shifted by 128 to make them unsigned.
+     */
+    static uint32_t packDateTuple(const DateTuple& dt) {
+      return ((uint32_t) (uint8_t) (dt.yearTiny + 128) << 24)
+          | ((uint32_t) dt.month << 16)
+          | ((uint32_t) dt.day << 8)
+          | (uint8_t) (dt.timeCode + 128);
+    }
+
+    /**
+     * Return the index of the last element in the sorted 'keys' array of
+     * length 'n' which is <= 'key', or -1 if there is no such element. The
+     * loop body compiles into a conditional move instead of a branch, and
+     * always runs log2(n) times, so its timing does not depend on the key.
+     */
+    template <typename K>
+    static int8_t searchKeys(const K* keys, uint8_t n, K key) {
+      if (n == 0) return -1;
+      const K* base = keys;
+      while (n > 1) {
+        uint8_t half = n / 2;
+        base = (base[half] <= key) ? base + half : base;
+        n -= half;
+      }
+      return (*base <= key) ? (int8_t) (base - keys) : -1;
+    }
+  #endif
+
     Transition mPool[SIZE];
     Transition* mTransitions[SIZE];
     uint8_t mIndexPrior;
     uint8_t mIndexCandidates;
     uint8_t mIndexFree;
 
+  #if ACE_TIME_TRANSITION_STORAGE_BINARY_SEARCH
+    /** Search keys of Transition.startEpochSeconds of the Active pool. */
+    acetime_t mStartEpochSeconds[SIZE];
+
+    /** Search keys of the packed Transition.startDateTime of Active pool. */
+    uint32_t mStartDateTimeKeys[SIZE];
+  #endif
+
     /** High water mark. For debugging. */
     uint8_t mHighWater = 0;
 };
@@ -729,6 +894,80 @@ class ExtendedZoneProcessor: public ZoneProcessor {
       return odt;
     }
 
+    ResolvedDateTime resolveLocalDateTime(const LocalDateTime& ldt,
+        uint8_t policy) const override {
+      if (ldt.isError() || ! init(ldt.localDate())) {
+        return ResolvedDateTime::forError();
+      }
+
+      const extended::Transition* earlier;
+      const extended::Transition* later;
+      mTransitionStorage.findTransitionsForDateTime(
+          ldt.toEpochSeconds(), &earlier, &later);
+      if (! earlier) return ResolvedDateTime::forError();
+
+      TimeOffset earlierOffset = TimeOffset::forOffsetCode(
+          earlier->offsetCode + earlier->deltaCode);
+      if (earlier == later) {
+        return ResolvedDateTime::forUnique(ldt, earlierOffset);
+      }
+      return ResolvedDateTime::forTransition(ldt, earlierOffset,
+          TimeOffset::forOffsetCode(later->offsetCode + later->deltaCode),
+          later->startEpochSeconds, policy);
+    }
+
+    /**
+     * Batch version of getUtcOffset(). The year is calculated only when an
+     * element falls outside of the year of the previous element, and the
+     * matching Transition is found by walking forward from the Transition of
+     * the previous element, so sorted input is processed in roughly constant
+     * time per element.
+     */
+    void getUtcOffsets(const acetime_t* epochSeconds, TimeOffset* offsets,
+        size_t n) const override {
+      // An empty range forces init() on the first element.
+      acetime_t yearStartSeconds = 0;
+      acetime_t yearUntilSeconds = 0;
+      extended::Transition** current = nullptr;
+      extended::Transition** end = nullptr;
+
+      for (size_t i = 0; i < n; i++) {
+        acetime_t seconds = epochSeconds[i];
+        if (seconds < yearStartSeconds || seconds >= yearUntilSeconds) {
+          LocalDate ld = LocalDate::forEpochSeconds(seconds);
+          yearUntilSeconds = yearStartSeconds; // invalidate range
+          if (! init(ld)) {
+            offsets[i] = TimeOffset::forError();
+            continue;
+          }
+          yearStartSeconds = LocalDate::forComponents(ld.year(), 1, 1)
+              .toEpochSeconds();
+          yearUntilSeconds = LocalDate::forComponents(ld.year() + 1, 1, 1)
+              .toEpochSeconds();
+          current = mTransitionStorage.getActivePoolBegin();
+          end = mTransitionStorage.getActivePoolEnd();
+        }
+
+        // Restart from the beginning if the input went backwards.
+        if (current == end) {
+          offsets[i] = TimeOffset::forError();
+          continue;
+        }
+        if ((*current)->startEpochSeconds > seconds) {
+          current = mTransitionStorage.getActivePoolBegin();
+        }
+        while (current + 1 != end
+            && (*(current + 1))->startEpochSeconds <= seconds) {
+          current++;
+        }
+        const extended::Transition* transition = *current;
+        offsets[i] = (transition->startEpochSeconds <= seconds)
+            ? TimeOffset::forOffsetCode(
+                transition->offsetCode + transition->deltaCode)
+            : TimeOffset::forError();
+      }
+    }
+
     void printTo(Print& printer) const override;
 
     void printShortTo(Print& printer) const override;
@@ -776,10 +1015,20 @@ class ExtendedZoneProcessor: public ZoneProcessor {
     friend class ::ExtendedZoneProcessorTest_fixTransitionTimes_generateStartUntilTimes;
     friend class ::ExtendedZoneProcessorTest_createAbbreviation;
     friend class ::ExtendedZoneProcessorTest_setZoneInfo;
+    friend class ::ExtendedZoneProcessorTest_rollForward;
+    friend class ::ExtendedZoneProcessorTest_rollForward_allZones;
 
-    template<uint8_t SIZE, uint8_t TYPE, typename ZS, typename ZI, typename ZIB>
+    template<uint8_t SIZE, uint8_t TYPE, typename ZS, typename ZI, typename ZIB,
+        uint8_t EVICTION>
     friend class ZoneProcessorCacheImpl; // setZoneInfo()
 
+    template<uint8_t YEARS>
+    friend class ExtendedZoneProcessorN; // setZoneInfo(), isFilled()
+
+    friend class FlatZoneProcessor; // init(), findTransition()
+    friend class CompiledZone; // init(), findTransition(), mTransitionStorage
+    friend class ZoneTransitionIterator; // init(), mTransitionStorage
+
     // Disable copy constructor and assignment operator.
     ExtendedZoneProcessor(const ExtendedZoneProcessor&) = delete;
     ExtendedZoneProcessor& operator=(const ExtendedZoneProcessor&) = delete;
@@ -805,8 +1054,15 @@ class ExtendedZoneProcessor: public ZoneProcessor {
      */
     static const uint8_t kMaxInteriorYears = 4;
 
-    /** A sentinel ZoneEra which has the smallest year. */
+    /**
+     * A sentinel ZoneEra which has the smallest year. It is a ZoneEra record
+     * of the binary zone database when ACE_TIME_USE_MAPPED_ZONEDB is enabled.
+     */
+#if ACE_TIME_USE_MAPPED_ZONEDB
+    static const uint8_t kAnchorEra[mapped::kZoneEraSize];
+#else
     static const extended::ZoneEra kAnchorEra;
+#endif
 
     bool equals(const ZoneProcessor& other) const override {
       const auto& that = (const ExtendedZoneProcessor&) other;
@@ -844,10 +1100,23 @@ class ExtendedZoneProcessor: public ZoneProcessor {
      */
     bool init(const LocalDate& ld) const {
       int16_t year = ld.year();
-      if (isFilled(year)) return true;
+      if (isFilled(year)) {
+        statsHit();
+        return true;
+      }
       if (ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG) {
         logging::println("init(): %d", year);
       }
+      uint16_t startMicros = statsRebuildStart();
+
+    #if ACE_TIME_EXTENDED_ZONE_PROCESSOR_INCREMENTAL
+      if (mIsFilled && year == mYear + 1 && year <= mZoneInfo.untilYear()
+          && rollForward(year)) {
+        mYear = year;
+        statsRebuildEnd(startMicros);
+        return true;
+      }
+    #endif
 
       mYear = year;
       mNumMatches = 0; // clear cache
@@ -873,8 +1142,10 @@ class ExtendedZoneProcessor: public ZoneProcessor {
       fixTransitionTimes(begin, end);
       generateStartUntilTimes(begin, end);
       calcAbbreviations(begin, end);
+      mTransitionStorage.buildSearchKeys();
 
       mIsFilled = true;
+      statsRebuildEnd(startMicros);
       return true;
     }
 
@@ -883,6 +1154,100 @@ class ExtendedZoneProcessor: public ZoneProcessor {
       return mIsFilled && (year == mYear);
     }
 
+    /**
+     * Slide the window [year-1/12, year+1/2) of the previous year forward to
+     * the given year. This applies only if both windows are covered by the
+     * same named ZoneEra, which is the normal case for the years of the
+     * zonedbx database. The Transitions in [year-1/12, year/2) are kept, the
+     * most recent Transition before year-1/12 becomes the new prior
+     * Transition, and only the Transitions of [year/2, year+1/2) are
+     * calculated, using findTransitionsFromNamedMatch() on a ZoneMatch which
+     * covers just that interval.
+     *
+     * Returns false if the window cannot be rolled forward. The Transitions
+     * may have been modified, so the caller must rebuild them from scratch.
+     */
+    bool rollForward(int16_t year) const {
+      if (mNumMatches != 1) return false;
+      extended::ZoneMatch& match = mMatches[0];
+      const extended::ZonePolicyBroker policy = match.era.zonePolicy();
+      if (policy.isNull()) return false;
+
+      // The new window must consist of the same ZoneEra, truncated at both
+      // ends.
+      extended::YearMonthTuple startYm = {
+        (int8_t) (year - LocalDate::kEpochYear - 1), 12 };
+      extended::YearMonthTuple untilYm =  {
+        (int8_t) (year - LocalDate::kEpochYear + 1), 2 };
+      extended::ZoneMatch newMatches[kMaxMatches];
+      uint8_t numMatches = findMatches(mZoneInfo, startYm, untilYm, newMatches,
+          kMaxMatches);
+      if (numMatches != 1) return false;
+      const extended::ZoneMatch& newMatch = newMatches[0];
+      if (newMatch.era.zoneEra() != match.era.zoneEra()) return false;
+      const extended::DateTuple startBound = {
+          startYm.yearTiny, startYm.month, 1, 0, 'w'};
+      const extended::DateTuple tailStart = {
+          (int8_t) (year - LocalDate::kEpochYear), 2, 1, 0, 'w'};
+      if (! (newMatch.startDateTime == startBound)) return false;
+      if (! (match.untilDateTime == tailStart)) return false;
+
+      // Find the most recent Transition at or before the start of the new
+      // window, which becomes the new prior Transition.
+      extended::Transition** begin = mTransitionStorage.getActivePoolBegin();
+      extended::Transition** end = mTransitionStorage.getActivePoolEnd();
+      uint8_t numActive = end - begin;
+      uint8_t iPrior = 0;
+      for (uint8_t i = 1; i < numActive; i++) {
+        if (begin[i]->transitionTime <= startBound) iPrior = i;
+      }
+
+      // Make sure that the Transitions of the tail fit into the storage:
+      // the kept Transitions, the reserved prior, the candidates, and the
+      // free agent.
+      int8_t startY = tailStart.yearTiny;
+      int8_t endY = newMatch.untilDateTime.yearTiny;
+      uint8_t numNeeded = (numActive - iPrior) + 2;
+      for (uint8_t r = 0; r < policy.numRules(); r++) {
+        const extended::ZoneRuleBroker rule = policy.rule(r);
+        int8_t interiorYears[kMaxInteriorYears];
+        numNeeded += calcInteriorYears(interiorYears, kMaxInteriorYears,
+            rule.fromYearTiny(), rule.toYearTiny(), startY, endY);
+      }
+      if (numNeeded > kMaxTransitions) return false;
+
+      for (uint8_t i = 0; i < iPrior; i++) {
+        mTransitionStorage.removeActive(0);
+      }
+      uint8_t numKept = numActive - iPrior;
+      extended::Transition* prior = *mTransitionStorage.getActivePoolBegin();
+      if (iPrior > 0) {
+        prior->originalTransitionTime = prior->transitionTime;
+      }
+      prior->transitionTime = startBound;
+
+      // Calculate the Transitions of the tail. Its own prior Transition is a
+      // duplicate of the last kept Transition, unless it is a real Transition
+      // which happens exactly at the start of the tail, which is too rare to
+      // handle here.
+      match = {tailStart, newMatch.untilDateTime, match.era};
+      findTransitionsFromNamedMatch(mTransitionStorage, &match);
+      begin = mTransitionStorage.getActivePoolBegin();
+      end = mTransitionStorage.getActivePoolEnd();
+      extended::Transition** tail = begin + numKept;
+      if (tail != end && (*tail)->transitionTime == tailStart) {
+        if ((*tail)->originalTransitionTime == tailStart) return false;
+        mTransitionStorage.removeActive(numKept);
+        end = mTransitionStorage.getActivePoolEnd();
+      }
+      match = newMatch;
+
+      generateStartUntilTimes(begin, end);
+      calcAbbreviations(begin + numKept, end);
+      mTransitionStorage.buildSearchKeys();
+      return true;
+    }
+
     /**
      * Find the ZoneEras which overlap [startYm, untilYm), ignoring day, time
      * and timeModifier. The start and until fields of the ZoneEra are
@@ -898,7 +1263,8 @@ class ExtendedZoneProcessor: public ZoneProcessor {
         logging::println("findMatches()");
       }
       uint8_t iMatch = 0;
-      extended::ZoneEraBroker prev = extended::ZoneEraBroker(&kAnchorEra);
+      extended::ZoneEraBroker prev = extended::ZoneEraBroker(
+          (const extended::ZoneEra*) &kAnchorEra);
       for (uint8_t iEra = 0; iEra < zoneInfo.numEras(); iEra++) {
         const extended::ZoneEraBroker era = zoneInfo.era(iEra);
         if (eraOverlapsInterval(prev, era, startYm, untilYm)) {
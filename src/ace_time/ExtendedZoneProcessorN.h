@@ -0,0 +1,205 @@
+/*
+ * MIT License
+ * Copyright (c) 2019 Brian T. Park
+ */
+
+#ifndef ACE_TIME_EXTENDED_ZONE_PROCESSOR_N_H
+#define ACE_TIME_EXTENDED_ZONE_PROCESSOR_N_H
+
+#include <stdint.h>
+#include "common/common.h"
+#include "TimeOffset.h"
+#include "LocalDate.h"
+#include "OffsetDateTime.h"
+#include "ExtendedZoneProcessor.h"
+
+namespace ace_time {
+
+/**
+ * An ExtendedZoneProcessor which caches the Transitions of the last YEARS
+ * distinct years that were requested, instead of only the most recent one.
+ * This avoids recalculating the ZoneMatches and Transitions when the
+ * requests alternate between a small number of years, for example, a log
+ * stream which straddles Jan 1, or a report which compares the same dates
+ * in consecutive years. When a year is not in the cache, the least recently
+ * used year is evicted.
+ *
+ * Each cached year needs the memory of a full ExtendedZoneProcessor. This
+ * object is itself the first cache entry, so sizeof(ExtendedZoneProcessorN)
+ * is about YEARS * sizeof(ExtendedZoneProcessor).
+ *
+ * The getCacheHits() and getCacheMisses() counters can be used to determine
+ * the appropriate value of YEARS for a given workload.
+ *
+ * Since this is a subclass of ExtendedZoneProcessor, it can be given to
+ * TimeZone::forZoneInfo() in place of an ExtendedZoneProcessor.
+ *
+ * @tparam YEARS number of years to cache, must be at least 2
+ */
+template <uint8_t YEARS>
+class ExtendedZoneProcessorN: public ExtendedZoneProcessor {
+  public:
+    static_assert(YEARS >= 2, "YEARS must be >= 2");
+
+    /**
+     * Constructor.
+     * @param zoneInfo pointer to a ZoneInfo. Can be nullptr which is useful
+     * for creating caches inside the ZoneManager.
+     */
+    explicit ExtendedZoneProcessorN(
+        const extended::ZoneInfo* zoneInfo = nullptr):
+        ExtendedZoneProcessor(zoneInfo) {
+      for (uint8_t i = 0; i < YEARS - 1; i++) {
+        mProcessors[i].setZoneInfo(zoneInfo);
+      }
+    }
+
+    TimeOffset getUtcOffset(acetime_t epochSeconds) const override {
+      int16_t year = LocalDate::forEpochSeconds(epochSeconds).year();
+      return getProcessorForYear(year)
+          ->ExtendedZoneProcessor::getUtcOffset(epochSeconds);
+    }
+
+    TimeOffset getDeltaOffset(acetime_t epochSeconds) const override {
+      int16_t year = LocalDate::forEpochSeconds(epochSeconds).year();
+      return getProcessorForYear(year)
+          ->ExtendedZoneProcessor::getDeltaOffset(epochSeconds);
+    }
+
+    const char* getAbbrev(acetime_t epochSeconds) const override {
+      int16_t year = LocalDate::forEpochSeconds(epochSeconds).year();
+      return getProcessorForYear(year)
+          ->ExtendedZoneProcessor::getAbbrev(epochSeconds);
+    }
+
+    OffsetDateTime getOffsetDateTime(const LocalDateTime& ldt) const override {
+      return getProcessorForYear(ldt.year())
+          ->ExtendedZoneProcessor::getOffsetDateTime(ldt);
+    }
+
+    ResolvedDateTime resolveLocalDateTime(const LocalDateTime& ldt,
+        uint8_t policy) const override {
+      return getProcessorForYear(ldt.year())
+          ->ExtendedZoneProcessor::resolveLocalDateTime(ldt, policy);
+    }
+
+    /**
+     * Batch version of getUtcOffset(). Each run of consecutive elements in
+     * the same year is one lookup in the cache, and is handed to the batch
+     * method of the ExtendedZoneProcessor which holds that year.
+     */
+    void getUtcOffsets(const acetime_t* epochSeconds, TimeOffset* offsets,
+        size_t n) const override {
+      size_t i = 0;
+      while (i < n) {
+        // Compare the years instead of the epoch seconds of Jan 1, which do
+        // not fit in a 32-bit acetime_t for the first and last years.
+        int16_t year = LocalDate::forEpochSeconds(epochSeconds[i]).year();
+        size_t end = i + 1;
+        while (end < n
+            && LocalDate::forEpochSeconds(epochSeconds[end]).year() == year) {
+          end++;
+        }
+        getProcessorForYear(year)->ExtendedZoneProcessor::getUtcOffsets(
+            epochSeconds + i, offsets + i, end - i);
+        i = end;
+      }
+    }
+
+    /** Return the number of lookups which found their year in the cache. */
+    uint32_t getCacheHits() const { return mCacheHits; }
+
+    /** Return the number of lookups which had to calculate their year. */
+    uint32_t getCacheMisses() const { return mCacheMisses; }
+
+    /** Reset the hit and miss counters. */
+    void resetCacheStats() {
+      mCacheHits = 0;
+      mCacheMisses = 0;
+    }
+
+    /**
+     * Return the sum of the ZoneProcessorStats of each cached year. All zeros
+     * unless ACE_TIME_ZONE_STATS is enabled.
+     */
+    ZoneProcessorStats getStats() const {
+      ZoneProcessorStats stats = ExtendedZoneProcessor::getStats();
+      for (uint8_t i = 0; i < YEARS - 1; i++) {
+        stats.merge(mProcessors[i].getStats());
+      }
+      return stats;
+    }
+
+    /** Reset the statistics returned by getStats(). */
+    void resetStats() {
+      ExtendedZoneProcessor::resetStats();
+      for (uint8_t i = 0; i < YEARS - 1; i++) {
+        mProcessors[i].resetStats();
+      }
+    }
+
+  private:
+    template<uint8_t SIZE, uint8_t TYPE, typename ZS, typename ZI, typename ZIB,
+        uint8_t EVICTION>
+    friend class ZoneProcessorCacheImpl; // setZoneInfo()
+
+    // Disable copy constructor and assignment operator.
+    ExtendedZoneProcessorN(const ExtendedZoneProcessorN&) = delete;
+    ExtendedZoneProcessorN& operator=(const ExtendedZoneProcessorN&) = delete;
+
+    void setZoneInfo(const void* zoneInfo) override {
+      if (getZoneInfo() == zoneInfo) return;
+
+      ExtendedZoneProcessor::setZoneInfo(zoneInfo);
+      for (uint8_t i = 0; i < YEARS - 1; i++) {
+        mProcessors[i].setZoneInfo(zoneInfo);
+      }
+      for (uint8_t i = 0; i < YEARS; i++) {
+        mLastUsed[i] = 0;
+      }
+      mClock = 0;
+    }
+
+    /** Return the cache entry at index i. Entry 0 is this object itself. */
+    const ExtendedZoneProcessor* getProcessor(uint8_t i) const {
+      return (i == 0) ? this : &mProcessors[i - 1];
+    }
+
+    /**
+     * Return the cache entry which holds the given year, or the least
+     * recently used entry if no entry holds that year. The caller fills the
+     * entry by calling one of its lookup methods.
+     */
+    const ExtendedZoneProcessor* getProcessorForYear(int16_t year) const {
+      mClock++;
+      uint8_t lru = 0;
+      for (uint8_t i = 0; i < YEARS; i++) {
+        if (getProcessor(i)->isFilled(year)) {
+          mCacheHits++;
+          mLastUsed[i] = mClock;
+          return getProcessor(i);
+        }
+        if (mLastUsed[i] < mLastUsed[lru]) lru = i;
+      }
+
+      mCacheMisses++;
+      mLastUsed[lru] = mClock;
+      return getProcessor(lru);
+    }
+
+    /** The cache entries after the first one, which is this object. */
+    ExtendedZoneProcessor mProcessors[YEARS - 1];
+
+    /** Value of mClock when each cache entry was last used. */
+    mutable uint32_t mLastUsed[YEARS] = {};
+
+    /** Incremented on each lookup, used to find the least recently used. */
+    mutable uint32_t mClock = 0;
+
+    mutable uint32_t mCacheHits = 0;
+    mutable uint32_t mCacheMisses = 0;
+};
+
+}
+
+#endif
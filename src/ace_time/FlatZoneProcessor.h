@@ -0,0 +1,170 @@
+/*
+ * MIT License
+ * Copyright (c) 2019 Brian T. Park
+ */
+
+#ifndef ACE_TIME_FLAT_ZONE_PROCESSOR_H
+#define ACE_TIME_FLAT_ZONE_PROCESSOR_H
+
+#include <stdint.h>
+#include "common/common.h"
+#include "TimeOffset.h"
+#include "LocalDate.h"
+#include "OffsetDateTime.h"
+#include "ExtendedZoneProcessor.h"
+#include "CompiledZone.h"
+
+class FlatZoneProcessorTest_allZones;
+
+namespace ace_time {
+
+/**
+ * An ExtendedZoneProcessor which expands the extended::ZoneInfo once into a
+ * flat, sorted table of the Transitions of every year in the range of the
+ * ZoneContext (e.g. 2000 until 2050). After the table is built, getUtcOffset(),
+ * getDeltaOffset(), getAbbrev() and getOffsetDateTime() are a binary search
+ * on the table, instead of the findMatches() and findTransitions()
+ * calculations that ExtendedZoneProcessor performs whenever the year changes.
+ *
+ * The table is a CompiledZone, built lazily on the first lookup after the
+ * zoneInfo is set, using the ExtendedZoneProcessor superclass to calculate the
+ * Transitions of each year. Times outside of the range of the table, or beyond
+ * the last year which fits into the table, are handled by the
+ * ExtendedZoneProcessor.
+ *
+ * This trades memory for latency. A FlatZoneProcessor consumes about 2kB of
+ * RAM, so it is intended for Linux or MacOS, or the larger 32-bit
+ * microcontrollers. Since this is a subclass of ExtendedZoneProcessor, it can
+ * be given to TimeZone::forZoneInfo() in place of an ExtendedZoneProcessor, or
+ * used through a FlatZoneManager.
+ */
+class FlatZoneProcessor: public ExtendedZoneProcessor {
+  public:
+    /** Maximum number of entries in the table. */
+    static const uint16_t kMaxEntries = CompiledZone::kMaxEntries;
+
+    /** Maximum number of distinct abbreviations in the table. */
+    static const uint8_t kMaxAbbrevs = CompiledZone::kMaxAbbrevs;
+
+    /**
+     * Constructor.
+     * @param zoneInfo pointer to a ZoneInfo. Can be nullptr which is useful
+     * for creating caches inside the ZoneManager.
+     */
+    explicit FlatZoneProcessor(const extended::ZoneInfo* zoneInfo = nullptr):
+        ExtendedZoneProcessor(zoneInfo) {}
+
+    TimeOffset getUtcOffset(acetime_t epochSeconds) const override {
+      if (! isInTable(epochSeconds)) {
+        return ExtendedZoneProcessor::getUtcOffset(epochSeconds);
+      }
+      return mCompiledZone.getUtcOffset(epochSeconds);
+    }
+
+    TimeOffset getDeltaOffset(acetime_t epochSeconds) const override {
+      if (! isInTable(epochSeconds)) {
+        return ExtendedZoneProcessor::getDeltaOffset(epochSeconds);
+      }
+      return mCompiledZone.getDeltaOffset(epochSeconds);
+    }
+
+    const char* getAbbrev(acetime_t epochSeconds) const override {
+      if (! isInTable(epochSeconds)) {
+        return ExtendedZoneProcessor::getAbbrev(epochSeconds);
+      }
+      return mCompiledZone.getAbbrev(epochSeconds);
+    }
+
+    /**
+     * Return the OffsetDateTime for the given LocalDateTime, using the same
+     * rules as ExtendedZoneProcessor::getOffsetDateTime() for a LocalDateTime
+     * in a DST gap or overlap.
+     */
+    OffsetDateTime getOffsetDateTime(const LocalDateTime& ldt) const override {
+      if (ldt.isError()) return OffsetDateTime::forError();
+
+      acetime_t localSeconds = ldt.toEpochSeconds();
+      if (! isInTable(localSeconds)) {
+        return ExtendedZoneProcessor::getOffsetDateTime(ldt);
+      }
+      return mCompiledZone.getOffsetDateTime(ldt);
+    }
+
+    ResolvedDateTime resolveLocalDateTime(const LocalDateTime& ldt,
+        uint8_t policy) const override {
+      if (ldt.isError()) return ResolvedDateTime::forError();
+
+      acetime_t localSeconds = ldt.toEpochSeconds();
+      if (! isInTable(localSeconds)) {
+        return ExtendedZoneProcessor::resolveLocalDateTime(ldt, policy);
+      }
+      return mCompiledZone.resolveLocalDateTime(ldt, policy);
+    }
+
+    /**
+     * Batch version of getUtcOffset() which walks forward through the table
+     * from the entry of the previous element, so sorted input is processed
+     * in roughly constant time per element.
+     */
+    void getUtcOffsets(const acetime_t* epochSeconds, TimeOffset* offsets,
+        size_t n) const override {
+      buildTable();
+      mCompiledZone.getUtcOffsets(epochSeconds, offsets, n);
+
+      // Elements outside of the table are handled by ExtendedZoneProcessor.
+      for (size_t i = 0; i < n; i++) {
+        if (offsets[i].isError()) {
+          offsets[i] = ExtendedZoneProcessor::getUtcOffset(epochSeconds[i]);
+        }
+      }
+    }
+
+    /** Return the number of entries in the table. Builds it if necessary. */
+    uint16_t getNumEntries() const {
+      buildTable();
+      return mCompiledZone.getNumEntries();
+    }
+
+  private:
+    friend class ::FlatZoneProcessorTest_allZones;
+
+    template<uint8_t SIZE, uint8_t TYPE, typename ZS, typename ZI, typename ZIB,
+        uint8_t EVICTION>
+    friend class ZoneProcessorCacheImpl; // setZoneInfo()
+
+    // Disable copy constructor and assignment operator.
+    FlatZoneProcessor(const FlatZoneProcessor&) = delete;
+    FlatZoneProcessor& operator=(const FlatZoneProcessor&) = delete;
+
+    void setZoneInfo(const void* zoneInfo) override {
+      if (getZoneInfo() == zoneInfo) return;
+
+      ExtendedZoneProcessor::setZoneInfo(zoneInfo);
+      mIsBuilt = false;
+    }
+
+    /**
+     * Return true if the given seconds is within the range of the table,
+     * building the table if necessary.
+     */
+    bool isInTable(acetime_t seconds) const {
+      buildTable();
+      return mCompiledZone.contains(seconds);
+    }
+
+    /**
+     * Compile the table using the ExtendedZoneProcessor superclass to
+     * calculate the Transitions of each year.
+     */
+    void buildTable() const {
+      if (mIsBuilt) return;
+      mIsBuilt = true;
+      mCompiledZone.compile(*this);
+    }
+
+    mutable CompiledZone mCompiledZone;
+    mutable bool mIsBuilt = false;
+};
+}
+
+#endif
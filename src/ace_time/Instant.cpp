@@ -0,0 +1,82 @@
+/*
+ * MIT License
+ * Copyright (c) 2019 Brian T. Park
+ */
+
+#include <Print.h>
+#include "common/BufferWriter.h"
+#include "internal/Iso8601.h"
+#include "LocalDateTime.h"
+#include "Instant.h"
+
+namespace ace_time {
+
+using common::BufferWriter;
+
+/** Write a number from 0 to 999 as 3 digits. */
+static void writePad3(BufferWriter& writer, uint16_t value) {
+  writer.writeChar('0' + value / 100);
+  writer.writePad2(value % 100);
+}
+
+Instant Instant::forIso8601(const char* s, size_t len) {
+  iso8601::DateTimeFields fields;
+  size_t consumed = iso8601::parseDateTime(s, len, fields);
+  if (consumed == 0 || consumed != len) return forError();
+  if (! fields.hasOffset) return forError();
+
+  auto ldt = LocalDateTime::forComponents(fields.year, fields.month,
+      fields.day, fields.hour, fields.minute, fields.second);
+  if (ldt.isError()) return forError();
+
+  // Calculate in 64 bits, because the range of LocalDate, and the UTC
+  // offset, can take the result outside of a 32-bit acetime_t.
+  int64_t seconds = (int64_t) ldt.localDate().toEpochDays() * 86400
+      + ldt.localTime().toSeconds() - (int32_t) 60 * fields.offsetMinutes;
+#if ! ACE_TIME_EPOCH_SECONDS_64
+  if (seconds <= ACETIME_T_MIN || seconds > ACETIME_T_MAX) return forError();
+#endif
+  return forEpochSeconds((acetime_t) seconds, fields.nanos);
+}
+
+void Instant::printTo(Print& printer) const {
+  char buf[kMaxStringLength + 1];
+  formatTo(buf, sizeof(buf));
+  printer.print(buf);
+}
+
+size_t Instant::formatTo(char* buf, size_t len) const {
+  BufferWriter writer(buf, len);
+  formatTo(writer);
+  return writer.finish();
+}
+
+void Instant::formatTo(BufferWriter& writer) const {
+  if (isError()) {
+    writer.writeString(F("<Invalid Instant>"));
+    return;
+  }
+
+  auto ldt = LocalDateTime::forEpochSeconds(mEpochSeconds);
+  if (ldt.isError()) {
+    writer.writeString(F("<Invalid Instant>"));
+    return;
+  }
+  ldt.formatTo(writer);
+
+  // Fraction of the second, in groups of 3 digits, without trailing groups
+  // of zeros.
+  if (mNanos != 0) {
+    writer.writeChar('.');
+    writePad3(writer, mNanos / 1000000);
+    uint32_t subMillis = mNanos % 1000000;
+    if (subMillis != 0) {
+      writePad3(writer, subMillis / 1000);
+      uint16_t subMicros = subMillis % 1000;
+      if (subMicros != 0) writePad3(writer, subMicros);
+    }
+  }
+  writer.writeChar('Z');
+}
+
+}
@@ -0,0 +1,187 @@
+/*
+ * MIT License
+ * Copyright (c) 2019 Brian T. Park
+ */
+
+#ifndef ACE_TIME_INSTANT_H
+#define ACE_TIME_INSTANT_H
+
+#include <stdint.h>
+#include <stddef.h> // size_t
+#include "common/common.h"
+#include "LocalDate.h"
+
+class Print;
+
+namespace ace_time {
+
+namespace common {
+class BufferWriter;
+}
+
+/**
+ * A point on the UTC time line, with a precision of nanoseconds. It holds the
+ * number of whole seconds since the AceTime epoch (2000-01-01T00:00:00Z) and
+ * the fraction of the second in nanoseconds [0, 999999999], which is always
+ * added to the seconds, so that 1.5 seconds before the epoch is (-2, 500000000).
+ * The fraction is kept separately so that the UTC offset of a TimeZone, which
+ * depends only on the whole seconds, is calculated exactly as for an
+ * acetime_t.
+ *
+ * An Instant can be ordered with compareTo(), parsed from an ISO 8601 string
+ * with a fractional second, printed as "2018-08-31T20:48:01.250Z", and
+ * converted to and from a ZonedDateTime, which drops the fraction.
+ *
+ * Parts of this class were inspired by the java.time.Instant class of Java 11
+ * (https://docs.oracle.com/en/java/javase/11/docs/api/java.base/java/time/Instant.html).
+ */
+class Instant {
+  public:
+    /** Number of nanoseconds in one second. */
+    static const uint32_t kNanosPerSecond = 1000000000;
+
+    /**
+     * Maximum length of the string written by formatTo(), not including the
+     * NUL terminator (e.g. "2018-08-31T20:48:01.123456789Z").
+     */
+    static const uint8_t kMaxStringLength = 30;
+
+    /**
+     * Factory method using the number of seconds since AceTime epoch and the
+     * fraction of the second. Returns Instant::forError() if epochSeconds is
+     * LocalDate::kInvalidEpochSeconds or nanos is not less than
+     * kNanosPerSecond.
+     *
+     * @param epochSeconds number of seconds since AceTime epoch (2000-01-01)
+     * @param nanos nanoseconds after epochSeconds [0, 999999999]
+     */
+    static Instant forEpochSeconds(acetime_t epochSeconds, uint32_t nanos = 0) {
+      if (epochSeconds == LocalDate::kInvalidEpochSeconds
+          || nanos >= kNanosPerSecond) {
+        return forError();
+      }
+      return Instant(epochSeconds, nanos);
+    }
+
+    /**
+     * Factory method using the number of seconds since AceTime epoch and the
+     * milliseconds [0, 999] after it.
+     */
+    static Instant forEpochMillis(acetime_t epochSeconds, uint16_t millis) {
+      return forEpochSeconds(epochSeconds, (uint32_t) millis * 1000000);
+    }
+
+    /**
+     * Factory method using the number of seconds since Unix epoch
+     * (1970-01-01T00:00:00Z) and the fraction of the second.
+     */
+    static Instant forUnixSeconds(acetime_t unixSeconds, uint32_t nanos = 0) {
+      if (unixSeconds == LocalDate::kInvalidEpochSeconds) return forError();
+      return forEpochSeconds(unixSeconds - LocalDate::kSecondsSinceUnixEpoch,
+          nanos);
+    }
+
+    /**
+     * Factory method. Create an Instant from an ISO 8601 date-time string of
+     * the given length, in any of the forms accepted by
+     * iso8601::parseDateTime() (e.g. "2018-08-31T13:48:01.250-07:00",
+     * "20180831T204801,123456789Z"). The UTC offset is required, but unlike
+     * OffsetDateTime::forIso8601(), it does not need to be a multiple of 15
+     * minutes. The fraction of the second is kept up to 9 digits. Returns
+     * Instant::forError() if a parsing error occurs, or if the epoch seconds
+     * do not fit in an acetime_t (e.g. before 1931-12-13T20:45:53Z or after
+     * 2068-01-19T03:14:07Z by default).
+     */
+    static Instant forIso8601(const char* s, size_t len);
+
+    /** Factory method that returns an Instant whose isError() is true. */
+    static Instant forError() {
+      return Instant(LocalDate::kInvalidEpochSeconds, 0);
+    }
+
+    /** Default constructor does nothing. */
+    explicit Instant() {}
+
+    /** Return true if any component indicates an error condition. */
+    bool isError() const {
+      return mEpochSeconds == LocalDate::kInvalidEpochSeconds;
+    }
+
+    /** Return the whole number of seconds since AceTime epoch. */
+    acetime_t epochSeconds() const { return mEpochSeconds; }
+
+    /** Return the whole number of seconds since Unix epoch. */
+    acetime_t unixSeconds() const {
+      if (isError()) return LocalDate::kInvalidEpochSeconds;
+      return mEpochSeconds + LocalDate::kSecondsSinceUnixEpoch;
+    }
+
+    /** Return the fraction of the second in nanoseconds. */
+    uint32_t nanos() const { return mNanos; }
+
+    /** Return the fraction of the second in microseconds, truncated. */
+    uint32_t micros() const { return mNanos / 1000; }
+
+    /** Return the fraction of the second in milliseconds, truncated. */
+    uint16_t millis() const { return mNanos / 1000000; }
+
+    /**
+     * Compare this Instant with that Instant, returning (<0, 0, >0)
+     * according to whether this is (earlier, equal, later) than that. If
+     * isError() is true, the behavior is undefined.
+     */
+    int8_t compareTo(const Instant& that) const {
+      if (mEpochSeconds < that.mEpochSeconds) return -1;
+      if (mEpochSeconds > that.mEpochSeconds) return 1;
+      if (mNanos < that.mNanos) return -1;
+      if (mNanos > that.mNanos) return 1;
+      return 0;
+    }
+
+    /**
+     * Print the Instant in UTC in ISO 8601 format, with 0, 3, 6 or 9 digits
+     * of the fraction of the second as needed, e.g. "2018-08-31T20:48:01Z",
+     * "2018-08-31T20:48:01.250Z" or "2018-08-31T20:48:01.000001Z".
+     */
+    void printTo(Print& printer) const;
+
+    /**
+     * Write the same characters as printTo() into the buffer of size len,
+     * terminated by NUL. Return the number of characters written, or 0 if
+     * the buffer is too small, leaving an empty string.
+     */
+    size_t formatTo(char* buf, size_t len) const;
+
+    /** Write the same characters as formatTo(char*, size_t) into writer. */
+    void formatTo(common::BufferWriter& writer) const;
+
+    // Use default copy constructor and assignment operator.
+    Instant(const Instant&) = default;
+    Instant& operator=(const Instant&) = default;
+
+  private:
+    friend bool operator==(const Instant& a, const Instant& b);
+
+    /** Constructor that sets the components. */
+    explicit Instant(acetime_t epochSeconds, uint32_t nanos):
+        mEpochSeconds(epochSeconds),
+        mNanos(nanos) {}
+
+    acetime_t mEpochSeconds; // kInvalidEpochSeconds indicates error
+    uint32_t mNanos; // [0, 999999999]
+};
+
+/** Return true if two Instant objects are equal. */
+inline bool operator==(const Instant& a, const Instant& b) {
+  return a.mEpochSeconds == b.mEpochSeconds
+      && a.mNanos == b.mNanos;
+}
+
+/** Return true if two Instant objects are not equal. */
+inline bool operator!=(const Instant& a, const Instant& b) {
+  return ! (a == b);
+}
+
+}
+
+#endif
@@ -5,12 +5,14 @@
 
 #include "common/util.h"
 #include "common/DateStrings.h"
+#include "common/BufferWriter.h"
 #include "LocalDate.h"
 
 namespace ace_time {
 
 using common::printPad2;
 using common::printPad3;
+using common::BufferWriter;
 
 // Using 0=Jan offset.
 const uint8_t LocalDate::sDayOfWeek[12] = {
@@ -44,6 +46,32 @@ const uint8_t LocalDate::sDaysInMonth[12] = {
   31 /*Dec=31*/,
 };
 
+void LocalDate::extractYearMonthDays(const acetime_t* epochDays,
+    int16_t* years, uint8_t* months, uint8_t* days, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    int16_t year;
+    uint8_t month;
+    uint8_t day;
+  #if (defined(ARDUINO_ARCH_AVR) && ! ACE_TIME_LOCAL_DATE_DIVISION_FREE) \
+      || ACE_TIME_EPOCH_SECONDS_64
+    extractYearMonthDay(epochDays[i], year, month, day);
+  #else
+    extractYearMonthDayFast(epochDays[i], year, month, day);
+  #endif
+
+    // Branchless, so that the loop can be vectorized.
+  #if ACE_TIME_EPOCH_SECONDS_64
+    bool isValid = (epochDays[i] >= kMinEpochDays)
+        & (epochDays[i] <= kMaxEpochDays);
+  #else
+    bool isValid = (epochDays[i] != kInvalidEpochDays);
+  #endif
+    years[i] = isValid ? year : 0;
+    months[i] = isValid ? month : 0;
+    days[i] = isValid ? day : 0;
+  }
+}
+
 void LocalDate::printTo(Print& printer) const {
   if (isError()) {
     printer.print(F("<Invalid LocalDate>"));
@@ -51,7 +79,8 @@ void LocalDate::printTo(Print& printer) const {
   }
 
   // Date
-  printer.print(year());
+  printPad2(printer, year() / 100);
+  printPad2(printer, year() % 100);
   printer.print('-');
   printPad2(printer, mMonth);
   printer.print('-');
@@ -59,8 +88,26 @@ void LocalDate::printTo(Print& printer) const {
   printer.print(' ');
 
   // Week day
-  DateStrings ds;
-  printer.print(ds.dayOfWeekLongString(dayOfWeek()));
+  printer.print(DateStrings::dayOfWeekLongName(dayOfWeek()));
+}
+
+size_t LocalDate::formatTo(char* buf, size_t len) const {
+  BufferWriter writer(buf, len);
+  formatTo(writer);
+  return writer.finish();
+}
+
+void LocalDate::formatTo(BufferWriter& writer) const {
+  if (isError()) {
+    writer.writeString(F("<Invalid LocalDate>"));
+    return;
+  }
+
+  writer.writePad4(year());
+  writer.writeChar('-');
+  writer.writePad2(mMonth);
+  writer.writeChar('-');
+  writer.writePad2(mDay);
 }
 
 LocalDate LocalDate::forDateString(const char* dateString) {
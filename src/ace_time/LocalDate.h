@@ -7,13 +7,39 @@
 #define ACE_TIME_LOCAL_DATE_H
 
 #include <stdint.h>
+#include <stddef.h> // size_t
 #include "common/common.h"
 #include "LocalTime.h"
 
+/**
+ * Set to 1 to make LocalDate::toEpochDays() and LocalDate::forEpochDays() use
+ * multiply-and-shift calendar arithmetic instead of the 32-bit divisions and
+ * modulos of the Julian Day formulas. The results are identical over the
+ * range of LocalDate. Enabled by default, except on AVR where the 32-bit
+ * multiplications are almost as slow as the divisions. The constants are
+ * exact only for years [1872, 2127], so this cannot be combined with
+ * ACE_TIME_EPOCH_SECONDS_64.
+ */
+#ifndef ACE_TIME_LOCAL_DATE_DIVISION_FREE
+  #if defined(ARDUINO_ARCH_AVR) || ACE_TIME_EPOCH_SECONDS_64
+    #define ACE_TIME_LOCAL_DATE_DIVISION_FREE 0
+  #else
+    #define ACE_TIME_LOCAL_DATE_DIVISION_FREE 1
+  #endif
+#endif
+
+#if ACE_TIME_LOCAL_DATE_DIVISION_FREE && ACE_TIME_EPOCH_SECONDS_64
+  #error ACE_TIME_LOCAL_DATE_DIVISION_FREE requires 32-bit epoch seconds
+#endif
+
 class Print;
 
 namespace ace_time {
 
+namespace common {
+class BufferWriter;
+}
+
 /**
  * The date (year, month, day) representing the date without regards to time
  * zone.
@@ -21,7 +47,9 @@ namespace ace_time {
  * The year field is internally represented as an int8_t offset from the year
  * 2000. However, the value of -128 (kInvalidYearTiny) is used to indicate an
  * error condition. So the actual range of the year is [1873, 2127] instead of
- * [1872, 2127].
+ * [1872, 2127]. If ACE_TIME_EPOCH_SECONDS_64 is enabled, the year is stored
+ * as an int16_t instead, and the range is [1, 9999], so that the year always
+ * has 4 digits in ISO 8601 format.
  *
  * If the year is restricted to 2000-2099 (2 digit years), these fields
  * correspond to the range supported by the DS3231 RTC chip.
@@ -44,8 +72,22 @@ class LocalDate {
      */
     static const int8_t kInvalidYearTiny = INT8_MIN;
 
+  #if ACE_TIME_EPOCH_SECONDS_64
+    /** Smallest valid year. */
+    static const int16_t kMinYear = 1;
+
+    /** Largest valid year. */
+    static const int16_t kMaxYear = 9999;
+  #else
+    /** Smallest valid year. */
+    static const int16_t kMinYear = kEpochYear + INT8_MIN + 1;
+
+    /** Largest valid year. */
+    static const int16_t kMaxYear = kEpochYear + INT8_MAX;
+  #endif
+
     /** Sentinel epochDays which indicates an error. */
-    static const acetime_t kInvalidEpochDays = INT32_MIN;
+    static const acetime_t kInvalidEpochDays = ACETIME_T_MIN;
 
     /** Sentinel epochSeconds which indicates an error. */
     static const acetime_t kInvalidEpochSeconds = LocalTime::kInvalidSeconds;
@@ -87,20 +129,30 @@ class LocalDate {
      * Factory method using separated year, month and day fields. Returns
      * LocalDate::forError() if the parameters are out of range.
      *
-     * @param year [1873-2127]
+     * @param year [kMinYear, kMaxYear], i.e. [1873-2127] by default
      * @param month month with January=1, December=12
      * @param day day of month [1-31]
      */
     static LocalDate forComponents(int16_t year, uint8_t month, uint8_t day) {
+    #if ACE_TIME_EPOCH_SECONDS_64
+      return LocalDate(isYearValid(year) ? year : kInvalidYear, month, day);
+    #else
       int8_t yearTiny = isYearValid(year)
           ? year - kEpochYear : kInvalidYearTiny;
       return LocalDate(yearTiny, month, day);
+    #endif
     }
 
     /** Factory method using components with an int8_t yearTiny. */
     static LocalDate forTinyComponents(int8_t yearTiny, uint8_t month,
         uint8_t day) {
+    #if ACE_TIME_EPOCH_SECONDS_64
+      return LocalDate(
+          (yearTiny == kInvalidYearTiny) ? kInvalidYear : yearTiny + kEpochYear,
+          month, day);
+    #else
       return LocalDate(yearTiny, month, day);
+    #endif
     }
 
     /**
@@ -116,12 +168,35 @@ class LocalDate {
       uint8_t day;
       if (epochDays == kInvalidEpochDays) {
         year = month = day = 0;
+    #if ACE_TIME_EPOCH_SECONDS_64
+      } else if (epochDays < kMinEpochDays || epochDays > kMaxEpochDays) {
+        year = month = day = 0;
+    #endif
       } else {
+      #if ACE_TIME_LOCAL_DATE_DIVISION_FREE
+        extractYearMonthDayFast(epochDays, year, month, day);
+      #else
         extractYearMonthDay(epochDays, year, month, day);
+      #endif
       }
       return forComponents(year, month, day);
     }
 
+    /**
+     * Bulk version of forEpochDays() using a structure of arrays. Fill the
+     * 'years', 'months' and 'days' arrays with the components of each of the
+     * 'n' elements of 'epochDays'. If an element is kInvalidEpochDays, its
+     * components are set to 0, as in forEpochDays().
+     *
+     * On 32-bit and 64-bit processors, this uses the division-free algorithm
+     * of Neri and Schneider, written as a loop without branches which the
+     * compiler can auto-vectorize (e.g. with SSE2 or AVX2 on x86-64 using
+     * -O3). On 8-bit AVR processors, it calls extractYearMonthDay() on each
+     * element, unless ACE_TIME_LOCAL_DATE_DIVISION_FREE is enabled.
+     */
+    static void extractYearMonthDays(const acetime_t* epochDays,
+        int16_t* years, uint8_t* months, uint8_t* days, size_t n);
+
     /** Factory method using the number of days since Unix epoch 1970-01-1. */
     static LocalDate forUnixDays(acetime_t unixDays) {
       if (unixDays == kInvalidEpochDays) {
@@ -192,7 +267,11 @@ class LocalDate {
      * condition. The isError() method will return true.
      */
     static LocalDate forError() {
+    #if ACE_TIME_EPOCH_SECONDS_64
+      return LocalDate(kInvalidYear, 0, 0);
+    #else
       return LocalDate(kInvalidYearTiny, 0, 0);
+    #endif
     }
 
     /** True if year is a leap year. */
@@ -200,10 +279,12 @@ class LocalDate {
       return ((year % 4 == 0) && (year % 100 != 0)) || (year % 400 == 0);
     }
 
-    /** Return true if year is within valid range of [1873, 2127]. */
+    /**
+     * Return true if year is within valid range of [kMinYear, kMaxYear], i.e.
+     * [1873, 2127] by default.
+     */
     static bool isYearValid(int16_t year) {
-      return year >= kEpochYear + kMinYearTiny
-          && year <= kEpochYear + kMaxYearTiny;
+      return year >= kMinYear && year <= kMaxYear;
     }
 
     /** Return the number of days in the current month. */
@@ -215,6 +296,31 @@ class LocalDate {
     /** Default constructor does nothing. */
     explicit LocalDate() {}
 
+  #if ACE_TIME_EPOCH_SECONDS_64
+    /** Return the full year instead of just the last 2 digits. */
+    int16_t year() const { return mYear; }
+
+    /**
+     * Set the year given the full year. A year outside of [kMinYear,
+     * kMaxYear] makes isError() return true.
+     */
+    void year(int16_t year) { mYear = isYearValid(year) ? year : kInvalidYear; }
+
+    /**
+     * Return the single-byte year offset from year 2000, or kInvalidYearTiny
+     * if the year is outside of [1873, 2127].
+     */
+    int8_t yearTiny() const {
+      return (mYear > kEpochYear + INT8_MIN && mYear <= kEpochYear + INT8_MAX)
+          ? mYear - kEpochYear : kInvalidYearTiny;
+    }
+
+    /** Set the single-byte year offset from year 2000. */
+    void yearTiny(int8_t yearTiny) {
+      mYear = (yearTiny == kInvalidYearTiny)
+          ? kInvalidYear : yearTiny + kEpochYear;
+    }
+  #else
     /** Return the full year instead of just the last 2 digits. */
     int16_t year() const { return mYearTiny + kEpochYear; }
 
@@ -226,6 +332,7 @@ class LocalDate {
 
     /** Set the single-byte year offset from year 2000. */
     void yearTiny(int8_t yearTiny) { mYearTiny = yearTiny; }
+  #endif
 
     /** Return the month with January=1, December=12. */
     uint8_t month() const { return mMonth; }
@@ -256,7 +363,11 @@ class LocalDate {
 
     /** Return true if any component indicates an error condition. */
     bool isError() const {
+    #if ACE_TIME_EPOCH_SECONDS_64
+      return mYear == kInvalidYear
+    #else
       return mYearTiny == kInvalidYearTiny
+    #endif
           || mDay < 1 || mDay > 31
           || mMonth < 1 || mMonth > 12;
     }
@@ -271,6 +382,9 @@ class LocalDate {
      *    * the largest date 2127-12-31 returns 46751
      *    * the smallest date 1872-01-01 returns -46751
      *
+     * With ACE_TIME_EPOCH_SECONDS_64, the range is [kMinEpochDays,
+     * kMaxEpochDays].
+     *
      * Uses Julian days which normally start at 12:00:00. But this method
      * returns the delta number of days since 00:00:00, so we can interpret the
      * Gregorian calendar day to start at 00:00:00.
@@ -280,6 +394,9 @@ class LocalDate {
     acetime_t toEpochDays() const {
       if (isError()) return kInvalidEpochDays;
 
+    #if ACE_TIME_LOCAL_DATE_DIVISION_FREE
+      return toEpochDaysFast(year(), mMonth, mDay);
+    #else
       // From wiki article:
       //
       // JDN = (1461 x (Y + 4800 + (M - 14)/12))/4
@@ -299,6 +416,7 @@ class LocalDate {
           - (3 * ((yy + 4900 + mm)/100))/4
           + mDay - 32075;
       return jdn - kDaysSinceJulianEpoch;
+    #endif
     }
 
     /** Return the number of days since Unix epoch (1970-01-01 00:00:00). */
@@ -311,11 +429,13 @@ class LocalDate {
      * Return the number of seconds since AceTime epoch (2000-01-01 00:00:00).
      * Returns kInvalidEpochSeconds if isError() is true. This is a convenience
      * method that returns (86400 * toEpochDays()). Since acetime_t is a
-     * 32-bit signed integer, the limits are different:
+     * 32-bit signed integer by default, the limits are different:
      *
      *    * the smallest date corresponding to INT32_MIN is 1931-12-13 20:45:52
      *      so this method supports dates as small as 1931-12-14.
      *    * the largest date corresponding to INT32_MAX is 2068-01-19 03:14:07.
+     *
+     * With ACE_TIME_EPOCH_SECONDS_64, every valid date is supported.
      */
     acetime_t toEpochSeconds() const {
       if (isError()) return kInvalidEpochSeconds;
@@ -336,8 +456,13 @@ class LocalDate {
      * this>that). If isError() is true, the behavior is undefined.
      */
     int8_t compareTo(const LocalDate& that) const {
+    #if ACE_TIME_EPOCH_SECONDS_64
+      if (mYear < that.mYear) return -1;
+      if (mYear > that.mYear) return 1;
+    #else
       if (mYearTiny < that.mYearTiny) return -1;
       if (mYearTiny > that.mYearTiny) return 1;
+    #endif
       if (mMonth < that.mMonth) return -1;
       if (mMonth > that.mMonth) return 1;
       if (mDay < that.mDay) return -1;
@@ -353,6 +478,18 @@ class LocalDate {
      */
     void printTo(Print& printer) const;
 
+    /**
+     * Write the ISO 8601 date (e.g. "2018-08-31") into the buffer of size len,
+     * terminated by NUL. Unlike printTo(), the day of week is not written.
+     * Return the number of characters written, or 0 if the buffer is too
+     * small, leaving an empty string. 11 characters are enough for a valid
+     * date.
+     */
+    size_t formatTo(char* buf, size_t len) const;
+
+    /** Write the same characters as formatTo(char*, size_t) into writer. */
+    void formatTo(common::BufferWriter& writer) const;
+
     // Use default copy constructor and assignment operator.
     LocalDate(const LocalDate&) = default;
     LocalDate& operator=(const LocalDate&) = default;
@@ -360,17 +497,16 @@ class LocalDate {
   private:
     friend bool operator==(const LocalDate& a, const LocalDate& b);
 
-    /**
-     * Sentinel yearTiny which represents the smallest year, effectively
-     * -Infinity.
-     */
-    static const int8_t kMinYearTiny = INT8_MIN + 1;
+  #if ACE_TIME_EPOCH_SECONDS_64
+    /** Sentinel mYear which indicates an error. */
+    static const int16_t kInvalidYear = INT16_MIN;
 
-    /**
-     * Sentinel yearTiny which represents the largest year, effectively
-     * -Infinity.
-     */
-    static const int8_t kMaxYearTiny = INT8_MAX;
+    /** Number of days from the AceTime epoch to 0001-01-01. */
+    static const acetime_t kMinEpochDays = -730119;
+
+    /** Number of days from the AceTime epoch to 9999-12-31. */
+    static const acetime_t kMaxEpochDays = 2921939;
+  #endif
 
     /**
      * Number of days between the Julian calendar epoch (4713 BC 01-01) and the
@@ -391,11 +527,81 @@ class LocalDate {
     /** Number of days in each month in a non-leap year. 0=Jan, 11=Dec. */
     static const uint8_t sDaysInMonth[12];
 
+  #if ACE_TIME_EPOCH_SECONDS_64
+    /** Constructor that sets the components. */
+    explicit LocalDate(int16_t year, uint8_t month, uint8_t day):
+        mYear(year),
+        mMonth(month),
+        mDay(day) {}
+  #else
     /** Constructor that sets the components. */
     explicit LocalDate(int8_t yearTiny, uint8_t month, uint8_t day):
         mYearTiny(yearTiny),
         mMonth(month),
         mDay(day) {}
+  #endif
+
+    /**
+     * Number of days from 1600-03-01 to the AceTime epoch (2000-01-01). The
+     * division-free algorithm counts days from 1600-03-01, so that the leap
+     * day is the last day of its computational year, and every century
+     * cycle starts on a multiple of 400 years.
+     */
+    static const uint32_t kDaysSinceMarch1600 = 146037;
+
+    /**
+     * Division-free version of the Julian Day formula of toEpochDays(), the
+     * inverse of extractYearMonthDayFast(). Exact for years [1872, 2127].
+     */
+    static acetime_t toEpochDaysFast(int16_t year, uint8_t month,
+        uint8_t day) {
+      // Treat January and February as months 13 and 14 of the previous
+      // computational year, which starts on March 1.
+      uint32_t j = (month <= 2);
+      uint32_t y = year - 1600 - j;
+      uint32_t m = month + 12 * j;
+
+      // Century since 1600, using y / 100 == (41 * y) >> 12 for y < 1000.
+      uint32_t c = (41 * y) >> 12;
+      uint32_t yearDays = ((1461 * y) >> 2) - c + (c >> 2);
+      uint32_t monthDays = (979 * m - 2919) >> 5;
+      return (acetime_t) (yearDays + monthDays + day - 1)
+          - (acetime_t) kDaysSinceMarch1600;
+    }
+
+    /**
+     * Division-free version of extractYearMonthDay(), based on the algorithm
+     * of Neri and Schneider ("Euclidean affine functions and their
+     * application to calendar algorithms", 2022), with the 64-bit
+     * multiplications replaced by 32-bit multiply-and-shift constants and
+     * comparisons which are exact only over the range of LocalDate, i.e. for
+     * years [1872, 2127]. The result is undefined outside of that range.
+     */
+    static void extractYearMonthDayFast(acetime_t epochDays, int16_t& year,
+        uint8_t& month, uint8_t& day) {
+      uint32_t n = epochDays + kDaysSinceMarch1600;
+
+      // Century since 1600. Only centuries 2 to 5 (1800 to 2199) are needed.
+      uint32_t c = 2 + (n >= 109572) + (n >= 146097) + (n >= 182621);
+
+      // Day of century, then year of century, using
+      // (4 * nc + 3) / 1461 == (91867 * nc + 80000) >> 25 for nc < 36525.
+      uint32_t nc = (4 * n + 3 - 146097 * c) >> 2;
+      uint32_t z = (91867 * nc + 80000) >> 25;
+
+      // Day of computational year, where 0 is March 1.
+      uint32_t ny = (4 * nc + 3 - 1461 * z) >> 2;
+
+      // Computational month [3, 14] and day of month.
+      uint32_t m = (2141 * ny + 197913) >> 16;
+      uint32_t d = ny - ((979 * m - 2919) >> 5) + 1;
+
+      // January and February belong to the following calendar year.
+      uint32_t j = (ny >= 306);
+      year = 1600 + 100 * c + z + j;
+      month = m - 12 * j;
+      day = d;
+    }
 
     /**
      * Extract the (year, month, day, dayOfWeek) fields from epochDays.
@@ -417,11 +623,15 @@ class LocalDate {
       //dayOfWeek = (epochDays + 6) % 7 + 1;
     }
 
+  #if ACE_TIME_EPOCH_SECONDS_64
+    int16_t mYear; // [1, 9999], INT16_MIN indicates error
+  #else
     /**
      * Store year as an int8_t offset from year 2000. This saves memory, but may
      * cause other problems later. Consider changing to int16_t if necessary.
      */
     int8_t mYearTiny; // [-127, 127], -128 indicates error
+  #endif
 
     uint8_t mMonth; // [1, 12], 0 indicates error
     uint8_t mDay; // [1, 31], 0 indicates error
@@ -431,7 +641,11 @@ class LocalDate {
 inline bool operator==(const LocalDate& a, const LocalDate& b) {
   return a.mDay == b.mDay
       && a.mMonth == b.mMonth
+    #if ACE_TIME_EPOCH_SECONDS_64
+      && a.mYear == b.mYear;
+    #else
       && a.mYearTiny == b.mYearTiny;
+    #endif
 }
 
 /** Return true if two LocalDate objects are not equal. */
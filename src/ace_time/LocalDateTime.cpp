@@ -5,11 +5,13 @@
 
 #include "common/util.h"
 #include "common/DateStrings.h"
+#include "common/BufferWriter.h"
 #include "LocalDateTime.h"
 
 namespace ace_time {
 
 using common::printPad2;
+using common::BufferWriter;
 
 void LocalDateTime::printTo(Print& printer) const {
   if (isError()) {
@@ -18,7 +20,8 @@ void LocalDateTime::printTo(Print& printer) const {
   }
 
   // Date
-  printer.print(mLocalDate.year());
+  printPad2(printer, mLocalDate.year() / 100);
+  printPad2(printer, mLocalDate.year() % 100);
   printer.print('-');
   printPad2(printer, mLocalDate.month());
   printer.print('-');
@@ -35,6 +38,23 @@ void LocalDateTime::printTo(Print& printer) const {
   printPad2(printer, mLocalTime.second());
 }
 
+size_t LocalDateTime::formatTo(char* buf, size_t len) const {
+  BufferWriter writer(buf, len);
+  formatTo(writer);
+  return writer.finish();
+}
+
+void LocalDateTime::formatTo(BufferWriter& writer) const {
+  if (isError()) {
+    writer.writeString(F("<Invalid LocalDateTime>"));
+    return;
+  }
+
+  mLocalDate.formatTo(writer);
+  writer.writeChar('T');
+  mLocalTime.formatTo(writer);
+}
+
 LocalDateTime LocalDateTime::forDateString(const char* dateString) {
   if (strlen(dateString) < kDateTimeStringLength) {
     return LocalDateTime::forError();
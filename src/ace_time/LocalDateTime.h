@@ -7,6 +7,7 @@
 #define ACE_TIME_LOCAL_DATE_TIME_H
 
 #include <stdint.h>
+#include "common/compat.h" // strncpy_P(), strlen()
 #include "LocalDate.h"
 #include "LocalTime.h"
 
@@ -15,6 +16,10 @@ class __FlashStringHelper;
 
 namespace ace_time {
 
+namespace common {
+class BufferWriter;
+}
+
 /**
  * Class that holds the date-time as the components (year, month, day, hour,
  * minute, second) without regards to the time zone. It is an aggregation of
@@ -30,7 +35,8 @@ class LocalDateTime {
     /**
      * Factory method using separated date and time components.
      *
-     * @param year [1873-2127]
+     * @param year [LocalDate::kMinYear, LocalDate::kMaxYear], i.e. [1873-2127]
+     *    by default
      * @param month month with January=1, December=12
      * @param day day of month [1-31]
      * @param hour hour [0-23]
@@ -39,10 +45,9 @@ class LocalDateTime {
      */
     static LocalDateTime forComponents(int16_t year, uint8_t month,
         uint8_t day, uint8_t hour, uint8_t minute, uint8_t second) {
-      int8_t yearTiny = LocalDate::isYearValid(year)
-          ? year - LocalDate::kEpochYear
-          : LocalDate::kInvalidYearTiny;
-      return forTinyComponents(yearTiny, month, day, hour, minute, second);
+      return LocalDateTime(
+          LocalDate::forComponents(year, month, day),
+          LocalTime::forComponents(hour, minute, second));
     }
 
     /** Factory method using components with an int8_t yearTiny. */
@@ -272,12 +277,24 @@ class LocalDateTime {
      */
     void printTo(Print& printer) const;
 
+    /**
+     * Write the same characters as printTo() (e.g. "2018-08-31T13:48:01")
+     * into the buffer of size len, terminated by NUL. Return the number of
+     * characters written, or 0 if the buffer is too small, leaving an empty
+     * string.
+     */
+    size_t formatTo(char* buf, size_t len) const;
+
+    /** Write the same characters as formatTo(char*, size_t) into writer. */
+    void formatTo(common::BufferWriter& writer) const;
+
     // Use default copy constructor and assignment operator.
     LocalDateTime(const LocalDateTime&) = default;
     LocalDateTime& operator=(const LocalDateTime&) = default;
 
   private:
     friend bool operator==(const LocalDateTime& a, const LocalDateTime& b);
+    friend class OffsetDateTime; // LocalDateTime(ld, lt)
 
     /** Expected length of an ISO 8601 date string. */
     static const uint8_t kDateTimeStringLength = 19;
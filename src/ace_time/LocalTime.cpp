@@ -4,11 +4,13 @@
  */
 
 #include "common/util.h"
+#include "common/BufferWriter.h"
 #include "LocalTime.h"
 
 namespace ace_time {
 
 using common::printPad2;
+using common::BufferWriter;
 
 void LocalTime::printTo(Print& printer) const {
   if (isError()) {
@@ -24,6 +26,25 @@ void LocalTime::printTo(Print& printer) const {
   printPad2(printer, mSecond);
 }
 
+size_t LocalTime::formatTo(char* buf, size_t len) const {
+  BufferWriter writer(buf, len);
+  formatTo(writer);
+  return writer.finish();
+}
+
+void LocalTime::formatTo(BufferWriter& writer) const {
+  if (isError()) {
+    writer.writeString(F("<Invalid LocalTime>"));
+    return;
+  }
+
+  writer.writePad2(mHour);
+  writer.writeChar(':');
+  writer.writePad2(mMinute);
+  writer.writeChar(':');
+  writer.writePad2(mSecond);
+}
+
 LocalTime LocalTime::forTimeString(const char* timeString) {
   if (strlen(timeString) < kTimeStringLength) {
     return forError();
@@ -13,6 +13,10 @@ class Print;
 
 namespace ace_time {
 
+namespace common {
+class BufferWriter;
+}
+
 /**
  * The time (hour, minute, second) fields representing the time without regards
  * to the day or the time zone. The valid range is 00:00:00 to 23:59:59.
@@ -26,7 +30,7 @@ namespace ace_time {
 class LocalTime {
   public:
     /** An invalid seconds marker that indicates isError() true. */
-    static const acetime_t kInvalidSeconds = INT32_MIN;
+    static const acetime_t kInvalidSeconds = ACETIME_T_MIN;
 
     /**
      * Factory method using separated date, time, and time zone fields. The
@@ -165,6 +169,16 @@ class LocalTime {
      */
     void printTo(Print& printer) const;
 
+    /**
+     * Write the same characters as printTo() (e.g. "13:48:01") into the
+     * buffer of size len, terminated by NUL. Return the number of characters
+     * written, or 0 if the buffer is too small, leaving an empty string.
+     */
+    size_t formatTo(char* buf, size_t len) const;
+
+    /** Write the same characters as formatTo(char*, size_t) into writer. */
+    void formatTo(common::BufferWriter& writer) const;
+
     // Use default copy constructor and assignment operator.
     LocalTime(const LocalTime&) = default;
     LocalTime& operator=(const LocalTime&) = default;
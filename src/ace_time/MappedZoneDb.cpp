@@ -0,0 +1,230 @@
+/*
+ * MIT License
+ * Copyright (c) 2019 Brian T. Park
+ */
+
+#include <string.h> // memcmp(), memchr()
+#include "MappedZoneDb.h"
+
+#if defined(__linux__) || defined(__APPLE__)
+  #include <fcntl.h> // open()
+  #include <unistd.h> // close()
+  #include <sys/mman.h> // mmap(), munmap()
+  #include <sys/stat.h> // fstat()
+  #define ACE_TIME_HAS_MMAP 1
+#else
+  #define ACE_TIME_HAS_MMAP 0
+#endif
+
+namespace ace_time {
+
+bool MappedZoneDb::openFile(const char* fileName) {
+  close();
+#if ACE_TIME_HAS_MMAP
+  int fd = ::open(fileName, O_RDONLY);
+  if (fd < 0) return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    ::close(fd);
+    return false;
+  }
+  size_t size = (size_t) st.st_size;
+
+  // The mapping stays valid after the file descriptor is closed.
+  void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) return false;
+
+  if (! isValid((const uint8_t*) data, size)) {
+    munmap(data, size);
+    return false;
+  }
+  mData = (const uint8_t*) data;
+  mSize = size;
+  mIsMapped = true;
+  return true;
+#else
+  (void) fileName;
+  return false;
+#endif
+}
+
+bool MappedZoneDb::openBuffer(const uint8_t* data, size_t size) {
+  close();
+  if (! isValid(data, size)) return false;
+  mData = data;
+  mSize = size;
+  return true;
+}
+
+void MappedZoneDb::close() {
+#if ACE_TIME_HAS_MMAP
+  if (mIsMapped) munmap((void*) mData, mSize);
+#endif
+  mData = nullptr;
+  mSize = 0;
+  mIsMapped = false;
+}
+
+const char* MappedZoneDb::tzVersion() const {
+  if (isError()) return "";
+  return (const char*) mapped::readPointer(mData + mapped::kHeaderZoneContext
+      + mapped::kZoneContextTzVersion);
+}
+
+int16_t MappedZoneDb::startYear() const {
+  if (isError()) return 0;
+  return (int16_t) mapped::readUint16(mData + mapped::kHeaderZoneContext
+      + mapped::kZoneContextStartYear);
+}
+
+int16_t MappedZoneDb::untilYear() const {
+  if (isError()) return 0;
+  return (int16_t) mapped::readUint16(mData + mapped::kHeaderZoneContext
+      + mapped::kZoneContextUntilYear);
+}
+
+uint16_t MappedZoneDb::registrySize() const {
+  if (isError()) return 0;
+  return mapped::readUint16(mData + mapped::kHeaderNumZones);
+}
+
+const extended::ZoneInfo* const* MappedZoneDb::zoneRegistry() const {
+  if (isError()) return nullptr;
+  return (const extended::ZoneInfo* const*) mapped::readPointer(
+      mData + mapped::kHeaderRegistry);
+}
+
+const extended::ZoneInfo* const* MappedZoneDb::zoneRegistryById() const {
+  if (isError()) return nullptr;
+  return (const extended::ZoneInfo* const*) mapped::readPointer(
+      mData + mapped::kHeaderRegistryById);
+}
+
+const uint8_t* MappedZoneDb::resolve(const uint8_t* data, size_t size,
+    const uint8_t* field, size_t recordSize) {
+  // Compute in integers to avoid forming pointers outside of the database.
+  int32_t offset = mapped::readOffset(field);
+  if (offset == 0) return nullptr;
+  int64_t target = (int64_t) (field - data) + offset;
+  if (target < 0 || (uint64_t) target + recordSize > size) return nullptr;
+  return data + target;
+}
+
+bool MappedZoneDb::isValidString(const uint8_t* data, size_t size,
+    const uint8_t* s) {
+  if (s == nullptr) return false;
+  return memchr(s, '\0', size - (size_t) (s - data)) != nullptr;
+}
+
+bool MappedZoneDb::isValidZonePolicy(const uint8_t* data, size_t size,
+    const uint8_t* zonePolicy) {
+  uint8_t numRules = zonePolicy[mapped::kZonePolicyNumRules];
+  uint8_t numLetters = zonePolicy[mapped::kZonePolicyNumLetters];
+
+  if (numRules > 0) {
+    const uint8_t* rules = resolve(data, size,
+        zonePolicy + mapped::kZonePolicyRules,
+        (size_t) numRules * mapped::kZoneRuleSize);
+    if (rules == nullptr) return false;
+
+    // A letter below 32 is an index into the letters of the policy. A letter
+    // of 128 or more would become a negative index on targets where char is
+    // signed.
+    for (uint8_t i = 0; i < numRules; i++) {
+      uint8_t letter = rules[i * mapped::kZoneRuleSize
+          + mapped::kZoneRuleLetter];
+      if (letter < 32 && letter >= numLetters) return false;
+      if (letter >= 128) return false;
+    }
+  }
+
+  if (numLetters > 0) {
+    const uint8_t* letters = resolve(data, size,
+        zonePolicy + mapped::kZonePolicyLetters,
+        (size_t) numLetters * mapped::kOffsetSize);
+    if (letters == nullptr) return false;
+    for (uint8_t i = 0; i < numLetters; i++) {
+      const uint8_t* letter = resolve(data, size,
+          letters + i * mapped::kOffsetSize, 1);
+      if (! isValidString(data, size, letter)) return false;
+    }
+  }
+  return true;
+}
+
+bool MappedZoneDb::isValidZoneInfo(const uint8_t* data, size_t size,
+    const uint8_t* zoneInfo) {
+  const uint8_t* name = resolve(data, size, zoneInfo + mapped::kZoneInfoName,
+      1);
+  if (! isValidString(data, size, name)) return false;
+
+  // Every ZoneInfo must point to the single ZoneContext of the header.
+  const uint8_t* context = resolve(data, size,
+      zoneInfo + mapped::kZoneInfoZoneContext, mapped::kZoneContextSize);
+  if (context != data + mapped::kHeaderZoneContext) return false;
+
+  uint8_t numEras = zoneInfo[mapped::kZoneInfoNumEras];
+  if (numEras == 0) return false;
+  const uint8_t* eras = resolve(data, size, zoneInfo + mapped::kZoneInfoEras,
+      (size_t) numEras * mapped::kZoneEraSize);
+  if (eras == nullptr) return false;
+
+  for (uint8_t i = 0; i < numEras; i++) {
+    const uint8_t* era = eras + i * mapped::kZoneEraSize;
+    const uint8_t* format = resolve(data, size,
+        era + mapped::kZoneEraFormat, 1);
+    if (! isValidString(data, size, format)) return false;
+
+    if (mapped::readOffset(era + mapped::kZoneEraZonePolicy) != 0) {
+      const uint8_t* zonePolicy = resolve(data, size,
+          era + mapped::kZoneEraZonePolicy, mapped::kZonePolicySize);
+      if (zonePolicy == nullptr) return false;
+      if (! isValidZonePolicy(data, size, zonePolicy)) return false;
+    }
+  }
+  return true;
+}
+
+bool MappedZoneDb::isValid(const uint8_t* data, size_t size) {
+  if (data == nullptr || size < mapped::kHeaderSize) return false;
+  if (memcmp(data + mapped::kHeaderMagic, mapped::kMagic,
+      sizeof(mapped::kMagic)) != 0) return false;
+  if (mapped::readUint16(data + mapped::kHeaderVersion) != mapped::kVersion) {
+    return false;
+  }
+  if (data[mapped::kHeaderScope] != mapped::kScopeExtended) return false;
+  if (mapped::readUint32(data + mapped::kHeaderFileSize) != size) return false;
+
+  const uint8_t* tzVersion = resolve(data, size,
+      data + mapped::kHeaderZoneContext + mapped::kZoneContextTzVersion, 1);
+  if (! isValidString(data, size, tzVersion)) return false;
+
+  uint16_t numZones = mapped::readUint16(data + mapped::kHeaderNumZones);
+  if (numZones == 0) return false;
+  size_t registrySize = (size_t) numZones * mapped::kOffsetSize;
+  const uint8_t* registry = resolve(data, size,
+      data + mapped::kHeaderRegistry, registrySize);
+  const uint8_t* registryById = resolve(data, size,
+      data + mapped::kHeaderRegistryById, registrySize);
+  if (registry == nullptr || registryById == nullptr) return false;
+
+  // The ZoneInfo records are normally shared by both registries, but nothing
+  // in the format requires it, so both are validated.
+  for (uint16_t i = 0; i < numZones; i++) {
+    const uint8_t* zoneInfo = resolve(data, size,
+        registry + i * mapped::kOffsetSize, mapped::kZoneInfoSize);
+    if (zoneInfo == nullptr) return false;
+    if (! isValidZoneInfo(data, size, zoneInfo)) return false;
+  }
+  for (uint16_t i = 0; i < numZones; i++) {
+    const uint8_t* zoneInfo = resolve(data, size,
+        registryById + i * mapped::kOffsetSize, mapped::kZoneInfoSize);
+    if (zoneInfo == nullptr) return false;
+    if (! isValidZoneInfo(data, size, zoneInfo)) return false;
+  }
+  return true;
+}
+
+}
@@ -0,0 +1,145 @@
+/*
+ * MIT License
+ * Copyright (c) 2019 Brian T. Park
+ */
+
+#ifndef ACE_TIME_MAPPED_ZONE_DB_H
+#define ACE_TIME_MAPPED_ZONE_DB_H
+
+#include <stdint.h>
+#include <stddef.h> // size_t
+#include "internal/ZoneInfo.h"
+#include "internal/MappedZoneInfo.h"
+
+class MappedZoneDbTest_openBuffer_corrupted;
+
+namespace ace_time {
+
+/**
+ * A binary zone database (see internal/MappedZoneInfo.h) generated by
+ * 'tzcompiler.py --language binary', loaded at runtime instead of being
+ * compiled into the program. The file is mapped read-only into memory with
+ * mmap(), so the operating system shares a single copy of its pages between
+ * all the processes which use the same file, and nothing is copied into the
+ * heap. Updating the time zone rules only requires installing a new file.
+ *
+ * The records are validated once by openFile() or openBuffer(), after which
+ * they are read in place by the Mapped*Broker classes. When
+ * ACE_TIME_USE_MAPPED_ZONEDB is enabled, those brokers are used by the
+ * ExtendedZoneProcessor, so the registry can be given to an
+ * ExtendedZoneRegistrar or an ExtendedZoneManager:
+ *
+ * @code
+ * MappedZoneDb zoneDb;
+ * if (! zoneDb.openFile("/usr/share/acetime/zonedbx.bin")) { ... }
+ * ExtendedZoneManager<2> manager(zoneDb.registrySize(), zoneDb.zoneRegistry());
+ * TimeZone tz = manager.createForZoneName("America/Los_Angeles");
+ * @endcode
+ *
+ * The MappedZoneDb must outlive every ZoneProcessor and TimeZone which uses
+ * its ZoneInfo records. To swap in a new version of the database while the
+ * program is running, open it in a second MappedZoneDb, create a new
+ * ZoneManager from it, then close the old one after the old TimeZone objects
+ * are gone.
+ *
+ * Only Linux and MacOS are supported by openFile(). The openBuffer() method
+ * works anywhere, for a database which was loaded by other means.
+ */
+class MappedZoneDb {
+  public:
+    /** Constructor. isError() is true until a database is opened. */
+    MappedZoneDb() {}
+
+    /** Destructor. Unmaps the file if it was opened by openFile(). */
+    ~MappedZoneDb() { close(); }
+
+    /**
+     * Map the given file into memory and validate it. Any previously opened
+     * database is closed first. Return false if the file cannot be mapped or
+     * is not a valid binary zone database of the extended scope.
+     */
+    bool openFile(const char* fileName);
+
+    /**
+     * Validate the binary zone database at the given address, which is not
+     * owned by this object and must outlive it. Any previously opened
+     * database is closed first. Return false if it is not valid.
+     */
+    bool openBuffer(const uint8_t* data, size_t size);
+
+    /** Release the database. isError() is true afterwards. */
+    void close();
+
+    /** Return true if no valid database is open. */
+    bool isError() const { return mData == nullptr; }
+
+    /** Return the address of the database. */
+    const uint8_t* data() const { return mData; }
+
+    /** Return the size of the database in bytes. */
+    size_t size() const { return mSize; }
+
+    /** Return the TZ Database version (e.g. "2019a"). */
+    const char* tzVersion() const;
+
+    /** Return the start year of the zone records. */
+    int16_t startYear() const;
+
+    /** Return the until year of the zone records. */
+    int16_t untilYear() const;
+
+    /** Return the number of zones in the registry. */
+    uint16_t registrySize() const;
+
+    /**
+     * Return the zone registry, sorted by name, for the ZoneRegistrar. It is
+     * an array of offsets to the ZoneInfo records which can be read only
+     * through a MappedZoneRegistryBroker, not as an array of pointers.
+     */
+    const extended::ZoneInfo* const* zoneRegistry() const;
+
+    /** Return the zone registry sorted by zoneId. */
+    const extended::ZoneInfo* const* zoneRegistryById() const;
+
+  private:
+    friend class ::MappedZoneDbTest_openBuffer_corrupted;
+
+    // Disable copy constructor and assignment operator.
+    MappedZoneDb(const MappedZoneDb&) = delete;
+    MappedZoneDb& operator=(const MappedZoneDb&) = delete;
+
+    /**
+     * Verify the header and every record reachable from the registries, and
+     * the letter index of every ZoneRule, so that the brokers never read
+     * outside of [data, data + size).
+     */
+    static bool isValid(const uint8_t* data, size_t size);
+
+    /**
+     * Return the target of the self-relative offset at 'field' if the
+     * 'recordSize' bytes starting there are within the database, otherwise
+     * nullptr. A null offset is also returned as nullptr.
+     */
+    static const uint8_t* resolve(const uint8_t* data, size_t size,
+        const uint8_t* field, size_t recordSize);
+
+    /** Return true if the NUL terminated string at s is within the database. */
+    static bool isValidString(const uint8_t* data, size_t size,
+        const uint8_t* s);
+
+    static bool isValidZoneInfo(const uint8_t* data, size_t size,
+        const uint8_t* zoneInfo);
+
+    static bool isValidZonePolicy(const uint8_t* data, size_t size,
+        const uint8_t* zonePolicy);
+
+    const uint8_t* mData = nullptr;
+    size_t mSize = 0;
+
+    /** True if mData was mapped by openFile() and must be unmapped. */
+    bool mIsMapped = false;
+};
+
+}
+
+#endif
@@ -5,12 +5,15 @@
 
 #include "common/util.h"
 #include "common/DateStrings.h"
+#include "common/BufferWriter.h"
+#include "internal/Iso8601.h"
 #include "LocalDateTime.h"
 #include "OffsetDateTime.h"
 
 namespace ace_time {
 
 using common::printPad2;
+using common::BufferWriter;
 
 void OffsetDateTime::printTo(Print& printer) const {
   if (isError()) {
@@ -25,6 +28,58 @@ void OffsetDateTime::printTo(Print& printer) const {
   mTimeOffset.printTo(printer);
 }
 
+size_t OffsetDateTime::formatTo(char* buf, size_t len) const {
+  BufferWriter writer(buf, len);
+  formatTo(writer);
+  return writer.finish();
+}
+
+void OffsetDateTime::formatTo(BufferWriter& writer) const {
+  if (isError()) {
+    writer.writeString(F("<Invalid OffsetDateTime>"));
+    return;
+  }
+
+  mLocalDateTime.formatTo(writer);
+  mTimeOffset.formatTo(writer);
+}
+
+size_t OffsetDateTime::formatTo(const OffsetDateTime* odts, size_t n,
+    char* buf, size_t len, char separator) {
+  BufferWriter writer(buf, len);
+  for (size_t i = 0; i < n && ! writer.isOverflow(); i++) {
+    odts[i].formatTo(writer);
+    writer.writeChar(separator);
+  }
+  return writer.finish();
+}
+
+void OffsetDateTime::forEpochSeconds(const acetime_t* epochSeconds,
+    const TimeOffset* timeOffsets, OffsetDateTime* odts, size_t n) {
+  acetime_t prevDays = LocalDate::kInvalidEpochDays;
+  LocalDate ld;
+  for (size_t i = 0; i < n; i++) {
+    acetime_t seconds = epochSeconds[i];
+    TimeOffset timeOffset = timeOffsets[i];
+    if (seconds == LocalDate::kInvalidEpochSeconds) {
+      odts[i] = forEpochSeconds(seconds, timeOffset);
+      continue;
+    }
+
+    // Same floor-division as LocalDateTime::forEpochSeconds().
+    seconds += timeOffset.toSeconds();
+    acetime_t days = (seconds < 0)
+        ? (seconds + 1) / 86400 - 1
+        : seconds / 86400;
+    if (days != prevDays) {
+      ld = LocalDate::forEpochDays(days);
+      prevDays = days;
+    }
+    LocalTime lt = LocalTime::forSeconds(seconds - 86400 * days);
+    odts[i] = OffsetDateTime(LocalDateTime(ld, lt), timeOffset);
+  }
+}
+
 OffsetDateTime OffsetDateTime::forDateString(const char* dateString) {
   if (strlen(dateString) < kDateStringLength) {
     return forError();
@@ -42,4 +97,21 @@ OffsetDateTime OffsetDateTime::forDateStringChainable(const char*& dateString) {
   return OffsetDateTime(ldt, offset);
 }
 
+OffsetDateTime OffsetDateTime::forIso8601(const char* s, size_t len) {
+  iso8601::DateTimeFields fields;
+  size_t consumed = iso8601::parseDateTime(s, len, fields);
+  if (consumed == 0 || consumed != len) return forError();
+  if (! fields.hasOffset || fields.offsetMinutes % 15 != 0) return forError();
+  return forComponents(fields.year, fields.month, fields.day, fields.hour,
+      fields.minute, fields.second,
+      TimeOffset::forMinutes(fields.offsetMinutes));
+}
+
+void OffsetDateTime::forIso8601(const char* const* strings,
+    const size_t* lengths, OffsetDateTime* odts, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    odts[i] = forIso8601(strings[i], lengths[i]);
+  }
+}
+
 }
@@ -7,6 +7,8 @@
 #define ACE_TIME_OFFSET_DATE_TIME_H
 
 #include <stdint.h>
+#include <stddef.h> // size_t
+#include "common/compat.h" // strncpy_P(), strlen()
 #include "TimeOffset.h"
 #include "LocalDateTime.h"
 
@@ -14,6 +16,10 @@ class Print;
 
 namespace ace_time {
 
+namespace common {
+class BufferWriter;
+}
+
 /**
  * The date (year, month, day), time (hour, minute, second) and
  * offset from UTC (timeOffset). The dayOfWeek (1=Monday, 7=Sunday, per ISO
@@ -24,7 +30,9 @@ namespace ace_time {
  * indicate an error condition. If the year is restricted to the range 00-99,
  * these fields map directly to the fields supported by the DS3231 RTC chip.
  * The "epoch" for this library is 2000-01-01T00:00:00Z and toEpochSeconds()
- * returns a int32_t number of seconds offset from that epoch.
+ * returns a int32_t number of seconds offset from that epoch. If
+ * ACE_TIME_EPOCH_SECONDS_64 is enabled, the year is an int16_t in the range
+ * [1, 9999] and toEpochSeconds() returns an int64_t.
  *
  * Parts of this class were inspired by the java.time.OffsetDateTime class of
  * Java 11
@@ -42,7 +50,7 @@ class OffsetDateTime {
     /**
      * Factory method using separated date, time, and UTC offset fields.
      *
-     * @param year [1873-2127] @param month month with January=1, December=12
+     * @param year [LocalDate::kMinYear, LocalDate::kMaxYear] @param month month with January=1, December=12
      * @param day day of month [1-31] @param hour hour [0-23] @param minute
      * minute [0-59] @param second second [0-59], does not support leap seconds
      * @param timeOffset the time offset from UTC. Using TimeOffset in the last
@@ -77,6 +85,17 @@ class OffsetDateTime {
       return OffsetDateTime(ldt, timeOffset);
     }
 
+    /**
+     * Batch version of forEpochSeconds(). Fill the 'odts' array with the
+     * OffsetDateTime of each of the 'n' elements of 'epochSeconds', using the
+     * corresponding element of 'timeOffsets' (e.g. from
+     * TimeZone::getUtcOffsets()). The year, month and day are recalculated
+     * only when the local date changes from the previous element, so sorted
+     * input avoids most of the cost of LocalDate::forEpochDays().
+     */
+    static void forEpochSeconds(const acetime_t* epochSeconds,
+        const TimeOffset* timeOffsets, OffsetDateTime* odts, size_t n);
+
     /**
      * Factory method that takes the number of seconds since Unix Epoch of
      * 1970-01-01. Similar to forEpochSeconds(), the seconds corresponding to
@@ -142,6 +161,25 @@ class OffsetDateTime {
       return forDateString(buffer);
     }
 
+    /**
+     * Factory method. Create an OffsetDateTime from an ISO 8601 date-time
+     * string of the given length, which does not need to be NUL-terminated,
+     * in any of the forms accepted by iso8601::parseDateTime() (e.g.
+     * "2018-08-31T13:48:01-07:00", "2018-08-31 20:48:01.250Z",
+     * "20180831T134801-0700"). The UTC offset is required and must be a
+     * multiple of 15 minutes, the fraction of the second is truncated, and the
+     * string must not contain anything else. Returns OffsetDateTime::forError()
+     * if a parsing error occurs.
+     */
+    static OffsetDateTime forIso8601(const char* s, size_t len);
+
+    /**
+     * Batch version of forIso8601(), which parses the n strings given by the
+     * pointers and lengths into odts.
+     */
+    static void forIso8601(const char* const* strings, const size_t* lengths,
+        OffsetDateTime* odts, size_t n);
+
     /** Factory method that returns an instance whose isError() is true. */
     static OffsetDateTime forError() {
       return OffsetDateTime(LocalDateTime::forError(), TimeOffset::forError());
@@ -290,6 +328,28 @@ class OffsetDateTime {
      */
     void printTo(Print& printer) const;
 
+    /**
+     * Write the same characters as printTo() (e.g.
+     * "2018-08-31T13:48:01-07:00") into the buffer of size len, terminated by
+     * NUL, without going through a Print object. Return the number of
+     * characters written, or 0 if the buffer is too small, leaving an empty
+     * string.
+     */
+    size_t formatTo(char* buf, size_t len) const;
+
+    /** Write the same characters as formatTo(char*, size_t) into writer. */
+    void formatTo(common::BufferWriter& writer) const;
+
+    /**
+     * Batch version of formatTo(), which writes the n OffsetDateTime objects
+     * into the buffer of size len, each one followed by the separator, and
+     * terminated by NUL. Return the total number of characters written, or 0
+     * if the buffer is too small, leaving an empty string. A buffer of
+     * n * (25 + 1) + 1 characters is enough.
+     */
+    static size_t formatTo(const OffsetDateTime* odts, size_t n, char* buf,
+        size_t len, char separator = '\n');
+
     // Use default copy constructor and assignment operator.
     OffsetDateTime(const OffsetDateTime&) = default;
     OffsetDateTime& operator=(const OffsetDateTime&) = default;
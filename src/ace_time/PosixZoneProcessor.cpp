@@ -0,0 +1,100 @@
+/*
+ * MIT License
+ * Copyright (c) 2019 Brian T. Park
+ */
+
+#include <Print.h>
+#include "LocalDate.h"
+#include "PosixZoneProcessor.h"
+
+namespace ace_time {
+
+/** Convert seconds into a 15-minute offsetCode, truncating toward zero. */
+static int8_t toOffsetCode(int32_t seconds) {
+  return (int8_t) (seconds / 900);
+}
+
+/** Return the epochSeconds of Jan 1 of the year, saturated to acetime_t. */
+static acetime_t yearStartSeconds(int16_t year) {
+  // The epochDays of a year outside of LocalDate is kInvalidEpochDays, which
+  // overflows when multiplied.
+  if (year < LocalDate::kMinYear) return ACETIME_T_MIN + 1;
+  if (year > LocalDate::kMaxYear) return ACETIME_T_MAX;
+  int64_t seconds = (int64_t) LocalDate::forComponents(year, 1, 1)
+      .toEpochDays() * 86400;
+  if (seconds > ACETIME_T_MAX) return ACETIME_T_MAX;
+  if (seconds <= ACETIME_T_MIN) return ACETIME_T_MIN + 1;
+  return (acetime_t) seconds;
+}
+
+void PosixZoneProcessor::printTo(Print& printer) const {
+  mTzSpec.printTo(printer);
+}
+
+void PosixZoneProcessor::printShortTo(Print& printer) const {
+  if (isError()) {
+    printer.print("<Error>");
+    return;
+  }
+  printer.print(mTzSpec.stdAbbrev());
+  if (mTzSpec.hasDst()) {
+    printer.print('/');
+    printer.print(mTzSpec.dstAbbrev());
+  }
+}
+
+const PrecomputedZone& PosixZoneProcessor::findZone(acetime_t seconds) const {
+  int16_t year = LocalDate::forEpochSeconds(seconds).year();
+  if (year == mYear) {
+    statsHit();
+    return mZone;
+  }
+  uint16_t startMicros = statsRebuildStart();
+
+  mYear = year;
+  mNumEntries = 0;
+  mAbbrevs[0] = mTzSpec.stdAbbrev();
+  mAbbrevs[1] = mTzSpec.dstAbbrev();
+
+  // The initial entry is the opposite of the first transition, which is in
+  // the previous year, so it is never used for the requested year.
+  posix::Transition transitions[posix::TzSpec::kMaxTransitions];
+  uint8_t numTransitions = mTzSpec.getTransitions(year, transitions);
+  addEntry(ACETIME_T_MIN + 1, numTransitions > 0 && ! transitions[0].isDst);
+  for (uint8_t i = 0; i < numTransitions; i++) {
+    addEntry(transitions[i].epochSeconds, transitions[i].isDst);
+  }
+
+  mZone = PrecomputedZone(nullptr, yearStartSeconds(year),
+      yearStartSeconds(year + 1), mNumEntries, mStartEpochSeconds,
+      mOffsetCodes, mDeltaCodes, mAbbrevIndexes, mAbbrevs);
+  statsRebuildEnd(startMicros);
+  return mZone;
+}
+
+void PosixZoneProcessor::addEntry(acetime_t startSeconds, bool isDst) const {
+  int8_t offsetCode = toOffsetCode(mTzSpec.stdOffsetSeconds());
+  int8_t deltaCode = isDst
+      ? toOffsetCode(mTzSpec.dstOffsetSeconds()) - offsetCode : 0;
+  uint8_t abbrevIndex = isDst ? 1 : 0;
+
+  if (mNumEntries > 0 && mStartEpochSeconds[mNumEntries - 1] == startSeconds) {
+    mNumEntries--;
+  }
+  if (mNumEntries > 0) {
+    uint8_t last = mNumEntries - 1;
+    if (mOffsetCodes[last] == offsetCode
+        && mDeltaCodes[last] == deltaCode
+        && mAbbrevIndexes[last] == abbrevIndex) {
+      return;
+    }
+  }
+
+  mStartEpochSeconds[mNumEntries] = startSeconds;
+  mOffsetCodes[mNumEntries] = offsetCode;
+  mDeltaCodes[mNumEntries] = deltaCode;
+  mAbbrevIndexes[mNumEntries] = abbrevIndex;
+  mNumEntries++;
+}
+
+}
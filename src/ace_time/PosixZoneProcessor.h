@@ -0,0 +1,156 @@
+/*
+ * MIT License
+ * Copyright (c) 2019 Brian T. Park
+ */
+
+#ifndef ACE_TIME_POSIX_ZONE_PROCESSOR_H
+#define ACE_TIME_POSIX_ZONE_PROCESSOR_H
+
+#include <stdint.h>
+#include "common/common.h"
+#include "internal/PosixTz.h"
+#include "TimeOffset.h"
+#include "LocalDateTime.h"
+#include "OffsetDateTime.h"
+#include "ResolvedDateTime.h"
+#include "ZoneProcessor.h"
+#include "PrecomputedZone.h"
+
+class PosixZoneProcessorTest_findZone;
+
+namespace ace_time {
+
+/**
+ * An implementation of ZoneProcessor for a POSIX TZ string (e.g.
+ * "PST8PDT,M3.2.0,M11.1.0"), as found in the TZ environment variable of
+ * embedded and container deployments, instead of a ZoneInfo from the TZ
+ * Database. The string is parsed once by posix::TzSpec, and the transitions
+ * of the 3 years around the requested year are calculated in closed form,
+ * then cached and searched through PrecomputedZone, like the footer of
+ * TzifZoneProcessor. Only the current rules of the zone are known, so the
+ * same rules are applied to every year.
+ *
+ * A PosixZoneProcessor does not allocate memory, and is small enough (less
+ * than 200 bytes) to be used on an AVR. Use
+ * TimeZone::forPosixZone() to create a TimeZone of type kTypePosix.
+ *
+ * Not thread-safe.
+ */
+class PosixZoneProcessor: public ZoneProcessor {
+  public:
+    /**
+     * Constructor.
+     * @param tz the POSIX TZ string, parsed by setPosixTz(). Can be nullptr
+     * which leaves the processor in the isError() state.
+     */
+    explicit PosixZoneProcessor(const char* tz = nullptr):
+        ZoneProcessor(kTypePosix) {
+      if (tz) setPosixTz(tz);
+    }
+
+    /**
+     * Parse the POSIX TZ string, which does not need to remain valid
+     * afterwards. Return false, and set isError(), if it is invalid.
+     */
+    bool setPosixTz(const char* tz) {
+      mYear = 0;
+      return mTzSpec.parse(tz);
+    }
+
+    /** Return true if the TZ string is missing or invalid. */
+    bool isError() const { return mTzSpec.isError(); }
+
+    /** Return the parsed TZ string. */
+    const posix::TzSpec& getTzSpec() const { return mTzSpec; }
+
+    /** Always nullptr, there is no ZoneInfo. */
+    const void* getZoneInfo() const override { return nullptr; }
+
+    /** Always 0, a TZ string has no zoneId. */
+    uint32_t getZoneId() const override { return 0; }
+
+    TimeOffset getUtcOffset(acetime_t epochSeconds) const override {
+      if (isError()) return TimeOffset::forError();
+      return findZone(epochSeconds).getUtcOffset(epochSeconds);
+    }
+
+    TimeOffset getDeltaOffset(acetime_t epochSeconds) const override {
+      if (isError()) return TimeOffset::forError();
+      return findZone(epochSeconds).getDeltaOffset(epochSeconds);
+    }
+
+    const char* getAbbrev(acetime_t epochSeconds) const override {
+      if (isError()) return "";
+      return findZone(epochSeconds).getAbbrev(epochSeconds);
+    }
+
+    /**
+     * Return the OffsetDateTime for the given LocalDateTime, using the same
+     * rules as ExtendedZoneProcessor::getOffsetDateTime() for a LocalDateTime
+     * in a DST gap or overlap.
+     */
+    OffsetDateTime getOffsetDateTime(const LocalDateTime& ldt) const override {
+      if (ldt.isError() || isError()) return OffsetDateTime::forError();
+      return findZone(ldt.toEpochSeconds()).getOffsetDateTime(ldt);
+    }
+
+    ResolvedDateTime resolveLocalDateTime(const LocalDateTime& ldt,
+        uint8_t policy) const override {
+      if (ldt.isError() || isError()) return ResolvedDateTime::forError();
+      return findZone(ldt.toEpochSeconds()).resolveLocalDateTime(ldt, policy);
+    }
+
+    /** Print the TZ string (e.g. "PST8PDT,M3.2.0,M11.1.0"). */
+    void printTo(Print& printer) const override;
+
+    /** Print the abbreviations (e.g. "PST/PDT", or "PST" without DST). */
+    void printShortTo(Print& printer) const override;
+
+  private:
+    friend class ::PosixZoneProcessorTest_findZone;
+
+    /**
+     * Maximum number of entries of the cache: the initial entry, plus
+     * 2 transitions in each of 3 years.
+     */
+    static const uint8_t kMaxEntries = posix::TzSpec::kMaxTransitions + 1;
+
+    // Disable copy constructor and assignment operator.
+    PosixZoneProcessor(const PosixZoneProcessor&) = delete;
+    PosixZoneProcessor& operator=(const PosixZoneProcessor&) = delete;
+
+    bool equals(const ZoneProcessor& other) const override {
+      return mTzSpec == ((const PosixZoneProcessor&) other).mTzSpec;
+    }
+
+    /** There is no ZoneInfo, so this does nothing. */
+    void setZoneInfo(const void* /*zoneInfo*/) override {}
+
+    /**
+     * Return the transitions of the year of the given seconds (UTC or
+     * wall clock), calculating them if the year is not in the cache.
+     */
+    const PrecomputedZone& findZone(acetime_t seconds) const;
+
+    /**
+     * Append an entry to the cache, replacing the last entry if it starts at
+     * the same time, and skipping it if it does not change the offsets.
+     */
+    void addEntry(acetime_t startSeconds, bool isDst) const;
+
+    posix::TzSpec mTzSpec;
+
+    /** The transitions of the 3 years around mYear, 0 if empty. */
+    mutable PrecomputedZone mZone;
+    mutable int16_t mYear = 0;
+    mutable acetime_t mStartEpochSeconds[kMaxEntries];
+    mutable int8_t mOffsetCodes[kMaxEntries];
+    mutable int8_t mDeltaCodes[kMaxEntries];
+    mutable uint8_t mAbbrevIndexes[kMaxEntries];
+    mutable uint8_t mNumEntries = 0;
+    mutable const char* mAbbrevs[2];
+};
+
+}
+
+#endif
@@ -0,0 +1,296 @@
+/*
+ * MIT License
+ * Copyright (c) 2019 Brian T. Park
+ */
+
+#ifndef ACE_TIME_PRECOMPUTED_ZONE_H
+#define ACE_TIME_PRECOMPUTED_ZONE_H
+
+#include <stdint.h>
+#include <stddef.h> // size_t
+#include "common/compat.h"
+#include "common/common.h"
+#include "internal/ZoneInfo.h"
+#include "TimeOffset.h"
+#include "LocalDateTime.h"
+#include "OffsetDateTime.h"
+#include "ResolvedDateTime.h"
+
+namespace ace_time {
+
+/**
+ * A read-only view of a table of the UTC offsets of an extended::ZoneInfo,
+ * sorted by the epochSeconds at which each entry starts. All query methods are
+ * pure const functions which perform a binary search on the table, so there
+ * is no init() step, no hidden state, and a PrecomputedZone can be used by
+ * multiple threads concurrently.
+ *
+ * The columns of the table are const arrays which are not owned by this
+ * object. They are normally generated at build time by
+ * tools/PrecomputedGenerator for a fixed set of zones (e.g.
+ * zonedbx::precomputed::kZoneAmerica_Los_Angeles), so that the table lives in
+ * the read-only data segment, and the constructor is constexpr so that the
+ * PrecomputedZone itself is initialized at compile time. The CompiledZone
+ * subclass fills its own copy of the columns at run time instead.
+ *
+ * The columns are read directly, not through PROGMEM helpers, so on AVR the
+ * generated tables would be copied into RAM. They are intended for Linux,
+ * MacOS, or the larger 32-bit microcontrollers.
+ *
+ * Queries outside of [getStartSeconds(), getUntilSeconds()) return an error
+ * (e.g. TimeOffset::forError()).
+ */
+class PrecomputedZone {
+  public:
+    /** Constructor for an empty table, whose isError() is true. */
+    constexpr PrecomputedZone():
+        mZoneInfo(nullptr),
+        mTableStartSeconds(0),
+        mTableUntilSeconds(0),
+        mNumEntries(0),
+        mStartEpochSeconds(nullptr),
+        mOffsetCodes(nullptr),
+        mDeltaCodes(nullptr),
+        mAbbrevIndexes(nullptr),
+        mAbbrevs(nullptr) {}
+
+    /**
+     * Constructor for the columns of a precomputed table.
+     *
+     * @param zoneInfo the extended::ZoneInfo of the table
+     * @param startSeconds start of the range of the table, inclusive
+     * @param untilSeconds end of the range of the table, exclusive
+     * @param numEntries number of entries in each column
+     * @param startEpochSeconds the epochSeconds when each entry starts,
+     *    sorted, the first one is in effect since before startSeconds
+     * @param offsetCodes the standard UTC offsetCode of each entry
+     * @param deltaCodes the DST offsetCode of each entry
+     * @param abbrevIndexes the index into abbrevs of each entry
+     * @param abbrevs the distinct abbreviations of the table
+     */
+    constexpr PrecomputedZone(const extended::ZoneInfo* zoneInfo,
+        acetime_t startSeconds, acetime_t untilSeconds, uint16_t numEntries,
+        const acetime_t* startEpochSeconds, const int8_t* offsetCodes,
+        const int8_t* deltaCodes, const uint8_t* abbrevIndexes,
+        const char* const* abbrevs):
+        mZoneInfo(zoneInfo),
+        mTableStartSeconds(startSeconds),
+        mTableUntilSeconds(untilSeconds),
+        mNumEntries(numEntries),
+        mStartEpochSeconds(startEpochSeconds),
+        mOffsetCodes(offsetCodes),
+        mDeltaCodes(deltaCodes),
+        mAbbrevIndexes(abbrevIndexes),
+        mAbbrevs(abbrevs) {}
+
+    /** Return true if the table is empty. */
+    bool isError() const { return mNumEntries == 0; }
+
+    /** Return the ZoneInfo of the table. */
+    const extended::ZoneInfo* getZoneInfo() const { return mZoneInfo; }
+
+    /** Return the start of the range of the table, inclusive. */
+    acetime_t getStartSeconds() const { return mTableStartSeconds; }
+
+    /** Return the end of the range of the table, exclusive. */
+    acetime_t getUntilSeconds() const { return mTableUntilSeconds; }
+
+    /** Return the number of entries in the table. */
+    uint16_t getNumEntries() const { return mNumEntries; }
+
+    /** Return the epochSeconds when entry i starts. */
+    acetime_t getEntryStartSeconds(uint16_t i) const {
+      return mStartEpochSeconds[i];
+    }
+
+    /** Return the standard UTC offsetCode of entry i. */
+    int8_t getEntryOffsetCode(uint16_t i) const { return mOffsetCodes[i]; }
+
+    /** Return the DST offsetCode of entry i. */
+    int8_t getEntryDeltaCode(uint16_t i) const { return mDeltaCodes[i]; }
+
+    /** Return the index of the abbreviation of entry i. */
+    uint8_t getEntryAbbrevIndex(uint16_t i) const { return mAbbrevIndexes[i]; }
+
+    /** Return true if the given seconds is within the range of the table. */
+    bool contains(acetime_t seconds) const {
+      return mNumEntries > 0
+          && mTableStartSeconds <= seconds
+          && seconds < mTableUntilSeconds;
+    }
+
+    /** Return the total UTC offset at epochSeconds, including DST offset. */
+    TimeOffset getUtcOffset(acetime_t epochSeconds) const {
+      if (! contains(epochSeconds)) return TimeOffset::forError();
+      uint16_t i = searchEntries(epochSeconds);
+      return TimeOffset::forOffsetCode(mOffsetCodes[i] + mDeltaCodes[i]);
+    }
+
+    /** Return the DST offset from the standard offset at epochSeconds. */
+    TimeOffset getDeltaOffset(acetime_t epochSeconds) const {
+      if (! contains(epochSeconds)) return TimeOffset::forError();
+      uint16_t i = searchEntries(epochSeconds);
+      return TimeOffset::forOffsetCode(mDeltaCodes[i]);
+    }
+
+    /**
+     * Return the time zone abbreviation at epochSeconds. Returns an empty
+     * string if epochSeconds is outside of the table.
+     */
+    const char* getAbbrev(acetime_t epochSeconds) const {
+      if (! contains(epochSeconds)) return "";
+      uint16_t i = searchEntries(epochSeconds);
+      return mAbbrevs[mAbbrevIndexes[i]];
+    }
+
+    /**
+     * Return the OffsetDateTime for the given LocalDateTime, using the same
+     * rules as ExtendedZoneProcessor::getOffsetDateTime() for a LocalDateTime
+     * in a DST gap or overlap. Returns an error if the LocalDateTime,
+     * treated as if it were UTC, is outside of the range of the table.
+     */
+    OffsetDateTime getOffsetDateTime(const LocalDateTime& ldt) const {
+      if (ldt.isError()) return OffsetDateTime::forError();
+
+      // Treat the LocalDateTime as if it were UTC to get the seconds of the
+      // wall clock, which is compared to the local start time of each entry.
+      acetime_t localSeconds = ldt.toEpochSeconds();
+      if (! contains(localSeconds)) return OffsetDateTime::forError();
+      uint16_t i = searchLocalEntries(localSeconds);
+
+      // Normalize the OffsetDateTime using the epochSeconds, the same way as
+      // ExtendedZoneProcessor. The search clamps to the first or last entry
+      // if the epochSeconds falls just outside of the table.
+      acetime_t epochSeconds = localSeconds - offsetSeconds(i);
+      uint16_t j = searchEntries(epochSeconds);
+      TimeOffset offset = TimeOffset::forOffsetCode(
+          mOffsetCodes[j] + mDeltaCodes[j]);
+      return OffsetDateTime::forEpochSeconds(epochSeconds, offset);
+    }
+
+    /**
+     * Resolve the given LocalDateTime using a single search of the table. See
+     * ZoneProcessor::resolveLocalDateTime(). Returns an error if the
+     * LocalDateTime, treated as if it were UTC, is outside of the range of the
+     * table.
+     */
+    ResolvedDateTime resolveLocalDateTime(const LocalDateTime& ldt,
+        uint8_t policy) const {
+      if (ldt.isError()) return ResolvedDateTime::forError();
+
+      acetime_t localSeconds = ldt.toEpochSeconds();
+      if (! contains(localSeconds)) return ResolvedDateTime::forError();
+      uint16_t i = searchLocalEntries(localSeconds);
+      TimeOffset offset = TimeOffset::forOffsetCode(
+          mOffsetCodes[i] + mDeltaCodes[i]);
+
+      // Overlap: the previous entry has not ended yet in its own offset.
+      if (i > 0) {
+        TimeOffset prevOffset = TimeOffset::forOffsetCode(
+            mOffsetCodes[i - 1] + mDeltaCodes[i - 1]);
+        if (localSeconds < mStartEpochSeconds[i] + prevOffset.toSeconds()) {
+          return ResolvedDateTime::forTransition(ldt, prevOffset, offset,
+              mStartEpochSeconds[i], policy);
+        }
+      }
+
+      // Gap: this entry has ended, but the next has not started.
+      if (i + 1 < mNumEntries
+          && localSeconds >= mStartEpochSeconds[i + 1] + offset.toSeconds()) {
+        TimeOffset nextOffset = TimeOffset::forOffsetCode(
+            mOffsetCodes[i + 1] + mDeltaCodes[i + 1]);
+        return ResolvedDateTime::forTransition(ldt, offset, nextOffset,
+            mStartEpochSeconds[i + 1], policy);
+      }
+
+      return ResolvedDateTime::forUnique(ldt, offset);
+    }
+
+    /**
+     * Batch version of getUtcOffset() which walks forward through the table
+     * from the entry of the previous element, so sorted input is processed
+     * in roughly constant time per element. Elements outside of the table
+     * are set to TimeOffset::forError().
+     */
+    void getUtcOffsets(const acetime_t* epochSeconds, TimeOffset* offsets,
+        size_t n) const {
+      uint16_t current = 0;
+      for (size_t i = 0; i < n; i++) {
+        acetime_t seconds = epochSeconds[i];
+        if (! contains(seconds)) {
+          offsets[i] = TimeOffset::forError();
+          continue;
+        }
+
+        // Restart from the beginning if the input went backwards.
+        if (mStartEpochSeconds[current] > seconds) current = 0;
+        while (current + 1 < mNumEntries
+            && mStartEpochSeconds[current + 1] <= seconds) {
+          current++;
+        }
+        offsets[i] = TimeOffset::forOffsetCode(
+            mOffsetCodes[current] + mDeltaCodes[current]);
+      }
+    }
+
+  protected:
+    /** Return the total UTC offset of entry i in seconds. */
+    acetime_t offsetSeconds(uint16_t i) const {
+      return (acetime_t) 900 * (mOffsetCodes[i] + mDeltaCodes[i]);
+    }
+
+    /**
+     * Return the index of the last entry which starts at or before
+     * epochSeconds. The first entry is in effect since before
+     * mTableStartSeconds, so return 0 if epochSeconds is before all entries.
+     */
+    uint16_t searchEntries(acetime_t epochSeconds) const {
+      uint16_t base = 0;
+      uint16_t n = mNumEntries;
+      while (n > 1) {
+        uint16_t half = n / 2;
+        base = (mStartEpochSeconds[base + half] <= epochSeconds)
+            ? base + half : base;
+        n -= half;
+      }
+      return base;
+    }
+
+    /**
+     * Same as searchEntries() but keyed by the start time of each entry in
+     * the wall clock of its own UTC offset, expressed as if it were UTC. This
+     * is the equivalent of Transition.startDateTime.
+     */
+    uint16_t searchLocalEntries(acetime_t localSeconds) const {
+      uint16_t base = 0;
+      uint16_t n = mNumEntries;
+      while (n > 1) {
+        uint16_t half = n / 2;
+        uint16_t mid = base + half;
+        base = (mStartEpochSeconds[mid] + offsetSeconds(mid) <= localSeconds)
+            ? mid : base;
+        n -= half;
+      }
+      return base;
+    }
+
+    const extended::ZoneInfo* mZoneInfo;
+
+    /** Start of the range covered by the table, inclusive. */
+    acetime_t mTableStartSeconds;
+
+    /** End of the range covered by the table, exclusive. */
+    acetime_t mTableUntilSeconds;
+
+    uint16_t mNumEntries;
+
+    const acetime_t* mStartEpochSeconds;
+    const int8_t* mOffsetCodes;
+    const int8_t* mDeltaCodes;
+    const uint8_t* mAbbrevIndexes;
+    const char* const* mAbbrevs;
+};
+
+}
+
+#endif
@@ -0,0 +1,150 @@
+/*
+ * MIT License
+ * Copyright (c) 2019 Brian T. Park
+ */
+
+#ifndef ACE_TIME_RESOLVED_DATE_TIME_H
+#define ACE_TIME_RESOLVED_DATE_TIME_H
+
+#include <stdint.h>
+#include "common/common.h"
+#include "TimeOffset.h"
+#include "LocalDateTime.h"
+#include "OffsetDateTime.h"
+
+namespace ace_time {
+
+/**
+ * The result of ZoneProcessor::resolveLocalDateTime() or
+ * TimeZone::resolveLocalDateTime(), which converts a LocalDateTime to an
+ * OffsetDateTime using an explicit policy for a LocalDateTime which falls in
+ * a DST gap (the local time does not exist) or a DST overlap (the local time
+ * occurs twice).
+ *
+ * The 'type' tells the caller which case happened, and 'earlierOffset' and
+ * 'laterOffset' are the UTC offsets before and after the transition, so that
+ * the caller can make its own decision without another lookup. For a unique
+ * LocalDateTime, both offsets are the same.
+ *
+ * For a LocalDateTime in a gap (e.g. 02:30 in America/Los_Angeles when 02:00
+ * becomes 03:00), the policies give:
+ *
+ *    * kPolicyEarlier: 01:30-08:00, the local time shifted backward by the
+ *      size of the gap, using the earlier offset
+ *    * kPolicyLater: 03:30-07:00, the local time shifted forward by the size
+ *      of the gap, using the later offset
+ *    * kPolicyReject: OffsetDateTime::forError()
+ *    * kPolicyShiftForward: 03:00-07:00, the first valid time after the gap
+ *
+ * For a LocalDateTime in an overlap (e.g. 01:30 in America/Los_Angeles when
+ * 02:00 becomes 01:00), the policies give:
+ *
+ *    * kPolicyEarlier: 01:30-07:00, the first occurrence
+ *    * kPolicyLater: 01:30-08:00, the second occurrence
+ *    * kPolicyReject: OffsetDateTime::forError()
+ *    * kPolicyShiftForward: same as kPolicyLater
+ */
+struct ResolvedDateTime {
+  /** The LocalDateTime could not be resolved (e.g. out of range). */
+  static const uint8_t kTypeError = 0;
+
+  /** The LocalDateTime has a single UTC offset. */
+  static const uint8_t kTypeUnique = 1;
+
+  /** The LocalDateTime falls in a DST gap and does not exist. */
+  static const uint8_t kTypeGap = 2;
+
+  /** The LocalDateTime falls in a DST overlap and occurs twice. */
+  static const uint8_t kTypeOverlap = 3;
+
+  /** Use the earlier of the 2 candidates. */
+  static const uint8_t kPolicyEarlier = 0;
+
+  /** Use the later of the 2 candidates. */
+  static const uint8_t kPolicyLater = 1;
+
+  /** Return OffsetDateTime::forError() for a gap or an overlap. */
+  static const uint8_t kPolicyReject = 2;
+
+  /**
+   * Move a LocalDateTime in a gap to the end of the gap. Same as
+   * kPolicyLater for an overlap.
+   */
+  static const uint8_t kPolicyShiftForward = 3;
+
+  /** Return an instance whose type is kTypeError. */
+  static ResolvedDateTime forError() {
+    return {kTypeError, TimeOffset::forError(), TimeOffset::forError(),
+        OffsetDateTime::forError()};
+  }
+
+  /** Return an instance for a LocalDateTime which has a single offset. */
+  static ResolvedDateTime forUnique(const LocalDateTime& ldt,
+      TimeOffset offset) {
+    return {kTypeUnique, offset, offset,
+        OffsetDateTime::forLocalDateTimeAndOffset(ldt, offset)};
+  }
+
+  /**
+   * Return an instance for a LocalDateTime which is known to fall in the gap
+   * or the overlap of a transition, resolved using the given policy. A gap
+   * is a transition whose laterOffset is greater than its earlierOffset.
+   *
+   * @param ldt the local date time
+   * @param earlierOffset the UTC offset before the transition
+   * @param laterOffset the UTC offset after the transition
+   * @param transitionEpochSeconds the epochSeconds of the transition, used
+   *    by kPolicyShiftForward
+   * @param policy one of the kPolicyXxx constants
+   */
+  static ResolvedDateTime forTransition(const LocalDateTime& ldt,
+      TimeOffset earlierOffset, TimeOffset laterOffset,
+      acetime_t transitionEpochSeconds, uint8_t policy) {
+    bool isGap = laterOffset.toOffsetCode() > earlierOffset.toOffsetCode();
+    OffsetDateTime odt;
+    if (policy == kPolicyReject) {
+      odt = OffsetDateTime::forError();
+    } else if (! isGap) {
+      odt = OffsetDateTime::forLocalDateTimeAndOffset(ldt,
+          (policy == kPolicyEarlier) ? earlierOffset : laterOffset);
+    } else if (policy == kPolicyShiftForward) {
+      odt = OffsetDateTime::forEpochSeconds(
+          transitionEpochSeconds, laterOffset);
+    } else {
+      // Interpret the local time using the offset of the other side of the
+      // gap, so that the result lands on the requested side.
+      acetime_t localSeconds = ldt.toEpochSeconds();
+      if (policy == kPolicyEarlier) {
+        odt = OffsetDateTime::forEpochSeconds(
+            localSeconds - laterOffset.toSeconds(), earlierOffset);
+      } else {
+        odt = OffsetDateTime::forEpochSeconds(
+            localSeconds - earlierOffset.toSeconds(), laterOffset);
+      }
+    }
+    return {isGap ? kTypeGap : kTypeOverlap, earlierOffset, laterOffset, odt};
+  }
+
+  /** Return true if the LocalDateTime could not be resolved. */
+  bool isError() const { return type == kTypeError; }
+
+  /** One of kTypeError, kTypeUnique, kTypeGap, or kTypeOverlap. */
+  uint8_t type;
+
+  /** The UTC offset before the transition, or the unique offset. */
+  TimeOffset earlierOffset;
+
+  /** The UTC offset after the transition, or the unique offset. */
+  TimeOffset laterOffset;
+
+  /**
+   * The OffsetDateTime selected by the policy. OffsetDateTime::forError() if
+   * the type is kTypeError, or if kPolicyReject was used for a gap or an
+   * overlap.
+   */
+  OffsetDateTime odt;
+};
+
+}
+
+#endif
@@ -6,11 +6,13 @@
 #include <string.h> // strlen()
 #include "common/util.h"
 #include "common/DateStrings.h"
+#include "common/BufferWriter.h"
 #include "TimeOffset.h"
 
 namespace ace_time {
 
 using common::printPad2;
+using common::BufferWriter;
 
 void TimeOffset::printTo(Print& printer) const {
   int8_t hour;
@@ -29,6 +31,29 @@ void TimeOffset::printTo(Print& printer) const {
   common::printPad2(printer, minute);
 }
 
+size_t TimeOffset::formatTo(char* buf, size_t len) const {
+  BufferWriter writer(buf, len);
+  formatTo(writer);
+  return writer.finish();
+}
+
+void TimeOffset::formatTo(BufferWriter& writer) const {
+  int8_t hour;
+  int8_t minute;
+  toHourMinute(hour, minute);
+
+  if (mOffsetCode < 0) {
+    writer.writeChar('-');
+    hour = -hour;
+    minute = -minute;
+  } else {
+    writer.writeChar('+');
+  }
+  writer.writePad2(hour);
+  writer.writeChar(':');
+  writer.writePad2(minute);
+}
+
 TimeOffset TimeOffset::forOffsetString(const char* offsetString) {
   // verify exact ISO 8601 string length
   if (strlen(offsetString) != kTimeOffsetStringLength) {
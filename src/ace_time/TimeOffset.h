@@ -12,6 +12,10 @@ class Print;
 
 namespace ace_time {
 
+namespace common {
+class BufferWriter;
+}
+
 // These functions need to set the mOffsetCode and it seemed inefficient to go
 // through the factory method and assignment operator, so I expose
 // setOffsetCode() to them for efficiency. If the compiler is smart enough to
@@ -159,6 +163,16 @@ class TimeOffset {
     /** Print the human readable string. For example, "-08:00". */
     void printTo(Print& printer) const;
 
+    /**
+     * Write the same characters as printTo() (e.g. "-08:00") into the buffer
+     * of size len, terminated by NUL. Return the number of characters
+     * written, or 0 if the buffer is too small, leaving an empty string.
+     */
+    size_t formatTo(char* buf, size_t len) const;
+
+    /** Write the same characters as formatTo(char*, size_t) into writer. */
+    void formatTo(common::BufferWriter& writer) const;
+
     // Use default copy constructor and assignment operator.
     TimeOffset(const TimeOffset&) = default;
     TimeOffset& operator=(const TimeOffset&) = default;
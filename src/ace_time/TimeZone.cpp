@@ -5,10 +5,35 @@
 
 #include <Print.h>
 #include "common/util.h"
+#include "common/BufferWriter.h"
 #include "TimeZone.h"
 
 namespace ace_time {
 
+using common::BufferWriter;
+
+namespace {
+
+/**
+ * Adapts a BufferWriter to the Print interface, for the few strings which are
+ * generated only by a printTo() method (e.g. the POSIX TZ string).
+ */
+class BufferWriterPrint: public Print {
+  public:
+    explicit BufferWriterPrint(BufferWriter& writer):
+        mWriter(writer) {}
+
+    size_t write(uint8_t c) override {
+      mWriter.writeChar(c);
+      return 1;
+    }
+
+  private:
+    BufferWriter& mWriter;
+};
+
+}
+
 void TimeZone::printTo(Print& printer) const {
   switch (mType) {
     case kTypeManual:
@@ -21,6 +46,7 @@ void TimeZone::printTo(Print& printer) const {
       return;
     case kTypeBasic:
     case kTypeExtended:
+    case kTypePosix:
       mZoneProcessor->printTo(printer);
       return;
     case kTypeBasicManaged:
@@ -32,10 +58,49 @@ void TimeZone::printTo(Print& printer) const {
       processor->printTo(printer);
       return;
     }
+    case kTypeCompiled:
+      printer.print(ExtendedZone((const extended::ZoneInfo*) mZoneInfo).name());
+      return;
   }
   printer.print("<Error>");
 }
 
+size_t TimeZone::formatTo(char* buf, size_t len) const {
+  BufferWriter writer(buf, len);
+  formatTo(writer);
+  return writer.finish();
+}
+
+void TimeZone::formatTo(BufferWriter& writer) const {
+  switch (mType) {
+    case kTypeManual:
+      if (isUtc()) {
+        writer.writeString("UTC");
+      } else {
+        TimeOffset::forOffsetCode(mStdOffsetCode).formatTo(writer);
+        TimeOffset::forOffsetCode(mDstOffsetCode).formatTo(writer);
+      }
+      return;
+    case kTypeBasic:
+    case kTypeBasicManaged:
+      writer.writeString(BasicZone((const basic::ZoneInfo*) mZoneInfo).name());
+      return;
+    case kTypeExtended:
+    case kTypeExtendedManaged:
+    case kTypeCompiled:
+      writer.writeString(
+          ExtendedZone((const extended::ZoneInfo*) mZoneInfo).name());
+      return;
+    case kTypePosix:
+    {
+      BufferWriterPrint printer(writer);
+      mZoneProcessor->printTo(printer);
+      return;
+    }
+  }
+  writer.writeString("<Error>");
+}
+
 void TimeZone::printShortTo(Print& printer) const {
   switch (mType) {
     case kTypeManual:
@@ -52,6 +117,7 @@ void TimeZone::printShortTo(Print& printer) const {
       return;
     case kTypeBasic:
     case kTypeExtended:
+    case kTypePosix:
       mZoneProcessor->printShortTo(printer);
       return;
     case kTypeBasicManaged:
@@ -63,6 +129,10 @@ void TimeZone::printShortTo(Print& printer) const {
       processor->printShortTo(printer);
       return;
     }
+    case kTypeCompiled:
+      printer.print(
+          ExtendedZone((const extended::ZoneInfo*) mZoneInfo).shortName());
+      return;
   }
   printer.print("<Error>");
 }
@@ -78,6 +148,7 @@ void TimeZone::printAbbrevTo(Print& printer, acetime_t epochSeconds) const {
       return;
     case kTypeBasic:
     case kTypeExtended:
+    case kTypePosix:
       printer.print(mZoneProcessor->getAbbrev(epochSeconds));
       return;
     case kTypeBasicManaged:
@@ -89,8 +160,49 @@ void TimeZone::printAbbrevTo(Print& printer, acetime_t epochSeconds) const {
       printer.print(processor->getAbbrev(epochSeconds));
       return;
     }
+    case kTypeCompiled:
+      printer.print(mCompiledZone->getAbbrev(epochSeconds));
+      return;
   }
   printer.print("<Error>");
 }
 
+size_t TimeZone::formatAbbrevTo(char* buf, size_t len,
+    acetime_t epochSeconds) const {
+  BufferWriter writer(buf, len);
+  formatAbbrevTo(writer, epochSeconds);
+  return writer.finish();
+}
+
+void TimeZone::formatAbbrevTo(BufferWriter& writer, acetime_t epochSeconds)
+    const {
+  switch (mType) {
+    case kTypeManual:
+      if (isUtc()) {
+        writer.writeString("UTC");
+      } else {
+        writer.writeString((mDstOffsetCode != 0) ? "DST" : "STD");
+      }
+      return;
+    case kTypeBasic:
+    case kTypeExtended:
+    case kTypePosix:
+      writer.writeString(mZoneProcessor->getAbbrev(epochSeconds));
+      return;
+    case kTypeBasicManaged:
+    case kTypeExtendedManaged:
+    {
+      ZoneProcessor* processor =
+          mZoneProcessorCache->getZoneProcessor(mZoneInfo);
+      if (! processor) break;
+      writer.writeString(processor->getAbbrev(epochSeconds));
+      return;
+    }
+    case kTypeCompiled:
+      writer.writeString(mCompiledZone->getAbbrev(epochSeconds));
+      return;
+  }
+  writer.writeString("<Error>");
+}
+
 }
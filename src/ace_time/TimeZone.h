@@ -9,7 +9,12 @@
 #include <stdint.h>
 #include "TimeOffset.h"
 #include "ZoneProcessor.h"
+#include "ResolvedDateTime.h"
 #include "ZoneProcessorCache.h"
+#include "PrecomputedZone.h"
+#include "CompiledZone.h"
+#include "TzifZoneProcessor.h"
+#include "PosixZoneProcessor.h"
 #include "BasicZone.h"
 #include "ExtendedZone.h"
 #include "TimeZoneData.h"
@@ -18,6 +23,10 @@ class Print;
 
 namespace ace_time {
 
+namespace common {
+class BufferWriter;
+}
+
 template<typename ZI, typename ZR, typename ZSC> class ZoneManager;
 
 /**
@@ -29,7 +38,7 @@ template<typename ZI, typename ZR, typename ZSC> class ZoneManager;
  * source of these geographical regions is the TZ Database maintained by IANA
  * (https://www.iana.org/time-zones). The TimeZone class supports both meanings.
  *
- * There are 6 types of TimeZone:
+ * There are 8 types of TimeZone:
  *
  *    * kTypeError: represents an error or unknown time zone
  *    * kTypeManual: holds a base offset and a DST offset, and
@@ -43,6 +52,12 @@ template<typename ZI, typename ZR, typename ZSC> class ZoneManager;
  *      an internal cache of BasicZoneProcessors.
  *    * kTypeExtendedManaged: created through the ZoneManager which contains
  *      an internal cache of ExtendedZoneProcessors.
+ *    * kTypeCompiled: using an immutable PrecomputedZone or CompiledZone, so
+ *      that all methods are pure const functions which can be called
+ *      concurrently.
+ *    * kTypePosix: using an underlying PosixZoneProcessor which computes the
+ *      DST transitions of a POSIX TZ string (e.g. "PST8PDT,M3.2.0,M11.1.0"),
+ *      without a ZoneInfo.
  *
  * The TimeZone class should be treated as a const value type. (Except for
  * kTypeManual which is self-contained and allows the stdOffset and dstOffset
@@ -89,6 +104,8 @@ class TimeZone {
         ZoneProcessorCache::kTypeBasicManaged;
     static const uint8_t kTypeExtendedManaged =
         ZoneProcessorCache::kTypeExtendedManaged;
+    static const uint8_t kTypeCompiled = kTypeExtendedManaged + 1;
+    static const uint8_t kTypePosix = ZoneProcessor::kTypePosix;
 
     /** Factory method to create a UTC TimeZone. */
     static TimeZone forUtc() {
@@ -132,6 +149,68 @@ class TimeZone {
       return TimeZone(kTypeExtended, zoneInfo, zoneProcessor);
     }
 
+    /**
+     * Factory method to create from a zoneInfo and an associated
+     * TzifZoneProcessor, which reads the rules of the zone from the TZif file
+     * of the same name instead of the zoneInfo. The TimeZone is of type
+     * kTypeExtended. The ZoneInfo previously associated with the given
+     * zoneProcessor is overridden.
+     *
+     * @param zoneInfo an extended::ZoneInfo that identifies the zone
+     * @param zoneProcessor a pointer to a ZoneProcessor, cannot be nullptr
+     */
+    static TimeZone forZoneInfo(const extended::ZoneInfo* zoneInfo,
+        TzifZoneProcessor* zoneProcessor) {
+      return TimeZone(kTypeExtended, zoneInfo, zoneProcessor);
+    }
+
+    /**
+     * Factory method to create from a CompiledZone. Unlike the other types
+     * of TimeZone, the queries do not modify any state, so the TimeZone can
+     * be used by multiple threads concurrently. The CompiledZone must remain
+     * alive for as long as this TimeZone and its copies are used.
+     *
+     * @param compiledZone a pointer to a CompiledZone, cannot be nullptr.
+     * Returns TimeZone::forError() if compiledZone->isError() is true.
+     */
+    static TimeZone forCompiledZone(const CompiledZone* compiledZone) {
+      return forPrecomputedZone(compiledZone);
+    }
+
+    /**
+     * Factory method to create from a PrecomputedZone, normally one of the
+     * tables generated at build time (e.g.
+     * &zonedbx::precomputed::kZoneAmerica_Los_Angeles). The TimeZone is of
+     * type kTypeCompiled and behaves the same as one created by
+     * forCompiledZone().
+     *
+     * @param precomputedZone a pointer to a PrecomputedZone, cannot be
+     * nullptr. Returns TimeZone::forError() if precomputedZone->isError() is
+     * true.
+     */
+    static TimeZone forPrecomputedZone(
+        const PrecomputedZone* precomputedZone) {
+      return (precomputedZone->isError())
+          ? TimeZone(kTypeError)
+          : TimeZone(precomputedZone);
+    }
+
+    /**
+     * Factory method to create from a PosixZoneProcessor which holds a parsed
+     * POSIX TZ string (e.g. "PST8PDT,M3.2.0,M11.1.0"). The TimeZone is of
+     * type kTypePosix. The zoneProcessor must remain alive for as long as
+     * this TimeZone and its copies are used.
+     *
+     * @param zoneProcessor a pointer to a PosixZoneProcessor, cannot be
+     * nullptr. Returns TimeZone::forError() if zoneProcessor->isError() is
+     * true.
+     */
+    static TimeZone forPosixZone(PosixZoneProcessor* zoneProcessor) {
+      return (zoneProcessor->isError())
+          ? TimeZone(kTypeError)
+          : TimeZone(kTypePosix, nullptr, zoneProcessor);
+    }
+
     /**
      * Return a TimeZone representing an error condition. isError() returns
      * true for this instance.
@@ -164,19 +243,22 @@ class TimeZone {
 
     /**
      * Return the zoneId for kTypeBasic, kTypeExtended, kTypeBasicManaged,
-     * kTypeExtendedManaged. Returns 0 for kTypeManual. (It is not entirely
+     * kTypeExtendedManaged, kTypeCompiled. Returns 0 for kTypeManual and
+     * kTypePosix. (It is not entirely
      * clear that a valid zoneId is always > 0, but there is little I can do
      * without C++ exceptions.)
      */
     uint32_t getZoneId() const {
       switch (mType) {
         case kTypeManual:
+        case kTypePosix:
           return 0;
         case kTypeBasic:
         case kTypeBasicManaged:
           return BasicZone((const basic::ZoneInfo*) mZoneInfo).zoneId();
         case kTypeExtended:
         case kTypeExtendedManaged:
+        case kTypeCompiled:
           return ExtendedZone((const extended::ZoneInfo*) mZoneInfo).zoneId();
       }
       return 0;
@@ -194,6 +276,7 @@ class TimeZone {
           return TimeOffset::forOffsetCode(mStdOffsetCode + mDstOffsetCode);
         case kTypeBasic:
         case kTypeExtended:
+        case kTypePosix:
           mZoneProcessor->setZoneInfo(mZoneInfo);
           return mZoneProcessor->getUtcOffset(epochSeconds);
         case kTypeBasicManaged:
@@ -204,10 +287,52 @@ class TimeZone {
           if (! processor) break;
           return processor->getUtcOffset(epochSeconds);
         }
+        case kTypeCompiled:
+          return mCompiledZone->getUtcOffset(epochSeconds);
       }
       return TimeOffset::forError();
     }
 
+    /**
+     * Batch version of getUtcOffset(). Fill the 'offsets' array with the
+     * total UTC offset at each of the 'n' elements of 'epochSeconds'. The
+     * ZoneProcessor is resolved only once for the whole array, and sorted or
+     * nearly sorted input is processed by walking forward through the
+     * transitions instead of searching for each element.
+     */
+    void getUtcOffsets(const acetime_t* epochSeconds, TimeOffset* offsets,
+        size_t n) const {
+      const ZoneProcessor* processor = nullptr;
+      switch (mType) {
+        case kTypeManual:
+        {
+          TimeOffset offset = TimeOffset::forOffsetCode(
+              mStdOffsetCode + mDstOffsetCode);
+          for (size_t i = 0; i < n; i++) offsets[i] = offset;
+          return;
+        }
+        case kTypeBasic:
+        case kTypeExtended:
+        case kTypePosix:
+          mZoneProcessor->setZoneInfo(mZoneInfo);
+          processor = mZoneProcessor;
+          break;
+        case kTypeBasicManaged:
+        case kTypeExtendedManaged:
+          processor = mZoneProcessorCache->getZoneProcessor(mZoneInfo);
+          break;
+        case kTypeCompiled:
+          mCompiledZone->getUtcOffsets(epochSeconds, offsets, n);
+          return;
+      }
+
+      if (processor) {
+        processor->getUtcOffsets(epochSeconds, offsets, n);
+      } else {
+        for (size_t i = 0; i < n; i++) offsets[i] = TimeOffset::forError();
+      }
+    }
+
     /**
      * Return the DST offset from standard UTC offset at epochSeconds. This is
      * an experimental method that has not been tested thoroughly. Use with
@@ -219,6 +344,7 @@ class TimeZone {
           return TimeOffset::forOffsetCode(mDstOffsetCode);
         case kTypeBasic:
         case kTypeExtended:
+        case kTypePosix:
           mZoneProcessor->setZoneInfo(mZoneInfo);
           return mZoneProcessor->getDeltaOffset(epochSeconds);
         case kTypeBasicManaged:
@@ -229,6 +355,8 @@ class TimeZone {
           if (! processor) break;
           return processor->getDeltaOffset(epochSeconds);
         }
+        case kTypeCompiled:
+          return mCompiledZone->getDeltaOffset(epochSeconds);
       }
       return TimeOffset::forError();
     }
@@ -248,6 +376,7 @@ class TimeZone {
           break;
         case kTypeBasic:
         case kTypeExtended:
+        case kTypePosix:
           mZoneProcessor->setZoneInfo(mZoneInfo);
           odt = mZoneProcessor->getOffsetDateTime(ldt);
           break;
@@ -260,10 +389,49 @@ class TimeZone {
           odt = processor->getOffsetDateTime(ldt);
           break;
         }
+        case kTypeCompiled:
+          odt = mCompiledZone->getOffsetDateTime(ldt);
+          break;
       }
       return odt;
     }
 
+    /**
+     * Resolve the given LocalDateTime for the current TimeZone, using the
+     * given policy if it falls in a DST gap or overlap. See
+     * ZoneProcessor::resolveLocalDateTime() and ResolvedDateTime. A
+     * kTypeManual TimeZone has no transitions, so the result is always
+     * unique.
+     *
+     * @param ldt the local date time
+     * @param policy one of the ResolvedDateTime::kPolicyXxx constants
+     */
+    ResolvedDateTime resolveLocalDateTime(const LocalDateTime& ldt,
+        uint8_t policy) const {
+      switch (mType) {
+        case kTypeManual:
+          if (ldt.isError()) break;
+          return ResolvedDateTime::forUnique(ldt,
+              TimeOffset::forOffsetCode(mStdOffsetCode + mDstOffsetCode));
+        case kTypeBasic:
+        case kTypeExtended:
+        case kTypePosix:
+          mZoneProcessor->setZoneInfo(mZoneInfo);
+          return mZoneProcessor->resolveLocalDateTime(ldt, policy);
+        case kTypeBasicManaged:
+        case kTypeExtendedManaged:
+        {
+          ZoneProcessor* processor =
+              mZoneProcessorCache->getZoneProcessor(mZoneInfo);
+          if (! processor) break;
+          return processor->resolveLocalDateTime(ldt, policy);
+        }
+        case kTypeCompiled:
+          return mCompiledZone->resolveLocalDateTime(ldt, policy);
+      }
+      return ResolvedDateTime::forError();
+    }
+
     /** Return true if UTC (+00:00+00:00). */
     bool isUtc() const {
       if (mType != kTypeManual) return false;
@@ -304,7 +472,9 @@ class TimeZone {
      * Convert to a TimeZoneData object, which can be fed back into
      * ZoneManager::createForTimeZoneData() to recreate the TimeZone. All of
      * TimeZone::kTypeBasic, kTypeExtended, kTypeBasicManaged,
-     * kTypeExtendedManaged collapse into TimeZoneData::kTypeZoneId.
+     * kTypeExtendedManaged, kTypeCompiled collapse into
+     * TimeZoneData::kTypeZoneId. A kTypePosix has no zoneId, so it becomes
+     * TimeZoneData::kTypeError.
      */
     TimeZoneData toTimeZoneData() const {
       TimeZoneData d;
@@ -318,6 +488,7 @@ class TimeZone {
         case TimeZone::kTypeExtended:
         case TimeZone::kTypeBasicManaged:
         case TimeZone::kTypeExtendedManaged:
+        case TimeZone::kTypeCompiled:
           d.zoneId = getZoneId();
           d.type = TimeZoneData::kTypeZoneId;
           break;
@@ -332,8 +503,10 @@ class TimeZone {
      * Print the human readable representation of the time zone.
      *   * kTypeManual is printed as "+/-hh:mm+/-hh:mm" (e.g. "-08:00+00:00")
      *   * kTypeBasic is printed as "{zonename}" (e.g. "America/Los_Angeles")
-     *   * kTypeExtended is printed as "{zonename}" (e.g.
+     *   * kTypeExtended and kTypeCompiled are printed as "{zonename}" (e.g.
      *     "America/Los_Angeles")
+     *   * kTypePosix is printed as the TZ string (e.g.
+     *     "PST8PDT,M3.2.0,M11.1.0")
      */
     void printTo(Print& printer) const;
 
@@ -341,7 +514,9 @@ class TimeZone {
      * Print the *short* human readable representation of the time zone.
      *   * kTypeManual is printed as "+/-hh:mm(STD|DST)" (e.g. "-07:00(DST)")
      *   * kTypeBasic is printed as "{zoneShortName}" (e.g. "Los_Angeles")
-     *   * kTypeExtended is printed as "{zoneShortName}" (e.g. "Los_Angeles")
+     *   * kTypeExtended and kTypeCompiled are printed as "{zoneShortName}"
+     *     (e.g. "Los_Angeles")
+     *   * kTypePosix is printed as "{std}/{dst}" (e.g. "PST/PDT")
      */
     void printShortTo(Print& printer) const;
 
@@ -349,10 +524,37 @@ class TimeZone {
      * Print the time zone abbreviation for the given epochSeconds.
      *   * kTypeManual is printed as "STD" or "DST"
      *   * kTypeBasic is printed as "{abbrev}" (e.g. "PDT")
-     *   * kTypeExtended is printed as "{abbrev}" (e.g. "PDT")
+     *   * kTypeExtended, kTypeCompiled and kTypePosix are printed as
+     *     "{abbrev}" (e.g. "PDT")
      */
     void printAbbrevTo(Print& printer, acetime_t epochSeconds) const;
 
+    /**
+     * Write the same characters as printTo() into the buffer of size len,
+     * terminated by NUL. Return the number of characters written, or 0 if
+     * the buffer is too small, leaving an empty string. The zone name is
+     * copied directly from the ZoneInfo, without a Print object, except for
+     * kTypePosix which goes through PosixZoneProcessor::printTo().
+     */
+    size_t formatTo(char* buf, size_t len) const;
+
+    /** Write the same characters as formatTo(char*, size_t) into writer. */
+    void formatTo(common::BufferWriter& writer) const;
+
+    /**
+     * Write the same characters as printAbbrevTo() into the buffer of size
+     * len, terminated by NUL. Return the number of characters written, or 0
+     * if the buffer is too small, leaving an empty string.
+     */
+    size_t formatAbbrevTo(char* buf, size_t len, acetime_t epochSeconds) const;
+
+    /**
+     * Write the same characters as formatAbbrevTo(char*, size_t, acetime_t)
+     * into writer.
+     */
+    void formatAbbrevTo(common::BufferWriter& writer, acetime_t epochSeconds)
+        const;
+
     // Use default copy constructor and assignment operator.
     TimeZone(const TimeZone&) = default;
     TimeZone& operator=(const TimeZone&) = default;
@@ -392,7 +594,13 @@ class TimeZone {
     explicit TimeZone(uint8_t type):
       mType(type) {}
 
-    /** Constructor for kTypeBasic or kTypeExtended. */
+    /** Constructor for kTypeCompiled. */
+    explicit TimeZone(const PrecomputedZone* precomputedZone):
+        mType(kTypeCompiled),
+        mZoneInfo(precomputedZone->getZoneInfo()),
+        mCompiledZone(precomputedZone) {}
+
+    /** Constructor for kTypeBasic, kTypeExtended or kTypePosix. */
     explicit TimeZone(uint8_t type, const void* zoneInfo,
         ZoneProcessor* mZoneProcessor):
         mType(type),
@@ -401,11 +609,12 @@ class TimeZone {
 
     uint8_t mType;
 
-    // 4 combinations:
+    // 5 combinations:
     //   (type) (kTypeError)
     //   (type, mStdOffsetCode, mDstOffsetCode)
     //   (type, mZoneInfo, mZoneProcessor)
     //   (type, mZoneInfo, mZoneProcessorCache)
+    //   (type, mZoneInfo, mCompiledZone)
     union {
       /** Used by kTypeManual. */
       struct {
@@ -416,16 +625,20 @@ class TimeZone {
       struct {
         /**
          * Used by kTypeBasic, kTypeExtended, kTypeBasicManaged,
-         * kTypeExtendedManaged.
+         * kTypeExtendedManaged, kTypeCompiled. Always nullptr for
+         * kTypePosix.
          */
         const void* mZoneInfo;
 
         union {
-          /** Used by kTypeBasic, kTypeExtended. */
+          /** Used by kTypeBasic, kTypeExtended, kTypePosix. */
           ZoneProcessor* mZoneProcessor;
 
           /** Used by kTypeBasicManaged, kTypeExtendedManaged. */
           ZoneProcessorCache* mZoneProcessorCache;
+
+          /** Used by kTypeCompiled. */
+          const PrecomputedZone* mCompiledZone;
         };
       };
     };
@@ -443,7 +656,10 @@ inline bool operator==(const TimeZone& a, const TimeZone& b) {
     case TimeZone::kTypeExtended:
     case TimeZone::kTypeBasicManaged:
     case TimeZone::kTypeExtendedManaged:
+    case TimeZone::kTypeCompiled:
       return (a.mZoneInfo == b.mZoneInfo);
+    case TimeZone::kTypePosix:
+      return *a.mZoneProcessor == *b.mZoneProcessor;
     default:
       return false;
   }
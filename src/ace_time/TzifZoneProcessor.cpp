@@ -0,0 +1,359 @@
+/*
+ * MIT License
+ * Copyright (c) 2019 Brian T. Park
+ */
+
+#include <stdio.h> // snprintf()
+#include <string.h> // memcmp(), memcpy(), memchr()
+#include <Print.h>
+#include "LocalDate.h"
+#include "ExtendedZone.h"
+#include "TzifZoneProcessor.h"
+
+#if defined(__linux__) || defined(__APPLE__)
+  #include <fcntl.h> // open()
+  #include <unistd.h> // close()
+  #include <sys/mman.h> // mmap(), munmap()
+  #include <sys/stat.h> // fstat()
+  #define ACE_TIME_HAS_MMAP 1
+#else
+  #define ACE_TIME_HAS_MMAP 0
+#endif
+
+namespace ace_time {
+
+/** Size of the header of a TZif data block. */
+static const size_t kTzifHeaderSize = 44;
+
+/** Number of seconds from the Unix epoch to the AceTime epoch. */
+static const int64_t kSecondsSinceUnixEpoch = 946684800;
+
+/** Read a big-endian 32-bit integer. */
+static uint32_t readTzifUint32(const uint8_t* p) {
+  return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16)
+      | ((uint32_t) p[2] << 8) | p[3];
+}
+
+/**
+ * Read a big-endian transition time of timeSize (4 or 8) bytes, relative to
+ * the AceTime epoch.
+ */
+static int64_t readTzifTime(const uint8_t* p, size_t timeSize) {
+  int64_t unixSeconds = (timeSize == 4)
+      ? (int64_t) (int32_t) readTzifUint32(p)
+      : (int64_t) (((uint64_t) readTzifUint32(p) << 32)
+          | readTzifUint32(p + 4));
+  return unixSeconds - kSecondsSinceUnixEpoch;
+}
+
+/** Convert seconds into a 15-minute offsetCode, truncating toward zero. */
+static int8_t toOffsetCode(int32_t seconds) {
+  return (int8_t) (seconds / 900);
+}
+
+/** Return the epochSeconds of Jan 1 of the year, saturated to acetime_t. */
+static acetime_t yearStartSeconds(int16_t year) {
+  // The epochDays of a year outside of LocalDate is kInvalidEpochDays, which
+  // overflows when multiplied.
+  if (year < LocalDate::kMinYear) return ACETIME_T_MIN + 1;
+  if (year > LocalDate::kMaxYear) return ACETIME_T_MAX;
+  int64_t seconds = (int64_t) LocalDate::forComponents(year, 1, 1)
+      .toEpochDays() * 86400;
+  if (seconds > ACETIME_T_MAX) return ACETIME_T_MAX;
+  if (seconds <= ACETIME_T_MIN) return ACETIME_T_MIN + 1;
+  return (acetime_t) seconds;
+}
+
+void TzifZoneProcessor::printTo(Print& printer) const {
+  printer.print(ExtendedZone(mZoneInfo.zoneInfo()).name());
+}
+
+void TzifZoneProcessor::printShortTo(Print& printer) const {
+  printer.print(ExtendedZone(mZoneInfo.zoneInfo()).shortName());
+}
+
+bool TzifZoneProcessor::loadFile() const {
+  mTable = PrecomputedZone();
+  if (mZoneInfo.zoneInfo() == nullptr) return false;
+
+#if ACE_TIME_HAS_MMAP
+  char path[kMaxPathSize];
+  int len = snprintf(path, sizeof(path), "%s/%s", mZoneinfoDir,
+      mZoneInfo.name());
+  if (len < 0 || (size_t) len >= sizeof(path)) return false;
+
+  int fd = ::open(path, O_RDONLY);
+  if (fd < 0) return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    ::close(fd);
+    return false;
+  }
+  size_t size = (size_t) st.st_size;
+
+  // The file is parsed in place, then unmapped, so nothing is copied into
+  // the heap.
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) return false;
+
+  bool isValid = parseBuffer((const uint8_t*) data, size);
+  munmap(data, size);
+  return isValid;
+#else
+  return false;
+#endif
+}
+
+bool TzifZoneProcessor::loadBuffer(const uint8_t* data, size_t size) const {
+  mIsLoadAttempted = true;
+  mIsLoaded = parseBuffer(data, size);
+  return mIsLoaded;
+}
+
+bool TzifZoneProcessor::parseBuffer(const uint8_t* data, size_t size) const {
+  mTable = PrecomputedZone();
+  mFooter = posix::TzSpec();
+  mFooterStartSeconds = kMaxSeconds;
+  mFooterLocalStartSeconds = kMaxSeconds;
+  mFooterYear = 0;
+
+  if (data == nullptr || size < kTzifHeaderSize) return false;
+  if (memcmp(data, "TZif", 4) != 0) return false;
+  uint8_t version = data[4];
+  const uint8_t* end = data + size;
+  const uint8_t* header = data;
+
+  // Use the 64-bit data block of version 2 and above, which follows the
+  // 32-bit data block of version 1.
+  size_t timeSize = 4;
+  for (uint8_t block = 0; block < ((version >= '2') ? 2 : 1); block++) {
+    if ((size_t) (end - header) < kTzifHeaderSize) return false;
+    if (memcmp(header, "TZif", 4) != 0) return false;
+    timeSize = (block == 0) ? 4 : 8;
+
+    uint64_t isutCount = readTzifUint32(header + 20);
+    uint64_t isstdCount = readTzifUint32(header + 24);
+    uint64_t leapCount = readTzifUint32(header + 28);
+    uint64_t timeCount = readTzifUint32(header + 32);
+    uint64_t typeCount = readTzifUint32(header + 36);
+    uint64_t charCount = readTzifUint32(header + 40);
+    uint64_t blockSize = timeCount * timeSize + timeCount + typeCount * 6
+        + charCount + leapCount * (timeSize + 4) + isstdCount + isutCount;
+    if (blockSize > (uint64_t) (end - header) - kTzifHeaderSize) return false;
+
+    if (block == 0 && version >= '2') {
+      header += kTzifHeaderSize + blockSize;
+      continue;
+    }
+
+    // AceTime has no leap seconds.
+    if (leapCount != 0) return false;
+    if (typeCount == 0 || typeCount > kMaxTypes) return false;
+    if (charCount == 0 || charCount >= kMaxAbbrevChars) return false;
+    if (isutCount != 0 && isutCount != typeCount) return false;
+    if (isstdCount != 0 && isstdCount != typeCount) return false;
+
+    const uint8_t* times = header + kTzifHeaderSize;
+    const uint8_t* indexes = times + timeCount * timeSize;
+    const uint8_t* types = indexes + timeCount;
+    const uint8_t* chars = types + typeCount * 6;
+
+    // Validate the transitions and the local time types.
+    for (uint32_t i = 0; i < timeCount; i++) {
+      if (indexes[i] >= typeCount) return false;
+      if (i > 0 && readTzifTime(times + i * timeSize, timeSize)
+          <= readTzifTime(times + (i - 1) * timeSize, timeSize)) {
+        return false;
+      }
+    }
+    memcpy(mAbbrevChars, chars, charCount);
+    mAbbrevChars[charCount] = '\0';
+    for (uint8_t i = 0; i < typeCount; i++) {
+      const uint8_t* type = types + i * 6;
+      if (type[4] > 1 || type[5] >= charCount) return false;
+      mAbbrevs[i] = mAbbrevChars + type[5];
+    }
+
+    // The footer is a POSIX TZ string between 2 newlines.
+    if (version >= '2') {
+      const char* footer = (const char*) (chars + charCount
+          + leapCount * (timeSize + 4) + isstdCount + isutCount);
+      if (footer == (const char*) end || *footer != '\n') return false;
+      footer++;
+      const char* footerEnd = (const char*) memchr(footer, '\n',
+          (const char*) end - footer);
+      if (footerEnd == nullptr) return false;
+      if (footerEnd != footer && ! mFooter.parse(footer, footerEnd - footer)) {
+        return false;
+      }
+    }
+
+    // Keep the transitions which fit into acetime_t, dropping the earliest
+    // ones if there are too many. The initial entry holds the local time
+    // type in effect before the first kept transition, which is type 0
+    // before the first transition of the file.
+    uint32_t first = 0;
+    uint32_t last = timeCount;
+    while (first < timeCount
+        && readTzifTime(times + first * timeSize, timeSize) <= kMinSeconds) {
+      first++;
+    }
+    while (last > first
+        && readTzifTime(times + (last - 1) * timeSize, timeSize)
+            > kMaxSeconds) {
+      last--;
+    }
+    if (last - first > (uint32_t) kMaxTransitions - 1) {
+      first = last - (kMaxTransitions - 1);
+    }
+
+    uint16_t numEntries = 0;
+    mStartEpochSeconds[numEntries] = kMinSeconds;
+    mAbbrevIndexes[numEntries] = (first > 0) ? indexes[first - 1] : 0;
+    numEntries++;
+    for (uint32_t i = first; i < last; i++) {
+      if (indexes[i] == mAbbrevIndexes[numEntries - 1]) continue;
+      mStartEpochSeconds[numEntries] =
+          (acetime_t) readTzifTime(times + i * timeSize, timeSize);
+      mAbbrevIndexes[numEntries] = indexes[i];
+      numEntries++;
+    }
+
+    // TZif gives only the total UTC offset and the isdst flag, so the
+    // standard offset of a DST entry is taken from the nearest standard
+    // entry, preferring the previous one.
+    int32_t stdOffsetSeconds = mFooter.isError()
+        ? (int32_t) readTzifUint32(types + mAbbrevIndexes[0] * 6) - 3600
+        : mFooter.stdOffsetSeconds();
+    for (uint16_t i = 0; i < numEntries; i++) {
+      const uint8_t* type = types + mAbbrevIndexes[i] * 6;
+      if (! type[4]) {
+        stdOffsetSeconds = (int32_t) readTzifUint32(type);
+        break;
+      }
+    }
+    for (uint16_t i = 0; i < numEntries; i++) {
+      const uint8_t* type = types + mAbbrevIndexes[i] * 6;
+      int32_t offsetSeconds = (int32_t) readTzifUint32(type);
+      if (! type[4]) stdOffsetSeconds = offsetSeconds;
+      int8_t offsetCode = toOffsetCode(offsetSeconds);
+      int8_t stdOffsetCode = type[4]
+          ? toOffsetCode(stdOffsetSeconds) : offsetCode;
+      mOffsetCodes[i] = stdOffsetCode;
+      mDeltaCodes[i] = offsetCode - stdOffsetCode;
+    }
+
+    mTable = PrecomputedZone(mZoneInfo.zoneInfo(), kMinSeconds, kMaxSeconds,
+        numEntries, mStartEpochSeconds, mOffsetCodes, mDeltaCodes,
+        mAbbrevIndexes, mAbbrevs);
+
+    // The footer applies after the last transition of the file, unless
+    // some transitions are beyond the range of acetime_t.
+    if (! mFooter.isError() && last == timeCount) {
+      mFooterAbbrevs[kFooterAbbrevStd] = mFooter.stdAbbrev();
+      mFooterAbbrevs[kFooterAbbrevDst] = mFooter.dstAbbrev();
+      mFooterAbbrevs[kFooterAbbrevTable] =
+          mAbbrevs[mAbbrevIndexes[numEntries - 1]];
+      if (numEntries == 1) {
+        mFooterStartSeconds = kMinSeconds;
+        mFooterLocalStartSeconds = kMinSeconds;
+      } else {
+        acetime_t lastSeconds = mStartEpochSeconds[numEntries - 1];
+        int32_t maxOffsetSeconds = 900 * (int32_t) (
+            mOffsetCodes[numEntries - 1] + mDeltaCodes[numEntries - 1]);
+        int32_t prevOffsetSeconds = 900 * (int32_t) (
+            mOffsetCodes[numEntries - 2] + mDeltaCodes[numEntries - 2]);
+        if (prevOffsetSeconds > maxOffsetSeconds) {
+          maxOffsetSeconds = prevOffsetSeconds;
+        }
+        int64_t localSeconds = (int64_t) lastSeconds + maxOffsetSeconds;
+        mFooterStartSeconds = lastSeconds;
+        mFooterLocalStartSeconds = (localSeconds > kMaxSeconds)
+            ? kMaxSeconds : (acetime_t) localSeconds;
+      }
+    }
+  }
+  return true;
+}
+
+const PrecomputedZone& TzifZoneProcessor::findFooterZone(acetime_t seconds)
+    const {
+  if (mFooter.isError()) return mTable;
+
+  int16_t year = LocalDate::forEpochSeconds(seconds).year();
+  if (year == mFooterYear) {
+    statsHit();
+    return mFooterZone;
+  }
+  uint16_t startMicros = statsRebuildStart();
+
+  mFooterYear = year;
+  mNumFooterEntries = 0;
+  posix::Transition transitions[posix::TzSpec::kMaxTransitions];
+  uint8_t numTransitions = mFooter.getTransitions(year, transitions);
+  if (numTransitions == 0) {
+    addFooterEntry(kMinSeconds, false);
+  } else {
+    // Like localtime.c, the footer only adds transitions after the last
+    // transition of the file, whose local time type is in effect until the
+    // next one, even if the footer disagrees (e.g. a zone which skipped DST
+    // in the year of its last transition).
+    uint8_t i = 0;
+    if (transitions[0].epochSeconds <= mFooterStartSeconds) {
+      uint16_t last = mTable.getNumEntries() - 1;
+      addFooterEntry(kMinSeconds, mOffsetCodes[last], mDeltaCodes[last],
+          kFooterAbbrevTable);
+      while (i < numTransitions
+          && transitions[i].epochSeconds <= mFooterStartSeconds) {
+        i++;
+      }
+    } else {
+      addFooterEntry(kMinSeconds, ! transitions[0].isDst);
+    }
+    for (; i < numTransitions; i++) {
+      addFooterEntry(transitions[i].epochSeconds, transitions[i].isDst);
+    }
+  }
+
+  mFooterZone = PrecomputedZone(mZoneInfo.zoneInfo(), yearStartSeconds(year),
+      yearStartSeconds(year + 1), mNumFooterEntries, mFooterStartEpochSeconds,
+      mFooterOffsetCodes, mFooterDeltaCodes, mFooterAbbrevIndexes,
+      mFooterAbbrevs);
+  statsRebuildEnd(startMicros);
+  return mFooterZone;
+}
+
+void TzifZoneProcessor::addFooterEntry(acetime_t startSeconds, bool isDst)
+    const {
+  int8_t offsetCode = toOffsetCode(mFooter.stdOffsetSeconds());
+  int8_t deltaCode = isDst
+      ? toOffsetCode(mFooter.dstOffsetSeconds()) - offsetCode : 0;
+  addFooterEntry(startSeconds, offsetCode, deltaCode,
+      isDst ? kFooterAbbrevDst : kFooterAbbrevStd);
+}
+
+void TzifZoneProcessor::addFooterEntry(acetime_t startSeconds,
+    int8_t offsetCode, int8_t deltaCode, uint8_t abbrevIndex) const {
+  if (mNumFooterEntries > 0
+      && mFooterStartEpochSeconds[mNumFooterEntries - 1] == startSeconds) {
+    mNumFooterEntries--;
+  }
+  if (mNumFooterEntries > 0) {
+    uint8_t last = mNumFooterEntries - 1;
+    if (mFooterOffsetCodes[last] == offsetCode
+        && mFooterDeltaCodes[last] == deltaCode
+        && mFooterAbbrevIndexes[last] == abbrevIndex) {
+      return;
+    }
+  }
+
+  mFooterStartEpochSeconds[mNumFooterEntries] = startSeconds;
+  mFooterOffsetCodes[mNumFooterEntries] = offsetCode;
+  mFooterDeltaCodes[mNumFooterEntries] = deltaCode;
+  mFooterAbbrevIndexes[mNumFooterEntries] = abbrevIndex;
+  mNumFooterEntries++;
+}
+
+}
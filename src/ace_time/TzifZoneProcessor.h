@@ -0,0 +1,314 @@
+/*
+ * MIT License
+ * Copyright (c) 2019 Brian T. Park
+ */
+
+#ifndef ACE_TIME_TZIF_ZONE_PROCESSOR_H
+#define ACE_TIME_TZIF_ZONE_PROCESSOR_H
+
+#include <stdint.h>
+#include <stddef.h> // size_t
+#include "common/common.h"
+#include "internal/ZoneInfo.h"
+#include "internal/Brokers.h"
+#include "internal/PosixTz.h"
+#include "TimeOffset.h"
+#include "LocalDateTime.h"
+#include "OffsetDateTime.h"
+#include "ResolvedDateTime.h"
+#include "ZoneProcessor.h"
+#include "PrecomputedZone.h"
+
+/**
+ * Directory which contains the TZif files read by TzifZoneProcessor, normally
+ * the system zoneinfo directory.
+ */
+#ifndef ACE_TIME_TZIF_DIR
+#define ACE_TIME_TZIF_DIR "/usr/share/zoneinfo"
+#endif
+
+class TzifZoneProcessorTest_loadBuffer;
+class TzifZoneProcessorTest_loadBuffer_v1;
+class TzifZoneProcessorTest_loadBuffer_invalid;
+class TzifZoneProcessorTest_loadBuffer_truncated;
+class TzifZoneProcessorTest_footer;
+class TzifZoneProcessorTest_footer_only;
+
+namespace ace_time {
+
+/**
+ * An implementation of ZoneProcessor which reads the rules of the zone from
+ * the compiled TZif file (RFC 8536) of the same name in the zoneinfo
+ * directory of the operating system (e.g.
+ * /usr/share/zoneinfo/America/Los_Angeles), instead of calculating them from
+ * the zonedbx:: ZoneRules. The extended::ZoneInfo identifies the zone, and
+ * provides its name and zoneId, so this processor can be given to
+ * TimeZone::forZoneInfo() in place of an ExtendedZoneProcessor, or used
+ * through a TzifZoneManager, with the same zonedbx:: registry.
+ *
+ * The file is read lazily on the first lookup after the zoneInfo is set, and
+ * its transitions are kept in a compact table of at most kMaxTransitions
+ * entries, which is searched by a binary search through PrecomputedZone.
+ * Times after the last transition of the file use the POSIX TZ string in the
+ * footer of TZif version 2 and above, whose transitions are calculated in
+ * closed form for the 3 years around the requested year, and cached.
+ *
+ * UTC offsets are stored in 15-minute offsetCodes like the rest of the
+ * library, so the Local Mean Time of the 19th century is truncated. Files
+ * with leap seconds (e.g. the "right/" zones) are rejected. If the file is
+ * missing or invalid, all lookups return an error. A TzifZoneProcessor
+ * consumes about 2.4kB of RAM, and needs a file system, so it is intended for
+ * Linux or MacOS.
+ *
+ * Not thread-safe.
+ */
+class TzifZoneProcessor: public ZoneProcessor {
+  public:
+    /**
+     * Maximum number of transitions kept from the file, including the
+     * initial entry which is in effect before the first transition. The
+     * transitions outside of the range of acetime_t are dropped first. This
+     * is enough for every zone of the 2019 TZ Database with the "fat" files
+     * of zic, which have about 240 transitions in that range.
+     */
+    static const uint16_t kMaxTransitions = 256;
+
+    /** Maximum number of local time types of the file. */
+    static const uint8_t kMaxTypes = 32;
+
+    /** Maximum size of the abbreviation characters of the file. */
+    static const uint8_t kMaxAbbrevChars = 64;
+
+    /**
+     * Constructor.
+     * @param zoneInfo pointer to a ZoneInfo. Can be nullptr which is useful
+     * for creating caches inside the ZoneManager.
+     * @param zoneinfoDir directory of the TZif files, which must remain
+     * valid for the life of this object
+     */
+    explicit TzifZoneProcessor(const extended::ZoneInfo* zoneInfo = nullptr,
+        const char* zoneinfoDir = ACE_TIME_TZIF_DIR):
+        ZoneProcessor(kTypeExtended),
+        mZoneInfo(zoneInfo),
+        mZoneinfoDir(zoneinfoDir) {}
+
+    /** Return the underlying ZoneInfo. */
+    const void* getZoneInfo() const override {
+      return mZoneInfo.zoneInfo();
+    }
+
+    uint32_t getZoneId() const override { return mZoneInfo.zoneId(); }
+
+    TimeOffset getUtcOffset(acetime_t epochSeconds) const override {
+      if (! load()) return TimeOffset::forError();
+      return findZone(epochSeconds).getUtcOffset(epochSeconds);
+    }
+
+    TimeOffset getDeltaOffset(acetime_t epochSeconds) const override {
+      if (! load()) return TimeOffset::forError();
+      return findZone(epochSeconds).getDeltaOffset(epochSeconds);
+    }
+
+    const char* getAbbrev(acetime_t epochSeconds) const override {
+      if (! load()) return "";
+      return findZone(epochSeconds).getAbbrev(epochSeconds);
+    }
+
+    /**
+     * Return the OffsetDateTime for the given LocalDateTime, using the same
+     * rules as ExtendedZoneProcessor::getOffsetDateTime() for a LocalDateTime
+     * in a DST gap or overlap.
+     */
+    OffsetDateTime getOffsetDateTime(const LocalDateTime& ldt) const override {
+      if (ldt.isError() || ! load()) return OffsetDateTime::forError();
+      return findLocalZone(ldt.toEpochSeconds()).getOffsetDateTime(ldt);
+    }
+
+    ResolvedDateTime resolveLocalDateTime(const LocalDateTime& ldt,
+        uint8_t policy) const override {
+      if (ldt.isError() || ! load()) return ResolvedDateTime::forError();
+      return findLocalZone(ldt.toEpochSeconds())
+          .resolveLocalDateTime(ldt, policy);
+    }
+
+    void printTo(Print& printer) const override;
+
+    void printShortTo(Print& printer) const override;
+
+    /**
+     * Return true if the TZif file of the current zone was read
+     * successfully. Reads it if necessary.
+     */
+    bool isLoaded() const { return load(); }
+
+    /**
+     * Return the number of entries in the table of transitions, including
+     * the initial entry. Reads the file if necessary.
+     */
+    uint16_t getNumTransitions() const {
+      return load() ? mTable.getNumEntries() : 0;
+    }
+
+    /**
+     * Return the POSIX TZ string of the footer of the file, whose isError()
+     * is true if there is none. Reads the file if necessary.
+     */
+    const posix::TzSpec& getFooter() const {
+      load();
+      return mFooter;
+    }
+
+  private:
+    friend class ::TzifZoneProcessorTest_loadBuffer;
+    friend class ::TzifZoneProcessorTest_loadBuffer_v1;
+    friend class ::TzifZoneProcessorTest_loadBuffer_invalid;
+    friend class ::TzifZoneProcessorTest_loadBuffer_truncated;
+    friend class ::TzifZoneProcessorTest_footer;
+    friend class ::TzifZoneProcessorTest_footer_only;
+
+    template<uint8_t SIZE, uint8_t TYPE, typename ZS, typename ZI, typename ZIB,
+        uint8_t EVICTION>
+    friend class ZoneProcessorCacheImpl; // setZoneInfo()
+
+    /** Maximum length of the path of a TZif file. */
+    static const uint16_t kMaxPathSize = 256;
+
+    /**
+     * Maximum number of entries of the footer cache: the initial entry, plus
+     * 2 transitions in each of 3 years.
+     */
+    static const uint8_t kMaxFooterEntries = 7;
+
+    /**
+     * Indexes of mFooterAbbrevs: the standard and DST abbreviations of the
+     * footer, and the abbreviation of the last transition of the file.
+     */
+    static const uint8_t kFooterAbbrevStd = 0;
+    static const uint8_t kFooterAbbrevDst = 1;
+    static const uint8_t kFooterAbbrevTable = 2;
+
+    /** Smallest valid acetime_t, since ACETIME_T_MIN is the error value. */
+    static const acetime_t kMinSeconds = ACETIME_T_MIN + 1;
+
+    /** Largest acetime_t. */
+    static const acetime_t kMaxSeconds = ACETIME_T_MAX;
+
+    // Disable copy constructor and assignment operator.
+    TzifZoneProcessor(const TzifZoneProcessor&) = delete;
+    TzifZoneProcessor& operator=(const TzifZoneProcessor&) = delete;
+
+    bool equals(const ZoneProcessor& other) const override {
+      return getZoneInfo() == other.getZoneInfo();
+    }
+
+    /** Set the underlying ZoneInfo. The file is read on the next lookup. */
+    void setZoneInfo(const void* zoneInfo) override {
+      if (mZoneInfo.zoneInfo() == zoneInfo) return;
+
+      mZoneInfo = extended::ZoneInfoBroker(
+          (const extended::ZoneInfo*) zoneInfo);
+      mIsLoadAttempted = false;
+      mIsLoaded = false;
+    }
+
+    /**
+     * Read the TZif file of the current zone, unless it was already read.
+     * Return true if the table is valid.
+     */
+    bool load() const {
+      if (! mIsLoadAttempted) {
+        mIsLoadAttempted = true;
+        mIsLoaded = loadFile();
+      }
+      return mIsLoaded;
+    }
+
+    /** Read the file {mZoneinfoDir}/{name of the zone}. */
+    bool loadFile() const;
+
+    /**
+     * Use the content of a TZif file instead of reading the file of the
+     * current zone, until the next setZoneInfo(). Return isLoaded().
+     */
+    bool loadBuffer(const uint8_t* data, size_t size) const;
+
+    /**
+     * Parse the content of a TZif file into the table. Return false if it is
+     * not a valid TZif file, leaving the table empty.
+     */
+    bool parseBuffer(const uint8_t* data, size_t size) const;
+
+    /**
+     * Return the table which covers epochSeconds: the transitions of the
+     * file, or the transitions of the footer after the last one.
+     */
+    const PrecomputedZone& findZone(acetime_t epochSeconds) const {
+      return (epochSeconds > mFooterStartSeconds)
+          ? findFooterZone(epochSeconds) : mTable;
+    }
+
+    /**
+     * Same as findZone() for the wall clock localSeconds. The footer is used
+     * only after the gap or overlap of the last transition of the file, which
+     * is resolved by the table.
+     */
+    const PrecomputedZone& findLocalZone(acetime_t localSeconds) const {
+      return (localSeconds >= mFooterLocalStartSeconds)
+          ? findFooterZone(localSeconds) : mTable;
+    }
+
+    /**
+     * Return the transitions of the footer for the year of the given seconds,
+     * calculating them if the year is not in the cache.
+     */
+    const PrecomputedZone& findFooterZone(acetime_t seconds) const;
+
+    /**
+     * Append an entry to the footer cache, replacing the last entry if it
+     * starts at the same time, and skipping it if it does not change the
+     * offsets.
+     */
+    void addFooterEntry(acetime_t startSeconds, bool isDst) const;
+
+    /** Append an entry with the given offsets to the footer cache. */
+    void addFooterEntry(acetime_t startSeconds, int8_t offsetCode,
+        int8_t deltaCode, uint8_t abbrevIndex) const;
+
+    extended::ZoneInfoBroker mZoneInfo;
+    const char* const mZoneinfoDir;
+
+    mutable bool mIsLoadAttempted = false;
+    mutable bool mIsLoaded = false;
+
+    /** The transitions of the file which fit into acetime_t. */
+    mutable PrecomputedZone mTable;
+    mutable acetime_t mStartEpochSeconds[kMaxTransitions];
+    mutable int8_t mOffsetCodes[kMaxTransitions];
+    mutable int8_t mDeltaCodes[kMaxTransitions];
+    mutable uint8_t mAbbrevIndexes[kMaxTransitions];
+    mutable const char* mAbbrevs[kMaxTypes];
+    mutable char mAbbrevChars[kMaxAbbrevChars];
+
+    /** The POSIX TZ string of the footer. */
+    mutable posix::TzSpec mFooter;
+
+    /** The footer applies after this epochSeconds (last transition). */
+    mutable acetime_t mFooterStartSeconds = kMaxSeconds;
+
+    /** The footer applies to wall clock seconds at or after this. */
+    mutable acetime_t mFooterLocalStartSeconds = kMaxSeconds;
+
+    /** The transitions of the footer for the 3 years around mFooterYear. */
+    mutable PrecomputedZone mFooterZone;
+    mutable int16_t mFooterYear = 0;
+    mutable acetime_t mFooterStartEpochSeconds[kMaxFooterEntries];
+    mutable int8_t mFooterOffsetCodes[kMaxFooterEntries];
+    mutable int8_t mFooterDeltaCodes[kMaxFooterEntries];
+    mutable uint8_t mFooterAbbrevIndexes[kMaxFooterEntries];
+    mutable uint8_t mNumFooterEntries = 0;
+    mutable const char* mFooterAbbrevs[3];
+};
+
+}
+
+#endif
@@ -78,6 +78,17 @@ class ZoneManager {
       return (zoneInfo - mZoneRegistrar.getZoneInfoForIndex(0));
     }
 
+    /**
+     * Return the statistics of the ZoneProcessorCache. All zeros unless
+     * ACE_TIME_ZONE_STATS is enabled.
+     */
+    ZoneProcessorCacheStats getStats() const {
+      return mZoneProcessorCache.getStats();
+    }
+
+    /** Reset the statistics returned by getStats(). */
+    void resetStats() { mZoneProcessorCache.resetStats(); }
+
     uint16_t indexForZoneId(uint32_t id) const {
       const ZI* zoneInfo = mZoneRegistrar.getZoneInfoForId(id);
       if (! zoneInfo) return 0;
@@ -85,8 +96,9 @@ class ZoneManager {
     }
 
   protected:
-    ZoneManager(uint16_t registrySize, const ZI* const* zoneRegistry):
-        mZoneRegistrar(registrySize, zoneRegistry),
+    ZoneManager(uint16_t registrySize, const ZI* const* zoneRegistry,
+        const ZI* const* zoneRegistryById = nullptr):
+        mZoneRegistrar(registrySize, zoneRegistry, zoneRegistryById),
         mZoneProcessorCache() {}
 
   private:
@@ -101,28 +113,79 @@ class ZoneManager {
 #if 1
 /**
  * @tparam SIZE size of the BasicZoneProcessorCache
+ * @tparam EVICTION eviction policy of the BasicZoneProcessorCache
  */
-template<uint16_t SIZE>
+template<uint16_t SIZE,
+    uint8_t EVICTION = ZoneProcessorCache::kEvictionRoundRobin>
 class BasicZoneManager: public ZoneManager<basic::ZoneInfo,
-    BasicZoneRegistrar, BasicZoneProcessorCache<SIZE>> {
+    BasicZoneRegistrar, BasicZoneProcessorCache<SIZE, EVICTION>> {
   public:
     BasicZoneManager(uint16_t registrySize,
-        const basic::ZoneInfo* const* zoneRegistry):
+        const basic::ZoneInfo* const* zoneRegistry,
+        const basic::ZoneInfo* const* zoneRegistryById = nullptr):
         ZoneManager<basic::ZoneInfo, BasicZoneRegistrar,
-            BasicZoneProcessorCache<SIZE>>(registrySize, zoneRegistry) {}
+            BasicZoneProcessorCache<SIZE, EVICTION>>(
+            registrySize, zoneRegistry, zoneRegistryById) {}
 };
 
 /**
  * @tparam SIZE size of the ExtendedZoneProcessorCache
+ * @tparam EVICTION eviction policy of the ExtendedZoneProcessorCache
  */
-template<uint16_t SIZE>
+template<uint16_t SIZE,
+    uint8_t EVICTION = ZoneProcessorCache::kEvictionRoundRobin>
 class ExtendedZoneManager: public ZoneManager<extended::ZoneInfo,
-    ExtendedZoneRegistrar, ExtendedZoneProcessorCache<SIZE>> {
+    ExtendedZoneRegistrar, ExtendedZoneProcessorCache<SIZE, EVICTION>> {
   public:
     ExtendedZoneManager(uint16_t registrySize,
-        const extended::ZoneInfo* const* zoneRegistry):
+        const extended::ZoneInfo* const* zoneRegistry,
+        const extended::ZoneInfo* const* zoneRegistryById = nullptr):
         ZoneManager<extended::ZoneInfo, ExtendedZoneRegistrar,
-            ExtendedZoneProcessorCache<SIZE>>(registrySize, zoneRegistry) {}
+            ExtendedZoneProcessorCache<SIZE, EVICTION>>(
+            registrySize, zoneRegistry, zoneRegistryById) {}
+};
+
+/**
+ * A ZoneManager which uses FlatZoneProcessors, trading about 2kB of RAM per
+ * cached zone for faster lookups. It uses the same zonedbx:: registry as the
+ * ExtendedZoneManager.
+ *
+ * @tparam SIZE size of the FlatZoneProcessorCache
+ * @tparam EVICTION eviction policy of the FlatZoneProcessorCache
+ */
+template<uint16_t SIZE,
+    uint8_t EVICTION = ZoneProcessorCache::kEvictionRoundRobin>
+class FlatZoneManager: public ZoneManager<extended::ZoneInfo,
+    ExtendedZoneRegistrar, FlatZoneProcessorCache<SIZE, EVICTION>> {
+  public:
+    FlatZoneManager(uint16_t registrySize,
+        const extended::ZoneInfo* const* zoneRegistry,
+        const extended::ZoneInfo* const* zoneRegistryById = nullptr):
+        ZoneManager<extended::ZoneInfo, ExtendedZoneRegistrar,
+            FlatZoneProcessorCache<SIZE, EVICTION>>(
+            registrySize, zoneRegistry, zoneRegistryById) {}
+};
+
+/**
+ * A ZoneManager which uses TzifZoneProcessors, reading the rules of each zone
+ * from the TZif files of the operating system (see ACE_TIME_TZIF_DIR) instead
+ * of the zonedbx:: ZoneRules. The zonedbx:: registry still provides the names
+ * and zoneIds of the zones.
+ *
+ * @tparam SIZE size of the TzifZoneProcessorCache
+ * @tparam EVICTION eviction policy of the TzifZoneProcessorCache
+ */
+template<uint16_t SIZE,
+    uint8_t EVICTION = ZoneProcessorCache::kEvictionRoundRobin>
+class TzifZoneManager: public ZoneManager<extended::ZoneInfo,
+    ExtendedZoneRegistrar, TzifZoneProcessorCache<SIZE, EVICTION>> {
+  public:
+    TzifZoneManager(uint16_t registrySize,
+        const extended::ZoneInfo* const* zoneRegistry,
+        const extended::ZoneInfo* const* zoneRegistryById = nullptr):
+        ZoneManager<extended::ZoneInfo, ExtendedZoneRegistrar,
+            TzifZoneProcessorCache<SIZE, EVICTION>>(
+            registrySize, zoneRegistry, zoneRegistryById) {}
 };
 
 #else
@@ -133,13 +196,25 @@ class ExtendedZoneManager: public ZoneManager<extended::ZoneInfo,
 // seems to be no difference in code size between the two. The compiler seems
 // to optimize away the vtables of the parent and child classes.
 
-template<uint8_t SIZE>
+template<uint8_t SIZE,
+    uint8_t EVICTION = ZoneProcessorCache::kEvictionRoundRobin>
 using BasicZoneManager = ZoneManager<basic::ZoneInfo,
-    BasicZoneRegistrar, BasicZoneProcessorCache<SIZE>>;
+    BasicZoneRegistrar, BasicZoneProcessorCache<SIZE, EVICTION>>;
 
-template<uint8_t SIZE>
+template<uint8_t SIZE,
+    uint8_t EVICTION = ZoneProcessorCache::kEvictionRoundRobin>
 using ExtendedZoneManager = ZoneManager<extended::ZoneInfo,
-    ExtendedZoneRegistrar, ExtendedZoneProcessorCache<SIZE>>;
+    ExtendedZoneRegistrar, ExtendedZoneProcessorCache<SIZE, EVICTION>>;
+
+template<uint8_t SIZE,
+    uint8_t EVICTION = ZoneProcessorCache::kEvictionRoundRobin>
+using FlatZoneManager = ZoneManager<extended::ZoneInfo,
+    ExtendedZoneRegistrar, FlatZoneProcessorCache<SIZE, EVICTION>>;
+
+template<uint8_t SIZE,
+    uint8_t EVICTION = ZoneProcessorCache::kEvictionRoundRobin>
+using TzifZoneManager = ZoneManager<extended::ZoneInfo,
+    ExtendedZoneRegistrar, TzifZoneProcessorCache<SIZE, EVICTION>>;
 
 #endif
 
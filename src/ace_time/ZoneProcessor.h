@@ -6,15 +6,23 @@
 #ifndef ACE_TIME_ZONE_PROCESSOR_H
 #define ACE_TIME_ZONE_PROCESSOR_H
 
+#include <stddef.h> // size_t
 #include "common/common.h"
 #include "TimeOffset.h"
 #include "OffsetDateTime.h"
+#include "ResolvedDateTime.h"
+#include "ZoneStats.h"
+
+#if ACE_TIME_ZONE_STATS
+#include <Arduino.h> // micros()
+#endif
 
 class Print;
 
 namespace ace_time {
 
-template<uint8_t SIZE, uint8_t TYPE, typename ZS, typename ZI, typename ZIB>
+template<uint8_t SIZE, uint8_t TYPE, typename ZS, typename ZI, typename ZIB,
+    uint8_t EVICTION>
 class ZoneProcessorCacheImpl;
 
 class LocalDateTime;
@@ -56,6 +64,12 @@ class ZoneProcessor {
      */
     static const uint8_t kTypeExtended = 3;
 
+    /**
+     * Indicate PosixZoneProcessor. Must not collide with the other
+     * TimeZone::kTypeXxx, including the ZoneProcessorCache::kTypeXxx.
+     */
+    static const uint8_t kTypePosix = 7;
+
     /** Return the kTypeXxx of the current instance. */
     uint8_t getType() const { return mType; }
 
@@ -95,18 +109,65 @@ class ZoneProcessor {
     virtual OffsetDateTime getOffsetDateTime(const LocalDateTime& ldt)
         const = 0;
 
+    /**
+     * Resolve the given LocalDateTime using a single search of the
+     * transitions, returning whether it is unique, or falls in a DST gap or
+     * overlap, the UTC offsets on both sides of the transition, and the
+     * OffsetDateTime selected by the given policy. Returns
+     * ResolvedDateTime::forError() if an error occurs.
+     *
+     * @param ldt the local date time
+     * @param policy one of the ResolvedDateTime::kPolicyXxx constants
+     */
+    virtual ResolvedDateTime resolveLocalDateTime(const LocalDateTime& ldt,
+        uint8_t policy) const = 0;
+
+    /**
+     * Fill the 'offsets' array with the total UTC offset at each of the 'n'
+     * elements of the 'epochSeconds' array, equivalent to calling
+     * getUtcOffset() on each element. Subclasses can override this to take
+     * advantage of input which is sorted or nearly sorted. Each offset is
+     * TimeOffset::forError() if an error occurs for that element.
+     */
+    virtual void getUtcOffsets(const acetime_t* epochSeconds,
+        TimeOffset* offsets, size_t n) const {
+      for (size_t i = 0; i < n; i++) {
+        offsets[i] = getUtcOffset(epochSeconds[i]);
+      }
+    }
+
     /** Print a human-readable identifier (e.g. "America/Los_Angeles"). */
     virtual void printTo(Print& printer) const = 0;
 
     /** Print a short human-readable identifier (e.g. "Los_Angeles") */
     virtual void printShortTo(Print& printer) const = 0;
 
+    /**
+     * Return the statistics of the transition cache. All zeros unless
+     * ACE_TIME_ZONE_STATS is enabled.
+     */
+    ZoneProcessorStats getStats() const {
+    #if ACE_TIME_ZONE_STATS
+      return mStats;
+    #else
+      return ZoneProcessorStats();
+    #endif
+    }
+
+    /** Reset the statistics returned by getStats(). */
+    void resetStats() {
+    #if ACE_TIME_ZONE_STATS
+      mStats = ZoneProcessorStats();
+    #endif
+    }
+
   protected:
     friend bool operator==(const ZoneProcessor& a, const ZoneProcessor& b);
 
     friend class TimeZone; // setZoneInfo()
 
-    template<uint8_t SIZE, uint8_t TYPE, typename ZS, typename ZI, typename ZIB>
+    template<uint8_t SIZE, uint8_t TYPE, typename ZS, typename ZI, typename ZIB,
+        uint8_t EVICTION>
     friend class ZoneProcessorCacheImpl; // setZoneInfo()
 
     // Disable copy constructor and assignment operator.
@@ -123,7 +184,40 @@ class ZoneProcessor {
     /** Set the opaque zoneInfo. */
     virtual void setZoneInfo(const void* zoneInfo) = 0;
 
+    /** Record a lookup which found its year in the transition cache. */
+    void statsHit() const {
+    #if ACE_TIME_ZONE_STATS
+      mStats.hits++;
+    #endif
+    }
+
+    /**
+     * Record a lookup which must calculate the transitions of its year.
+     * Returns the start time to pass to statsRebuildEnd().
+     */
+    uint16_t statsRebuildStart() const {
+    #if ACE_TIME_ZONE_STATS
+      mStats.misses++;
+      return micros();
+    #else
+      return 0;
+    #endif
+    }
+
+    /** Record the end of a successful calculation of the transitions. */
+    void statsRebuildEnd(uint16_t startMicros) const {
+    #if ACE_TIME_ZONE_STATS
+      mStats.rebuildMicros.update((uint16_t) micros() - startMicros);
+    #else
+      (void) startMicros;
+    #endif
+    }
+
     uint8_t mType;
+
+  #if ACE_TIME_ZONE_STATS
+    mutable ZoneProcessorStats mStats;
+  #endif
 };
 
 inline bool operator==(const ZoneProcessor& a, const ZoneProcessor& b) {
@@ -11,7 +11,10 @@
 #include "OffsetDateTime.h"
 #include "BasicZoneProcessor.h"
 #include "ExtendedZoneProcessor.h"
+#include "FlatZoneProcessor.h"
+#include "TzifZoneProcessor.h"
 #include "ZoneRegistrar.h"
+#include "ZoneStats.h"
 
 namespace ace_time {
 
@@ -27,6 +30,21 @@ class ZoneProcessorCache {
     static const uint8_t kTypeExtendedManaged =
         ZoneProcessor::kTypeExtended + 2;
 
+    /**
+     * Evict the ZoneProcessors in round-robin order, and find them using a
+     * linear search. Uses no extra memory, so it is the default for small
+     * caches.
+     */
+    static const uint8_t kEvictionRoundRobin = 0;
+
+    /**
+     * Evict the least recently used ZoneProcessor, and find them using a hash
+     * table keyed by the ZoneInfo pointer. Uses about 4 extra bytes per
+     * ZoneProcessor. Keeps the frequently used zones in the cache when a few
+     * zones receive most of the lookups.
+     */
+    static const uint8_t kEvictionLru = 1;
+
     /** Return the type of this cache. */
     virtual uint8_t getType() = 0;
 
@@ -39,6 +57,175 @@ class ZoneProcessorCache {
     virtual ZoneProcessor* getZoneProcessor(const void* zoneInfo) = 0;
 };
 
+/**
+ * Return the smallest power of 2 which is >= n, the size of the hash table of
+ * the kEvictionLru policy.
+ */
+constexpr uint16_t zoneProcessorCacheTableSize(uint16_t n, uint16_t p = 1) {
+  return (p >= n) ? p : zoneProcessorCacheTableSize(n, 2 * p);
+}
+
+/**
+ * Selects the ZoneProcessor to use for a given ZoneInfo, and the one to evict
+ * when the ZoneInfo is not in the cache. This is the round-robin
+ * implementation which uses a linear search.
+ *
+ * @tparam SIZE number of zone processors
+ * @tparam EVICTION eviction policy (ZoneProcessorCache::kEvictionRoundRobin or
+ *    ZoneProcessorCache::kEvictionLru)
+ */
+template<uint8_t SIZE, uint8_t EVICTION>
+class ZoneProcessorCachePolicy {
+  public:
+    /**
+     * Return the index of the ZoneProcessor which holds zoneInfo, or SIZE if
+     * not found.
+     */
+    template<typename ZS>
+    uint8_t find(const ZS* zoneProcessors, const void* zoneInfo) {
+      for (uint8_t i = 0; i < SIZE; i++) {
+        if (zoneProcessors[i].getZoneInfo() == zoneInfo) return i;
+      }
+      return SIZE;
+    }
+
+    /**
+     * Return the index of the ZoneProcessor to be reassigned to zoneInfo. The
+     * caller must then call setZoneInfo(zoneInfo) on it.
+     */
+    template<typename ZS>
+    uint8_t evict(const ZS* /*zoneProcessors*/, const void* /*zoneInfo*/) {
+      uint8_t i = mCurrentIndex;
+      mCurrentIndex++;
+      if (mCurrentIndex >= SIZE) mCurrentIndex = 0;
+      return i;
+    }
+
+  private:
+    uint8_t mCurrentIndex = 0;
+};
+
+/**
+ * The LRU implementation of ZoneProcessorCachePolicy. A hash table of
+ * indexes, using linear probing and keyed by the ZoneInfo pointer held by
+ * each ZoneProcessor, finds the ZoneProcessor in O(1) time. A doubly linked
+ * list of indexes, with the most recently used in front, finds the
+ * ZoneProcessor to evict in O(1) time.
+ */
+template<uint8_t SIZE>
+class ZoneProcessorCachePolicy<SIZE, ZoneProcessorCache::kEvictionLru> {
+  public:
+    ZoneProcessorCachePolicy() {
+      for (uint16_t i = 0; i < kTableSize; i++) {
+        mTable[i] = kEmpty;
+      }
+      for (uint8_t i = 0; i < SIZE; i++) {
+        mPrev[i] = i - 1;
+        mNext[i] = i + 1;
+      }
+      mPrev[0] = kEmpty;
+      mNext[SIZE - 1] = kEmpty;
+      mHead = 0;
+      mTail = SIZE - 1;
+    }
+
+    template<typename ZS>
+    uint8_t find(const ZS* zoneProcessors, const void* zoneInfo) {
+      if (zoneInfo == nullptr) return SIZE;
+      for (uint16_t h = hash(zoneInfo); mTable[h] != kEmpty;
+          h = (h + 1) & kTableMask) {
+        uint8_t i = mTable[h];
+        if (zoneProcessors[i].getZoneInfo() == zoneInfo) {
+          moveToFront(i);
+          return i;
+        }
+      }
+      return SIZE;
+    }
+
+    template<typename ZS>
+    uint8_t evict(const ZS* zoneProcessors, const void* zoneInfo) {
+      uint8_t i = mTail;
+      const void* oldZoneInfo = zoneProcessors[i].getZoneInfo();
+      if (oldZoneInfo != nullptr) remove(zoneProcessors, oldZoneInfo);
+      if (zoneInfo != nullptr) insert(zoneInfo, i);
+      moveToFront(i);
+      return i;
+    }
+
+  private:
+    /** Marks an empty slot in mTable, and the end of the list. */
+    static const uint8_t kEmpty = 0xFF;
+
+    /** Size of mTable, with a load factor of 0.5 or less. */
+    static const uint16_t kTableSize = zoneProcessorCacheTableSize(2 * SIZE);
+    static const uint16_t kTableMask = kTableSize - 1;
+
+    static_assert(SIZE < kEmpty, "SIZE must be < 255 with kEvictionLru");
+
+    /** Fibonacci hashing of the pointer. */
+    static uint16_t hash(const void* zoneInfo) {
+      uint32_t h = (uint32_t) (uintptr_t) zoneInfo * 2654435769U;
+      return (h >> 16) & kTableMask;
+    }
+
+    void insert(const void* zoneInfo, uint8_t i) {
+      uint16_t h = hash(zoneInfo);
+      while (mTable[h] != kEmpty) h = (h + 1) & kTableMask;
+      mTable[h] = i;
+    }
+
+    /**
+     * Remove zoneInfo from mTable, moving the following entries of the same
+     * probe sequence backwards so that no tombstones are needed.
+     */
+    template<typename ZS>
+    void remove(const ZS* zoneProcessors, const void* zoneInfo) {
+      uint16_t h = hash(zoneInfo);
+      while (zoneProcessors[mTable[h]].getZoneInfo() != zoneInfo) {
+        h = (h + 1) & kTableMask;
+      }
+
+      uint16_t j = h;
+      while (true) {
+        j = (j + 1) & kTableMask;
+        if (mTable[j] == kEmpty) break;
+
+        // Move the entry at j into the hole at h, unless its home slot is
+        // cyclically in (h, j].
+        uint16_t home = hash(zoneProcessors[mTable[j]].getZoneInfo());
+        if (((j - home) & kTableMask) >= ((j - h) & kTableMask)) {
+          mTable[h] = mTable[j];
+          h = j;
+        }
+      }
+      mTable[h] = kEmpty;
+    }
+
+    void moveToFront(uint8_t i) {
+      if (i == mHead) return;
+
+      // Unlink. Since i is not the head, mPrev[i] is valid.
+      mNext[mPrev[i]] = mNext[i];
+      if (i == mTail) {
+        mTail = mPrev[i];
+      } else {
+        mPrev[mNext[i]] = mPrev[i];
+      }
+
+      mPrev[i] = kEmpty;
+      mNext[i] = mHead;
+      mPrev[mHead] = i;
+      mHead = i;
+    }
+
+    uint8_t mTable[kTableSize];
+    uint8_t mPrev[SIZE];
+    uint8_t mNext[SIZE];
+    uint8_t mHead;
+    uint8_t mTail;
+};
+
 /**
  * A cache of ZoneProcessors that provides a ZoneProcessor to the TimeZone
  * upon request.
@@ -47,13 +234,16 @@ class ZoneProcessorCache {
  *    zones *concurrently* used in the app. It is expected that this will be
  *    small. It can be 1 if the app never changes the TimeZone. It should be 2
  *    if the user is able to select different timezones from a menu.
- * @tparam ZS type of ZoneProcessor (BasicZoneProcessor or
- * ExtendedZoneProcessor)
+ * @tparam ZS type of ZoneProcessor (BasicZoneProcessor,
+ * ExtendedZoneProcessor, FlatZoneProcessor or TzifZoneProcessor)
  * @tparam ZI type of ZoneInfo (basic::ZoneInfo or extended::ZoneInfo)
  * @tparam ZIB type of ZoneInfoBroker (basic::ZoneInfoBroker or 
  *    extended::ZoneInfoBroker)
+ * @tparam EVICTION eviction policy, ZoneProcessorCache::kEvictionRoundRobin
+ *    (default) or ZoneProcessorCache::kEvictionLru
  */
-template<uint8_t SIZE, uint8_t TYPE, typename ZS, typename ZI, typename ZIB>
+template<uint8_t SIZE, uint8_t TYPE, typename ZS, typename ZI, typename ZIB,
+    uint8_t EVICTION = ZoneProcessorCache::kEvictionRoundRobin>
 class ZoneProcessorCacheImpl: public ZoneProcessorCache {
   public:
     ZoneProcessorCacheImpl() {}
@@ -62,52 +252,93 @@ class ZoneProcessorCacheImpl: public ZoneProcessorCache {
 
     /** Get the ZoneProcessor from the zoneInfo. Will never return nullptr. */
     ZoneProcessor* getZoneProcessor(const void* zoneInfo) override {
-      ZS* zoneProcessor = findUsingZoneInfo((const ZI*) zoneInfo);
-      if (zoneProcessor) return zoneProcessor;
+      uint8_t i = mPolicy.find(mZoneProcessors, zoneInfo);
+      if (i < SIZE) {
+      #if ACE_TIME_ZONE_STATS
+        mStats.hits++;
+      #endif
+        return &mZoneProcessors[i];
+      }
 
-      // Allocate the next ZoneProcessor in the cache using round-robin.
-      zoneProcessor = &mZoneProcessors[mCurrentIndex];
-      mCurrentIndex++;
-      if (mCurrentIndex >= SIZE) mCurrentIndex = 0;
+      // Allocate a ZoneProcessor in the cache using the eviction policy.
+      i = mPolicy.evict(mZoneProcessors, zoneInfo);
+      ZS* zoneProcessor = &mZoneProcessors[i];
+    #if ACE_TIME_ZONE_STATS
+      mStats.misses++;
+      if (zoneProcessor->getZoneInfo() != nullptr) mStats.evictions++;
+    #endif
       zoneProcessor->setZoneInfo((const ZI*) zoneInfo);
       return zoneProcessor;
     }
 
-  private:
-    // disable copy constructor and assignment operator
-    ZoneProcessorCacheImpl(const ZoneProcessorCacheImpl&) = delete;
-    ZoneProcessorCacheImpl& operator=(const ZoneProcessorCacheImpl&) = delete;
-
     /**
-     * Find an existing ZoneProcessor with the same zoneInfo.
-     * Returns nullptr if not found. This is a linear search, which should
-     * be perfectly ok if SIZE is small, say <= 5.
+     * Return the statistics of this cache, including the sum of the
+     * statistics of its ZoneProcessors. All zeros unless ACE_TIME_ZONE_STATS
+     * is enabled.
      */
-    ZS* findUsingZoneInfo(const ZI* zoneInfoKey) {
+    ZoneProcessorCacheStats getStats() const {
+    #if ACE_TIME_ZONE_STATS
+      ZoneProcessorCacheStats stats = mStats;
       for (uint8_t i = 0; i < SIZE; i++) {
-        const ZI* zoneInfo = (const ZI*) mZoneProcessors[i].getZoneInfo();
-        if (zoneInfo == zoneInfoKey) {
-          return &mZoneProcessors[i];
-        }
+        stats.processors.merge(mZoneProcessors[i].getStats());
       }
-      return nullptr;
+      return stats;
+    #else
+      return ZoneProcessorCacheStats();
+    #endif
     }
 
+    /** Reset the statistics of this cache and its ZoneProcessors. */
+    void resetStats() {
+    #if ACE_TIME_ZONE_STATS
+      mStats = ZoneProcessorCacheStats();
+      for (uint8_t i = 0; i < SIZE; i++) {
+        mZoneProcessors[i].resetStats();
+      }
+    #endif
+    }
+
+  private:
+    // disable copy constructor and assignment operator
+    ZoneProcessorCacheImpl(const ZoneProcessorCacheImpl&) = delete;
+    ZoneProcessorCacheImpl& operator=(const ZoneProcessorCacheImpl&) = delete;
+
     ZS mZoneProcessors[SIZE];
-    uint8_t mCurrentIndex = 0;
+    ZoneProcessorCachePolicy<SIZE, EVICTION> mPolicy;
+
+  #if ACE_TIME_ZONE_STATS
+    ZoneProcessorCacheStats mStats;
+  #endif
 };
 
 #if 1
-template<uint8_t SIZE>
+template<uint8_t SIZE,
+    uint8_t EVICTION = ZoneProcessorCache::kEvictionRoundRobin>
 class BasicZoneProcessorCache: public ZoneProcessorCacheImpl<
     SIZE, ZoneProcessorCache::kTypeBasicManaged,
-    BasicZoneProcessor, basic::ZoneInfo, basic::ZoneInfoBroker> {
+    BasicZoneProcessor, basic::ZoneInfo, basic::ZoneInfoBroker, EVICTION> {
 };
 
-template<uint8_t SIZE>
+template<uint8_t SIZE,
+    uint8_t EVICTION = ZoneProcessorCache::kEvictionRoundRobin>
 class ExtendedZoneProcessorCache: public ZoneProcessorCacheImpl<
     SIZE, ZoneProcessorCache::kTypeExtendedManaged,
-    ExtendedZoneProcessor, extended::ZoneInfo, extended::ZoneInfoBroker> {
+    ExtendedZoneProcessor, extended::ZoneInfo, extended::ZoneInfoBroker,
+    EVICTION> {
+};
+
+template<uint8_t SIZE,
+    uint8_t EVICTION = ZoneProcessorCache::kEvictionRoundRobin>
+class FlatZoneProcessorCache: public ZoneProcessorCacheImpl<
+    SIZE, ZoneProcessorCache::kTypeExtendedManaged,
+    FlatZoneProcessor, extended::ZoneInfo, extended::ZoneInfoBroker, EVICTION> {
+};
+
+template<uint8_t SIZE,
+    uint8_t EVICTION = ZoneProcessorCache::kEvictionRoundRobin>
+class TzifZoneProcessorCache: public ZoneProcessorCacheImpl<
+    SIZE, ZoneProcessorCache::kTypeExtendedManaged,
+    TzifZoneProcessor, extended::ZoneInfo, extended::ZoneInfoBroker, EVICTION> {
 };
 #else
 
@@ -117,15 +348,30 @@ class ExtendedZoneProcessorCache: public ZoneProcessorCacheImpl<
 // seems to be no difference in code size between the two. The compiler seems
 // to optimize away the vtables of the parent and child classes.
 
-template<uint8_t SIZE>
+template<uint8_t SIZE,
+    uint8_t EVICTION = ZoneProcessorCache::kEvictionRoundRobin>
 using BasicZoneProcessorCache = ZoneProcessorCacheImpl<
     SIZE, ZoneProcessorCache::kTypeBasicManaged,
-    BasicZoneProcessor, basic::ZoneInfo, basic::ZoneInfoBroker>;
+    BasicZoneProcessor, basic::ZoneInfo, basic::ZoneInfoBroker, EVICTION>;
 
-template<uint8_t SIZE>
+template<uint8_t SIZE,
+    uint8_t EVICTION = ZoneProcessorCache::kEvictionRoundRobin>
 using ExtendedZoneProcessorCache  = ZoneProcessorCacheImpl<
     SIZE, ZoneProcessorCache::kTypeExtendedManaged,
-    ExtendedZoneProcessor, extended::ZoneInfo, extended::ZoneInfoBroker>;
+    ExtendedZoneProcessor, extended::ZoneInfo, extended::ZoneInfoBroker,
+    EVICTION>;
+
+template<uint8_t SIZE,
+    uint8_t EVICTION = ZoneProcessorCache::kEvictionRoundRobin>
+using FlatZoneProcessorCache  = ZoneProcessorCacheImpl<
+    SIZE, ZoneProcessorCache::kTypeExtendedManaged,
+    FlatZoneProcessor, extended::ZoneInfo, extended::ZoneInfoBroker, EVICTION>;
+
+template<uint8_t SIZE,
+    uint8_t EVICTION = ZoneProcessorCache::kEvictionRoundRobin>
+using TzifZoneProcessorCache  = ZoneProcessorCacheImpl<
+    SIZE, ZoneProcessorCache::kTypeExtendedManaged,
+    TzifZoneProcessor, extended::ZoneInfo, extended::ZoneInfoBroker, EVICTION>;
 #endif
 
 }
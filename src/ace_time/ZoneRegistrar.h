@@ -19,6 +19,8 @@ class BasicZoneRegistrarTest_Sorted_binarySearch;
 class BasicZoneRegistrarTest_Sorted_binarySearch_not_found;
 class BasicZoneRegistrarTest_Unsorted_isSorted;
 class BasicZoneRegistrarTest_Unsorted_linearSearch;
+class BasicZoneRegistrarTest_Sorted_isSortedById;
+class BasicZoneRegistrarTest_Sorted_binarySearchUsingId;
 
 namespace ace_time {
 
@@ -29,6 +31,10 @@ typedef int (*strcmp_t)(const char*, const char*);
  * Class that allows looking up the ZoneInfo (ZI) from its TZDB identifier
  * (e.g. "America/Los_Angeles"), or index, or zoneId (hash from its name).
  *
+ * The lookup by zoneId is a linear search, unless a second registry sorted by
+ * zoneId (e.g. zonedbx::kZoneRegistryById) is given to the constructor, in
+ * which case it is a binary search.
+ *
  * @tparam ZI ZoneInfo type (e.g. basic::ZoneInfo)
  * @tparam ZRB ZoneRegistryBroker type (e.g. basic::ZoneRegistryBroker)
  * @tparam ZIB ZoneInfoBroker type (e.g. basic::ZoneInfoBroker)
@@ -41,10 +47,21 @@ template<typename ZI, typename ZRB, typename ZIB, strcmp_t STRCMP_P,
     strcmp_t STRCMP_PP>
 class ZoneRegistrar {
   public:
-    /** Constructor. */
-    ZoneRegistrar(uint16_t registrySize, const ZI* const* zoneRegistry):
+    /**
+     * Constructor.
+     *
+     * @param registrySize number of zones in zoneRegistry
+     * @param zoneRegistry array of ZoneInfo pointers, preferably sorted by name
+     * @param zoneRegistryById optional array of the same registrySize
+     *    ZoneInfo pointers, sorted by zoneId (e.g. zonedb::kZoneRegistryById).
+     *    It is ignored if it is not sorted.
+     */
+    ZoneRegistrar(uint16_t registrySize, const ZI* const* zoneRegistry,
+        const ZI* const* zoneRegistryById = nullptr):
         mRegistrySize(registrySize),
         mZoneRegistry(zoneRegistry),
+        mZoneRegistryById(isSortedById(zoneRegistryById, registrySize)
+            ? zoneRegistryById : nullptr),
         mIsSorted(isSorted(zoneRegistry, registrySize)) {}
 
     /** Return the number of zones. */
@@ -56,6 +73,12 @@ class ZoneRegistrar {
      */
     bool isSorted() const { return mIsSorted; }
 
+    /**
+     * Return true if a registry sorted by zoneId was given, so that
+     * getZoneInfoForId() uses a binary search.
+     */
+    bool isSortedById() const { return mZoneRegistryById != nullptr; }
+
     /* Return the ZoneInfo at index i. Return nullptr if i is out of range. */
     const ZI* getZoneInfoForIndex(uint16_t i) const {
       return (i < mRegistrySize) ? ZRB(mZoneRegistry).zoneInfo(i) : nullptr;
@@ -75,7 +98,11 @@ class ZoneRegistrar {
 
     /* Return the ZoneInfo using the zoneId. Return nullptr if not found. */
     const ZI* getZoneInfoForId(uint32_t zoneId) const {
+      if (mZoneRegistryById && mRegistrySize >= kBinarySearchThreshold) {
+        return binarySearchUsingId(mZoneRegistryById, mRegistrySize, zoneId);
+      } else {
         return linearSearchUsingId(mZoneRegistry, mRegistrySize, zoneId);
+      }
     }
 
   protected:
@@ -86,6 +113,8 @@ class ZoneRegistrar {
     friend class ::BasicZoneRegistrarTest_Sorted_binarySearch_not_found;
     friend class ::BasicZoneRegistrarTest_Unsorted_isSorted;
     friend class ::BasicZoneRegistrarTest_Unsorted_linearSearch;
+    friend class ::BasicZoneRegistrarTest_Sorted_isSortedById;
+    friend class ::BasicZoneRegistrarTest_Sorted_binarySearchUsingId;
 
     /** Use binarySearch() if registrySize >= threshold. */
     static const uint8_t kBinarySearchThreshold = 6;
@@ -107,6 +136,23 @@ class ZoneRegistrar {
       return true;
     }
 
+    static bool isSortedById(const ZI* const* zr, uint16_t registrySize) {
+      if (zr == nullptr || registrySize == 0) {
+        return false;
+      }
+
+      const ZRB zoneRegistry(zr);
+      uint32_t prevId = ZIB(zoneRegistry.zoneInfo(0)).zoneId();
+      for (uint16_t i = 1; i < registrySize; ++i) {
+        uint32_t currId = ZIB(zoneRegistry.zoneInfo(i)).zoneId();
+        if (prevId > currId) {
+          return false;
+        }
+        prevId = currId;
+      }
+      return true;
+    }
+
     static const ZI* linearSearch(const ZI* const* zr,
         uint16_t registrySize, const char* name) {
       const ZRB zoneRegistry(zr);
@@ -150,8 +196,28 @@ class ZoneRegistrar {
       return nullptr;
     }
 
+    static const ZI* binarySearchUsingId(const ZI* const* zr,
+        uint16_t registrySize, uint32_t zoneId) {
+      uint16_t a = 0;
+      uint16_t b = registrySize;
+      const ZRB zoneRegistry(zr);
+      while (a < b) {
+        uint16_t c = a + (b - a) / 2;
+        const ZI* zoneInfo = zoneRegistry.zoneInfo(c);
+        uint32_t id = ZIB(zoneInfo).zoneId();
+        if (id == zoneId) return zoneInfo;
+        if (zoneId < id) {
+          b = c;
+        } else {
+          a = c + 1;
+        }
+      }
+      return nullptr;
+    }
+
     uint16_t const mRegistrySize;
     const ZI* const* const mZoneRegistry;
+    const ZI* const* const mZoneRegistryById;
     bool const mIsSorted;
 };
 
@@ -0,0 +1,67 @@
+/*
+ * MIT License
+ * Copyright (c) 2019 Brian T. Park
+ */
+
+#ifndef ACE_TIME_ZONE_STATS_H
+#define ACE_TIME_ZONE_STATS_H
+
+#include <stdint.h>
+#include "common/TimingStats.h"
+
+/**
+ * Set to 1 to collect the statistics returned by ZoneProcessor::getStats(),
+ * ZoneProcessorCache::getStats() and ZoneManager::getStats(). When set to 0
+ * (the default), the counters are not compiled in, and getStats() returns all
+ * zeros.
+ */
+#ifndef ACE_TIME_ZONE_STATS
+#define ACE_TIME_ZONE_STATS 0
+#endif
+
+namespace ace_time {
+
+/**
+ * Statistics of the transition cache of a BasicZoneProcessor or an
+ * ExtendedZoneProcessor, which holds the transitions of a single year.
+ */
+struct ZoneProcessorStats {
+  /** Number of lookups which found their year already calculated. */
+  uint32_t hits = 0;
+
+  /** Number of lookups which (re)calculated the transitions of their year. */
+  uint32_t misses = 0;
+
+  /** Duration in micros of each successful calculation of the transitions. */
+  common::TimingStats rebuildMicros;
+
+  /** Add the stats of another ZoneProcessor. */
+  void merge(const ZoneProcessorStats& other) {
+    hits += other.hits;
+    misses += other.misses;
+    rebuildMicros.merge(other.rebuildMicros);
+  }
+};
+
+/**
+ * Statistics of a ZoneProcessorCache, or the ZoneManager which holds it. A
+ * high number of evictions relative to hits indicates that the SIZE of the
+ * cache is too small for the number of zones in use.
+ */
+struct ZoneProcessorCacheStats {
+  /** Number of getZoneProcessor() calls which found the zone in the cache. */
+  uint32_t hits = 0;
+
+  /** Number of getZoneProcessor() calls which did not find the zone. */
+  uint32_t misses = 0;
+
+  /** Number of misses which replaced a zone already in the cache. */
+  uint32_t evictions = 0;
+
+  /** Sum of the stats of all ZoneProcessors in the cache. */
+  ZoneProcessorStats processors;
+};
+
+}
+
+#endif
@@ -0,0 +1,194 @@
+/*
+ * MIT License
+ * Copyright (c) 2019 Brian T. Park
+ */
+
+#ifndef ACE_TIME_ZONE_TRANSITION_ITERATOR_H
+#define ACE_TIME_ZONE_TRANSITION_ITERATOR_H
+
+#include <stdint.h>
+#include <string.h> // strncmp(), strncpy()
+#include "common/common.h"
+#include "TimeOffset.h"
+#include "LocalDate.h"
+#include "ExtendedZoneProcessor.h"
+
+namespace ace_time {
+
+/**
+ * A change of the UTC offset or the abbreviation of a time zone, returned by
+ * ZoneTransitionIterator.
+ */
+struct ZoneTransition {
+  /** Size of the abbreviation, including the NUL terminator. */
+  static const uint8_t kAbbrevSize = extended::Transition::kAbbrevSize;
+
+  /** The instant of the transition. */
+  acetime_t epochSeconds;
+
+  /** The total UTC offset (including DST) just before the transition. */
+  TimeOffset offsetBefore;
+
+  /** The total UTC offset (including DST) starting at the transition. */
+  TimeOffset offsetAfter;
+
+  /** The abbreviation starting at the transition (e.g. "PDT"). */
+  char abbrev[kAbbrevSize];
+};
+
+/**
+ * An iterator over the transitions of the zone of an ExtendedZoneProcessor,
+ * in either direction, across year boundaries. Only the transitions which
+ * change the total UTC offset or the abbreviation are returned, which are the
+ * transitions seen by ExtendedZoneProcessor::getUtcOffset() and getAbbrev().
+ *
+ * The transitions are read directly from the TransitionStorage of the
+ * processor, one year at a time, so the range is never materialized. Moving
+ * forward into the next year uses the incremental update of
+ * ExtendedZoneProcessor::init() when
+ * ACE_TIME_EXTENDED_ZONE_PROCESSOR_INCREMENTAL is enabled, instead of
+ * calculating the whole year again. Moving backward recalculates each year.
+ *
+ * The iterator behaves like a cursor positioned between two transitions:
+ * next() returns the first transition at or after the cursor and moves the
+ * cursor after it, and prev() returns the last transition before the cursor
+ * and moves the cursor before it. So a next() followed by a prev() returns
+ * the same transition twice. Iteration is limited to the years of the
+ * ZoneContext (e.g. 2000 until 2050 for zonedbx), like CompiledZone.
+ *
+ * The processor is shared with other users (e.g. a TimeZone), which may
+ * change the year cached in the processor between calls. That is safe, but
+ * interleaving queries of different years with the iteration defeats the
+ * incremental update. Not thread-safe.
+ *
+ * Example:
+ *
+ * @code
+ * ExtendedZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles);
+ * ZoneTransitionIterator iter(processor, startSeconds);
+ * ZoneTransition transition;
+ * while (iter.next(transition) && transition.epochSeconds < untilSeconds) {
+ *   ...
+ * }
+ * @endcode
+ */
+class ZoneTransitionIterator {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param processor the ExtendedZoneProcessor of the zone, which must
+     *    outlive the iterator
+     * @param epochSeconds the initial position of the cursor
+     */
+    ZoneTransitionIterator(const ExtendedZoneProcessor& processor,
+        acetime_t epochSeconds):
+        mProcessor(processor),
+        mCursor(epochSeconds) {}
+
+    /** Return the current position of the cursor. */
+    acetime_t getCursor() const { return mCursor; }
+
+    /** Move the cursor to the given epochSeconds. */
+    void setCursor(acetime_t epochSeconds) { mCursor = epochSeconds; }
+
+    /**
+     * Find the first transition at or after the cursor, and move the cursor
+     * just after it. Return false, leaving the cursor unchanged, if there is
+     * no such transition within the range of the zone.
+     */
+    bool next(ZoneTransition& transition) {
+      if (mProcessor.getZoneInfo() == nullptr) return false;
+
+      int16_t year = LocalDate::forEpochSeconds(mCursor).year();
+      int16_t startYear = mProcessor.mZoneInfo.startYear();
+      int16_t untilYear = mProcessor.mZoneInfo.untilYear();
+      if (year < startYear) year = startYear;
+
+      for (; year < untilYear; year++) {
+        if (findInYear(year, true, transition)) {
+          mCursor = transition.epochSeconds + 1;
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /**
+     * Find the last transition before the cursor, and move the cursor to it.
+     * Return false, leaving the cursor unchanged, if there is no such
+     * transition within the range of the zone.
+     */
+    bool prev(ZoneTransition& transition) {
+      if (mProcessor.getZoneInfo() == nullptr) return false;
+
+      int16_t year = LocalDate::forEpochSeconds(mCursor - 1).year();
+      int16_t startYear = mProcessor.mZoneInfo.startYear();
+      int16_t untilYear = mProcessor.mZoneInfo.untilYear();
+      if (year >= untilYear) year = untilYear - 1;
+
+      for (; year >= startYear; year--) {
+        if (findInYear(year, false, transition)) {
+          mCursor = transition.epochSeconds;
+          return true;
+        }
+      }
+      return false;
+    }
+
+  private:
+    /**
+     * Search the Transitions of the given year which start in
+     * [Jan 1, Jan 1 of the next year) UTC, for the first one at or after the
+     * cursor (forward), or the last one before the cursor (backward). Each
+     * Transition belongs to exactly one year, so no transition is returned
+     * twice. The Transition before it in the Active pool supplies the
+     * offsetBefore, and Transitions which do not change the total offset or
+     * the abbreviation are skipped.
+     */
+    bool findInYear(int16_t year, bool forward, ZoneTransition& transition)
+        const {
+      if (! mProcessor.init(LocalDate::forComponents(year, 1, 1))) {
+        return false;
+      }
+      acetime_t startSeconds = LocalDate::forComponents(year, 1, 1)
+          .toEpochSeconds();
+      acetime_t untilSeconds = LocalDate::forComponents(year + 1, 1, 1)
+          .toEpochSeconds();
+
+      auto& storage = mProcessor.mTransitionStorage;
+      extended::Transition** begin = storage.getActivePoolBegin();
+      extended::Transition** end = storage.getActivePoolEnd();
+      int8_t n = end - begin;
+      for (int8_t k = 1; k < n; k++) {
+        int8_t i = forward ? k : n - k;
+        const extended::Transition* t = begin[i];
+        acetime_t seconds = t->startEpochSeconds;
+        if (seconds < startSeconds || seconds >= untilSeconds) continue;
+        if (forward ? seconds < mCursor : seconds >= mCursor) continue;
+
+        const extended::Transition* prev = begin[i - 1];
+        int8_t codeBefore = prev->offsetCode + prev->deltaCode;
+        int8_t codeAfter = t->offsetCode + t->deltaCode;
+        if (codeBefore == codeAfter && strncmp(prev->abbrev, t->abbrev,
+            extended::Transition::kAbbrevSize) == 0) {
+          continue;
+        }
+
+        transition.epochSeconds = seconds;
+        transition.offsetBefore = TimeOffset::forOffsetCode(codeBefore);
+        transition.offsetAfter = TimeOffset::forOffsetCode(codeAfter);
+        strncpy(transition.abbrev, t->abbrev, ZoneTransition::kAbbrevSize);
+        transition.abbrev[ZoneTransition::kAbbrevSize - 1] = '\0';
+        return true;
+      }
+      return false;
+    }
+
+    const ExtendedZoneProcessor& mProcessor;
+    acetime_t mCursor;
+};
+
+}
+
+#endif
@@ -5,11 +5,13 @@
 
 #include "common/util.h"
 #include "common/DateStrings.h"
+#include "common/BufferWriter.h"
 #include "ZonedDateTime.h"
 
 namespace ace_time {
 
 using common::printPad2;
+using common::BufferWriter;
 
 // Print ZonedDateTime in ISO 8601 format
 void ZonedDateTime::printTo(Print& printer) const {
@@ -24,4 +26,22 @@ void ZonedDateTime::printTo(Print& printer) const {
   printer.print(']');
 }
 
+size_t ZonedDateTime::formatTo(char* buf, size_t len) const {
+  BufferWriter writer(buf, len);
+  formatTo(writer);
+  return writer.finish();
+}
+
+void ZonedDateTime::formatTo(BufferWriter& writer) const {
+  if (isError()) {
+    writer.writeString(F("<Invalid ZonedDateTime>"));
+    return;
+  }
+
+  mOffsetDateTime.formatTo(writer);
+  writer.writeChar('[');
+  mTimeZone.formatTo(writer);
+  writer.writeChar(']');
+}
+
 }
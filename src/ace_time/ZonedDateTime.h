@@ -10,17 +10,23 @@
 #include "common/compat.h"
 #include "OffsetDateTime.h"
 #include "TimeZone.h"
+#include "Instant.h"
 
 class Print;
 
 namespace ace_time {
 
+namespace common {
+class BufferWriter;
+}
+
 /**
  * The date (year, month, day), time (hour, minute, second), and
  * a timeZone representing an instant in time. The year field is internally
  * represented as an int8_t number from -128 to 127. The value of -128 is used
  * to indicate an error condition so that range of valid year is 1873 to 2127
- * inclusive.
+ * inclusive. If ACE_TIME_EPOCH_SECONDS_64 is enabled, the range is 1 to 9999,
+ * but the TimeZone still supports only the years of its zone database.
  *
  * The "epoch" for this library is 2000-01-01 00:00:00Z. The dayOfWeek
  * (1=Sunday, 7=Saturday) is calculated internally from the date components.
@@ -40,7 +46,7 @@ class ZonedDateTime {
      * ZoneProcessor::getUtcOffsetForDateTime() determined by the actual
      * subtype of ZoneProcessor held by the given timeZone.
      *
-     * @param year [1873-2127]
+     * @param year [LocalDate::kMinYear, LocalDate::kMaxYear]
      * @param month month with January=1, December=12
      * @param day day of month [1-31]
      * @param hour hour [0-23]
@@ -80,6 +86,41 @@ class ZonedDateTime {
       return ZonedDateTime(odt, timeZone);
     }
 
+    /**
+     * Factory method. Create the ZonedDateTime of the instant as seen from
+     * the given time zone. The fraction of the second is dropped, and the UTC
+     * offset is the same as for forEpochSeconds(instant.epochSeconds()).
+     * Returns ZonedDateTime::forError() if instant is an error.
+     */
+    static ZonedDateTime forInstant(const Instant& instant,
+        const TimeZone& timeZone) {
+      return forEpochSeconds(instant.epochSeconds(), timeZone);
+    }
+
+    /**
+     * Batch version of forEpochSeconds(). Fill the 'zdts' array with the
+     * ZonedDateTime of each of the 'n' elements of 'epochSeconds' in the given
+     * timeZone, using TimeZone::getUtcOffsets() and the batch
+     * OffsetDateTime::forEpochSeconds(). Sorted or nearly sorted input is
+     * processed much faster than calling forEpochSeconds() on each element.
+     */
+    static void forEpochSeconds(const acetime_t* epochSeconds,
+        const TimeZone& timeZone, ZonedDateTime* zdts, size_t n) {
+      TimeOffset offsets[kBatchSize];
+      OffsetDateTime odts[kBatchSize];
+      while (n > 0) {
+        size_t count = (n < kBatchSize) ? n : kBatchSize;
+        timeZone.getUtcOffsets(epochSeconds, offsets, count);
+        OffsetDateTime::forEpochSeconds(epochSeconds, offsets, odts, count);
+        for (size_t i = 0; i < count; i++) {
+          zdts[i] = ZonedDateTime(odts[i], timeZone);
+        }
+        epochSeconds += count;
+        zdts += count;
+        n -= count;
+      }
+    }
+
     /**
      * Factory method to create a ZonedDateTime using the number of seconds from
      * Unix epoch.
@@ -235,6 +276,17 @@ class ZonedDateTime {
       return mOffsetDateTime.toEpochSeconds();
     }
 
+    /**
+     * Return the Instant of this ZonedDateTime, with the given fraction of
+     * the second, which a ZonedDateTime does not hold. Returns
+     * Instant::forError() if isError() is true.
+     *
+     * @param nanos nanoseconds after the second [0, 999999999]
+     */
+    Instant toInstant(uint32_t nanos = 0) const {
+      return Instant::forEpochSeconds(toEpochSeconds(), nanos);
+    }
+
     /**
      * Return the number of seconds from Unix epoch 1970-01-01 00:00:00Z. The
      * return type is a acetime_t which can represent a range of 136 years.
@@ -264,6 +316,17 @@ class ZonedDateTime {
      */
     void printTo(Print& printer) const;
 
+    /**
+     * Write the same characters as printTo() (e.g.
+     * "2018-08-31T13:48:01-07:00[America/Los_Angeles]") into the buffer of
+     * size len, terminated by NUL. Return the number of characters written,
+     * or 0 if the buffer is too small, leaving an empty string.
+     */
+    size_t formatTo(char* buf, size_t len) const;
+
+    /** Write the same characters as formatTo(char*, size_t) into writer. */
+    void formatTo(common::BufferWriter& writer) const;
+
     // Use default copy constructor and assignment operator.
     ZonedDateTime(const ZonedDateTime&) = default;
     ZonedDateTime& operator=(const ZonedDateTime&) = default;
@@ -272,6 +335,9 @@ class ZonedDateTime {
     /** Expected length of an ISO 8601 date string. */
     static const uint8_t kDateStringLength = 25;
 
+    /** Number of elements converted at a time by the batch forEpochSeconds(). */
+    static const uint8_t kBatchSize = 16;
+
     friend bool operator==(const ZonedDateTime& a, const ZonedDateTime& b);
 
     /** Constructor. From OffsetDateTime and TimeZone. */
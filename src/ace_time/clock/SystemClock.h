@@ -8,6 +8,7 @@
 
 #include <stdint.h>
 #include "../common/TimingStats.h"
+#include "../Instant.h"
 #include "Clock.h"
 
 extern "C" unsigned long millis();
@@ -21,7 +22,8 @@ namespace clock {
 /**
  * A Clock that uses the Arduino millis() function to advance the time
  * returned to the user. The real time is returned as the number of seconds
- * since the AceTime epoch of 2000-01-01T00:00:00Z.
+ * since the AceTime epoch of 2000-01-01T00:00:00Z, or by getNowInstant() as
+ * an Instant which includes the milliseconds.
  *
  * The built-in millis() is not accurate, so this class allows a periodic
  * sync using the (presumably) more accurate referenceClock. The current
@@ -71,13 +73,25 @@ class SystemClock: public Clock {
     acetime_t getNow() const override {
       if (!mIsInit) return kInvalidSeconds;
 
-      while ((uint16_t) ((uint16_t) clockMillis() - mPrevMillis) >= 1000) {
-        mPrevMillis += 1000;
-        mEpochSeconds += 1;
-      }
+      advanceTo((uint16_t) clockMillis());
       return mEpochSeconds;
     }
 
+    /**
+     * Return the same time as getNow(), plus the milliseconds elapsed since
+     * that second according to clockMillis(). Returns Instant::forError() if
+     * the clock has not been initialized. Like getNow(), this keeps the
+     * internal counter alive.
+     */
+    Instant getNowInstant() const {
+      if (!mIsInit) return Instant::forError();
+
+      uint16_t nowMillis = clockMillis();
+      advanceTo(nowMillis);
+      return Instant::forEpochMillis(mEpochSeconds,
+          (uint16_t) (nowMillis - mPrevMillis));
+    }
+
     void setNow(acetime_t epochSeconds) override {
       if (epochSeconds == kInvalidSeconds) return;
 
@@ -171,6 +185,17 @@ class SystemClock: public Clock {
       }
     }
 
+    /**
+     * Move mEpochSeconds forward by the number of whole seconds between
+     * mPrevMillis and nowMillis, leaving the remainder less than 1000.
+     */
+    void advanceTo(uint16_t nowMillis) const {
+      while ((uint16_t) (nowMillis - mPrevMillis) >= 1000) {
+        mPrevMillis += 1000;
+        mEpochSeconds += 1;
+      }
+    }
+
     Clock* const mReferenceClock;
     Clock* const mBackupClock;
 
@@ -0,0 +1,119 @@
+/*
+ * MIT License
+ * Copyright (c) 2019 Brian T. Park
+ */
+
+#ifndef ACE_TIME_COMMON_BUFFER_WRITER_H
+#define ACE_TIME_COMMON_BUFFER_WRITER_H
+
+#include <stdint.h>
+#include <stddef.h> // size_t
+#include "compat.h"
+
+class __FlashStringHelper;
+
+namespace ace_time {
+namespace common {
+
+/**
+ * The 2-digit decimal strings "00" to "99", concatenated into a single
+ * NUL-terminated string of 200 characters, in PROGMEM. Used by
+ * BufferWriter::writePad2() to convert a number into 2 characters with one
+ * lookup instead of a division.
+ */
+extern const char kDigitPairs[] PROGMEM;
+
+/**
+ * Writes characters into a buffer supplied by the caller, for the formatTo()
+ * methods of the date and time classes. Unlike a Print object, no method is
+ * virtual, so the compiler can inline the writes. If the characters do not
+ * fit into the buffer, the writer remembers the overflow, and finish() leaves
+ * an empty string in the buffer.
+ */
+class BufferWriter {
+  public:
+    /**
+     * Constructor.
+     * @param buf the destination buffer
+     * @param len the size of buf, including the space for the NUL terminator
+     */
+    BufferWriter(char* buf, size_t len):
+        mBuf(buf),
+        mLen(len),
+        mPos(0),
+        mIsOverflow(len == 0) {}
+
+    /** Return true if the buffer was too small. */
+    bool isOverflow() const { return mIsOverflow; }
+
+    /** Return the number of characters written so far. */
+    size_t length() const { return mPos; }
+
+    /** Write a single character. */
+    void writeChar(char c) {
+      if (! reserve(1)) return;
+      mBuf[mPos++] = c;
+    }
+
+    /** Write an integer from 0 to 99 as 2 digits, with a leading '0'. */
+    void writePad2(uint8_t value) {
+      if (! reserve(2)) return;
+      const char* digits = &kDigitPairs[2 * value];
+      mBuf[mPos++] = pgm_read_byte(digits);
+      mBuf[mPos++] = pgm_read_byte(digits + 1);
+    }
+
+    /** Write an integer from 0 to 9999 as 4 digits, with leading '0's. */
+    void writePad4(uint16_t value) {
+      writePad2(value / 100);
+      writePad2(value % 100);
+    }
+
+    /** Write the NUL-terminated string. */
+    void writeString(const char* s) {
+      for (; *s; s++) writeChar(*s);
+    }
+
+    /** Write the NUL-terminated string in PROGMEM. */
+    void writeString(const __FlashStringHelper* fs) {
+      const char* s = (const char*) fs;
+      for (char c = pgm_read_byte(s); c; c = pgm_read_byte(++s)) {
+        writeChar(c);
+      }
+    }
+
+    /**
+     * Terminate the string with a NUL. Return the number of characters
+     * written, or 0 if the buffer was too small, in which case it is set to
+     * an empty string.
+     */
+    size_t finish() {
+      if (mLen == 0) return 0;
+      if (mIsOverflow) {
+        mBuf[0] = '\0';
+        return 0;
+      }
+      mBuf[mPos] = '\0';
+      return mPos;
+    }
+
+  private:
+    /** Check that n characters and the NUL terminator fit. */
+    bool reserve(size_t n) {
+      if (mIsOverflow || mLen - mPos <= n) {
+        mIsOverflow = true;
+        return false;
+      }
+      return true;
+    }
+
+    char* const mBuf;
+    size_t const mLen;
+    size_t mPos;
+    bool mIsOverflow;
+};
+
+}
+}
+
+#endif
@@ -28,6 +28,30 @@ const char* const DateStrings::kMonthNames[] PROGMEM = {
   kJuly, kAugust, kSeptember, kOctober, kNovember, kDecember
 };
 
+const uint8_t DateStrings::kMonthNameLengths[] PROGMEM = {
+  5, 7, 8, 5, 5, 3, 4, 4, 6, 9, 7, 8, 8
+};
+
+static const char kErr[] PROGMEM = "Err";
+static const char kJan[] PROGMEM = "Jan";
+static const char kFeb[] PROGMEM = "Feb";
+static const char kMar[] PROGMEM = "Mar";
+static const char kApr[] PROGMEM = "Apr";
+static const char kJun[] PROGMEM = "Jun";
+static const char kJul[] PROGMEM = "Jul";
+static const char kAug[] PROGMEM = "Aug";
+static const char kSep[] PROGMEM = "Sep";
+static const char kOct[] PROGMEM = "Oct";
+static const char kNov[] PROGMEM = "Nov";
+static const char kDec[] PROGMEM = "Dec";
+
+// Separate NUL-terminated short names, so that monthShortName() can return a
+// pointer without copying. "May" is shared with the long name.
+const char* const DateStrings::kMonthShortNames[] PROGMEM = {
+  kErr, kJan, kFeb, kMar, kApr, kMay, kJun,
+  kJul, kAug, kSep, kOct, kNov, kDec
+};
+
 const uint8_t DateStrings::kNumMonthNames =
     sizeof(kMonthNames) / sizeof(const char *);
 
@@ -46,6 +70,22 @@ const char* const DateStrings::kDayOfWeekNames[] PROGMEM = {
   kError, kMonday, kTuesday, kWednesday, kThursday, kFriday, kSaturday, kSunday
 };
 
+const uint8_t DateStrings::kDayOfWeekNameLengths[] PROGMEM = {
+  5, 6, 7, 9, 8, 6, 8, 6
+};
+
+static const char kMon[] PROGMEM = "Mon";
+static const char kTue[] PROGMEM = "Tue";
+static const char kWed[] PROGMEM = "Wed";
+static const char kThu[] PROGMEM = "Thu";
+static const char kFri[] PROGMEM = "Fri";
+static const char kSat[] PROGMEM = "Sat";
+static const char kSun[] PROGMEM = "Sun";
+
+const char* const DateStrings::kDayOfWeekShortNames[] PROGMEM = {
+  kErr, kMon, kTue, kWed, kThu, kFri, kSat, kSun
+};
+
 const uint8_t DateStrings::kNumDayOfWeekNames =
     sizeof(kDayOfWeekNames) / sizeof(const char *);
 
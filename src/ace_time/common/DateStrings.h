@@ -14,11 +14,18 @@ namespace ace_time {
 
 /**
  * Class that translates a numeric month (1-12) or dayOfWeek (1-7) into a human
- * readable string. Both long and short versions can be retrieved. The object
- * uses an internal char[] buffer to store the result strings, so the strings
- * must be used before DateStrings object is destroyed. This also means that
- * the object is not thread-safe but Arduino boards are single-threaded
- * currently so we don't have to worry about this.
+ * readable string. Both long and short versions can be retrieved.
+ *
+ * The static *Name() methods return pointers into constant tables stored in
+ * flash memory (PROGMEM) on AVR and ESP8266, without copying, so they are
+ * stateless and can be shared by any number of callers. The result can be
+ * passed directly to Print::print(). The long name variants can also return
+ * the length of the name, which saves a strlen_P() when the caller copies or
+ * lays out the string. Short names are always kShortNameLength characters.
+ *
+ * The older *String() methods copy the name into an internal char[] buffer,
+ * so the returned string must be used before the DateStrings object is
+ * destroyed, and a DateStrings object must not be shared.
  *
  * Inspired by the DateStrings.cpp file in
  * https://github.com/PaulStoffregen/Time/blob/master/DateStrings.cpp.
@@ -31,39 +38,90 @@ class DateStrings {
     static const uint8_t kBufferSize = 10;
 
     /**
-     * Number of prefix characters to use to create a short name.
+     * Length of every short name, which is the prefix of the long name.
      * kShortNameLength < kBufferSize must be true.
      */
     static const uint8_t kShortNameLength = 3;
 
     /** Return the long month name. 0=Error, 1=January, 12=December. */
+    static const __FlashStringHelper* monthLongName(uint8_t month) {
+      return FPSTR(getStringAt(kMonthNames, monthIndex(month)));
+    }
+
+    /** Return the long month name and its length in 'length'. */
+    static const __FlashStringHelper* monthLongName(uint8_t month,
+        uint8_t& length) {
+      uint8_t index = monthIndex(month);
+      length = pgm_read_byte(&kMonthNameLengths[index]);
+      return FPSTR(getStringAt(kMonthNames, index));
+    }
+
+    /** Return the short month name. 0=Err, 1=Jan, 12=Dec. */
+    static const __FlashStringHelper* monthShortName(uint8_t month) {
+      return FPSTR(getStringAt(kMonthShortNames, monthIndex(month)));
+    }
+
+    /** Return the long dayOfWeek name. 0=Error, 1=Monday, 7=Sunday. */
+    static const __FlashStringHelper* dayOfWeekLongName(uint8_t dayOfWeek) {
+      return FPSTR(getStringAt(kDayOfWeekNames, dayOfWeekIndex(dayOfWeek)));
+    }
+
+    /** Return the long dayOfWeek name and its length in 'length'. */
+    static const __FlashStringHelper* dayOfWeekLongName(uint8_t dayOfWeek,
+        uint8_t& length) {
+      uint8_t index = dayOfWeekIndex(dayOfWeek);
+      length = pgm_read_byte(&kDayOfWeekNameLengths[index]);
+      return FPSTR(getStringAt(kDayOfWeekNames, index));
+    }
+
+    /** Return the short dayOfWeek name. 0=Err, 1=Mon, 7=Sun. */
+    static const __FlashStringHelper* dayOfWeekShortName(uint8_t dayOfWeek) {
+      return FPSTR(getStringAt(kDayOfWeekShortNames,
+          dayOfWeekIndex(dayOfWeek)));
+    }
+
+    /**
+     * Return the long month name, copied into the internal buffer.
+     * 0=Error, 1=January, 12=December.
+     */
     const char* monthLongString(uint8_t month) {
-      uint8_t index = (month < kNumMonthNames) ? month : 0;
-      strncpy_P(mBuffer, getStringAt(kMonthNames, index), kBufferSize);
+      strncpy_P(mBuffer, getStringAt(kMonthNames, monthIndex(month)),
+          kBufferSize);
       mBuffer[kBufferSize - 1] = '\0';
       return mBuffer;
     }
 
-    /** Return the short month name. 0=Err, 1=Jan, 12=Dec. */
+    /**
+     * Return the short month name, copied into the internal buffer.
+     * 0=Err, 1=Jan, 12=Dec.
+     */
     const char* monthShortString(uint8_t month) {
-      uint8_t index = (month < kNumMonthNames) ? month : 0;
-      strncpy_P(mBuffer, getStringAt(kMonthNames, index), kShortNameLength);
+      strncpy_P(mBuffer, getStringAt(kMonthShortNames, monthIndex(month)),
+          kBufferSize);
       mBuffer[kShortNameLength] = '\0';
       return mBuffer;
     }
 
-    /** Return the short dayOfWeek name. 0=Error, 1=Monday, 7=Sunday. */
+    /**
+     * Return the long dayOfWeek name, copied into the internal buffer.
+     * 0=Error, 1=Monday, 7=Sunday.
+     */
     const char* dayOfWeekLongString(uint8_t dayOfWeek) {
-      uint8_t index = (dayOfWeek < kNumDayOfWeekNames) ? dayOfWeek : 0;
-      strncpy_P(mBuffer, getStringAt(kDayOfWeekNames, index), kBufferSize);
+      strncpy_P(mBuffer,
+          getStringAt(kDayOfWeekNames, dayOfWeekIndex(dayOfWeek)),
+          kBufferSize);
       mBuffer[kBufferSize - 1] = '\0';
       return mBuffer;
     }
 
-    /** Return the short dayOfWeek name. 0=Err, 1=Mon, 7=Sun. */
+    /**
+     * Return the short dayOfWeek name, copied into the internal buffer.
+     * 0=Err, 1=Mon, 7=Sun.
+     */
     const char* dayOfWeekShortString(uint8_t dayOfWeek) {
-      uint8_t index = (dayOfWeek < kNumDayOfWeekNames) ? dayOfWeek : 0;
-      strncpy_P(mBuffer, getStringAt(kDayOfWeekNames, index), kShortNameLength);
+      strncpy_P(mBuffer,
+          getStringAt(kDayOfWeekShortNames, dayOfWeekIndex(dayOfWeek)),
+          kBufferSize);
       mBuffer[kShortNameLength] = '\0';
       return mBuffer;
     }
@@ -73,8 +131,22 @@ class DateStrings {
       return (const char*) pgm_read_ptr(&strings[i]);
     }
 
+    /** Map an invalid month to 0, which selects the error name. */
+    static uint8_t monthIndex(uint8_t month) {
+      return (month < kNumMonthNames) ? month : 0;
+    }
+
+    /** Map an invalid dayOfWeek to 0, which selects the error name. */
+    static uint8_t dayOfWeekIndex(uint8_t dayOfWeek) {
+      return (dayOfWeek < kNumDayOfWeekNames) ? dayOfWeek : 0;
+    }
+
     static const char * const kDayOfWeekNames[];
+    static const char * const kDayOfWeekShortNames[];
+    static const uint8_t kDayOfWeekNameLengths[];
     static const char * const kMonthNames[];
+    static const char * const kMonthShortNames[];
+    static const uint8_t kMonthNameLengths[];
     static const uint8_t kNumDayOfWeekNames;
     static const uint8_t kNumMonthNames;
 
@@ -63,6 +63,31 @@ class TimingStats {
       mExpDecayAvg = (mExpDecayAvg + duration) / 2;
     }
 
+    /**
+     * Combine the stats collected by another TimingStats into this one. The
+     * exponential decay average becomes the average of the two, weighted by
+     * their counts, so that an instance with no updates leaves it unchanged.
+     */
+    void merge(const TimingStats& other) {
+      mCounter += other.mCounter;
+      if (other.mCount == 0) return;
+      if (mCount == 0) {
+        mExpDecayAvg = other.mExpDecayAvg;
+      } else {
+        mExpDecayAvg = ((uint64_t) mExpDecayAvg * mCount
+            + (uint64_t) other.mExpDecayAvg * other.mCount)
+            / ((uint32_t) mCount + other.mCount);
+      }
+      mCount += other.mCount;
+      mSum += other.mSum;
+      if (other.mMin < mMin) {
+        mMin = other.mMin;
+      }
+      if (other.mMax > mMax) {
+        mMax = other.mMax;
+      }
+    }
+
   private:
     uint16_t mExpDecayAvg;
     uint16_t mMin;
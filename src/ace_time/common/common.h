@@ -8,14 +8,46 @@
 
 #include <stdint.h>
 
+/**
+ * Set to 1 to make acetime_t a 64-bit integer, and to extend the range of
+ * LocalDate (and the classes built on it) from [1873, 2127] to [1, 9999].
+ * This costs 4 more bytes for every acetime_t stored in RAM or flash (e.g.
+ * in the Transition caches of the zone processors), 1 more byte for every
+ * LocalDate, and 64-bit arithmetic for every epochSeconds calculation, which
+ * is slow on 8-bit processors. The zone processors still support only the
+ * years of their zone database. Disabled by default.
+ */
+#ifndef ACE_TIME_EPOCH_SECONDS_64
+  #define ACE_TIME_EPOCH_SECONDS_64 0
+#endif
+
 namespace ace_time {
 
 /**
  * Type for the number of seconds from epoch. AceTime epoch is 2000-01-01
- * 00:00:00Z. Unix epoch is 1970-01-01 00:00:00Z.
+ * 00:00:00Z. Unix epoch is 1970-01-01 00:00:00Z. A 32-bit signed integer
+ * unless ACE_TIME_EPOCH_SECONDS_64 is enabled.
  */
+#if ACE_TIME_EPOCH_SECONDS_64
+typedef int64_t acetime_t;
+#else
 typedef int32_t acetime_t;
+#endif
 
 }
 
+/** Smallest value of acetime_t, used as the invalid sentinel. */
+#if ACE_TIME_EPOCH_SECONDS_64
+  #define ACETIME_T_MIN INT64_MIN
+#else
+  #define ACETIME_T_MIN INT32_MIN
+#endif
+
+/** Largest value of acetime_t. */
+#if ACE_TIME_EPOCH_SECONDS_64
+  #define ACETIME_T_MAX INT64_MAX
+#else
+  #define ACETIME_T_MAX INT32_MAX
+#endif
+
 #endif
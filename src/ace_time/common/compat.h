@@ -26,6 +26,16 @@
   #define ACE_TIME_PROGMEM
 #endif
 
+/**
+ * Determine if the extended::ZoneInfo records are read from a binary zone
+ * database mapped into memory (see MappedZoneDb) instead of the zonedbx files
+ * compiled into the program. Only for Linux or MacOS. When enabled, the
+ * zonedbx::kZone* objects must not be given to an ExtendedZoneProcessor.
+ */
+#ifndef ACE_TIME_USE_MAPPED_ZONEDB
+#define ACE_TIME_USE_MAPPED_ZONEDB 0
+#endif
+
 // Include the correct pgmspace.h depending on architecture. Define a
 // consistent acetime_strcmp_P() which can be passed as a function pointer
 // into the ZoneManager template class.
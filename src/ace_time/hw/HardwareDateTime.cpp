@@ -34,7 +34,7 @@ void HardwareDateTime::printTo(Print& printer) const {
   printPad2(printer, second);
 
   // Week day
-  printer.print(DateStrings().dayOfWeekLongString(dayOfWeek));
+  printer.print(DateStrings::dayOfWeekLongName(dayOfWeek));
 }
 
 
@@ -30,6 +30,11 @@
  * source code replacement of direct zoneinfo access to using these data
  * brokers.
  *
+ * The Mapped*Broker classes read the same records from a binary zone database
+ * file (see MappedZoneInfo.h) which was mapped into memory at runtime. They
+ * are used by the extended:: typedefs when ACE_TIME_USE_MAPPED_ZONEDB is
+ * enabled.
+ *
  * The core broker classes live in the common:: namespace and are templatized
  * so that they can be used for both basic::Zone* classes and the
  * extended::Zone* classes. Specific template instantiations are created in the
@@ -39,6 +44,7 @@
 
 #include "../common/compat.h"
 #include "ZoneInfo.h"
+#include "MappedZoneInfo.h"
 
 namespace ace_time {
 
@@ -467,6 +473,261 @@ class FlashZoneRegistryBroker {
     const ZI* const* mZoneRegistry;
 };
 
+//----------------------------------------------------------------------------
+// Data brokers for reading from a binary zone database file.
+//----------------------------------------------------------------------------
+
+/**
+ * Data broker for accessing a ZoneRule record of a binary zone database (see
+ * MappedZoneInfo.h). The ZR pointer is the address of the record, it cannot
+ * be dereferenced as a ZR.
+ */
+template <typename ZR>
+class MappedZoneRuleBroker {
+  public:
+    explicit MappedZoneRuleBroker(const ZR* zoneRule):
+        mZoneRule((const uint8_t*) zoneRule) {}
+
+    MappedZoneRuleBroker():
+        mZoneRule(nullptr) {}
+
+    // use the default copy constructor
+    MappedZoneRuleBroker(const MappedZoneRuleBroker&) = default;
+
+    // use the default assignment operator
+    MappedZoneRuleBroker& operator=(const MappedZoneRuleBroker&) = default;
+
+    bool isNull() const { return mZoneRule == nullptr; }
+
+    bool isNotNull() const { return mZoneRule != nullptr; }
+
+    int8_t fromYearTiny() const {
+      return (int8_t) mZoneRule[mapped::kZoneRuleFromYearTiny];
+    }
+
+    int8_t toYearTiny() const {
+      return (int8_t) mZoneRule[mapped::kZoneRuleToYearTiny];
+    }
+
+    int8_t inMonth() const {
+      return (int8_t) mZoneRule[mapped::kZoneRuleInMonth];
+    }
+
+    int8_t onDayOfWeek() const {
+      return (int8_t) mZoneRule[mapped::kZoneRuleOnDayOfWeek];
+    }
+
+    int8_t onDayOfMonth() const {
+      return (int8_t) mZoneRule[mapped::kZoneRuleOnDayOfMonth];
+    }
+
+    uint8_t atTimeCode() const {
+      return mZoneRule[mapped::kZoneRuleAtTimeCode];
+    }
+
+    uint8_t atTimeModifier() const {
+      return mZoneRule[mapped::kZoneRuleAtTimeModifier];
+    }
+
+    int8_t deltaCode() const {
+      return (int8_t) mZoneRule[mapped::kZoneRuleDeltaCode];
+    }
+
+    uint8_t letter() const {
+      return mZoneRule[mapped::kZoneRuleLetter];
+    }
+
+  private:
+    const uint8_t* mZoneRule;
+};
+
+/** Data broker for accessing a ZonePolicy record of a binary zone database. */
+template <typename ZP, typename ZR>
+class MappedZonePolicyBroker {
+  public:
+    explicit MappedZonePolicyBroker(const ZP* zonePolicy):
+        mZonePolicy((const uint8_t*) zonePolicy) {}
+
+    // use default copy constructor
+    MappedZonePolicyBroker(const MappedZonePolicyBroker&) = default;
+
+    // use default assignment operator
+    MappedZonePolicyBroker& operator=(const MappedZonePolicyBroker&) = default;
+
+    bool isNull() const { return mZonePolicy == nullptr; }
+
+    bool isNotNull() const { return mZonePolicy != nullptr; }
+
+    uint8_t numRules() const {
+      return mZonePolicy[mapped::kZonePolicyNumRules];
+    }
+
+    const MappedZoneRuleBroker<ZR> rule(uint8_t i) const {
+      const uint8_t* rules = mapped::readPointer(
+          mZonePolicy + mapped::kZonePolicyRules);
+      return MappedZoneRuleBroker<ZR>(
+          (const ZR*) (rules + i * mapped::kZoneRuleSize));
+    }
+
+    uint8_t numLetters() const {
+      return mZonePolicy[mapped::kZonePolicyNumLetters];
+    }
+
+    const char* letter(uint8_t i) const {
+      const uint8_t* letters = mapped::readPointer(
+          mZonePolicy + mapped::kZonePolicyLetters);
+      return (const char*) mapped::readPointer(
+          letters + i * mapped::kOffsetSize);
+    }
+
+  private:
+    const uint8_t* mZonePolicy;
+};
+
+/** Data broker for accessing a ZoneEra record of a binary zone database. */
+template <typename ZE, typename ZP, typename ZR>
+class MappedZoneEraBroker {
+  public:
+    explicit MappedZoneEraBroker(const ZE* zoneEra):
+        mZoneEra((const uint8_t*) zoneEra) {}
+
+    MappedZoneEraBroker():
+        mZoneEra(nullptr) {}
+
+    // use default copy constructor
+    MappedZoneEraBroker(const MappedZoneEraBroker&) = default;
+
+    // use default assignment operator
+    MappedZoneEraBroker& operator=(const MappedZoneEraBroker&) = default;
+
+    const ZE* zoneEra() const { return (const ZE*) mZoneEra; }
+
+    bool isNull() const { return mZoneEra == nullptr; }
+
+    bool isNotNull() const { return mZoneEra != nullptr; }
+
+    int8_t offsetCode() const {
+      return (int8_t) mZoneEra[mapped::kZoneEraOffsetCode];
+    }
+
+    const MappedZonePolicyBroker<ZP, ZR> zonePolicy() const {
+      return MappedZonePolicyBroker<ZP, ZR>((const ZP*)
+          mapped::readPointer(mZoneEra + mapped::kZoneEraZonePolicy));
+    }
+
+    int8_t deltaCode() const {
+      return (int8_t) mZoneEra[mapped::kZoneEraDeltaCode];
+    }
+
+    const char* format() const {
+      return (const char*) mapped::readPointer(
+          mZoneEra + mapped::kZoneEraFormat);
+    }
+
+    int8_t untilYearTiny() const {
+      return (int8_t) mZoneEra[mapped::kZoneEraUntilYearTiny];
+    }
+
+    uint8_t untilMonth() const {
+      return mZoneEra[mapped::kZoneEraUntilMonth];
+    }
+
+    uint8_t untilDay() const {
+      return mZoneEra[mapped::kZoneEraUntilDay];
+    }
+
+    uint8_t untilTimeCode() const {
+      return mZoneEra[mapped::kZoneEraUntilTimeCode];
+    }
+
+    uint8_t untilTimeModifier() const {
+      return mZoneEra[mapped::kZoneEraUntilTimeModifier];
+    }
+
+  private:
+    const uint8_t* mZoneEra;
+};
+
+/** Data broker for accessing a ZoneInfo record of a binary zone database. */
+template <typename ZI, typename ZE, typename ZP, typename ZR, typename ZC>
+class MappedZoneInfoBroker {
+  public:
+    explicit MappedZoneInfoBroker(const ZI* zoneInfo):
+        mZoneInfo((const uint8_t*) zoneInfo) {}
+
+    // use default copy constructor
+    MappedZoneInfoBroker(const MappedZoneInfoBroker&) = default;
+
+    // use default assignment operator
+    MappedZoneInfoBroker& operator=(const MappedZoneInfoBroker&) = default;
+
+    const ZI* zoneInfo() const { return (const ZI*) mZoneInfo; }
+
+    const char* name() const {
+      return (const char*) mapped::readPointer(
+          mZoneInfo + mapped::kZoneInfoName);
+    }
+
+    uint32_t zoneId() const {
+      return mapped::readUint32(mZoneInfo + mapped::kZoneInfoZoneId);
+    }
+
+    int16_t startYear() const {
+      return (int16_t) mapped::readUint16(zoneContext()
+          + mapped::kZoneContextStartYear);
+    }
+
+    int16_t untilYear() const {
+      return (int16_t) mapped::readUint16(zoneContext()
+          + mapped::kZoneContextUntilYear);
+    }
+
+    uint8_t numEras() const {
+      return mZoneInfo[mapped::kZoneInfoNumEras];
+    }
+
+    const MappedZoneEraBroker<ZE, ZP, ZR> era(uint8_t i) const {
+      const uint8_t* eras = mapped::readPointer(
+          mZoneInfo + mapped::kZoneInfoEras);
+      return MappedZoneEraBroker<ZE, ZP, ZR>(
+          (const ZE*) (eras + i * mapped::kZoneEraSize));
+    }
+
+  private:
+    const uint8_t* zoneContext() const {
+      return mapped::readPointer(mZoneInfo + mapped::kZoneInfoZoneContext);
+    }
+
+    const uint8_t* mZoneInfo;
+};
+
+/**
+ * Data broker for accessing the ZoneRegistry of a binary zone database. The
+ * ZoneRegistry is an array of offsets to ZoneInfo records, whose address is
+ * given by MappedZoneDb::zoneRegistry().
+ */
+template <typename ZI>
+class MappedZoneRegistryBroker {
+  public:
+    explicit MappedZoneRegistryBroker(const ZI* const* zoneRegistry):
+        mZoneRegistry((const uint8_t*) zoneRegistry) {}
+
+    // use default copy constructor
+    MappedZoneRegistryBroker(const MappedZoneRegistryBroker&) = default;
+
+    // use default assignment operator
+    MappedZoneRegistryBroker& operator=(const MappedZoneRegistryBroker&) =
+        default;
+
+    const ZI* zoneInfo(uint16_t i) const {
+      return (const ZI*) mapped::readPointer(
+          mZoneRegistry + i * mapped::kOffsetSize);
+    }
+
+  private:
+    const uint8_t* mZoneRegistry;
+};
+
 }
 
 //----------------------------------------------------------------------------
@@ -494,7 +755,15 @@ typedef common::DirectZoneRegistryBroker<ZoneInfo> ZoneRegistryBroker;
 
 namespace extended {
 
-#if ACE_TIME_USE_PROGMEM
+#if ACE_TIME_USE_MAPPED_ZONEDB
+typedef common::MappedZoneRuleBroker<ZoneRule> ZoneRuleBroker;
+typedef common::MappedZonePolicyBroker<ZonePolicy, ZoneRule> ZonePolicyBroker;
+typedef common::MappedZoneEraBroker<ZoneEra, ZonePolicy, ZoneRule>
+    ZoneEraBroker;
+typedef common::MappedZoneInfoBroker<ZoneInfo, ZoneEra, ZonePolicy, ZoneRule,
+    ZoneContext> ZoneInfoBroker;
+typedef common::MappedZoneRegistryBroker<ZoneInfo> ZoneRegistryBroker;
+#elif ACE_TIME_USE_PROGMEM
 typedef common::FlashZoneRuleBroker<ZoneRule> ZoneRuleBroker;
 typedef common::FlashZonePolicyBroker<ZonePolicy, ZoneRule> ZonePolicyBroker;
 typedef common::FlashZoneEraBroker<ZoneEra, ZonePolicy, ZoneRule> ZoneEraBroker;
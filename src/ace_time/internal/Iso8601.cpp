@@ -0,0 +1,201 @@
+/*
+ * MIT License
+ * Copyright (c) 2019 Brian T. Park
+ */
+
+#include "../LocalDate.h"
+#include "Iso8601.h"
+
+#if ACE_TIME_ISO8601_SIMD
+  #include <emmintrin.h> // SSE2
+  #if defined(__SSSE3__)
+    #include <tmmintrin.h> // SSSE3
+  #endif
+#endif
+
+namespace ace_time {
+namespace iso8601 {
+
+/** Return true if c is an ASCII digit. */
+static inline bool isDigit(char c) {
+  return (uint8_t) (c - '0') <= 9;
+}
+
+/**
+ * Parse exactly n digits at s[pos], advancing pos. Return false if there are
+ * fewer than n characters left, or if one of them is not a digit.
+ */
+static bool parseDigits(const char* s, size_t len, size_t& pos, uint8_t n,
+    uint16_t& value) {
+  if (len - pos < n) return false;
+  value = 0;
+  for (uint8_t i = 0; i < n; i++) {
+    char c = s[pos + i];
+    if (! isDigit(c)) return false;
+    value = value * 10 + (c - '0');
+  }
+  pos += n;
+  return true;
+}
+
+/** Return true if s[pos] is the character c, advancing pos. */
+static bool parseChar(const char* s, size_t len, size_t& pos, char c) {
+  if (pos >= len || s[pos] != c) return false;
+  pos++;
+  return true;
+}
+
+/**
+ * Parse "YYYY-MM-DDThh:mm" or "YYYYMMDDThhmm" at the start of s. Return the
+ * number of characters consumed, or 0 on error.
+ */
+static size_t parsePrefix(const char* s, size_t len, DateTimeFields& fields,
+    bool& isExtended) {
+  size_t pos = 0;
+  uint16_t year, month, day, hour, minute;
+  if (! parseDigits(s, len, pos, 4, year)) return 0;
+  isExtended = parseChar(s, len, pos, '-');
+  if (! parseDigits(s, len, pos, 2, month)) return 0;
+  if (isExtended && ! parseChar(s, len, pos, '-')) return 0;
+  if (! parseDigits(s, len, pos, 2, day)) return 0;
+
+  if (pos >= len) return 0;
+  char sep = s[pos++];
+  if (sep != 'T' && sep != 't' && sep != ' ') return 0;
+
+  if (! parseDigits(s, len, pos, 2, hour)) return 0;
+  if (isExtended && ! parseChar(s, len, pos, ':')) return 0;
+  if (! parseDigits(s, len, pos, 2, minute)) return 0;
+
+  fields.year = year;
+  fields.month = month;
+  fields.day = day;
+  fields.hour = hour;
+  fields.minute = minute;
+  return pos;
+}
+
+#if ACE_TIME_ISO8601_SIMD
+
+/**
+ * Validate and convert the 16 characters of "YYYY-MM-DDThh:mm" with SSE.
+ * The 12 digits are checked by a single unsigned comparison of (c - '0')
+ * with 9, and the 4 separators by a comparison with a template. Return false
+ * if any character does not match, without setting the fields. The caller
+ * guarantees that 16 characters can be read.
+ */
+static bool parsePrefixSimd(const char* s, DateTimeFields& fields) {
+  const __m128i input = _mm_loadu_si128((const __m128i*) s);
+  const __m128i separators = _mm_setr_epi8(
+      0, 0, 0, 0, '-', 0, 0, '-', 0, 0, 'T', 0, 0, ':', 0, 0);
+  const __m128i digitMask = _mm_setr_epi8(
+      -1, -1, -1, -1, 0, -1, -1, 0, -1, -1, 0, -1, -1, 0, -1, -1);
+
+  const __m128i digits = _mm_sub_epi8(input, _mm_set1_epi8('0'));
+  const __m128i isDigit = _mm_cmpeq_epi8(
+      _mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+  const __m128i isSeparator = _mm_cmpeq_epi8(input, separators);
+  const __m128i isValid = _mm_or_si128(
+      _mm_and_si128(digitMask, isDigit),
+      _mm_andnot_si128(digitMask, isSeparator));
+  if (_mm_movemask_epi8(isValid) != 0xFFFF) return false;
+
+#if defined(__SSSE3__)
+  // Gather the digits into pairs, then combine each pair into a 16-bit lane
+  // with 10 * tens + ones: [YY, YY, MM, DD, hh, mm, 0, 0].
+  const __m128i pairs = _mm_shuffle_epi8(digits, _mm_setr_epi8(
+      0, 1, 2, 3, 5, 6, 8, 9, 11, 12, 14, 15, -1, -1, -1, -1));
+  const __m128i values = _mm_maddubs_epi16(pairs, _mm_setr_epi8(
+      10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+  fields.year = _mm_extract_epi16(values, 0) * 100
+      + _mm_extract_epi16(values, 1);
+  fields.month = _mm_extract_epi16(values, 2);
+  fields.day = _mm_extract_epi16(values, 3);
+  fields.hour = _mm_extract_epi16(values, 4);
+  fields.minute = _mm_extract_epi16(values, 5);
+#else
+  uint8_t d[16];
+  _mm_storeu_si128((__m128i*) d, digits);
+  fields.year = d[0] * 1000 + d[1] * 100 + d[2] * 10 + d[3];
+  fields.month = d[5] * 10 + d[6];
+  fields.day = d[8] * 10 + d[9];
+  fields.hour = d[11] * 10 + d[12];
+  fields.minute = d[14] * 10 + d[15];
+#endif
+  return true;
+}
+
+#endif
+
+size_t parseDateTime(const char* s, size_t len, DateTimeFields& fields) {
+  size_t pos = 0;
+  bool isExtended = true;
+#if ACE_TIME_ISO8601_SIMD
+  if (len >= 16 && parsePrefixSimd(s, fields)) pos = 16;
+#endif
+  if (pos == 0) {
+    pos = parsePrefix(s, len, fields, isExtended);
+    if (pos == 0) return 0;
+  }
+
+  // Optional seconds, in the same form as the date.
+  uint16_t second = 0;
+  bool hasSeconds;
+  if (isExtended) {
+    hasSeconds = parseChar(s, len, pos, ':');
+    if (hasSeconds && ! parseDigits(s, len, pos, 2, second)) return 0;
+  } else {
+    hasSeconds = (len - pos >= 2) && isDigit(s[pos]);
+    if (hasSeconds && ! parseDigits(s, len, pos, 2, second)) return 0;
+  }
+  fields.second = second;
+
+  // Optional fraction of the second, truncated to nanoseconds.
+  uint32_t nanos = 0;
+  if (hasSeconds && pos < len && (s[pos] == '.' || s[pos] == ',')) {
+    pos++;
+    if (pos >= len || ! isDigit(s[pos])) return 0;
+    uint32_t scale = 100000000;
+    for (; pos < len && isDigit(s[pos]); pos++) {
+      nanos += (s[pos] - '0') * scale;
+      scale /= 10;
+    }
+  }
+  fields.nanos = nanos;
+
+  // Optional UTC offset.
+  fields.hasOffset = false;
+  fields.offsetMinutes = 0;
+  if (pos < len) {
+    char c = s[pos];
+    if (c == 'Z' || c == 'z') {
+      pos++;
+      fields.hasOffset = true;
+    } else if (c == '+' || c == '-') {
+      pos++;
+      uint16_t offsetHour;
+      uint16_t offsetMinute = 0;
+      if (! parseDigits(s, len, pos, 2, offsetHour)) return 0;
+      if (parseChar(s, len, pos, ':')) {
+        if (! parseDigits(s, len, pos, 2, offsetMinute)) return 0;
+      } else if (len - pos >= 2 && isDigit(s[pos])) {
+        parseDigits(s, len, pos, 2, offsetMinute);
+      }
+      if (offsetHour > 23 || offsetMinute > 59) return 0;
+      int16_t minutes = offsetHour * 60 + offsetMinute;
+      fields.hasOffset = true;
+      fields.offsetMinutes = (c == '-') ? -minutes : minutes;
+    }
+  }
+
+  if (fields.month < 1 || fields.month > 12) return 0;
+  if (fields.day < 1
+      || fields.day > LocalDate::daysInMonth(fields.year, fields.month)) {
+    return 0;
+  }
+  if (fields.hour > 23 || fields.minute > 59 || fields.second > 59) return 0;
+  return pos;
+}
+
+}
+}
@@ -0,0 +1,79 @@
+/*
+ * MIT License
+ * Copyright (c) 2019 Brian T. Park
+ */
+
+#ifndef ACE_TIME_ISO8601_H
+#define ACE_TIME_ISO8601_H
+
+#include <stdint.h>
+#include <stddef.h> // size_t
+#include "../common/common.h"
+
+/**
+ * Set to 1 to let iso8601::parseDateTime() validate and convert the fixed
+ * width "YYYY-MM-DDThh:mm" prefix of the common extended format with SSE2
+ * instructions, and SSSE3 instructions if they are enabled by the compiler
+ * flags (e.g. -mssse3 or -march=native). Any string which does not match the
+ * prefix exactly falls back to the portable parser. Enabled by default when
+ * the target supports SSE2 (all x86_64 processors).
+ */
+#ifndef ACE_TIME_ISO8601_SIMD
+  #if defined(__SSE2__)
+    #define ACE_TIME_ISO8601_SIMD 1
+  #else
+    #define ACE_TIME_ISO8601_SIMD 0
+  #endif
+#endif
+
+namespace ace_time {
+namespace iso8601 {
+
+/**
+ * The components of an ISO 8601 date-time string, as parsed by
+ * parseDateTime(). The fields are not validated against the range of
+ * LocalDate or TimeOffset, which is left to the caller.
+ */
+struct DateTimeFields {
+  int16_t year;
+  uint8_t month;
+  uint8_t day;
+  uint8_t hour;
+  uint8_t minute;
+  uint8_t second;
+
+  /** The fraction of the second in nanoseconds, 0 if absent. */
+  uint32_t nanos;
+
+  /** True if a UTC offset or 'Z' was given. */
+  bool hasOffset;
+
+  /** The UTC offset in minutes, 0 for 'Z' or if absent. */
+  int16_t offsetMinutes;
+};
+
+/**
+ * Parse an ISO 8601 date-time at the start of the buffer of the given length,
+ * which does not need to be NUL-terminated, and return the number of
+ * characters consumed, or 0 if the buffer does not start with a valid
+ * date-time. The following forms are accepted:
+ *
+ *    * date: "YYYY-MM-DD" (extended) or "YYYYMMDD" (basic)
+ *    * separator: 'T', 't' or ' '
+ *    * time: "hh:mm", "hh:mm:ss" (extended) or "hhmm", "hhmmss" (basic), in
+ *      the same form as the date
+ *    * fraction: '.' or ',' followed by 1 or more digits, only after the
+ *      seconds; digits beyond the 9th are ignored
+ *    * offset (optional): 'Z', 'z', "+hh", "+hh:mm" or "+hhmm", with '+' or
+ *      '-'
+ *
+ * The month, day, hour, minute and second are range checked (leap seconds
+ * and 24:00 are rejected), including the number of days of the month. The
+ * caller decides whether characters after the date-time are an error.
+ */
+size_t parseDateTime(const char* s, size_t len, DateTimeFields& fields);
+
+}
+}
+
+#endif
@@ -0,0 +1,151 @@
+/*
+ * MIT License
+ * Copyright (c) 2019 Brian T. Park
+ */
+
+#ifndef ACE_TIME_MAPPED_ZONE_INFO_H
+#define ACE_TIME_MAPPED_ZONE_INFO_H
+
+/**
+ * @file MappedZoneInfo.h
+ *
+ * Layout of the binary zone database file which is read by the Mapped*Broker
+ * classes in Brokers.h, and written by tools/bingenerator.py. The file
+ * contains the same ZoneContext, ZoneInfo, ZoneEra, ZonePolicy and ZoneRule
+ * records as the zonedb/ and zonedbx/ files, but every pointer is replaced by
+ * a signed 32-bit offset relative to the location of the offset field itself
+ * (0 means nullptr). The file is therefore position-independent, and can be
+ * read in place from any address, e.g. from a read-only mmap() shared by
+ * multiple processes, without relocation or copying.
+ *
+ * All multi-byte integers are little-endian, and are read one byte at a time,
+ * so the records do not need to be aligned and the file can be read by a
+ * big-endian processor. All sizes and offsets below are in bytes.
+ *
+ * Header (kHeaderSize):
+ *
+ *    * 0: char[4] magic, "ACTZ"
+ *    * 4: uint16 format version, kVersion
+ *    * 6: uint8 scope, kScopeBasic or kScopeExtended
+ *    * 7: uint8 reserved
+ *    * 8: uint32 size of the file
+ *    * 12: ZoneContext record (kZoneContextSize)
+ *    * 20: uint16 number of zones
+ *    * 22: uint16 reserved
+ *    * 24: offset to an array of offsets to ZoneInfo, sorted by name
+ *    * 28: offset to an array of offsets to ZoneInfo, sorted by zoneId
+ *
+ * The records are described by the kXxx constants of each record type. A
+ * ZoneInfo points to an array of numEras ZoneEra records, a ZonePolicy points
+ * to an array of numRules ZoneRule records and to an array of numLetters
+ * offsets to strings. Strings are NUL terminated.
+ */
+
+#include <stdint.h>
+
+namespace ace_time {
+namespace mapped {
+
+/** Magic bytes at the start of the file. */
+static const char kMagic[4] = {'A', 'C', 'T', 'Z'};
+
+/** Version of the file format described in this file. */
+static const uint16_t kVersion = 1;
+
+/** Scope of a file generated for BasicZoneProcessor. */
+static const uint8_t kScopeBasic = 1;
+
+/** Scope of a file generated for ExtendedZoneProcessor. */
+static const uint8_t kScopeExtended = 2;
+
+// Header
+static const uint8_t kHeaderMagic = 0;
+static const uint8_t kHeaderVersion = 4;
+static const uint8_t kHeaderScope = 6;
+static const uint8_t kHeaderFileSize = 8;
+static const uint8_t kHeaderZoneContext = 12;
+static const uint8_t kHeaderNumZones = 20;
+static const uint8_t kHeaderRegistry = 24;
+static const uint8_t kHeaderRegistryById = 28;
+static const uint8_t kHeaderSize = 32;
+
+// ZoneContext
+static const uint8_t kZoneContextStartYear = 0;
+static const uint8_t kZoneContextUntilYear = 2;
+static const uint8_t kZoneContextTzVersion = 4;
+static const uint8_t kZoneContextSize = 8;
+
+// ZoneInfo
+static const uint8_t kZoneInfoName = 0;
+static const uint8_t kZoneInfoZoneId = 4;
+static const uint8_t kZoneInfoZoneContext = 8;
+static const uint8_t kZoneInfoEras = 12;
+static const uint8_t kZoneInfoTransitionBufSize = 16;
+static const uint8_t kZoneInfoNumEras = 17;
+static const uint8_t kZoneInfoSize = 20;
+
+// ZoneEra
+static const uint8_t kZoneEraZonePolicy = 0;
+static const uint8_t kZoneEraFormat = 4;
+static const uint8_t kZoneEraOffsetCode = 8;
+static const uint8_t kZoneEraDeltaCode = 9;
+static const uint8_t kZoneEraUntilYearTiny = 10;
+static const uint8_t kZoneEraUntilMonth = 11;
+static const uint8_t kZoneEraUntilDay = 12;
+static const uint8_t kZoneEraUntilTimeCode = 13;
+static const uint8_t kZoneEraUntilTimeModifier = 14;
+static const uint8_t kZoneEraSize = 16;
+
+// ZonePolicy
+static const uint8_t kZonePolicyRules = 0;
+static const uint8_t kZonePolicyLetters = 4;
+static const uint8_t kZonePolicyNumRules = 8;
+static const uint8_t kZonePolicyNumLetters = 9;
+static const uint8_t kZonePolicySize = 12;
+
+// ZoneRule
+static const uint8_t kZoneRuleFromYearTiny = 0;
+static const uint8_t kZoneRuleToYearTiny = 1;
+static const uint8_t kZoneRuleInMonth = 2;
+static const uint8_t kZoneRuleOnDayOfWeek = 3;
+static const uint8_t kZoneRuleOnDayOfMonth = 4;
+static const uint8_t kZoneRuleAtTimeCode = 5;
+static const uint8_t kZoneRuleAtTimeModifier = 6;
+static const uint8_t kZoneRuleDeltaCode = 7;
+static const uint8_t kZoneRuleLetter = 8;
+static const uint8_t kZoneRuleSize = 9;
+
+/** Size of an offset field. */
+static const uint8_t kOffsetSize = 4;
+
+/** Read a little-endian uint16_t. */
+inline uint16_t readUint16(const uint8_t* p) {
+  return (uint16_t) (p[0] | (p[1] << 8));
+}
+
+/** Read a little-endian uint32_t. */
+inline uint32_t readUint32(const uint8_t* p) {
+  return (uint32_t) p[0]
+      | ((uint32_t) p[1] << 8)
+      | ((uint32_t) p[2] << 16)
+      | ((uint32_t) p[3] << 24);
+}
+
+/** Read the self-relative offset at p. */
+inline int32_t readOffset(const uint8_t* p) {
+  return (int32_t) readUint32(p);
+}
+
+/**
+ * Return the address referenced by the self-relative offset at p, or nullptr
+ * if the offset is 0.
+ */
+inline const uint8_t* readPointer(const uint8_t* p) {
+  int32_t offset = readOffset(p);
+  return (offset == 0) ? nullptr : p + offset;
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,326 @@
+/*
+ * MIT License
+ * Copyright (c) 2019 Brian T. Park
+ */
+
+#include <string.h> // strlen()
+#include <Print.h>
+#include "../LocalDate.h"
+#include "PosixTz.h"
+
+namespace ace_time {
+namespace posix {
+
+/** The rules used when the DST part of a TZ string has no rules. */
+static const char kDefaultRules[] = "M3.2.0,M11.1.0";
+
+acetime_t DateRule::toLocalSeconds(int16_t year) const {
+  // The epochDays of a year outside of LocalDate is kInvalidEpochDays, which
+  // overflows when offset or multiplied.
+  if (year < LocalDate::kMinYear) return ACETIME_T_MIN + 1;
+  if (year > LocalDate::kMaxYear) return ACETIME_T_MAX;
+
+  acetime_t epochDays;
+  switch (type) {
+    case kTypeJulianNoLeap:
+      // Day 60 is always March 1, even in a leap year.
+      epochDays = LocalDate::forComponents(year, 1, 1).toEpochDays()
+          + day - 1;
+      if (day >= 60 && LocalDate::isLeapYear(year)) epochDays++;
+      break;
+    case kTypeJulian:
+      epochDays = LocalDate::forComponents(year, 1, 1).toEpochDays() + day;
+      break;
+    default:
+    {
+      // LocalDate::dayOfWeek() is 1=Monday to 7=Sunday, but POSIX uses
+      // 0=Sunday to 6=Saturday. Week 5 is the last week of the month.
+      LocalDate first = LocalDate::forComponents(year, month, 1);
+      uint8_t firstDayOfWeek = first.dayOfWeek() % 7;
+      uint8_t dayOfMonth = 1 + (dayOfWeek + 7 - firstDayOfWeek) % 7
+          + 7 * (week - 1);
+      uint8_t daysInMonth = LocalDate::daysInMonth(year, month);
+      while (dayOfMonth > daysInMonth) dayOfMonth -= 7;
+      epochDays = first.toEpochDays() + dayOfMonth - 1;
+      break;
+    }
+  }
+
+  // Saturate instead of overflowing at the ends of the range of acetime_t.
+  int64_t seconds = (int64_t) epochDays * 86400 + timeSeconds;
+  if (seconds > ACETIME_T_MAX) return ACETIME_T_MAX;
+  if (seconds <= ACETIME_T_MIN) return ACETIME_T_MIN + 1;
+  return (acetime_t) seconds;
+}
+
+acetime_t TzSpec::toUtcSeconds(acetime_t localSeconds, int32_t offsetSeconds) {
+  if (localSeconds == ACETIME_T_MAX || localSeconds == ACETIME_T_MIN + 1) {
+    return localSeconds;
+  }
+  int64_t seconds = (int64_t) localSeconds - offsetSeconds;
+  if (seconds > ACETIME_T_MAX) return ACETIME_T_MAX;
+  if (seconds <= ACETIME_T_MIN) return ACETIME_T_MIN + 1;
+  return (acetime_t) seconds;
+}
+
+bool TzSpec::parse(const char* s) {
+  return parse(s, strlen(s));
+}
+
+bool TzSpec::parse(const char* s, size_t len) {
+  *this = TzSpec();
+  const char* end = s + len;
+
+  // POSIX offsets are positive west of Greenwich, so flip the sign.
+  int32_t seconds;
+  if (! parseAbbrev(s, end, mStdAbbrev)) return false;
+  if (! parseTime(s, end, 24, seconds)) return false;
+  mStdOffsetSeconds = -seconds;
+  mDstOffsetSeconds = mStdOffsetSeconds;
+  if (s == end) {
+    mIsError = false;
+    return true;
+  }
+
+  if (! parseAbbrev(s, end, mDstAbbrev)) return false;
+  mDstOffsetSeconds = mStdOffsetSeconds + 3600;
+  if (s != end && *s != ',') {
+    if (! parseTime(s, end, 24, seconds)) return false;
+    mDstOffsetSeconds = -seconds;
+  }
+
+  if (s == end) {
+    s = kDefaultRules;
+    end = s + sizeof(kDefaultRules) - 1;
+  } else if (*s++ != ',') {
+    return false;
+  }
+  if (! parseRule(s, end, mDstStartRule)) return false;
+  if (s == end || *s++ != ',') return false;
+  if (! parseRule(s, end, mDstEndRule)) return false;
+  if (s != end) return false;
+
+  mHasDst = true;
+  mIsError = false;
+  return true;
+}
+
+uint8_t TzSpec::getTransitions(int16_t year, Transition* transitions) const {
+  if (! mHasDst) return 0;
+
+  // Insertion sort of the 6 transitions. The transitions of the adjacent
+  // years can cross the boundaries of the middle year.
+  uint8_t numTransitions = 0;
+  for (int16_t y = year - 1; y <= year + 1; y++) {
+    // The saturated transitions of a year outside of LocalDate would all
+    // have the same epochSeconds, and could not be ordered correctly.
+    if (! LocalDate::isYearValid(y)) continue;
+    for (uint8_t isDst = 0; isDst <= 1; isDst++) {
+      Transition t = {
+        isDst ? dstStartSeconds(y) : dstEndSeconds(y),
+        (bool) isDst
+      };
+      uint8_t j = numTransitions;
+      for (; j > 0 && (transitions[j - 1].epochSeconds > t.epochSeconds
+          || (transitions[j - 1].epochSeconds == t.epochSeconds
+              && transitions[j - 1].isDst && ! t.isDst)); j--) {
+        transitions[j] = transitions[j - 1];
+      }
+      transitions[j] = t;
+      numTransitions++;
+    }
+  }
+  return numTransitions;
+}
+
+bool TzSpec::isDst(acetime_t epochSeconds) const {
+  Transition transitions[kMaxTransitions];
+  int16_t year = LocalDate::forEpochSeconds(epochSeconds).year();
+  uint8_t numTransitions = getTransitions(year, transitions);
+  if (numTransitions == 0) return false;
+
+  // The latest transition at or before epochSeconds, or the opposite of the
+  // first one.
+  bool isDst = ! transitions[0].isDst;
+  for (uint8_t i = 0; i < numTransitions; i++) {
+    if (transitions[i].epochSeconds > epochSeconds) break;
+    isDst = transitions[i].isDst;
+  }
+  return isDst;
+}
+
+void TzSpec::printTo(Print& printer) const {
+  if (mIsError) {
+    printer.print("<Error>");
+    return;
+  }
+
+  // POSIX offsets are positive west of Greenwich.
+  printAbbrev(printer, mStdAbbrev);
+  printTime(printer, -mStdOffsetSeconds);
+  if (! mHasDst) return;
+
+  printAbbrev(printer, mDstAbbrev);
+  if (mDstOffsetSeconds != mStdOffsetSeconds + 3600) {
+    printTime(printer, -mDstOffsetSeconds);
+  }
+  printer.print(',');
+  printRule(printer, mDstStartRule);
+  printer.print(',');
+  printRule(printer, mDstEndRule);
+}
+
+void TzSpec::printAbbrev(Print& printer, const char* abbrev) {
+  bool isAlpha = true;
+  for (const char* s = abbrev; *s; s++) {
+    if (! ((*s >= 'A' && *s <= 'Z') || (*s >= 'a' && *s <= 'z'))) {
+      isAlpha = false;
+      break;
+    }
+  }
+  if (! isAlpha) printer.print('<');
+  printer.print(abbrev);
+  if (! isAlpha) printer.print('>');
+}
+
+void TzSpec::printTime(Print& printer, int32_t seconds) {
+  if (seconds < 0) {
+    printer.print('-');
+    seconds = -seconds;
+  }
+  printer.print(seconds / 3600);
+  int32_t minutes = seconds / 60 % 60;
+  int32_t secs = seconds % 60;
+  if (minutes != 0 || secs != 0) {
+    printer.print(':');
+    if (minutes < 10) printer.print('0');
+    printer.print(minutes);
+  }
+  if (secs != 0) {
+    printer.print(':');
+    if (secs < 10) printer.print('0');
+    printer.print(secs);
+  }
+}
+
+void TzSpec::printRule(Print& printer, const DateRule& rule) {
+  switch (rule.type) {
+    case DateRule::kTypeJulianNoLeap:
+      printer.print('J');
+      printer.print(rule.day);
+      break;
+    case DateRule::kTypeJulian:
+      printer.print(rule.day);
+      break;
+    default:
+      printer.print('M');
+      printer.print(rule.month);
+      printer.print('.');
+      printer.print(rule.week);
+      printer.print('.');
+      printer.print(rule.dayOfWeek);
+      break;
+  }
+  if (rule.timeSeconds != 2 * 3600) {
+    printer.print('/');
+    printTime(printer, rule.timeSeconds);
+  }
+}
+
+bool TzSpec::parseAbbrev(const char*& s, const char* end, char* abbrev) {
+  uint8_t len = 0;
+  if (s != end && *s == '<') {
+    s++;
+    while (s != end && *s != '>') {
+      char c = *s;
+      bool isValid = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')
+          || (c >= '0' && c <= '9') || c == '+' || c == '-';
+      if (! isValid || len >= kAbbrevSize - 1) return false;
+      abbrev[len++] = c;
+      s++;
+    }
+    if (s == end) return false;
+    s++; // '>'
+  } else {
+    while (s != end && ((*s >= 'A' && *s <= 'Z') || (*s >= 'a' && *s <= 'z'))) {
+      if (len >= kAbbrevSize - 1) return false;
+      abbrev[len++] = *s++;
+    }
+  }
+  abbrev[len] = '\0';
+  return len >= 3;
+}
+
+bool TzSpec::parseNumber(const char*& s, const char* end, int32_t min,
+    int32_t max, int32_t& value) {
+  const char* begin = s;
+  value = 0;
+  while (s != end && *s >= '0' && *s <= '9') {
+    value = value * 10 + (*s - '0');
+    if (value > max) return false;
+    s++;
+  }
+  return s != begin && value >= min;
+}
+
+bool TzSpec::parseTime(const char*& s, const char* end, int32_t maxHours,
+    int32_t& seconds) {
+  int32_t sign = 1;
+  if (s != end && (*s == '+' || *s == '-')) {
+    if (*s == '-') sign = -1;
+    s++;
+  }
+
+  int32_t hours;
+  int32_t minutes = 0;
+  int32_t secs = 0;
+  if (! parseNumber(s, end, 0, maxHours, hours)) return false;
+  if (s != end && *s == ':') {
+    s++;
+    if (! parseNumber(s, end, 0, 59, minutes)) return false;
+    if (s != end && *s == ':') {
+      s++;
+      if (! parseNumber(s, end, 0, 59, secs)) return false;
+    }
+  }
+  seconds = sign * (hours * 3600 + minutes * 60 + secs);
+  return true;
+}
+
+bool TzSpec::parseRule(const char*& s, const char* end, DateRule& rule) {
+  int32_t value;
+  rule = DateRule();
+  if (s == end) return false;
+  if (*s == 'M') {
+    s++;
+    rule.type = DateRule::kTypeMonthWeekDay;
+    if (! parseNumber(s, end, 1, 12, value)) return false;
+    rule.month = value;
+    if (s == end || *s++ != '.') return false;
+    if (! parseNumber(s, end, 1, 5, value)) return false;
+    rule.week = value;
+    if (s == end || *s++ != '.') return false;
+    if (! parseNumber(s, end, 0, 6, value)) return false;
+    rule.dayOfWeek = value;
+  } else if (*s == 'J') {
+    s++;
+    rule.type = DateRule::kTypeJulianNoLeap;
+    if (! parseNumber(s, end, 1, 365, value)) return false;
+    rule.day = value;
+  } else {
+    rule.type = DateRule::kTypeJulian;
+    if (! parseNumber(s, end, 0, 365, value)) return false;
+    rule.day = value;
+  }
+
+  // RFC 8536 extends the time of the rule to [-167, 167] hours.
+  rule.timeSeconds = 2 * 3600;
+  if (s != end && *s == '/') {
+    s++;
+    if (! parseTime(s, end, 167, rule.timeSeconds)) return false;
+  }
+  return true;
+}
+
+}
+}
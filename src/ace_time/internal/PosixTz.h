@@ -0,0 +1,216 @@
+/*
+ * MIT License
+ * Copyright (c) 2019 Brian T. Park
+ */
+
+#ifndef ACE_TIME_POSIX_TZ_H
+#define ACE_TIME_POSIX_TZ_H
+
+#include <stdint.h>
+#include <stddef.h> // size_t
+#include <string.h> // strcmp()
+#include "../common/common.h"
+
+class Print;
+
+namespace ace_time {
+namespace posix {
+
+/**
+ * The rule of a POSIX TZ string which gives the date and local time of the
+ * start or the end of DST in each year, in one of 3 forms:
+ *
+ *    * kTypeMonthWeekDay: "Mm.w.d", day d (0=Sunday) of week w (1-4, or 5 for
+ *      the last) of month m
+ *    * kTypeJulianNoLeap: "Jn", day n (1-365) of the year, never counting
+ *      February 29
+ *    * kTypeJulian: "n", zero-based day n (0-365) of the year, counting
+ *      February 29
+ */
+struct DateRule {
+  static const uint8_t kTypeMonthWeekDay = 0;
+  static const uint8_t kTypeJulianNoLeap = 1;
+  static const uint8_t kTypeJulian = 2;
+
+  /**
+   * Return the time of the rule in the given year, in the local time of the
+   * UTC offset which is in effect just before the transition, expressed as
+   * if it were UTC (i.e. LocalDateTime::toEpochSeconds()).
+   */
+  acetime_t toLocalSeconds(int16_t year) const;
+
+  uint8_t type = kTypeMonthWeekDay;
+  uint8_t month = 1;
+  uint8_t week = 1;
+  uint8_t dayOfWeek = 0;
+  uint16_t day = 0;
+
+  /** Local time of the transition, can be negative or above 24 hours. */
+  int32_t timeSeconds = 0;
+};
+
+inline bool operator==(const DateRule& a, const DateRule& b) {
+  return a.type == b.type
+      && a.month == b.month
+      && a.week == b.week
+      && a.dayOfWeek == b.dayOfWeek
+      && a.day == b.day
+      && a.timeSeconds == b.timeSeconds;
+}
+
+inline bool operator!=(const DateRule& a, const DateRule& b) {
+  return ! (a == b);
+}
+
+/** A transition of a TzSpec, at the start or at the end of DST. */
+struct Transition {
+  /** The epochSeconds of the transition. */
+  acetime_t epochSeconds;
+
+  /** True at the start of DST, false at the end of DST. */
+  bool isDst;
+};
+
+/**
+ * A parsed POSIX TZ string (e.g. "PST8PDT,M3.2.0,M11.1.0"), as found in the
+ * TZ environment variable or in the footer of a TZif file, with the
+ * extensions of RFC 8536 (quoted abbreviations like "<+0530>", and rule
+ * times from -167 to 167 hours). Unlike the POSIX string, the UTC offsets are
+ * stored with the usual sign, positive east of Greenwich.
+ *
+ * The transitions of any year are computed in closed form by
+ * dstStartSeconds() and dstEndSeconds(). A parsed TzSpec is a small value
+ * type without pointers, which can be copied freely.
+ */
+class TzSpec {
+  public:
+    /** Size of the abbreviation buffers, including the NUL terminator. */
+    static const uint8_t kAbbrevSize = 6 + 1;
+
+    /** Maximum number of transitions returned by getTransitions(). */
+    static const uint8_t kMaxTransitions = 6;
+
+    /** Constructor for an empty TzSpec, whose isError() is true. */
+    TzSpec() {}
+
+    /**
+     * Parse the NUL terminated TZ string. Return false, and leave isError()
+     * true, if it is not valid. If the DST part has no rules (e.g.
+     * "EST5EDT"), the US rules "M3.2.0,M11.1.0" are used, like glibc.
+     */
+    bool parse(const char* s);
+
+    /** Parse the first 'len' characters of s. */
+    bool parse(const char* s, size_t len);
+
+    /** Return true if no valid TZ string was parsed. */
+    bool isError() const { return mIsError; }
+
+    /** Return true if the TZ string has a DST part. */
+    bool hasDst() const { return mHasDst; }
+
+    /** Return the standard UTC offset in seconds, positive east of UTC. */
+    int32_t stdOffsetSeconds() const { return mStdOffsetSeconds; }
+
+    /** Return the UTC offset during DST in seconds. */
+    int32_t dstOffsetSeconds() const { return mDstOffsetSeconds; }
+
+    /** Return the abbreviation of standard time (e.g. "PST"). */
+    const char* stdAbbrev() const { return mStdAbbrev; }
+
+    /** Return the abbreviation of DST (e.g. "PDT"), or "" without DST. */
+    const char* dstAbbrev() const { return mDstAbbrev; }
+
+    /** Return the rule for the start of DST. */
+    const DateRule& dstStartRule() const { return mDstStartRule; }
+
+    /** Return the rule for the end of DST. */
+    const DateRule& dstEndRule() const { return mDstEndRule; }
+
+    /** Return the epochSeconds of the start of DST in the given year. */
+    acetime_t dstStartSeconds(int16_t year) const {
+      return toUtcSeconds(mDstStartRule.toLocalSeconds(year),
+          mStdOffsetSeconds);
+    }
+
+    /** Return the epochSeconds of the end of DST in the given year. */
+    acetime_t dstEndSeconds(int16_t year) const {
+      return toUtcSeconds(mDstEndRule.toLocalSeconds(year),
+          mDstOffsetSeconds);
+    }
+
+    /**
+     * Fill 'transitions' with the transitions of the 3 years from year-1 to
+     * year+1, sorted by epochSeconds, and return their number, which is 0 if
+     * hasDst() is false. When the end of DST coincides with the start of DST
+     * (e.g. "J365/25"), the end goes first, so that DST is in effect all year.
+     *
+     * @param year the year in the middle
+     * @param transitions an array of kMaxTransitions elements
+     */
+    uint8_t getTransitions(int16_t year, Transition* transitions) const;
+
+    /**
+     * Return true if DST is in effect at epochSeconds. Always false if
+     * hasDst() is false.
+     */
+    bool isDst(acetime_t epochSeconds) const;
+
+    /**
+     * Print the TZ string in its normalized form, with the default parts
+     * (e.g. the "/2" time of the rules) omitted. Prints "<Error>" if
+     * isError() is true.
+     */
+    void printTo(Print& printer) const;
+
+  private:
+    friend bool operator==(const TzSpec& a, const TzSpec& b);
+
+    /**
+     * Return localSeconds minus the UTC offset, saturated to acetime_t. A
+     * localSeconds which is already saturated is returned unchanged.
+     */
+    static acetime_t toUtcSeconds(acetime_t localSeconds,
+        int32_t offsetSeconds);
+
+    static void printAbbrev(Print& printer, const char* abbrev);
+    static void printTime(Print& printer, int32_t seconds);
+    static void printRule(Print& printer, const DateRule& rule);
+
+    static bool parseAbbrev(const char*& s, const char* end, char* abbrev);
+    static bool parseNumber(const char*& s, const char* end, int32_t min,
+        int32_t max, int32_t& value);
+    static bool parseTime(const char*& s, const char* end, int32_t maxHours,
+        int32_t& seconds);
+    static bool parseRule(const char*& s, const char* end, DateRule& rule);
+
+    DateRule mDstStartRule;
+    DateRule mDstEndRule;
+    int32_t mStdOffsetSeconds = 0;
+    int32_t mDstOffsetSeconds = 0;
+    char mStdAbbrev[kAbbrevSize] = "";
+    char mDstAbbrev[kAbbrevSize] = "";
+    bool mHasDst = false;
+    bool mIsError = true;
+};
+
+inline bool operator==(const TzSpec& a, const TzSpec& b) {
+  if (a.mIsError || b.mIsError) return a.mIsError == b.mIsError;
+  return a.mStdOffsetSeconds == b.mStdOffsetSeconds
+      && a.mDstOffsetSeconds == b.mDstOffsetSeconds
+      && a.mHasDst == b.mHasDst
+      && strcmp(a.mStdAbbrev, b.mStdAbbrev) == 0
+      && strcmp(a.mDstAbbrev, b.mDstAbbrev) == 0
+      && (! a.mHasDst
+          || (a.mDstStartRule == b.mDstStartRule
+              && a.mDstEndRule == b.mDstEndRule));
+}
+
+inline bool operator!=(const TzSpec& a, const TzSpec& b) {
+  return ! (a == b);
+}
+
+}
+}
+
+#endif
@@ -291,5 +291,283 @@ const basic::ZoneInfo* const kZoneRegistry[270] ACE_TIME_PROGMEM = {
 
 };
 
+//---------------------------------------------------------------------------
+// Zone registry. Sorted by zoneId, for a binary search in
+// ZoneRegistrar::getZoneInfoForId().
+//---------------------------------------------------------------------------
+const basic::ZoneInfo* const kZoneRegistryById[270] ACE_TIME_PROGMEM = {
+  &kZoneAsia_Kuala_Lumpur, // 0x014763c4, Asia/Kuala_Lumpur
+  &kZoneIndian_Cocos, // 0x021e86de, Indian/Cocos
+  &kZoneAsia_Jakarta, // 0x0506ab50, Asia/Jakarta
+  &kZoneAmerica_Mazatlan, // 0x0532189e, America/Mazatlan
+  &kZoneAmerica_Hermosillo, // 0x065d21c4, America/Hermosillo
+  &kZoneCET, // 0x0b87d921, CET
+  &kZoneEET, // 0x0b87e1a3, EET
+  &kZoneEST, // 0x0b87e371, EST
+  &kZoneHST, // 0x0b87f034, HST
+  &kZoneMET, // 0x0b8803ab, MET
+  &kZoneMST, // 0x0b880579, MST
+  &kZoneWET, // 0x0b882e35, WET
+  &kZoneAmerica_Guatemala, // 0x0c8259f7, America/Guatemala
+  &kZoneAfrica_Monrovia, // 0x0ce90385, Africa/Monrovia
+  &kZoneAntarctica_Rothera, // 0x0e86d203, Antarctica/Rothera
+  &kZoneAmerica_Yellowknife, // 0x0f76c76f, America/Yellowknife
+  &kZoneAustralia_Melbourne, // 0x0fe559a3, Australia/Melbourne
+  &kZoneAmerica_Sao_Paulo, // 0x1063bfc9, America/Sao_Paulo
+  &kZoneEurope_Amsterdam, // 0x109395c2, Europe/Amsterdam
+  &kZoneAmerica_Indiana_Vevay, // 0x10aca054, America/Indiana/Vevay
+  &kZoneAmerica_Scoresbysund, // 0x123f8d2a, America/Scoresbysund
+  &kZoneAsia_Samarkand, // 0x13ae5104, Asia/Samarkand
+  &kZoneAsia_Amman, // 0x148d21bc, Asia/Amman
+  &kZoneAsia_Dhaka, // 0x14c07b8b, Asia/Dhaka
+  &kZoneAsia_Dubai, // 0x14c79f77, Asia/Dubai
+  &kZoneAsia_Kabul, // 0x153b5601, Asia/Kabul
+  &kZoneAsia_Macau, // 0x155f88b9, Asia/Macau
+  &kZoneAsia_Qatar, // 0x15a8330b, Asia/Qatar
+  &kZoneAsia_Seoul, // 0x15ce82da, Asia/Seoul
+  &kZoneAsia_Tokyo, // 0x15e606a8, Asia/Tokyo
+  &kZoneAsia_Thimphu, // 0x170380d1, Asia/Thimphu
+  &kZoneAmerica_Guayaquil, // 0x17e64958, America/Guayaquil
+  &kZoneAmerica_Kentucky_Louisville, // 0x1a21024b, America/Kentucky/Louisville
+  &kZoneAsia_Pontianak, // 0x1a76c057, Asia/Pontianak
+  &kZoneAtlantic_Reykjavik, // 0x1c2b4f74, Atlantic/Reykjavik
+  &kZoneAmerica_New_York, // 0x1e2a7654, America/New_York
+  &kZoneEurope_Luxembourg, // 0x1f8bc6ce, Europe/Luxembourg
+  &kZoneAsia_Baku, // 0x1fa788b5, Asia/Baku
+  &kZoneAsia_Hovd, // 0x1fab0fe3, Asia/Hovd
+  &kZoneAsia_Ho_Chi_Minh, // 0x20f2d127, Asia/Ho_Chi_Minh
+  &kZoneAsia_Damascus, // 0x20fbb063, Asia/Damascus
+  &kZonePacific_Fiji, // 0x23383ba5, Pacific/Fiji
+  &kZonePacific_Niue, // 0x233ca014, Pacific/Niue
+  &kZonePacific_Wake, // 0x23416c2b, Pacific/Wake
+  &kZoneAustralia_Adelaide, // 0x2428e8a3, Australia/Adelaide
+  &kZonePacific_Auckland, // 0x25062f86, Pacific/Auckland
+  &kZonePacific_Tongatapu, // 0x262ca836, Pacific/Tongatapu
+  &kZoneAmerica_Monterrey, // 0x269a1deb, America/Monterrey
+  &kZoneAustralia_Currie, // 0x278b6a24, Australia/Currie
+  &kZoneAustralia_Darwin, // 0x2876bdff, Australia/Darwin
+  &kZonePacific_Pohnpei, // 0x28929f96, Pacific/Pohnpei
+  &kZoneAmerica_Indiana_Indianapolis, // 0x28a669a4, America/Indiana/Indianapolis
+  &kZoneAmerica_Vancouver, // 0x2c6f6b1f, America/Vancouver
+  &kZonePacific_Chatham, // 0x2f0de999, Pacific/Chatham
+  &kZoneAmerica_Indiana_Marengo, // 0x2feeee72, America/Indiana/Marengo
+  &kZoneAsia_Ulaanbaatar, // 0x30f0cc4e, Asia/Ulaanbaatar
+  &kZoneAustralia_Hobart, // 0x32bf951a, Australia/Hobart
+  &kZoneAsia_Dushanbe, // 0x32fc5c3c, Asia/Dushanbe
+  &kZoneAtlantic_South_Georgia, // 0x33013174, Atlantic/South_Georgia
+  &kZoneAmerica_Phoenix, // 0x34b5af01, America/Phoenix
+  &kZoneAmerica_Cayenne, // 0x3c617269, America/Cayenne
+  &kZoneAtlantic_Bermuda, // 0x3d4bb1c4, Atlantic/Bermuda
+  &kZoneAmerica_Managua, // 0x3d5e7600, America/Managua
+  &kZoneEtc_GMT_PLUS_10, // 0x3f8f1cc4, Etc/GMT+10
+  &kZoneEtc_GMT_PLUS_11, // 0x3f8f1cc5, Etc/GMT+11
+  &kZoneEtc_GMT_PLUS_12, // 0x3f8f1cc6, Etc/GMT+12
+  &kZoneEtc_GMT_10, // 0x3f8f2546, Etc/GMT-10
+  &kZoneEtc_GMT_11, // 0x3f8f2547, Etc/GMT-11
+  &kZoneEtc_GMT_12, // 0x3f8f2548, Etc/GMT-12
+  &kZoneEtc_GMT_13, // 0x3f8f2549, Etc/GMT-13
+  &kZoneEtc_GMT_14, // 0x3f8f254a, Etc/GMT-14
+  &kZoneEurope_Athens, // 0x4318fa27, Europe/Athens
+  &kZoneIndian_Kerguelen, // 0x4351b389, Indian/Kerguelen
+  &kZoneEurope_Berlin, // 0x44644c20, Europe/Berlin
+  &kZoneIndian_Chagos, // 0x456f7c3c, Indian/Chagos
+  &kZoneIndian_Mahe, // 0x45e725e2, Indian/Mahe
+  &kZoneEurope_Dublin, // 0x4a275f62, Europe/Dublin
+  &kZoneAsia_Nicosia, // 0x4b0fcf78, Asia/Nicosia
+  &kZoneAmerica_Chicago, // 0x4b92b5d4, America/Chicago
+  &kZoneAustralia_Sydney, // 0x4d1e9776, Australia/Sydney
+  &kZoneAntarctica_Vostok, // 0x4f966fd4, Antarctica/Vostok
+  &kZoneAustralia_Brisbane, // 0x4fedc9c0, Australia/Brisbane
+  &kZoneAmerica_Asuncion, // 0x50ec79a6, America/Asuncion
+  &kZoneAsia_Karachi, // 0x527f5245, Asia/Karachi
+  &kZonePacific_Gambier, // 0x53720c3a, Pacific/Gambier
+  &kZoneAmerica_Whitehorse, // 0x54e0e3e8, America/Whitehorse
+  &kZoneAmerica_Martinique, // 0x551e84c5, America/Martinique
+  &kZoneAmerica_Jamaica, // 0x565dad6c, America/Jamaica
+  &kZoneAsia_Hong_Kong, // 0x577f28ac, Asia/Hong_Kong
+  &kZonePacific_Marquesas, // 0x57ca7135, Pacific/Marquesas
+  &kZoneAmerica_Miquelon, // 0x59674330, America/Miquelon
+  &kZoneAntarctica_DumontDUrville, // 0x5a3c656c, Antarctica/DumontDUrville
+  &kZoneAmerica_Anchorage, // 0x5a79260e, America/Anchorage
+  &kZoneAsia_Jerusalem, // 0x5becd23a, Asia/Jerusalem
+  &kZoneEurope_Stockholm, // 0x5bf6fbb8, Europe/Stockholm
+  &kZoneEurope_Lisbon, // 0x5c00a70b, Europe/Lisbon
+  &kZoneAtlantic_Cape_Verde, // 0x5c5e1772, Atlantic/Cape_Verde
+  &kZoneEurope_London, // 0x5c6a84ae, Europe/London
+  &kZoneEurope_Madrid, // 0x5dbd1535, Europe/Madrid
+  &kZoneAmerica_Moncton, // 0x5e07fe24, America/Moncton
+  &kZoneEurope_Monaco, // 0x5ebf9f01, Europe/Monaco
+  &kZonePacific_Pago_Pago, // 0x603aebd0, Pacific/Pago_Pago
+  &kZonePacific_Enderbury, // 0x61599a93, Pacific/Enderbury
+  &kZoneAmerica_Creston, // 0x62a70204, America/Creston
+  &kZoneAmerica_Costa_Rica, // 0x63ff66be, America/Costa_Rica
+  &kZoneEurope_Prague, // 0x65ee5d48, Europe/Prague
+  &kZoneAmerica_Puerto_Rico, // 0x6752ca31, America/Puerto_Rico
+  &kZoneIndian_Christmas, // 0x68c207d5, Indian/Christmas
+  &kZoneAmerica_Curacao, // 0x6a879184, America/Curacao
+  &kZoneAsia_Makassar, // 0x6aa21c85, Asia/Makassar
+  &kZoneEurope_Helsinki, // 0x6ab2975b, Europe/Helsinki
+  &kZoneAmerica_Porto_Velho, // 0x6b1aac77, America/Porto_Velho
+  &kZoneAmerica_Edmonton, // 0x6cb9484a, America/Edmonton
+  &kZoneAmerica_Dawson_Creek, // 0x6cf24e5b, America/Dawson_Creek
+  &kZoneAmerica_Blanc_Sablon, // 0x6e299892, America/Blanc-Sablon
+  &kZoneEurope_Tirane, // 0x6ea95b47, Europe/Tirane
+  &kZoneIndian_Reunion, // 0x7076c047, Indian/Reunion
+  &kZoneAsia_Kolkata, // 0x72c06cd9, Asia/Kolkata
+  &kZoneEurope_Vienna, // 0x734cc2e5, Europe/Vienna
+  &kZoneAmerica_Santiago, // 0x7410c9bc, America/Santiago
+  &kZoneEurope_Warsaw, // 0x75185c19, Europe/Warsaw
+  &kZoneAmerica_El_Salvador, // 0x752ad652, America/El_Salvador
+  &kZoneAfrica_Bissau, // 0x75564141, Africa/Bissau
+  &kZoneAfrica_Accra, // 0x77d5b054, Africa/Accra
+  &kZoneAfrica_Ceuta, // 0x77fb46ec, Africa/Ceuta
+  &kZoneAfrica_Lagos, // 0x789bb5d0, Africa/Lagos
+  &kZoneAmerica_Toronto, // 0x792e851b, America/Toronto
+  &kZoneAfrica_Tunis, // 0x79378e6d, Africa/Tunis
+  &kZoneIndian_Mauritius, // 0x7b09c02a, Indian/Mauritius
+  &kZoneEurope_Zurich, // 0x7d8195b9, Europe/Zurich
+  &kZoneAsia_Kuching, // 0x801b003b, Asia/Kuching
+  &kZoneAtlantic_Madeira, // 0x81b5c037, Atlantic/Madeira
+  &kZoneAmerica_Atikokan, // 0x81b92098, America/Atikokan
+  &kZonePacific_Kiritimati, // 0x8305073a, Pacific/Kiritimati
+  &kZoneAmerica_Chihuahua, // 0x8827d776, America/Chihuahua
+  &kZonePacific_Pitcairn, // 0x8837d8bd, Pacific/Pitcairn
+  &kZonePacific_Chuuk, // 0x8a090b23, Pacific/Chuuk
+  &kZonePacific_Efate, // 0x8a2bce28, Pacific/Efate
+  &kZonePacific_Nauru, // 0x8acc41ae, Pacific/Nauru
+  &kZoneEST5EDT, // 0x8adc72a3, EST5EDT
+  &kZonePacific_Palau, // 0x8af04a36, Pacific/Palau
+  &kZoneAmerica_Winnipeg, // 0x8c7dafc7, America/Winnipeg
+  &kZoneAustralia_Eucla, // 0x8cf99e44, Australia/Eucla
+  &kZoneAustralia_Perth, // 0x8db8269d, Australia/Perth
+  &kZonePacific_Kwajalein, // 0x8e216759, Pacific/Kwajalein
+  &kZoneAmerica_Port_au_Prince, // 0x8e4a7bdc, America/Port-au-Prince
+  &kZoneAfrica_Maputo, // 0x8e6ca1f0, Africa/Maputo
+  &kZoneAmerica_Godthab, // 0x8f7eba1f, America/Godthab
+  &kZoneAsia_Yerevan, // 0x9185c8cc, Asia/Yerevan
+  &kZoneAmerica_Detroit, // 0x925cfbc1, America/Detroit
+  &kZoneAmerica_Bogota, // 0x93d7bc62, America/Bogota
+  &kZoneAmerica_Glace_Bay, // 0x9681f8dd, America/Glace_Bay
+  &kZoneAmerica_Dawson, // 0x978d8d12, America/Dawson
+  &kZoneAmerica_Denver, // 0x97d10b2a, America/Denver
+  &kZoneAmerica_Belem, // 0x97da580b, America/Belem
+  &kZoneAmerica_Boise, // 0x97dfc8d8, America/Boise
+  &kZoneEurope_Andorra, // 0x97f6764b, Europe/Andorra
+  &kZoneAmerica_Adak, // 0x97fe49d7, America/Adak
+  &kZoneAmerica_Lima, // 0x980468c9, America/Lima
+  &kZoneAmerica_Nome, // 0x98059b15, America/Nome
+  &kZoneIndian_Maldives, // 0x9869681c, Indian/Maldives
+  &kZoneAmerica_Sitka, // 0x99104ce2, America/Sitka
+  &kZoneAmerica_Thule, // 0x9921dd68, America/Thule
+  &kZonePacific_Rarotonga, // 0x9981a3b0, Pacific/Rarotonga
+  &kZoneAsia_Kathmandu, // 0x9a96ce6f, Asia/Kathmandu
+  &kZoneAmerica_Rainy_River, // 0x9cd58a10, America/Rainy_River
+  &kZoneEurope_Budapest, // 0x9ce0197c, Europe/Budapest
+  &kZoneAsia_Baghdad, // 0x9ceffbed, Asia/Baghdad
+  &kZoneEtc_GMT_PLUS_1, // 0x9d13da14, Etc/GMT+1
+  &kZoneEtc_GMT_PLUS_2, // 0x9d13da15, Etc/GMT+2
+  &kZoneEtc_GMT_PLUS_3, // 0x9d13da16, Etc/GMT+3
+  &kZoneEtc_GMT_PLUS_4, // 0x9d13da17, Etc/GMT+4
+  &kZoneEtc_GMT_PLUS_5, // 0x9d13da18, Etc/GMT+5
+  &kZoneEtc_GMT_PLUS_6, // 0x9d13da19, Etc/GMT+6
+  &kZoneEtc_GMT_PLUS_7, // 0x9d13da1a, Etc/GMT+7
+  &kZoneEtc_GMT_PLUS_8, // 0x9d13da1b, Etc/GMT+8
+  &kZoneEtc_GMT_PLUS_9, // 0x9d13da1c, Etc/GMT+9
+  &kZoneEtc_GMT_1, // 0x9d13da56, Etc/GMT-1
+  &kZoneEtc_GMT_2, // 0x9d13da57, Etc/GMT-2
+  &kZoneEtc_GMT_3, // 0x9d13da58, Etc/GMT-3
+  &kZoneEtc_GMT_4, // 0x9d13da59, Etc/GMT-4
+  &kZoneEtc_GMT_5, // 0x9d13da5a, Etc/GMT-5
+  &kZoneEtc_GMT_6, // 0x9d13da5b, Etc/GMT-6
+  &kZoneEtc_GMT_7, // 0x9d13da5c, Etc/GMT-7
+  &kZoneEtc_GMT_8, // 0x9d13da5d, Etc/GMT-8
+  &kZoneEtc_GMT_9, // 0x9d13da5e, Etc/GMT-9
+  &kZoneAmerica_Nipigon, // 0x9d2a8b1a, America/Nipigon
+  &kZoneAsia_Bangkok, // 0x9d6e3aaf, Asia/Bangkok
+  &kZoneAmerica_North_Dakota_Center, // 0x9da42814, America/North_Dakota/Center
+  &kZoneAfrica_Ndjamena, // 0x9fe09898, Africa/Ndjamena
+  &kZoneAmerica_Guyana, // 0x9ff7bd0b, America/Guyana
+  &kZoneAmerica_Havana, // 0xa0e15675, America/Havana
+  &kZoneEurope_Kiev, // 0xa2c19eb3, Europe/Kiev
+  &kZoneEurope_Oslo, // 0xa2c3fba1, Europe/Oslo
+  &kZoneEurope_Rome, // 0xa2c58fd7, Europe/Rome
+  &kZoneAmerica_Inuvik, // 0xa42189fc, America/Inuvik
+  &kZoneAmerica_Juneau, // 0xa6f13e2e, America/Juneau
+  &kZoneAustralia_Lord_Howe, // 0xa748b67d, Australia/Lord_Howe
+  &kZonePacific_Port_Moresby, // 0xa7ba7f68, Pacific/Port_Moresby
+  &kZoneAsia_Beirut, // 0xa7f3d5fd, Asia/Beirut
+  &kZoneAfrica_Nairobi, // 0xa87ab57e, Africa/Nairobi
+  &kZoneAsia_Brunei, // 0xa8e595f7, Asia/Brunei
+  &kZonePacific_Galapagos, // 0xa952f752, Pacific/Galapagos
+  &kZoneAmerica_La_Paz, // 0xaa29125d, America/La_Paz
+  &kZoneAmerica_Manaus, // 0xac86bf8b, America/Manaus
+  &kZoneAmerica_Merida, // 0xacd172d8, America/Merida
+  &kZoneEurope_Chisinau, // 0xad58aa18, Europe/Chisinau
+  &kZoneAmerica_Nassau, // 0xaedef011, America/Nassau
+  &kZoneEurope_Uzhgorod, // 0xb066f5d6, Europe/Uzhgorod
+  &kZoneAustralia_Broken_Hill, // 0xb06eada3, Australia/Broken_Hill
+  &kZoneAmerica_Paramaribo, // 0xb319e4c4, America/Paramaribo
+  &kZoneAmerica_Panama, // 0xb3863854, America/Panama
+  &kZoneAmerica_Los_Angeles, // 0xb7f7e8f2, America/Los_Angeles
+  &kZoneAmerica_Regina, // 0xb875371c, America/Regina
+  &kZoneAsia_Ashgabat, // 0xba87598d, Asia/Ashgabat
+  &kZoneAmerica_Halifax, // 0xbc5b7183, America/Halifax
+  &kZoneAmerica_Tegucigalpa, // 0xbfd6fd4c, America/Tegucigalpa
+  &kZoneAsia_Manila, // 0xc156c944, Asia/Manila
+  &kZoneAfrica_Abidjan, // 0xc21305a3, Africa/Abidjan
+  &kZoneAsia_Jayapura, // 0xc6833c2f, Asia/Jayapura
+  &kZoneAmerica_Barbados, // 0xcbbc3b04, America/Barbados
+  &kZoneAsia_Riyadh, // 0xcd973d93, Asia/Riyadh
+  &kZonePacific_Easter, // 0xcf54f7e7, Pacific/Easter
+  &kZoneAsia_Singapore, // 0xcf8581fa, Asia/Singapore
+  &kZoneAsia_Taipei, // 0xd1a844ae, Asia/Taipei
+  &kZoneAsia_Tehran, // 0xd1f02254, Asia/Tehran
+  &kZoneAsia_Urumqi, // 0xd5379735, Asia/Urumqi
+  &kZoneAfrica_Johannesburg, // 0xd5d157a0, Africa/Johannesburg
+  &kZoneAmerica_Port_of_Spain, // 0xd8b28d59, America/Port_of_Spain
+  &kZoneEtc_GMT, // 0xd8e2de58, Etc/GMT
+  &kZoneEtc_UTC, // 0xd8e31abc, Etc/UTC
+  &kZoneAmerica_Yakutat, // 0xd8ee31e9, America/Yakutat
+  &kZoneAfrica_Algiers, // 0xd94515c1, Africa/Algiers
+  &kZonePST8PDT, // 0xd99ee2dc, PST8PDT
+  &kZonePacific_Funafuti, // 0xdb402d65, Pacific/Funafuti
+  &kZoneAmerica_Matamoros, // 0xdd1b0259, America/Matamoros
+  &kZoneAsia_Yangon, // 0xdd54a8be, Asia/Yangon
+  &kZonePacific_Kosrae, // 0xde5139a8, Pacific/Kosrae
+  &kZoneEurope_Brussels, // 0xdee07337, Europe/Brussels
+  &kZoneAmerica_Swift_Current, // 0xdef98e55, America/Swift_Current
+  &kZoneAustralia_Lindeman, // 0xe05029e2, Australia/Lindeman
+  &kZoneEurope_Belgrade, // 0xe0532b3a, Europe/Belgrade
+  &kZoneAmerica_Menominee, // 0xe0e9c583, America/Menominee
+  &kZoneEurope_Copenhagen, // 0xe0ed30bc, Europe/Copenhagen
+  &kZoneAtlantic_Faroe, // 0xe110a971, Atlantic/Faroe
+  &kZonePacific_Majuro, // 0xe1f95371, Pacific/Majuro
+  &kZoneAntarctica_Syowa, // 0xe330c7e1, Antarctica/Syowa
+  &kZonePacific_Noumea, // 0xe551b788, Pacific/Noumea
+  &kZonePacific_Honolulu, // 0xe6e70af9, Pacific/Honolulu
+  &kZoneEurope_Zaporozhye, // 0xeab9767f, Europe/Zaporozhye
+  &kZoneAmerica_Ojinaga, // 0xebfde83f, America/Ojinaga
+  &kZoneCST6CDT, // 0xf0e87d00, CST6CDT
+  &kZonePacific_Tahiti, // 0xf24c2446, Pacific/Tahiti
+  &kZonePacific_Tarawa, // 0xf2517e63, Pacific/Tarawa
+  &kZoneMST7MDT, // 0xf2af9375, MST7MDT
+  &kZoneAsia_Tashkent, // 0xf3924254, Asia/Tashkent
+  &kZonePacific_Guadalcanal, // 0xf4dd25f0, Pacific/Guadalcanal
+  &kZoneAmerica_Danmarkshavn, // 0xf554d204, America/Danmarkshavn
+  &kZoneAsia_Shanghai, // 0xf895a7f5, Asia/Shanghai
+  &kZoneEurope_Gibraltar, // 0xf8e325fc, Europe/Gibraltar
+  &kZoneAtlantic_Azores, // 0xf93ed918, Atlantic/Azores
+  &kZonePacific_Wallis, // 0xf94ddb0f, Pacific/Wallis
+  &kZoneAmerica_Thunder_Bay, // 0xf962e71b, America/Thunder_Bay
+  &kZoneAmerica_Montevideo, // 0xfa214780, America/Montevideo
+  &kZoneEurope_Malta, // 0xfb1560f3, Europe/Malta
+  &kZoneEurope_Bucharest, // 0xfb349ec5, Europe/Bucharest
+  &kZoneEurope_Paris, // 0xfb4bc2a3, Europe/Paris
+  &kZoneEurope_Sofia, // 0xfb898656, Europe/Sofia
+  &kZoneAtlantic_Canary, // 0xfc23f2c2, Atlantic/Canary
+  &kZoneAmerica_Campo_Grande, // 0xfec3e7a6, America/Campo_Grande
+
+};
+
 }
 }
@@ -19,6 +19,8 @@ const uint16_t kZoneRegistrySize = 270;
 
 extern const basic::ZoneInfo* const kZoneRegistry[270];
 
+extern const basic::ZoneInfo* const kZoneRegistryById[270];
+
 }
 }
 #endif
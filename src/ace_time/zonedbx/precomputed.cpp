@@ -0,0 +1,684 @@
+// This file was generated by the following program:
+//
+//  $ ../../../tools/PrecomputedGenerator/PrecomputedGenerator.out < precomputed_zones.txt
+//
+// using the zonedbx:: files of TZ Database version 2019a, start_year 2000, until_year 2050.
+//
+// DO NOT EDIT
+
+#include <ace_time/zonedbx/zone_infos.h>
+#include "precomputed.h"
+
+namespace ace_time {
+namespace zonedbx {
+namespace precomputed {
+
+//---------------------------------------------------------------------------
+// Zone name: America/Los_Angeles
+// Entries: 101
+// Abbrevs: 2
+//---------------------------------------------------------------------------
+
+static const acetime_t kStartEpochSecondsAmerica_Los_Angeles[101] = {
+  -2649600,
+  7984800,
+  26125200,
+  39434400,
+  57574800,
+  71488800,
+  89024400,
+  102938400,
+  120474000,
+  134388000,
+  152528400,
+  165837600,
+  183978000,
+  197287200,
+  215427600,
+  226922400,
+  247482000,
+  258372000,
+  278931600,
+  289821600,
+  310381200,
+  321876000,
+  342435600,
+  353325600,
+  373885200,
+  384775200,
+  405334800,
+  416224800,
+  436784400,
+  447674400,
+  468234000,
+  479124000,
+  499683600,
+  511178400,
+  531738000,
+  542628000,
+  563187600,
+  574077600,
+  594637200,
+  605527200,
+  626086800,
+  636976800,
+  657536400,
+  669031200,
+  689590800,
+  700480800,
+  721040400,
+  731930400,
+  752490000,
+  763380000,
+  783939600,
+  794829600,
+  815389200,
+  826279200,
+  846838800,
+  858333600,
+  878893200,
+  889783200,
+  910342800,
+  921232800,
+  941792400,
+  952682400,
+  973242000,
+  984132000,
+  1004691600,
+  1016186400,
+  1036746000,
+  1047636000,
+  1068195600,
+  1079085600,
+  1099645200,
+  1110535200,
+  1131094800,
+  1141984800,
+  1162544400,
+  1173434400,
+  1193994000,
+  1205488800,
+  1226048400,
+  1236938400,
+  1257498000,
+  1268388000,
+  1288947600,
+  1299837600,
+  1320397200,
+  1331287200,
+  1351846800,
+  1362736800,
+  1383296400,
+  1394791200,
+  1415350800,
+  1426240800,
+  1446800400,
+  1457690400,
+  1478250000,
+  1489140000,
+  1509699600,
+  1520589600,
+  1541149200,
+  1552644000,
+  1573203600,
+};
+
+static const int8_t kOffsetCodesAmerica_Los_Angeles[101] = {
+  -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32,
+  -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32,
+  -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32,
+  -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32,
+  -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32,
+  -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32, -32,
+  -32, -32, -32, -32, -32,
+};
+
+static const int8_t kDeltaCodesAmerica_Los_Angeles[101] = {
+  0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4,
+  0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4,
+  0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4,
+  0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4,
+  0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4,
+  0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4,
+  0, 4, 0, 4, 0,
+};
+
+static const uint8_t kAbbrevIndexesAmerica_Los_Angeles[101] = {
+  0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+  0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+  0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+  0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+  0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+  0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+  0, 1, 0, 1, 0,
+};
+
+static const char* const kAbbrevsAmerica_Los_Angeles[2] = {
+  "PST",
+  "PDT",
+};
+
+const PrecomputedZone kZoneAmerica_Los_Angeles(
+  &zonedbx::kZoneAmerica_Los_Angeles /*zoneInfo*/,
+  0 /*startSeconds*/,
+  1577923200 /*untilSeconds*/,
+  101 /*numEntries*/,
+  kStartEpochSecondsAmerica_Los_Angeles /*startEpochSeconds*/,
+  kOffsetCodesAmerica_Los_Angeles /*offsetCodes*/,
+  kDeltaCodesAmerica_Los_Angeles /*deltaCodes*/,
+  kAbbrevIndexesAmerica_Los_Angeles /*abbrevIndexes*/,
+  kAbbrevsAmerica_Los_Angeles /*abbrevs*/
+);
+
+//---------------------------------------------------------------------------
+// Zone name: America/New_York
+// Entries: 101
+// Abbrevs: 2
+//---------------------------------------------------------------------------
+
+static const acetime_t kStartEpochSecondsAmerica_New_York[101] = {
+  -2660400,
+  7974000,
+  26114400,
+  39423600,
+  57564000,
+  71478000,
+  89013600,
+  102927600,
+  120463200,
+  134377200,
+  152517600,
+  165826800,
+  183967200,
+  197276400,
+  215416800,
+  226911600,
+  247471200,
+  258361200,
+  278920800,
+  289810800,
+  310370400,
+  321865200,
+  342424800,
+  353314800,
+  373874400,
+  384764400,
+  405324000,
+  416214000,
+  436773600,
+  447663600,
+  468223200,
+  479113200,
+  499672800,
+  511167600,
+  531727200,
+  542617200,
+  563176800,
+  574066800,
+  594626400,
+  605516400,
+  626076000,
+  636966000,
+  657525600,
+  669020400,
+  689580000,
+  700470000,
+  721029600,
+  731919600,
+  752479200,
+  763369200,
+  783928800,
+  794818800,
+  815378400,
+  826268400,
+  846828000,
+  858322800,
+  878882400,
+  889772400,
+  910332000,
+  921222000,
+  941781600,
+  952671600,
+  973231200,
+  984121200,
+  1004680800,
+  1016175600,
+  1036735200,
+  1047625200,
+  1068184800,
+  1079074800,
+  1099634400,
+  1110524400,
+  1131084000,
+  1141974000,
+  1162533600,
+  1173423600,
+  1193983200,
+  1205478000,
+  1226037600,
+  1236927600,
+  1257487200,
+  1268377200,
+  1288936800,
+  1299826800,
+  1320386400,
+  1331276400,
+  1351836000,
+  1362726000,
+  1383285600,
+  1394780400,
+  1415340000,
+  1426230000,
+  1446789600,
+  1457679600,
+  1478239200,
+  1489129200,
+  1509688800,
+  1520578800,
+  1541138400,
+  1552633200,
+  1573192800,
+};
+
+static const int8_t kOffsetCodesAmerica_New_York[101] = {
+  -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20,
+  -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20,
+  -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20,
+  -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20,
+  -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20,
+  -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20, -20,
+  -20, -20, -20, -20, -20,
+};
+
+static const int8_t kDeltaCodesAmerica_New_York[101] = {
+  0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4,
+  0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4,
+  0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4,
+  0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4,
+  0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4,
+  0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4,
+  0, 4, 0, 4, 0,
+};
+
+static const uint8_t kAbbrevIndexesAmerica_New_York[101] = {
+  0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+  0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+  0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+  0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+  0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+  0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+  0, 1, 0, 1, 0,
+};
+
+static const char* const kAbbrevsAmerica_New_York[2] = {
+  "EST",
+  "EDT",
+};
+
+const PrecomputedZone kZoneAmerica_New_York(
+  &zonedbx::kZoneAmerica_New_York /*zoneInfo*/,
+  0 /*startSeconds*/,
+  1577923200 /*untilSeconds*/,
+  101 /*numEntries*/,
+  kStartEpochSecondsAmerica_New_York /*startEpochSeconds*/,
+  kOffsetCodesAmerica_New_York /*offsetCodes*/,
+  kDeltaCodesAmerica_New_York /*deltaCodes*/,
+  kAbbrevIndexesAmerica_New_York /*abbrevIndexes*/,
+  kAbbrevsAmerica_New_York /*abbrevs*/
+);
+
+//---------------------------------------------------------------------------
+// Zone name: Europe/London
+// Entries: 101
+// Abbrevs: 2
+//---------------------------------------------------------------------------
+
+static const acetime_t kStartEpochSecondsEurope_London[101] = {
+  -2678400,
+  7347600,
+  26096400,
+  38797200,
+  57546000,
+  70851600,
+  88995600,
+  102301200,
+  120445200,
+  133750800,
+  152499600,
+  165200400,
+  183949200,
+  196650000,
+  215398800,
+  228099600,
+  246848400,
+  260154000,
+  278298000,
+  291603600,
+  309747600,
+  323053200,
+  341802000,
+  354502800,
+  373251600,
+  385952400,
+  404701200,
+  418006800,
+  436150800,
+  449456400,
+  467600400,
+  480906000,
+  499050000,
+  512355600,
+  531104400,
+  543805200,
+  562554000,
+  575254800,
+  594003600,
+  607309200,
+  625453200,
+  638758800,
+  656902800,
+  670208400,
+  688957200,
+  701658000,
+  720406800,
+  733107600,
+  751856400,
+  765162000,
+  783306000,
+  796611600,
+  814755600,
+  828061200,
+  846205200,
+  859510800,
+  878259600,
+  890960400,
+  909709200,
+  922410000,
+  941158800,
+  954464400,
+  972608400,
+  985914000,
+  1004058000,
+  1017363600,
+  1036112400,
+  1048813200,
+  1067562000,
+  1080262800,
+  1099011600,
+  1111712400,
+  1130461200,
+  1143766800,
+  1161910800,
+  1175216400,
+  1193360400,
+  1206666000,
+  1225414800,
+  1238115600,
+  1256864400,
+  1269565200,
+  1288314000,
+  1301619600,
+  1319763600,
+  1333069200,
+  1351213200,
+  1364518800,
+  1382662800,
+  1395968400,
+  1414717200,
+  1427418000,
+  1446166800,
+  1458867600,
+  1477616400,
+  1490922000,
+  1509066000,
+  1522371600,
+  1540515600,
+  1553821200,
+  1572570000,
+};
+
+static const int8_t kOffsetCodesEurope_London[101] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0,
+};
+
+static const int8_t kDeltaCodesEurope_London[101] = {
+  0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4,
+  0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4,
+  0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4,
+  0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4,
+  0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4,
+  0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4,
+  0, 4, 0, 4, 0,
+};
+
+static const uint8_t kAbbrevIndexesEurope_London[101] = {
+  0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+  0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+  0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+  0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+  0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+  0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+  0, 1, 0, 1, 0,
+};
+
+static const char* const kAbbrevsEurope_London[2] = {
+  "GMT",
+  "BST",
+};
+
+const PrecomputedZone kZoneEurope_London(
+  &zonedbx::kZoneEurope_London /*zoneInfo*/,
+  0 /*startSeconds*/,
+  1577923200 /*untilSeconds*/,
+  101 /*numEntries*/,
+  kStartEpochSecondsEurope_London /*startEpochSeconds*/,
+  kOffsetCodesEurope_London /*offsetCodes*/,
+  kDeltaCodesEurope_London /*deltaCodes*/,
+  kAbbrevIndexesEurope_London /*abbrevIndexes*/,
+  kAbbrevsEurope_London /*abbrevs*/
+);
+
+//---------------------------------------------------------------------------
+// Zone name: Australia/Sydney
+// Entries: 101
+// Abbrevs: 2
+//---------------------------------------------------------------------------
+
+static const acetime_t kStartEpochSecondsAustralia_Sydney[101] = {
+  -2718000,
+  7315200,
+  20620800,
+  38764800,
+  57513600,
+  70819200,
+  88963200,
+  102268800,
+  120412800,
+  133718400,
+  152467200,
+  165168000,
+  183916800,
+  197222400,
+  215366400,
+  228067200,
+  246816000,
+  260726400,
+  276451200,
+  292176000,
+  307900800,
+  323625600,
+  339350400,
+  355075200,
+  370800000,
+  386524800,
+  402854400,
+  418579200,
+  434304000,
+  450028800,
+  465753600,
+  481478400,
+  497203200,
+  512928000,
+  528652800,
+  544377600,
+  560102400,
+  575827200,
+  592156800,
+  607881600,
+  623606400,
+  639331200,
+  655056000,
+  670780800,
+  686505600,
+  702230400,
+  717955200,
+  733680000,
+  749404800,
+  765734400,
+  781459200,
+  797184000,
+  812908800,
+  828633600,
+  844358400,
+  860083200,
+  875808000,
+  891532800,
+  907257600,
+  922982400,
+  939312000,
+  955036800,
+  970761600,
+  986486400,
+  1002211200,
+  1017936000,
+  1033660800,
+  1049385600,
+  1065110400,
+  1080835200,
+  1096560000,
+  1112284800,
+  1128614400,
+  1144339200,
+  1160064000,
+  1175788800,
+  1191513600,
+  1207238400,
+  1222963200,
+  1238688000,
+  1254412800,
+  1270137600,
+  1286467200,
+  1302192000,
+  1317916800,
+  1333641600,
+  1349366400,
+  1365091200,
+  1380816000,
+  1396540800,
+  1412265600,
+  1427990400,
+  1443715200,
+  1459440000,
+  1475769600,
+  1491494400,
+  1507219200,
+  1522944000,
+  1538668800,
+  1554393600,
+  1570118400,
+};
+
+static const int8_t kOffsetCodesAustralia_Sydney[101] = {
+  40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40,
+  40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40,
+  40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40,
+  40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40,
+  40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40,
+  40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40,
+  40, 40, 40, 40, 40,
+};
+
+static const int8_t kDeltaCodesAustralia_Sydney[101] = {
+  4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0,
+  4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0,
+  4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0,
+  4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0,
+  4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0,
+  4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0,
+  4, 0, 4, 0, 4,
+};
+
+static const uint8_t kAbbrevIndexesAustralia_Sydney[101] = {
+  0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+  0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+  0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+  0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+  0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+  0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+  0, 1, 0, 1, 0,
+};
+
+static const char* const kAbbrevsAustralia_Sydney[2] = {
+  "AEDT",
+  "AEST",
+};
+
+const PrecomputedZone kZoneAustralia_Sydney(
+  &zonedbx::kZoneAustralia_Sydney /*zoneInfo*/,
+  0 /*startSeconds*/,
+  1577923200 /*untilSeconds*/,
+  101 /*numEntries*/,
+  kStartEpochSecondsAustralia_Sydney /*startEpochSeconds*/,
+  kOffsetCodesAustralia_Sydney /*offsetCodes*/,
+  kDeltaCodesAustralia_Sydney /*deltaCodes*/,
+  kAbbrevIndexesAustralia_Sydney /*abbrevIndexes*/,
+  kAbbrevsAustralia_Sydney /*abbrevs*/
+);
+
+//---------------------------------------------------------------------------
+// Zone name: Asia/Kolkata
+// Entries: 1
+// Abbrevs: 1
+//---------------------------------------------------------------------------
+
+static const acetime_t kStartEpochSecondsAsia_Kolkata[1] = {
+  -2698200,
+};
+
+static const int8_t kOffsetCodesAsia_Kolkata[1] = {
+  22,
+};
+
+static const int8_t kDeltaCodesAsia_Kolkata[1] = {
+  0,
+};
+
+static const uint8_t kAbbrevIndexesAsia_Kolkata[1] = {
+  0,
+};
+
+static const char* const kAbbrevsAsia_Kolkata[1] = {
+  "IST",
+};
+
+const PrecomputedZone kZoneAsia_Kolkata(
+  &zonedbx::kZoneAsia_Kolkata /*zoneInfo*/,
+  0 /*startSeconds*/,
+  1577923200 /*untilSeconds*/,
+  1 /*numEntries*/,
+  kStartEpochSecondsAsia_Kolkata /*startEpochSeconds*/,
+  kOffsetCodesAsia_Kolkata /*offsetCodes*/,
+  kDeltaCodesAsia_Kolkata /*deltaCodes*/,
+  kAbbrevIndexesAsia_Kolkata /*abbrevIndexes*/,
+  kAbbrevsAsia_Kolkata /*abbrevs*/
+);
+
+}
+}
+}
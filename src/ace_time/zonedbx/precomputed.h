@@ -0,0 +1,29 @@
+// This file was generated by the following program:
+//
+//  $ ../../../tools/PrecomputedGenerator/PrecomputedGenerator.out < precomputed_zones.txt
+//
+// using the zonedbx:: files of TZ Database version 2019a, start_year 2000, until_year 2050.
+//
+// DO NOT EDIT
+
+#ifndef ACE_TIME_ZONEDBX_PRECOMPUTED_H
+#define ACE_TIME_ZONEDBX_PRECOMPUTED_H
+
+#include <ace_time/PrecomputedZone.h>
+
+namespace ace_time {
+namespace zonedbx {
+namespace precomputed {
+
+// Zones: 5
+extern const PrecomputedZone kZoneAmerica_Los_Angeles; // America/Los_Angeles
+extern const PrecomputedZone kZoneAmerica_New_York; // America/New_York
+extern const PrecomputedZone kZoneEurope_London; // Europe/London
+extern const PrecomputedZone kZoneAustralia_Sydney; // Australia/Sydney
+extern const PrecomputedZone kZoneAsia_Kolkata; // Asia/Kolkata
+
+}
+}
+}
+
+#endif
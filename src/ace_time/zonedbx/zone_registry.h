@@ -19,6 +19,8 @@ const uint16_t kZoneRegistrySize = 387;
 
 extern const extended::ZoneInfo* const kZoneRegistry[387];
 
+extern const extended::ZoneInfo* const kZoneRegistryById[387];
+
 }
 }
 #endif
@@ -299,6 +299,112 @@ test(BasicZoneProcessorTest, kZoneAmerica_Los_Angeles_outOfBounds) {
   assertEqual("", zoneProcessor.getAbbrev(epochSeconds));
 }
 
+test(BasicZoneProcessorTest, getOffsetDateTime) {
+  BasicZoneProcessor zoneProcessor(&zonedb::kZoneAmerica_Los_Angeles);
+
+  // Normal time
+  auto ldt = LocalDateTime::forComponents(2018, 3, 11, 1, 59, 0);
+  OffsetDateTime odt = zoneProcessor.getOffsetDateTime(ldt);
+  assertTrue(odt == OffsetDateTime::forLocalDateTimeAndOffset(
+      ldt, TimeOffset::forHour(-8)));
+
+  // In the gap, 2:30am is shifted forward to 3:30am PDT
+  ldt = LocalDateTime::forComponents(2018, 3, 11, 2, 30, 0);
+  odt = zoneProcessor.getOffsetDateTime(ldt);
+  assertTrue(odt == OffsetDateTime::forComponents(2018, 3, 11, 3, 30, 0,
+      TimeOffset::forHour(-7)));
+
+  // In the overlap, the earlier PDT is selected west of UTC
+  ldt = LocalDateTime::forComponents(2018, 11, 4, 1, 30, 0);
+  odt = zoneProcessor.getOffsetDateTime(ldt);
+  assertTrue(odt == OffsetDateTime::forLocalDateTimeAndOffset(
+      ldt, TimeOffset::forHour(-7)));
+
+  ldt = LocalDateTime::forComponents(2018, 11, 4, 2, 0, 0);
+  odt = zoneProcessor.getOffsetDateTime(ldt);
+  assertTrue(odt == OffsetDateTime::forLocalDateTimeAndOffset(
+      ldt, TimeOffset::forHour(-8)));
+
+  // Out of bounds
+  ldt = LocalDateTime::forComponents(1998, 3, 11, 1, 0, 0);
+  assertTrue(zoneProcessor.getOffsetDateTime(ldt).isError());
+}
+
+// The iterative algorithm of the previous getOffsetDateTime(), which evaluated
+// getUtcOffset() up to 3 times, used as a reference.
+static OffsetDateTime iterativeOffsetDateTime(
+    const BasicZoneProcessor& zoneProcessor, const LocalDateTime& ldt) {
+  acetime_t epochSeconds0 = ldt.toEpochSeconds();
+  TimeOffset offset0 = zoneProcessor.getUtcOffset(epochSeconds0);
+  if (offset0.isError()) return OffsetDateTime::forError();
+
+  auto odt = OffsetDateTime::forLocalDateTimeAndOffset(ldt, offset0);
+  acetime_t epochSeconds1 = odt.toEpochSeconds();
+  TimeOffset offset1 = zoneProcessor.getUtcOffset(epochSeconds1);
+
+  odt = OffsetDateTime::forLocalDateTimeAndOffset(ldt, offset1);
+  acetime_t epochSeconds2 = odt.toEpochSeconds();
+  TimeOffset offset2 = zoneProcessor.getUtcOffset(epochSeconds2);
+
+  if (offset1.toOffsetCode() == offset2.toOffsetCode()) return odt;
+  return (epochSeconds1 > epochSeconds2)
+      ? OffsetDateTime::forEpochSeconds(epochSeconds1, offset1)
+      : OffsetDateTime::forEpochSeconds(epochSeconds2, offset2);
+}
+
+static bool isSameOffsetDateTime(const BasicZoneProcessor& zoneProcessor,
+    acetime_t localSeconds) {
+  auto ldt = LocalDateTime::forEpochSeconds(localSeconds);
+  OffsetDateTime expected = iterativeOffsetDateTime(zoneProcessor, ldt);
+  OffsetDateTime actual = zoneProcessor.getOffsetDateTime(ldt);
+  if (expected.isError() || actual.isError()) {
+    return expected.isError() == actual.isError();
+  }
+  return expected == actual;
+}
+
+// Verify that the single search of getOffsetDateTime() gives the same result
+// as the iterative algorithm, every 15 minutes around each Transition and each
+// Jan 1, and once a week in between.
+test(BasicZoneProcessorTest, getOffsetDateTime_allZones) {
+  const acetime_t kStep = 15 * 60;
+  const acetime_t kMargin = 16 * 3600;
+  BasicZoneProcessor zoneProcessor;
+
+  for (uint16_t z = 0; z < zonedb::kZoneRegistrySize; z++) {
+    zoneProcessor.setZoneInfo(zonedb::kZoneRegistry[z]);
+    for (int16_t year = 2000; year < 2050; year++) {
+      acetime_t yearStart = LocalDate::forComponents(year, 1, 1)
+          .toEpochSeconds();
+      acetime_t yearEnd = LocalDate::forComponents(year + 1, 1, 1)
+          .toEpochSeconds();
+
+      // Copy the start times, since the lookups below may recalculate the
+      // Transitions of a different year.
+      zoneProcessor.init(LocalDate::forComponents(year, 7, 1));
+      uint8_t numTransitions = zoneProcessor.mNumTransitions;
+      acetime_t starts[4];
+      for (uint8_t i = 0; i < numTransitions; i++) {
+        starts[i] = zoneProcessor.mTransitions[i].startEpochSeconds;
+      }
+
+      for (uint8_t i = 0; i < numTransitions; i++) {
+        for (acetime_t t = starts[i] - kMargin; t <= starts[i] + kMargin;
+            t += kStep) {
+          assertTrue(isSameOffsetDateTime(zoneProcessor, t));
+        }
+      }
+      for (acetime_t t = yearStart - kMargin; t <= yearStart + kMargin;
+          t += kStep) {
+        assertTrue(isSameOffsetDateTime(zoneProcessor, t));
+      }
+      for (acetime_t t = yearStart; t < yearEnd; t += 7 * 86400 + 3600) {
+        assertTrue(isSameOffsetDateTime(zoneProcessor, t));
+      }
+    }
+  }
+}
+
 // --------------------------------------------------------------------------
 
 void setup() {
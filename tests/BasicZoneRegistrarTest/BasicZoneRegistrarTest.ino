@@ -67,6 +67,22 @@ test(BasicZoneRegistrarTest, getZoneInfoForId_not_found) {
   assertTrue(zoneInfo == nullptr);
 }
 
+test(BasicZoneRegistrarTest, getZoneInfoForId_sortedById) {
+  BasicZoneRegistrar zoneRegistrar(
+      zonedb::kZoneRegistrySize, zonedb::kZoneRegistry,
+      zonedb::kZoneRegistryById);
+  assertTrue(zoneRegistrar.isSortedById());
+
+  // Every zone must be found through the kZoneRegistryById.
+  for (uint16_t i = 0; i < zonedb::kZoneRegistrySize; i++) {
+    const basic::ZoneInfo* zoneInfo = zoneRegistrar.getZoneInfoForIndex(i);
+    uint32_t zoneId = BasicZone(zoneInfo).zoneId();
+    assertTrue(zoneInfo == zoneRegistrar.getZoneInfoForId(zoneId));
+  }
+
+  assertTrue(zoneRegistrar.getZoneInfoForId(0x11111111) == nullptr);
+}
+
 // --------------------------------------------------------------------------
 // Test ZoneRegistrar::isSorted(), binarySearch(), linearSearch() for *sorted*
 // registry. Sufficient to test BasicZoneRegistrar only since they are the same
@@ -127,6 +143,29 @@ test(BasicZoneRegistrarTest_Sorted, binarySearch_not_found) {
   assertTrue(zi == nullptr);
 }
 
+test(BasicZoneRegistrarTest_Sorted, isSortedById) {
+  assertTrue(BasicZoneRegistrar::isSortedById(
+      zonedb::kZoneRegistryById, zonedb::kZoneRegistrySize));
+  assertFalse(BasicZoneRegistrar::isSortedById(
+      zonedb::kZoneRegistry, zonedb::kZoneRegistrySize));
+  assertFalse(BasicZoneRegistrar::isSortedById(
+      nullptr, zonedb::kZoneRegistrySize));
+}
+
+test(BasicZoneRegistrarTest_Sorted, binarySearchUsingId) {
+  const basic::ZoneInfo* zi = BasicZoneRegistrar::binarySearchUsingId(
+      zonedb::kZoneRegistryById, zonedb::kZoneRegistrySize, 0xb7f7e8f2);
+  assertEqual(F("America/Los_Angeles"), BasicZone(zi).name());
+
+  // Not found, below and above all zoneIds.
+  const basic::ZoneInfo* first = BasicZoneRegistrar::binarySearchUsingId(
+      zonedb::kZoneRegistryById, zonedb::kZoneRegistrySize, 0);
+  assertTrue(first == nullptr);
+  const basic::ZoneInfo* last = BasicZoneRegistrar::binarySearchUsingId(
+      zonedb::kZoneRegistryById, zonedb::kZoneRegistrySize, 0xffffffff);
+  assertTrue(last == nullptr);
+}
+
 // --------------------------------------------------------------------------
 // Test ZoneRegistrar::isSorted(), binarySearch(), linearSearch() for *unsorted*
 // registry. Sufficient to test BasicZoneRegistrar only since they are the same
@@ -91,6 +91,89 @@ test(DateStringsTest, dayOfWeekStringsFitInBuffer) {
   assertLessOrEqual(maxLength, DateStrings::kBufferSize - 1);
 }
 
+test(DateStringsTest, monthName) {
+  DateStrings ds;
+  for (uint8_t month = 0; month <= 13; month++) {
+    uint8_t length;
+    const __FlashStringHelper* name = DateStrings::monthLongName(
+        month, length);
+    assertEqual(ds.monthLongString(month), name);
+    assertEqual(ds.monthLongString(month), DateStrings::monthLongName(month));
+    assertEqual(strlen_P((const char*) name), (size_t) length);
+
+    const __FlashStringHelper* shortName = DateStrings::monthShortName(month);
+    assertEqual(ds.monthShortString(month), shortName);
+    assertEqual((size_t) DateStrings::kShortNameLength,
+        strlen_P((const char*) shortName));
+  }
+  assertEqual("September", DateStrings::monthLongName(9));
+  assertEqual("Sep", DateStrings::monthShortName(9));
+}
+
+test(DateStringsTest, dayOfWeekName) {
+  DateStrings ds;
+  for (uint8_t dayOfWeek = 0; dayOfWeek <= 8; dayOfWeek++) {
+    uint8_t length;
+    const __FlashStringHelper* name = DateStrings::dayOfWeekLongName(
+        dayOfWeek, length);
+    assertEqual(ds.dayOfWeekLongString(dayOfWeek), name);
+    assertEqual(ds.dayOfWeekLongString(dayOfWeek),
+        DateStrings::dayOfWeekLongName(dayOfWeek));
+    assertEqual(strlen_P((const char*) name), (size_t) length);
+
+    const __FlashStringHelper* shortName =
+        DateStrings::dayOfWeekShortName(dayOfWeek);
+    assertEqual(ds.dayOfWeekShortString(dayOfWeek), shortName);
+    assertEqual((size_t) DateStrings::kShortNameLength,
+        strlen_P((const char*) shortName));
+  }
+  assertEqual("Wednesday", DateStrings::dayOfWeekLongName(3));
+  assertEqual("Wed", DateStrings::dayOfWeekShortName(3));
+}
+
+// --------------------------------------------------------------------------
+// BufferWriter
+// --------------------------------------------------------------------------
+
+test(BufferWriterTest, write) {
+  char buf[16];
+  BufferWriter writer(buf, sizeof(buf));
+  writer.writePad4(2019);
+  writer.writeChar('-');
+  writer.writePad2(7);
+  writer.writeChar(' ');
+  writer.writeString("ab");
+  writer.writeString(F("cd"));
+  assertFalse(writer.isOverflow());
+  assertEqual((size_t) 12, writer.finish());
+  assertEqual("2019-07 abcd", buf);
+}
+
+test(BufferWriterTest, digitPairs) {
+  char buf[3];
+  for (uint8_t i = 0; i < 100; i++) {
+    BufferWriter writer(buf, sizeof(buf));
+    writer.writePad2(i);
+    assertEqual((size_t) 2, writer.finish());
+    assertEqual(i, (buf[0] - '0') * 10 + (buf[1] - '0'));
+  }
+}
+
+test(BufferWriterTest, overflow) {
+  char buf[4] = "xyz";
+  BufferWriter writer(buf, sizeof(buf));
+  writer.writeString("abc");
+  assertFalse(writer.isOverflow());
+  writer.writeChar('d');
+  assertTrue(writer.isOverflow());
+  assertEqual((size_t) 0, writer.finish());
+  assertEqual("", buf);
+
+  BufferWriter empty(buf, 0);
+  assertTrue(empty.isOverflow());
+  assertEqual((size_t) 0, empty.finish());
+}
+
 // --------------------------------------------------------------------------
 // common::decToBcd(), common::bcdToDec()
 // --------------------------------------------------------------------------
@@ -0,0 +1,172 @@
+#line 2 "CompiledZoneTest.ino"
+
+#include <AUnit.h>
+#include <aunit/fake/FakePrint.h>
+#include <AceTime.h>
+
+using namespace aunit;
+using namespace aunit::fake;
+using namespace ace_time;
+
+// --------------------------------------------------------------------------
+
+test(CompiledZoneTest, getUtcOffset) {
+  CompiledZone compiledZone(&zonedbx::kZoneAmerica_Los_Angeles);
+  assertFalse(compiledZone.isError());
+  assertTrue(&zonedbx::kZoneAmerica_Los_Angeles == compiledZone.getZoneInfo());
+
+  // 2 transitions per year from 2000 until 2049, merged into 1 entry at the
+  // start of 2000.
+  assertEqual(101, compiledZone.getNumEntries());
+  assertEqual(LocalDate::forComponents(2000, 1, 1).toEpochSeconds(),
+      compiledZone.getStartSeconds());
+  assertEqual(LocalDate::forComponents(2050, 1, 1).toEpochSeconds(),
+      compiledZone.getUntilSeconds());
+
+  acetime_t seconds = LocalDateTime::forComponents(2019, 3, 10, 1, 59, 59)
+      .toEpochSeconds() + 8 * 3600;
+  assertEqual(-8*60, compiledZone.getUtcOffset(seconds).toMinutes());
+  assertEqual(0, compiledZone.getDeltaOffset(seconds).toMinutes());
+  assertEqual("PST", compiledZone.getAbbrev(seconds));
+
+  seconds++;
+  assertEqual(-7*60, compiledZone.getUtcOffset(seconds).toMinutes());
+  assertEqual(60, compiledZone.getDeltaOffset(seconds).toMinutes());
+  assertEqual("PDT", compiledZone.getAbbrev(seconds));
+}
+
+test(CompiledZoneTest, getOffsetDateTime) {
+  CompiledZone compiledZone(&zonedbx::kZoneAmerica_Los_Angeles);
+
+  // In the gap, the LocalDateTime is shifted forward by one hour.
+  auto ldt = LocalDateTime::forComponents(2019, 3, 10, 2, 30, 0);
+  OffsetDateTime odt = compiledZone.getOffsetDateTime(ldt);
+  assertTrue(odt == OffsetDateTime::forComponents(
+      2019, 3, 10, 3, 30, 0, TimeOffset::forHour(-7)));
+
+  // In the overlap, the result is the same as ExtendedZoneProcessor.
+  ExtendedZoneProcessor extendedProcessor(&zonedbx::kZoneAmerica_Los_Angeles);
+  ldt = LocalDateTime::forComponents(2019, 11, 3, 1, 30, 0);
+  odt = compiledZone.getOffsetDateTime(ldt);
+  assertTrue(odt == extendedProcessor.getOffsetDateTime(ldt));
+}
+
+test(CompiledZoneTest, outsideOfTable) {
+  CompiledZone compiledZone(&zonedbx::kZoneAmerica_Los_Angeles);
+
+  acetime_t seconds = compiledZone.getStartSeconds() - 1;
+  assertTrue(compiledZone.getUtcOffset(seconds).isError());
+  assertTrue(compiledZone.getDeltaOffset(seconds).isError());
+  assertEqual("", compiledZone.getAbbrev(seconds));
+
+  seconds = compiledZone.getUntilSeconds();
+  assertTrue(compiledZone.getUtcOffset(seconds).isError());
+
+  auto ldt = LocalDateTime::forComponents(1999, 7, 1, 0, 0, 0);
+  assertTrue(compiledZone.getOffsetDateTime(ldt).isError());
+}
+
+test(CompiledZoneTest, empty) {
+  CompiledZone compiledZone;
+  assertTrue(compiledZone.isError());
+  assertTrue(compiledZone.getUtcOffset(0).isError());
+
+  CompiledZone nullZone(nullptr);
+  assertTrue(nullZone.isError());
+  assertTrue(TimeZone::forCompiledZone(&nullZone).isError());
+}
+
+test(CompiledZoneTest, copy) {
+  CompiledZone original(&zonedbx::kZoneEurope_London);
+  CompiledZone copy = original;
+  original = CompiledZone(&zonedbx::kZoneAsia_Tokyo);
+
+  acetime_t seconds = LocalDateTime::forComponents(2019, 7, 1, 0, 0, 0)
+      .toEpochSeconds();
+  assertEqual(60, copy.getUtcOffset(seconds).toMinutes());
+  assertEqual("BST", copy.getAbbrev(seconds));
+  assertEqual(9*60, original.getUtcOffset(seconds).toMinutes());
+}
+
+// Verify that the table agrees with ExtendedZoneProcessor for every zone in
+// zonedbx, over the whole range of the table.
+test(CompiledZoneTest, allZones) {
+  ExtendedZoneRegistrar registrar(
+      zonedbx::kZoneRegistrySize, zonedbx::kZoneRegistry);
+
+  for (uint16_t i = 0; i < registrar.registrySize(); i++) {
+    const extended::ZoneInfo* zoneInfo = registrar.getZoneInfoForIndex(i);
+    CompiledZone compiledZone(zoneInfo);
+    ExtendedZoneProcessor extendedProcessor(zoneInfo);
+    assertEqual(LocalDate::forComponents(2050, 1, 1).toEpochSeconds(),
+        compiledZone.getUntilSeconds());
+
+    for (acetime_t seconds = compiledZone.getStartSeconds();
+        seconds < compiledZone.getUntilSeconds();
+        seconds += 29 * 86400L + 3599) {
+      assertEqual(extendedProcessor.getUtcOffset(seconds).toMinutes(),
+          compiledZone.getUtcOffset(seconds).toMinutes());
+      assertEqual(extendedProcessor.getAbbrev(seconds),
+          compiledZone.getAbbrev(seconds));
+
+      // The range of getOffsetDateTime() applies to the LocalDateTime. Its
+      // result must survive a round trip through its epochSeconds. (The
+      // ExtendedZoneProcessor does not always do that, e.g. in the hour after
+      // the overlap of America/Godthab in 2003, so it is not compared here.)
+      LocalDateTime ldt = LocalDateTime::forEpochSeconds(seconds);
+      if (! compiledZone.contains(ldt.toEpochSeconds())) continue;
+      OffsetDateTime odt = compiledZone.getOffsetDateTime(ldt);
+      assertEqual(
+          extendedProcessor.getUtcOffset(odt.toEpochSeconds()).toMinutes(),
+          odt.timeOffset().toMinutes());
+    }
+  }
+}
+
+test(CompiledZoneTest, timeZone) {
+  static const CompiledZone compiledZone(&zonedbx::kZoneAmerica_New_York);
+  TimeZone tz = TimeZone::forCompiledZone(&compiledZone);
+  TimeZone tz2 = tz;
+
+  assertEqual(TimeZone::kTypeCompiled, tz.getType());
+  assertEqual((uint32_t) 0x1e2a7654, tz.getZoneId());
+  assertTrue(tz == tz2);
+  assertTrue(tz != TimeZone::forUtc());
+
+  acetime_t seconds = LocalDateTime::forComponents(2019, 7, 1, 0, 0, 0)
+      .toEpochSeconds();
+  assertEqual(-4*60, tz2.getUtcOffset(seconds).toMinutes());
+  assertEqual(60, tz2.getDeltaOffset(seconds).toMinutes());
+
+  auto dt = ZonedDateTime::forComponents(2019, 7, 1, 12, 0, 0, tz);
+  assertEqual(-4*60, dt.timeOffset().toMinutes());
+
+  TimeZoneData data = tz.toTimeZoneData();
+  assertEqual(TimeZoneData::kTypeZoneId, data.type);
+  assertEqual(tz.getZoneId(), data.zoneId);
+
+  FakePrint fakePrint;
+  tz.printTo(fakePrint);
+  assertEqual(F("America/New_York"), fakePrint.getBuffer());
+  fakePrint.flush();
+  tz.printShortTo(fakePrint);
+  assertEqual(F("New_York"), fakePrint.getBuffer());
+  fakePrint.flush();
+  tz.printAbbrevTo(fakePrint, seconds);
+  assertEqual(F("EDT"), fakePrint.getBuffer());
+  fakePrint.flush();
+}
+
+// --------------------------------------------------------------------------
+
+void setup() {
+#if defined(ARDUINO)
+  delay(1000); // wait for stability on some boards to prevent garbage SERIAL_PORT_MONITOR
+#endif
+  SERIAL_PORT_MONITOR.begin(115200); // ESP8266 default of 74880 not supported on Linux
+  while(!SERIAL_PORT_MONITOR); // for the Arduino Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
@@ -0,0 +1,115 @@
+#line 2 "ConcurrentZoneManagerTest.ino"
+
+#include <AUnit.h>
+#include <AceTime.h>
+
+using namespace aunit;
+using namespace ace_time;
+
+// ConcurrentZoneManager is available only on Linux or MacOS.
+#if ! defined(ARDUINO)
+
+#include <thread>
+
+// --------------------------------------------------------------------------
+
+static ConcurrentZoneManager<2> zoneManager(
+    zonedbx::kZoneRegistrySize, zonedbx::kZoneRegistry);
+
+test(ConcurrentZoneManagerTest, createForZoneName) {
+  TimeZone tz = zoneManager.createForZoneName("America/Los_Angeles");
+  assertEqual(TimeZone::kTypeExtendedManaged, tz.getType());
+
+  acetime_t seconds = LocalDateTime::forComponents(2019, 7, 1, 0, 0, 0)
+      .toEpochSeconds();
+  assertEqual(-7*60, tz.getUtcOffset(seconds).toMinutes());
+}
+
+// Each thread gets its own ZoneProcessor for the same ZoneInfo.
+test(ConcurrentZoneManagerTest, processorPerThread) {
+  ThreadLocalZoneProcessorCache<ExtendedZoneProcessorCache<2>> cache;
+
+  ZoneProcessor* processor = cache.getZoneProcessor(
+      &zonedbx::kZoneAmerica_Los_Angeles);
+  ZoneProcessor* otherProcessor = nullptr;
+  std::thread thread([&cache, &otherProcessor]() {
+    otherProcessor = cache.getZoneProcessor(
+        &zonedbx::kZoneAmerica_Los_Angeles);
+  });
+  thread.join();
+
+  assertTrue(otherProcessor != nullptr);
+  assertTrue(processor != otherProcessor);
+  assertTrue(processor == cache.getZoneProcessor(
+      &zonedbx::kZoneAmerica_Los_Angeles));
+}
+
+// Share the same TimeZones across threads, and compare the results of each
+// thread against an ExtendedZoneProcessor used by a single thread.
+test(ConcurrentZoneManagerTest, sharedTimeZones) {
+  const uint8_t kNumZones = 3;
+  const extended::ZoneInfo* const zoneInfos[kNumZones] = {
+    &zonedbx::kZoneAmerica_Los_Angeles,
+    &zonedbx::kZoneEurope_London,
+    &zonedbx::kZoneAustralia_Sydney,
+  };
+  const uint16_t kNumSamples = 200;
+  const acetime_t start = LocalDateTime::forComponents(2018, 1, 1, 0, 0, 0)
+      .toEpochSeconds();
+  const acetime_t step = 3 * 86400 + 3600;
+
+  // Expected offsets, in minutes.
+  int16_t expected[kNumZones][kNumSamples];
+  TimeZone timeZones[kNumZones];
+  for (uint8_t z = 0; z < kNumZones; z++) {
+    ExtendedZoneProcessor processor(zoneInfos[z]);
+    for (uint16_t i = 0; i < kNumSamples; i++) {
+      expected[z][i] = processor.getUtcOffset(start + i * step).toMinutes();
+    }
+    timeZones[z] = zoneManager.createForZoneInfo(zoneInfos[z]);
+  }
+
+  // Each thread walks through the samples in a different order, so that the
+  // threads would overwrite each other's transitions if they shared the
+  // ZoneProcessors.
+  const uint8_t kNumThreads = 4;
+  uint16_t mismatches[kNumThreads] = {};
+  std::thread threads[kNumThreads];
+  for (uint8_t t = 0; t < kNumThreads; t++) {
+    threads[t] = std::thread([&, t]() {
+      for (uint8_t repeat = 0; repeat < 20; repeat++) {
+        for (uint16_t n = 0; n < kNumSamples; n++) {
+          uint16_t i = (n * (2 * t + 1)) % kNumSamples;
+          for (uint8_t z = 0; z < kNumZones; z++) {
+            int16_t minutes = timeZones[z].getUtcOffset(start + i * step)
+                .toMinutes();
+            if (minutes != expected[z][i]) mismatches[t]++;
+          }
+        }
+      }
+    });
+  }
+  for (uint8_t t = 0; t < kNumThreads; t++) {
+    threads[t].join();
+  }
+
+  for (uint8_t t = 0; t < kNumThreads; t++) {
+    assertEqual(0, mismatches[t]);
+  }
+}
+
+#endif
+
+// --------------------------------------------------------------------------
+
+void setup() {
+#if defined(ARDUINO)
+  delay(1000); // wait for stability on some boards to prevent garbage SERIAL_PORT_MONITOR
+#endif
+  SERIAL_PORT_MONITOR.begin(115200); // ESP8266 default of 74880 not supported on Linux
+  while(!SERIAL_PORT_MONITOR); // for the Arduino Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
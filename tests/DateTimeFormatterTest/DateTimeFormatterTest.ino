@@ -0,0 +1,131 @@
+#line 2 "DateTimeFormatterTest.ino"
+
+#include <AUnit.h>
+#include <aunit/fake/FakePrint.h>
+#include <AceTime.h>
+
+using namespace aunit;
+using namespace aunit::fake;
+using namespace ace_time;
+
+ExtendedZoneProcessor zoneProcessor;
+
+// 2018-08-31 13:48:01 PDT, a Friday.
+static ZonedDateTime losAngeles() {
+  TimeZone tz = TimeZone::forZoneInfo(
+      &zonedbx::kZoneAmerica_Los_Angeles, &zoneProcessor);
+  return ZonedDateTime::forComponents(2018, 8, 31, 13, 48, 1, tz);
+}
+
+// --------------------------------------------------------------------------
+
+test(DateTimeFormatterTest, conversions) {
+  char buf[64];
+  ZonedDateTime dt = losAngeles();
+
+  auto formatter = DateTimeFormatter::forPattern("%a %d %b %Y %H:%M %Z");
+  assertFalse(formatter.isError());
+  assertEqual((size_t) 25, formatter.formatTo(buf, sizeof(buf), dt));
+  assertEqual("Fri 31 Aug 2018 13:48 PDT", buf);
+
+  formatter = DateTimeFormatter::forPattern("%A, %B %e %y %I:%M:%S %p");
+  formatter.formatTo(buf, sizeof(buf), dt);
+  assertEqual("Friday, August 31 18 01:48:01 PM", buf);
+
+  formatter = DateTimeFormatter::forPattern("%F %T%z %:z %j %u %R");
+  formatter.formatTo(buf, sizeof(buf), dt);
+  assertEqual("2018-08-31 13:48:01-0700 -07:00 243 5 13:48", buf);
+
+  formatter = DateTimeFormatter::forPattern("100%%%n%t%h");
+  formatter.formatTo(buf, sizeof(buf), dt);
+  assertEqual("100%\n\tAug", buf);
+}
+
+test(DateTimeFormatterTest, padding) {
+  char buf[32];
+  TimeZone tz = TimeZone::forTimeOffset(TimeOffset::forHourMinute(5, 45));
+  ZonedDateTime dt = ZonedDateTime::forComponents(2001, 2, 3, 0, 5, 9, tz);
+
+  auto formatter = DateTimeFormatter::forPattern("%e|%j|%I%p|%z|%Z");
+  formatter.formatTo(buf, sizeof(buf), dt);
+  assertEqual(" 3|034|12AM|+0545|STD", buf);
+}
+
+test(DateTimeFormatterTest, printTo) {
+  FakePrint fakePrint;
+  char buf[64];
+  ZonedDateTime dt = losAngeles();
+
+  auto formatter = DateTimeFormatter::forPattern(
+      "%a %e %B %Y %I:%M:%S %p %:z %Z \xC2\xB0");
+  formatter.printTo(fakePrint, dt);
+  formatter.formatTo(buf, sizeof(buf), dt);
+  assertEqual(fakePrint.getBuffer(), buf);
+  assertEqual("Fri 31 August 2018 01:48:01 PM -07:00 PDT \xC2\xB0", buf);
+}
+
+test(DateTimeFormatterTest, fraction) {
+  FakePrint fakePrint;
+  char buf[64];
+  ZonedDateTime dt = losAngeles();
+  Instant instant = dt.toInstant(123456789);
+
+  auto formatter = DateTimeFormatter::forPattern("%T.%3N|%6N|%N|%9N %Z");
+  formatter.formatTo(buf, sizeof(buf), instant, dt.timeZone());
+  assertEqual("13:48:01.123|123456|123456789|123456789 PDT", buf);
+
+  formatter.printTo(fakePrint, instant, dt.timeZone());
+  assertEqual(buf, fakePrint.getBuffer());
+
+  // A ZonedDateTime has no fraction.
+  formatter.formatTo(buf, sizeof(buf), dt);
+  assertEqual("13:48:01.000|000000|000000000|000000000 PDT", buf);
+
+  formatter.formatTo(buf, sizeof(buf), Instant::forError(), dt.timeZone());
+  assertEqual("<Invalid ZonedDateTime>", buf);
+
+  assertTrue(DateTimeFormatter::forPattern("%3").isError());
+  assertTrue(DateTimeFormatter::forPattern("%4N").isError());
+  assertTrue(DateTimeFormatter::forPattern("%6Z").isError());
+}
+
+test(DateTimeFormatterTest, errors) {
+  char buf[32];
+  ZonedDateTime dt = losAngeles();
+
+  assertTrue(DateTimeFormatter::forPattern("%Q").isError());
+  assertTrue(DateTimeFormatter::forPattern("abc%").isError());
+  assertTrue(DateTimeFormatter::forPattern("%:").isError());
+  assertTrue(DateTimeFormatter::forPattern("%:Z").isError());
+  assertTrue(DateTimeFormatter::forError().isError());
+  assertFalse(DateTimeFormatter::forPattern("").isError());
+
+  // Too many opcodes.
+  assertFalse(DateTimeFormatter::forPattern(
+      "0123456789012345678901234567890%Y").isError());
+  assertTrue(DateTimeFormatter::forPattern(
+      "0123456789012345678901234567890%F").isError());
+
+  assertEqual((size_t) 0, DateTimeFormatter::forPattern("%Q")
+      .formatTo(buf, sizeof(buf), dt));
+  assertEqual("", buf);
+
+  auto formatter = DateTimeFormatter::forPattern("%F");
+  formatter.formatTo(buf, sizeof(buf), ZonedDateTime::forError());
+  assertEqual("<Invalid ZonedDateTime>", buf);
+  assertEqual((size_t) 0, formatter.formatTo(buf, 10, dt));
+}
+
+// --------------------------------------------------------------------------
+
+void setup() {
+#if defined(ARDUINO)
+  delay(1000); // wait for stability on some boards to prevent garbage SERIAL_PORT_MONITOR
+#endif
+  SERIAL_PORT_MONITOR.begin(115200); // ESP8266 default of 74880 not supported on Linux
+  while(!SERIAL_PORT_MONITOR); // for the Arduino Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
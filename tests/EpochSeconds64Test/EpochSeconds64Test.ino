@@ -0,0 +1,183 @@
+#line 2 "EpochSeconds64Test.ino"
+
+#include <AUnit.h>
+#include <AceTime.h>
+#include <ace_time/local_date_mutation.h>
+
+using namespace aunit;
+using namespace ace_time;
+
+// The 64-bit acetime_t and the wide year are enabled only if the entire
+// library is compiled with ACE_TIME_EPOCH_SECONDS_64=1, which the Makefile
+// does on Linux and MacOS.
+
+// --------------------------------------------------------------------------
+
+#if ACE_TIME_EPOCH_SECONDS_64
+
+test(EpochSeconds64Test, limits) {
+  assertEqual(sizeof(int64_t), sizeof(acetime_t));
+  assertEqual((int16_t) 1, (int16_t) LocalDate::kMinYear);
+  assertEqual((int16_t) 9999, (int16_t) LocalDate::kMaxYear);
+
+  assertFalse(LocalDate::forComponents(1, 1, 1).isError());
+  assertFalse(LocalDate::forComponents(9999, 12, 31).isError());
+  assertTrue(LocalDate::forComponents(0, 12, 31).isError());
+  assertTrue(LocalDate::forComponents(10000, 1, 1).isError());
+}
+
+test(EpochSeconds64Test, epochDays) {
+  LocalDate ld = LocalDate::forComponents(1, 1, 1);
+  assertTrue((acetime_t) -730119 == ld.toEpochDays());
+  assertTrue(ld == LocalDate::forEpochDays(-730119));
+
+  ld = LocalDate::forComponents(9999, 12, 31);
+  assertTrue((acetime_t) 2921939 == ld.toEpochDays());
+  assertTrue(ld == LocalDate::forEpochDays(2921939));
+
+  ld = LocalDate::forComponents(1600, 3, 1);
+  assertTrue(ld == LocalDate::forEpochDays(ld.toEpochDays()));
+
+  assertTrue(LocalDate::forEpochDays(-730120).isError());
+  assertTrue(LocalDate::forEpochDays(2921940).isError());
+}
+
+test(EpochSeconds64Test, extractYearMonthDays) {
+  const acetime_t epochDays[] = {
+    -730119, 0, 2921939, 2921940, LocalDate::kInvalidEpochDays
+  };
+  int16_t years[5];
+  uint8_t months[5];
+  uint8_t days[5];
+  LocalDate::extractYearMonthDays(epochDays, years, months, days, 5);
+
+  assertEqual((int16_t) 1, years[0]);
+  assertEqual(1, months[0]);
+  assertEqual(1, days[0]);
+  assertEqual((int16_t) 2000, years[1]);
+  assertEqual((int16_t) 9999, years[2]);
+  assertEqual(12, months[2]);
+  assertEqual(31, days[2]);
+  assertEqual((int16_t) 0, years[3]);
+  assertEqual((int16_t) 0, years[4]);
+}
+
+test(EpochSeconds64Test, yearTiny) {
+  LocalDate ld = LocalDate::forComponents(2127, 12, 31);
+  assertEqual(127, ld.yearTiny());
+
+  ld = LocalDate::forComponents(2128, 1, 1);
+  assertEqual(LocalDate::kInvalidYearTiny, ld.yearTiny());
+  assertFalse(ld.isError());
+
+  ld.yearTiny(-1);
+  assertEqual((int16_t) 1999, ld.year());
+
+  ld.year(10000);
+  assertTrue(ld.isError());
+}
+
+test(EpochSeconds64Test, epochSeconds_beyond_2038) {
+  // 2100-01-01 00:00:00 does not fit in 32 bits.
+  LocalDateTime ldt = LocalDateTime::forComponents(2100, 1, 1, 0, 0, 0);
+  acetime_t epochSeconds = ldt.toEpochSeconds();
+  assertTrue((acetime_t) 36525 * 86400 == epochSeconds);
+  assertTrue(ldt == LocalDateTime::forEpochSeconds(epochSeconds));
+
+  // 1800-01-01 00:00:00 is before 1931-12-14, the 32-bit limit.
+  ldt = LocalDateTime::forComponents(1800, 1, 1, 0, 0, 0);
+  assertTrue(ldt == LocalDateTime::forEpochSeconds(ldt.toEpochSeconds()));
+  assertTrue(ldt == LocalDateTime::forUnixSeconds(ldt.toUnixSeconds()));
+}
+
+test(EpochSeconds64Test, offsetDateTime) {
+  TimeOffset offset = TimeOffset::forHourMinute(-8, 0);
+  auto odt = OffsetDateTime::forComponents(9999, 12, 31, 23, 59, 59, offset);
+  acetime_t epochSeconds = odt.toEpochSeconds();
+  assertTrue((acetime_t) 2921940 * 86400 - 1 + 8 * 3600 == epochSeconds);
+  assertTrue(odt == OffsetDateTime::forEpochSeconds(epochSeconds, offset));
+
+  // The UTC time is in the year 10000.
+  odt = OffsetDateTime::forEpochSeconds(epochSeconds, TimeOffset());
+  assertTrue(odt.isError());
+}
+
+test(EpochSeconds64Test, zonedDateTime) {
+  ExtendedZoneProcessor zoneProcessor;
+  TimeZone tz = TimeZone::forZoneInfo(
+      &zonedbx::kZoneAmerica_Los_Angeles, &zoneProcessor);
+
+  // Within the range of the zone database.
+  auto dt = ZonedDateTime::forComponents(2049, 7, 1, 12, 0, 0, tz);
+  assertEqual(-7 * 60, dt.timeOffset().toMinutes());
+  assertTrue(dt == ZonedDateTime::forEpochSeconds(dt.toEpochSeconds(), tz));
+
+  // A fixed offset has no zone database.
+  tz = TimeZone::forTimeOffset(TimeOffset::forHourMinute(1, 0));
+  dt = ZonedDateTime::forComponents(3000, 2, 28, 1, 2, 3, tz);
+  assertFalse(dt.isError());
+  assertTrue(dt == ZonedDateTime::forEpochSeconds(dt.toEpochSeconds(), tz));
+}
+
+// The adjacent years 0 and 10000 of the first and last years are outside of
+// LocalDate, and must not break the TZ rules of the years themselves.
+test(EpochSeconds64Test, posixZoneProcessor) {
+  PosixZoneProcessor processor("PST8PDT,M3.2.0,M11.1.0");
+  acetime_t seconds = LocalDateTime::forComponents(1, 1, 15, 0, 0, 0)
+      .toEpochSeconds();
+  assertEqual(-8*60, processor.getUtcOffset(seconds).toMinutes());
+  seconds = LocalDateTime::forComponents(1, 6, 1, 0, 0, 0).toEpochSeconds();
+  assertEqual(-7*60, processor.getUtcOffset(seconds).toMinutes());
+  seconds = LocalDateTime::forComponents(9999, 6, 1, 0, 0, 0)
+      .toEpochSeconds();
+  assertEqual(-7*60, processor.getUtcOffset(seconds).toMinutes());
+  seconds = LocalDateTime::forComponents(9999, 12, 31, 12, 0, 0)
+      .toEpochSeconds();
+  assertEqual(-8*60, processor.getUtcOffset(seconds).toMinutes());
+
+  processor.setPosixTz("CET-1CEST,M3.5.0,M10.5.0/3");
+  seconds = LocalDateTime::forComponents(1, 1, 1, 0, 0, 0).toEpochSeconds();
+  assertEqual(60, processor.getUtcOffset(seconds).toMinutes());
+  seconds = LocalDateTime::forComponents(9999, 7, 1, 0, 0, 0)
+      .toEpochSeconds();
+  assertEqual(2*60, processor.getUtcOffset(seconds).toMinutes());
+}
+
+test(EpochSeconds64Test, formatTo) {
+  char buf[32];
+  LocalDate::forComponents(1, 2, 3).formatTo(buf, sizeof(buf));
+  assertEqual("0001-02-03", buf);
+
+  LocalDateTime::forComponents(812, 1, 2, 3, 4, 5).formatTo(buf, sizeof(buf));
+  assertEqual("0812-01-02T03:04:05", buf);
+}
+
+test(EpochSeconds64Test, incrementOneDay) {
+  auto ld = LocalDate::forComponents(2127, 12, 31);
+  local_date_mutation::incrementOneDay(ld);
+  assertTrue(ld == LocalDate::forComponents(2128, 1, 1));
+
+  ld = LocalDate::forComponents(9999, 12, 31);
+  local_date_mutation::incrementOneDay(ld);
+  assertTrue(ld.isError());
+
+  ld = LocalDate::forComponents(1, 1, 1);
+  local_date_mutation::decrementOneDay(ld);
+  assertTrue(ld.isError());
+}
+
+#endif
+
+// --------------------------------------------------------------------------
+
+void setup() {
+#if defined(ARDUINO)
+  delay(1000); // wait for stability on some boards to prevent garbage SERIAL_PORT_MONITOR
+#endif
+  SERIAL_PORT_MONITOR.begin(115200); // ESP8266 default of 74880 not supported on Linux
+  while(!SERIAL_PORT_MONITOR); // for the Arduino Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
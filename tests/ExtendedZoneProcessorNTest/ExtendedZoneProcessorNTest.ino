@@ -0,0 +1,175 @@
+#line 2 "ExtendedZoneProcessorNTest.ino"
+
+#include <AUnit.h>
+#include <AceTime.h>
+
+using namespace aunit;
+using namespace ace_time;
+
+// --------------------------------------------------------------------------
+
+// Verify that the multi-year cache returns the same results as the
+// single-year ExtendedZoneProcessor, when alternating between 2 years.
+test(ExtendedZoneProcessorNTest, sameAsExtendedZoneProcessor) {
+  ExtendedZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles);
+  ExtendedZoneProcessorN<2> processorN(&zonedbx::kZoneAmerica_Los_Angeles);
+
+  acetime_t start = LocalDateTime::forComponents(2018, 1, 1, 0, 0, 0)
+      .toEpochSeconds();
+  for (acetime_t seconds = start; seconds < start + 2 * 366 * 86400L;
+      seconds += 5 * 86400L + 3601) {
+    assertEqual(processor.getUtcOffset(seconds).toMinutes(),
+        processorN.getUtcOffset(seconds).toMinutes());
+    assertEqual(processor.getDeltaOffset(seconds).toMinutes(),
+        processorN.getDeltaOffset(seconds).toMinutes());
+    assertEqual(processor.getAbbrev(seconds), processorN.getAbbrev(seconds));
+
+    LocalDateTime ldt = LocalDateTime::forEpochSeconds(seconds);
+    assertTrue(processor.getOffsetDateTime(ldt)
+        == processorN.getOffsetDateTime(ldt));
+  }
+}
+
+test(ExtendedZoneProcessorNTest, hitsAndMisses) {
+  ExtendedZoneProcessorN<2> processorN(&zonedbx::kZoneAmerica_Los_Angeles);
+  acetime_t seconds2018 = LocalDateTime::forComponents(
+      2018, 12, 31, 23, 0, 0).toEpochSeconds();
+  acetime_t seconds2019 = LocalDateTime::forComponents(
+      2019, 1, 1, 1, 0, 0).toEpochSeconds();
+
+  // First access of each year is a miss.
+  assertEqual(-8*60, processorN.getUtcOffset(seconds2018).toMinutes());
+  assertEqual(-8*60, processorN.getUtcOffset(seconds2019).toMinutes());
+  assertEqual((uint32_t) 0, processorN.getCacheHits());
+  assertEqual((uint32_t) 2, processorN.getCacheMisses());
+
+  // Alternating between the 2 years is always a hit.
+  for (uint8_t i = 0; i < 5; i++) {
+    processorN.getUtcOffset(seconds2018);
+    processorN.getUtcOffset(seconds2019);
+  }
+  assertEqual((uint32_t) 10, processorN.getCacheHits());
+  assertEqual((uint32_t) 2, processorN.getCacheMisses());
+
+  processorN.resetCacheStats();
+  assertEqual((uint32_t) 0, processorN.getCacheHits());
+  assertEqual((uint32_t) 0, processorN.getCacheMisses());
+}
+
+test(ExtendedZoneProcessorNTest, lruEviction) {
+  ExtendedZoneProcessorN<2> processorN(&zonedbx::kZoneAmerica_Los_Angeles);
+  auto ldt2017 = LocalDateTime::forComponents(2017, 6, 1, 0, 0, 0);
+  auto ldt2018 = LocalDateTime::forComponents(2018, 6, 1, 0, 0, 0);
+  auto ldt2019 = LocalDateTime::forComponents(2019, 6, 1, 0, 0, 0);
+
+  processorN.getOffsetDateTime(ldt2017); // miss
+  processorN.getOffsetDateTime(ldt2018); // miss
+  processorN.getOffsetDateTime(ldt2017); // hit, 2018 is now LRU
+  processorN.getOffsetDateTime(ldt2019); // miss, evicts 2018
+  assertEqual((uint32_t) 1, processorN.getCacheHits());
+  assertEqual((uint32_t) 3, processorN.getCacheMisses());
+
+  processorN.getOffsetDateTime(ldt2017); // hit
+  assertEqual((uint32_t) 2, processorN.getCacheHits());
+  processorN.getOffsetDateTime(ldt2018); // miss, evicts 2019
+  assertEqual((uint32_t) 4, processorN.getCacheMisses());
+  processorN.getOffsetDateTime(ldt2017); // hit
+  assertEqual((uint32_t) 3, processorN.getCacheHits());
+}
+
+test(ExtendedZoneProcessorNTest, getUtcOffsets) {
+  ExtendedZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles);
+  ExtendedZoneProcessorN<2> processorN(&zonedbx::kZoneAmerica_Los_Angeles);
+
+  // Runs in 2018, 2019, 2018, then an invalid value.
+  const size_t n = 8;
+  acetime_t epochSeconds[n];
+  acetime_t seconds2018 = LocalDateTime::forComponents(
+      2018, 3, 11, 1, 0, 0).toEpochSeconds();
+  acetime_t seconds2019 = LocalDateTime::forComponents(
+      2019, 11, 3, 1, 0, 0).toEpochSeconds();
+  epochSeconds[0] = seconds2018;
+  epochSeconds[1] = seconds2018 + 7200;
+  epochSeconds[2] = seconds2018 + 86400;
+  epochSeconds[3] = seconds2019;
+  epochSeconds[4] = seconds2019 + 7200;
+  epochSeconds[5] = seconds2018;
+  epochSeconds[6] = seconds2018 + 7200;
+  epochSeconds[7] = LocalDate::kInvalidEpochSeconds;
+
+  TimeOffset offsets[n];
+  processorN.getUtcOffsets(epochSeconds, offsets, n);
+  for (size_t i = 0; i < n; i++) {
+    TimeOffset expected = processor.getUtcOffset(epochSeconds[i]);
+    assertEqual(expected.isError(), offsets[i].isError());
+    if (! expected.isError()) {
+      assertEqual(expected.toMinutes(), offsets[i].toMinutes());
+    }
+  }
+
+  // One lookup per run of the same year.
+  assertEqual((uint32_t) 1, processorN.getCacheHits());
+  assertEqual((uint32_t) 3, processorN.getCacheMisses());
+}
+
+// The epoch seconds of 1931-01-01 and 2069-01-01 do not fit in a 32-bit
+// acetime_t, so the runs of 1931 and 2068 must not need them.
+test(ExtendedZoneProcessorNTest, getUtcOffsets_edgeYears) {
+  ExtendedZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles);
+  ExtendedZoneProcessorN<2> processorN(&zonedbx::kZoneAmerica_Los_Angeles);
+
+  const size_t n = 4;
+  acetime_t epochSeconds[n];
+  epochSeconds[0] = LocalDateTime::forComponents(1931, 12, 14, 0, 0, 0)
+      .toEpochSeconds();
+  epochSeconds[1] = LocalDateTime::forComponents(1931, 12, 31, 0, 0, 0)
+      .toEpochSeconds();
+  epochSeconds[2] = LocalDateTime::forComponents(2068, 1, 1, 0, 0, 0)
+      .toEpochSeconds();
+  epochSeconds[3] = LocalDateTime::forComponents(2068, 1, 19, 3, 14, 7)
+      .toEpochSeconds();
+
+  TimeOffset offsets[n];
+  processorN.getUtcOffsets(epochSeconds, offsets, n);
+  for (size_t i = 0; i < n; i++) {
+    TimeOffset expected = processor.getUtcOffset(epochSeconds[i]);
+    assertEqual(expected.isError(), offsets[i].isError());
+    if (! expected.isError()) {
+      assertEqual(expected.toMinutes(), offsets[i].toMinutes());
+    }
+  }
+  assertEqual((uint32_t) 2, processorN.getCacheMisses());
+  assertEqual((uint32_t) 0, processorN.getCacheHits());
+}
+
+test(ExtendedZoneProcessorNTest, timeZone) {
+  ExtendedZoneProcessorN<2> processorN;
+  TimeZone tz = TimeZone::forZoneInfo(
+      &zonedbx::kZoneAmerica_Los_Angeles, &processorN);
+
+  acetime_t seconds = LocalDateTime::forComponents(2019, 7, 1, 0, 0, 0)
+      .toEpochSeconds();
+  assertEqual(-7*60, tz.getUtcOffset(seconds).toMinutes());
+  assertEqual((uint32_t) 1, processorN.getCacheMisses());
+
+  // Switching the TimeZone to a different zone clears the cache.
+  TimeZone tzNewYork = TimeZone::forZoneInfo(
+      &zonedbx::kZoneAmerica_New_York, &processorN);
+  assertEqual(-4*60, tzNewYork.getUtcOffset(seconds).toMinutes());
+  assertEqual((uint32_t) 0, processorN.getCacheHits());
+  assertEqual((uint32_t) 2, processorN.getCacheMisses());
+}
+
+// --------------------------------------------------------------------------
+
+void setup() {
+#if defined(ARDUINO)
+  delay(1000); // wait for stability on some boards to prevent garbage SERIAL_PORT_MONITOR
+#endif
+  SERIAL_PORT_MONITOR.begin(115200); // ESP8266 default of 74880 not supported on Linux
+  while(!SERIAL_PORT_MONITOR); // for the Arduino Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
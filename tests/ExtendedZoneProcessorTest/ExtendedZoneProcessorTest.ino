@@ -749,6 +749,80 @@ test(ExtendedZoneProcessorTest, setZoneInfo) {
   assertTrue(zoneInfo.mIsFilled);
 }
 
+// Return true if the Active pools [eBegin, eEnd) and [aBegin, aEnd) hold
+// identical Transitions.
+static bool isSameTransitions(Transition** eBegin, Transition** eEnd,
+    Transition** aBegin, Transition** aEnd) {
+  if (eEnd - eBegin != aEnd - aBegin) return false;
+  for (; eBegin != eEnd; ++eBegin, ++aBegin) {
+    const Transition* e = *eBegin;
+    const Transition* a = *aBegin;
+    if (! (e->transitionTime == a->transitionTime)) return false;
+    if (! (e->startDateTime == a->startDateTime)) return false;
+    if (! (e->untilDateTime == a->untilDateTime)) return false;
+    if (e->startEpochSeconds != a->startEpochSeconds) return false;
+    if (e->offsetCode != a->offsetCode) return false;
+    if (e->deltaCode != a->deltaCode) return false;
+    if (strcmp(e->abbrev, a->abbrev) != 0) return false;
+  }
+  return true;
+}
+
+test(ExtendedZoneProcessorTest, rollForward) {
+  ExtendedZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles);
+  assertTrue(processor.init(LocalDate::forComponents(2018, 1, 1)));
+  assertTrue(processor.rollForward(2019));
+
+  ExtendedZoneProcessor expected(&zonedbx::kZoneAmerica_Los_Angeles);
+  assertTrue(expected.init(LocalDate::forComponents(2019, 1, 1)));
+  assertTrue(isSameTransitions(
+      expected.mTransitionStorage.getActivePoolBegin(),
+      expected.mTransitionStorage.getActivePoolEnd(),
+      processor.mTransitionStorage.getActivePoolBegin(),
+      processor.mTransitionStorage.getActivePoolEnd()));
+
+  // Prior (Nov 2018), Mar 2019, Nov 2019.
+  assertEqual((int) 3, (int) (processor.mTransitionStorage.getActivePoolEnd()
+      - processor.mTransitionStorage.getActivePoolBegin()));
+}
+
+// Verify that rolling forward one year at a time produces the same
+// Transitions as building each year from scratch, for every zone.
+test(ExtendedZoneProcessorTest, rollForward_allZones) {
+  ExtendedZoneRegistrar registrar(
+      zonedbx::kZoneRegistrySize, zonedbx::kZoneRegistry);
+  uint16_t numRolled = 0;
+  uint16_t numYears = 0;
+
+  for (uint16_t i = 0; i < registrar.registrySize(); i++) {
+    const extended::ZoneInfo* zoneInfo = registrar.getZoneInfoForIndex(i);
+    ExtendedZoneProcessor processor(zoneInfo);
+    assertTrue(processor.init(LocalDate::forComponents(2000, 1, 1)));
+
+    for (int16_t year = 2001; year < 2050; year++) {
+      ExtendedZoneProcessor expected(zoneInfo);
+      assertTrue(expected.init(LocalDate::forComponents(year, 1, 1)));
+      if (processor.rollForward(year)) {
+        processor.mYear = year;
+        numRolled++;
+      } else {
+        processor.mIsFilled = false;
+      }
+      assertTrue(processor.init(LocalDate::forComponents(year, 1, 1)));
+      assertTrue(isSameTransitions(
+          expected.mTransitionStorage.getActivePoolBegin(),
+          expected.mTransitionStorage.getActivePoolEnd(),
+          processor.mTransitionStorage.getActivePoolBegin(),
+          processor.mTransitionStorage.getActivePoolEnd()));
+      numYears++;
+    }
+  }
+
+  // Zones with a simple ZoneEra (no ZonePolicy) are always rebuilt, but most
+  // of the others should have been rolled forward.
+  assertMore(numRolled, (uint16_t) (numYears / 3));
+}
+
 // --------------------------------------------------------------------------
 
 void setup() {
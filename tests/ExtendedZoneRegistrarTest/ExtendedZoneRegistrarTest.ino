@@ -66,6 +66,22 @@ test(ExtendedZoneRegistrarTest, getZoneInfoForId_not_found) {
   assertTrue(zoneInfo == nullptr);
 }
 
+test(ExtendedZoneRegistrarTest, getZoneInfoForId_sortedById) {
+  ExtendedZoneRegistrar zoneRegistrar(
+      zonedbx::kZoneRegistrySize, zonedbx::kZoneRegistry,
+      zonedbx::kZoneRegistryById);
+  assertTrue(zoneRegistrar.isSortedById());
+
+  // Every zone must be found through the kZoneRegistryById.
+  for (uint16_t i = 0; i < zonedbx::kZoneRegistrySize; i++) {
+    const extended::ZoneInfo* zoneInfo = zoneRegistrar.getZoneInfoForIndex(i);
+    uint32_t zoneId = ExtendedZone(zoneInfo).zoneId();
+    assertTrue(zoneInfo == zoneRegistrar.getZoneInfoForId(zoneId));
+  }
+
+  assertTrue(zoneRegistrar.getZoneInfoForId(0x11111111) == nullptr);
+}
+
 // --------------------------------------------------------------------------
 
 void setup() {
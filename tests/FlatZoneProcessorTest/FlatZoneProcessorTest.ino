@@ -0,0 +1,138 @@
+#line 2 "FlatZoneProcessorTest.ino"
+
+#include <AUnit.h>
+#include <AceTime.h>
+
+using namespace aunit;
+using namespace ace_time;
+
+// --------------------------------------------------------------------------
+
+test(FlatZoneProcessorTest, getUtcOffset) {
+  FlatZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles);
+
+  // 2 transitions per year from 2000 until 2049, merged into 1 entry at the
+  // start of 2000.
+  assertEqual(101, processor.getNumEntries());
+
+  acetime_t seconds = LocalDateTime::forComponents(2019, 3, 10, 1, 59, 59)
+      .toEpochSeconds() + 8 * 3600;
+  assertEqual(-8*60, processor.getUtcOffset(seconds).toMinutes());
+  assertEqual(0, processor.getDeltaOffset(seconds).toMinutes());
+  assertEqual("PST", processor.getAbbrev(seconds));
+
+  seconds++;
+  assertEqual(-7*60, processor.getUtcOffset(seconds).toMinutes());
+  assertEqual(60, processor.getDeltaOffset(seconds).toMinutes());
+  assertEqual("PDT", processor.getAbbrev(seconds));
+}
+
+test(FlatZoneProcessorTest, getOffsetDateTime) {
+  FlatZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles);
+
+  // In the gap, the LocalDateTime is shifted forward by one hour.
+  auto ldt = LocalDateTime::forComponents(2019, 3, 10, 2, 30, 0);
+  OffsetDateTime odt = processor.getOffsetDateTime(ldt);
+  assertTrue(odt == OffsetDateTime::forComponents(
+      2019, 3, 10, 3, 30, 0, TimeOffset::forHour(-7)));
+
+  // Normal time.
+  ldt = LocalDateTime::forComponents(2019, 7, 1, 12, 0, 0);
+  odt = processor.getOffsetDateTime(ldt);
+  assertTrue(odt == OffsetDateTime::forComponents(
+      2019, 7, 1, 12, 0, 0, TimeOffset::forHour(-7)));
+}
+
+test(FlatZoneProcessorTest, outsideOfTable) {
+  FlatZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles);
+  ExtendedZoneProcessor extendedProcessor(&zonedbx::kZoneAmerica_Los_Angeles);
+
+  // Year 1999 is before the table, so the ExtendedZoneProcessor is used.
+  acetime_t seconds = LocalDateTime::forComponents(1999, 7, 1, 0, 0, 0)
+      .toEpochSeconds();
+  assertEqual(extendedProcessor.getUtcOffset(seconds).toMinutes(),
+      processor.getUtcOffset(seconds).toMinutes());
+  assertEqual(-7*60, processor.getUtcOffset(seconds).toMinutes());
+}
+
+test(FlatZoneProcessorTest, getUtcOffsets) {
+  FlatZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles);
+
+  // Sorted from 1999 (outside of the table) into 2001, then backwards.
+  const size_t n = 48;
+  acetime_t epochSeconds[n];
+  acetime_t start = LocalDateTime::forComponents(1999, 7, 1, 0, 0, 0)
+      .toEpochSeconds();
+  for (size_t i = 0; i < n - 1; i++) {
+    epochSeconds[i] = start + i * (acetime_t) (17 * 86400L + 3599);
+  }
+  epochSeconds[n - 1] = start + 200 * (acetime_t) 86400;
+
+  TimeOffset offsets[n];
+  processor.getUtcOffsets(epochSeconds, offsets, n);
+  for (size_t i = 0; i < n; i++) {
+    assertEqual(processor.getUtcOffset(epochSeconds[i]).toMinutes(),
+        offsets[i].toMinutes());
+  }
+}
+
+// Verify that the table agrees with ExtendedZoneProcessor for every zone in
+// zonedbx, and that every table fits into kMaxEntries.
+test(FlatZoneProcessorTest, allZones) {
+  ExtendedZoneRegistrar registrar(
+      zonedbx::kZoneRegistrySize, zonedbx::kZoneRegistry);
+  FlatZoneProcessor processor;
+
+  for (uint16_t i = 0; i < registrar.registrySize(); i++) {
+    const extended::ZoneInfo* zoneInfo = registrar.getZoneInfoForIndex(i);
+    processor.setZoneInfo(zoneInfo);
+    ExtendedZoneProcessor extendedProcessor(zoneInfo);
+
+    processor.buildTable();
+    assertEqual(LocalDate::forComponents(2000, 1, 1).toEpochSeconds(),
+        processor.mCompiledZone.getStartSeconds());
+    assertEqual(LocalDate::forComponents(2050, 1, 1).toEpochSeconds(),
+        processor.mCompiledZone.getUntilSeconds());
+
+    for (acetime_t seconds = processor.mCompiledZone.getStartSeconds();
+        seconds < processor.mCompiledZone.getUntilSeconds();
+        seconds += 13 * 86400L + 3599) {
+      assertEqual(extendedProcessor.getUtcOffset(seconds).toMinutes(),
+          processor.getUtcOffset(seconds).toMinutes());
+      assertEqual(extendedProcessor.getDeltaOffset(seconds).toMinutes(),
+          processor.getDeltaOffset(seconds).toMinutes());
+      assertEqual(extendedProcessor.getAbbrev(seconds),
+          processor.getAbbrev(seconds));
+
+      LocalDateTime ldt = LocalDateTime::forEpochSeconds(seconds);
+      assertTrue(extendedProcessor.getOffsetDateTime(ldt)
+          == processor.getOffsetDateTime(ldt));
+    }
+  }
+}
+
+test(FlatZoneProcessorTest, flatZoneManager) {
+  FlatZoneManager<2> manager(
+      zonedbx::kZoneRegistrySize, zonedbx::kZoneRegistry);
+  TimeZone tz = manager.createForZoneName("America/New_York");
+  assertEqual(TimeZone::kTypeExtendedManaged, tz.getType());
+
+  acetime_t seconds = LocalDateTime::forComponents(2019, 7, 1, 0, 0, 0)
+      .toEpochSeconds();
+  assertEqual(-4*60, tz.getUtcOffset(seconds).toMinutes());
+  assertEqual(60, tz.getDeltaOffset(seconds).toMinutes());
+}
+
+// --------------------------------------------------------------------------
+
+void setup() {
+#if defined(ARDUINO)
+  delay(1000); // wait for stability on some boards to prevent garbage SERIAL_PORT_MONITOR
+#endif
+  SERIAL_PORT_MONITOR.begin(115200); // ESP8266 default of 74880 not supported on Linux
+  while(!SERIAL_PORT_MONITOR); // for the Arduino Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
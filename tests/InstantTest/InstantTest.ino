@@ -0,0 +1,190 @@
+#line 2 "InstantTest.ino"
+
+#include <AUnit.h>
+#include <aunit/fake/FakePrint.h>
+#include <AceTime.h>
+
+using namespace aunit;
+using namespace aunit::fake;
+using namespace ace_time;
+
+// --------------------------------------------------------------------------
+
+test(InstantTest, forEpochSeconds) {
+  Instant instant = Instant::forEpochSeconds(100, 123456789);
+  assertFalse(instant.isError());
+  assertTrue((acetime_t) 100 == instant.epochSeconds());
+  assertEqual((uint32_t) 123456789, instant.nanos());
+  assertEqual((uint32_t) 123456, instant.micros());
+  assertEqual((uint16_t) 123, instant.millis());
+
+  instant = Instant::forEpochMillis(-1, 250);
+  assertTrue((acetime_t) -1 == instant.epochSeconds());
+  assertEqual((uint32_t) 250000000, instant.nanos());
+
+  instant = Instant::forUnixSeconds(LocalDate::kSecondsSinceUnixEpoch, 1);
+  assertTrue((acetime_t) 0 == instant.epochSeconds());
+  assertTrue(LocalDate::kSecondsSinceUnixEpoch == instant.unixSeconds());
+}
+
+test(InstantTest, isError) {
+  assertTrue(Instant::forError().isError());
+  assertTrue(Instant::forEpochSeconds(
+      LocalDate::kInvalidEpochSeconds).isError());
+  assertTrue(Instant::forEpochSeconds(0, Instant::kNanosPerSecond).isError());
+  assertTrue(Instant::forEpochMillis(0, 1000).isError());
+  assertTrue(Instant::forUnixSeconds(
+      LocalDate::kInvalidEpochSeconds).isError());
+  assertTrue(LocalDate::kInvalidEpochSeconds
+      == Instant::forError().unixSeconds());
+}
+
+test(InstantTest, compareTo) {
+  Instant a = Instant::forEpochSeconds(-1, 999999999);
+  Instant b = Instant::forEpochSeconds(0, 0);
+  Instant c = Instant::forEpochSeconds(0, 1);
+
+  assertLess(a.compareTo(b), 0);
+  assertLess(b.compareTo(c), 0);
+  assertMore(c.compareTo(a), 0);
+  assertEqual(0, b.compareTo(Instant::forEpochSeconds(0)));
+
+  assertTrue(b == Instant::forEpochSeconds(0));
+  assertTrue(b != c);
+}
+
+test(InstantTest, forIso8601) {
+  const char s1[] = "2018-08-31T13:48:01.25-07:00";
+  Instant instant = Instant::forIso8601(s1, sizeof(s1) - 1);
+  acetime_t epochSeconds = LocalDateTime::forComponents(
+      2018, 8, 31, 20, 48, 1).toEpochSeconds();
+  assertTrue(instant == Instant::forEpochMillis(epochSeconds, 250));
+
+  const char s2[] = "20180831T204801,123456789123Z";
+  instant = Instant::forIso8601(s2, sizeof(s2) - 1);
+  assertTrue(instant == Instant::forEpochSeconds(epochSeconds, 123456789));
+
+  // Offsets which are not a multiple of 15 minutes are allowed.
+  const char s3[] = "2018-08-31T21:29:01+00:41";
+  instant = Instant::forIso8601(s3, sizeof(s3) - 1);
+  assertTrue(instant == Instant::forEpochSeconds(epochSeconds));
+
+  // Fraction before the epoch is added to the earlier second.
+  const char s4[] = "1999-12-31T23:59:59.5Z";
+  instant = Instant::forIso8601(s4, sizeof(s4) - 1);
+  assertTrue(instant == Instant::forEpochMillis(-1, 500));
+}
+
+test(InstantTest, forIso8601_errors) {
+  const char noOffset[] = "2018-08-31T13:48:01.25";
+  assertTrue(Instant::forIso8601(noOffset, sizeof(noOffset) - 1).isError());
+
+  const char trailing[] = "2018-08-31T13:48:01.25Z ";
+  assertTrue(Instant::forIso8601(trailing, sizeof(trailing) - 1).isError());
+
+  const char badFraction[] = "2018-08-31T13:48:01.Z";
+  assertTrue(Instant::forIso8601(
+      badFraction, sizeof(badFraction) - 1).isError());
+
+  const char badYear[] = "0000-01-01T00:00:00Z";
+  assertTrue(Instant::forIso8601(badYear, sizeof(badYear) - 1).isError());
+}
+
+// Valid dates whose epoch seconds do not fit in a 32-bit acetime_t.
+test(InstantTest, forIso8601_range) {
+  char buf[Instant::kMaxStringLength + 1];
+  const char before1931[] = "1900-01-01T00:00:00Z";
+  const char after2068[] = "2100-01-01T00:00:00Z";
+  const char maxSeconds[] = "2068-01-19T03:14:07Z";
+  const char maxSecondsOffset[] = "2068-01-19T03:14:07-00:01";
+
+  Instant instant = Instant::forIso8601(maxSeconds, sizeof(maxSeconds) - 1);
+  instant.formatTo(buf, sizeof(buf));
+  assertEqual(maxSeconds, buf);
+
+#if ACE_TIME_EPOCH_SECONDS_64
+  instant = Instant::forIso8601(before1931, sizeof(before1931) - 1);
+  instant.formatTo(buf, sizeof(buf));
+  assertEqual(before1931, buf);
+
+  instant = Instant::forIso8601(after2068, sizeof(after2068) - 1);
+  instant.formatTo(buf, sizeof(buf));
+  assertEqual(after2068, buf);
+
+  instant = Instant::forIso8601(maxSecondsOffset, sizeof(maxSecondsOffset) - 1);
+  instant.formatTo(buf, sizeof(buf));
+  assertEqual("2068-01-19T03:15:07Z", buf);
+#else
+  assertTrue(Instant::forIso8601(
+      before1931, sizeof(before1931) - 1).isError());
+  assertTrue(Instant::forIso8601(
+      after2068, sizeof(after2068) - 1).isError());
+  assertTrue(Instant::forIso8601(
+      maxSecondsOffset, sizeof(maxSecondsOffset) - 1).isError());
+#endif
+}
+
+test(InstantTest, formatTo) {
+  char buf[Instant::kMaxStringLength + 1];
+  acetime_t epochSeconds = LocalDateTime::forComponents(
+      2018, 8, 31, 20, 48, 1).toEpochSeconds();
+
+  Instant::forEpochSeconds(epochSeconds).formatTo(buf, sizeof(buf));
+  assertEqual("2018-08-31T20:48:01Z", buf);
+
+  Instant::forEpochMillis(epochSeconds, 250).formatTo(buf, sizeof(buf));
+  assertEqual("2018-08-31T20:48:01.250Z", buf);
+
+  Instant::forEpochSeconds(epochSeconds, 1000).formatTo(buf, sizeof(buf));
+  assertEqual("2018-08-31T20:48:01.000001Z", buf);
+
+  assertEqual((size_t) Instant::kMaxStringLength,
+      Instant::forEpochSeconds(epochSeconds, 123456789)
+          .formatTo(buf, sizeof(buf)));
+  assertEqual("2018-08-31T20:48:01.123456789Z", buf);
+
+  Instant::forError().formatTo(buf, sizeof(buf));
+  assertEqual("<Invalid Instant>", buf);
+
+  assertEqual((size_t) 0,
+      Instant::forEpochSeconds(epochSeconds, 123456789).formatTo(buf, 30));
+}
+
+test(InstantTest, printTo) {
+  FakePrint fakePrint;
+  Instant::forEpochMillis(-1, 500).printTo(fakePrint);
+  assertEqual("1999-12-31T23:59:59.500Z", fakePrint.getBuffer());
+}
+
+test(InstantTest, zonedDateTime) {
+  ExtendedZoneProcessor zoneProcessor;
+  TimeZone tz = TimeZone::forZoneInfo(
+      &zonedbx::kZoneAmerica_Los_Angeles, &zoneProcessor);
+  ZonedDateTime dt = ZonedDateTime::forComponents(2018, 8, 31, 13, 48, 1, tz);
+
+  Instant instant = dt.toInstant(250000000);
+  assertTrue(dt.toEpochSeconds() == instant.epochSeconds());
+  assertEqual((uint16_t) 250, instant.millis());
+
+  // The fraction does not change the UTC offset.
+  assertTrue(dt == ZonedDateTime::forInstant(instant, tz));
+  assertTrue(ZonedDateTime::forEpochSeconds(instant.epochSeconds(), tz)
+      == ZonedDateTime::forInstant(instant, tz));
+
+  assertTrue(ZonedDateTime::forInstant(Instant::forError(), tz).isError());
+  assertTrue(ZonedDateTime::forError().toInstant().isError());
+}
+
+// --------------------------------------------------------------------------
+
+void setup() {
+#if defined(ARDUINO)
+  delay(1000); // wait for stability on some boards to prevent garbage SERIAL_PORT_MONITOR
+#endif
+  SERIAL_PORT_MONITOR.begin(115200); // ESP8266 default of 74880 not supported on Linux
+  while(!SERIAL_PORT_MONITOR); // for the Arduino Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
@@ -0,0 +1,148 @@
+#line 2 "Iso8601Test.ino"
+
+#include <string.h>
+#include <AUnit.h>
+#include <AceTime.h>
+#include <ace_time/internal/Iso8601.h>
+
+using namespace aunit;
+using namespace ace_time;
+using namespace ace_time::iso8601;
+
+/** Parse the NUL-terminated string, returning the number of chars consumed. */
+static size_t parse(const char* s, DateTimeFields& fields) {
+  return parseDateTime(s, strlen(s), fields);
+}
+
+// --------------------------------------------------------------------------
+
+test(Iso8601Test, extended) {
+  DateTimeFields fields;
+  assertEqual((size_t) 25, parse("2018-08-31T13:48:01-07:00", fields));
+  assertEqual(2018, fields.year);
+  assertEqual(8, fields.month);
+  assertEqual(31, fields.day);
+  assertEqual(13, fields.hour);
+  assertEqual(48, fields.minute);
+  assertEqual(1, fields.second);
+  assertEqual((uint32_t) 0, fields.nanos);
+  assertTrue(fields.hasOffset);
+  assertEqual(-7*60, fields.offsetMinutes);
+
+  // Lower case and space separators skip the SIMD path.
+  assertEqual((size_t) 20, parse("2018-08-31t13:48:01z", fields));
+  assertEqual(1, fields.second);
+  assertTrue(fields.hasOffset);
+  assertEqual(0, fields.offsetMinutes);
+  assertEqual((size_t) 19, parse("2018-08-31 13:48:01", fields));
+  assertFalse(fields.hasOffset);
+
+  // Without seconds.
+  assertEqual((size_t) 22, parse("2018-08-31T13:48+05:30", fields));
+  assertEqual(0, fields.second);
+  assertEqual(5*60+30, fields.offsetMinutes);
+  assertEqual((size_t) 16, parse("2018-08-31T13:48", fields));
+}
+
+test(Iso8601Test, basic) {
+  DateTimeFields fields;
+  assertEqual((size_t) 20, parse("20180831T134801+0530", fields));
+  assertEqual(2018, fields.year);
+  assertEqual(8, fields.month);
+  assertEqual(31, fields.day);
+  assertEqual(13, fields.hour);
+  assertEqual(48, fields.minute);
+  assertEqual(1, fields.second);
+  assertEqual(5*60+30, fields.offsetMinutes);
+
+  assertEqual((size_t) 16, parse("20180831T1348-08", fields));
+  assertEqual(0, fields.second);
+  assertEqual(-8*60, fields.offsetMinutes);
+}
+
+test(Iso8601Test, fraction) {
+  DateTimeFields fields;
+  assertEqual((size_t) 23, parse("2018-08-31T13:48:01.25Z", fields));
+  assertEqual((uint32_t) 250000000, fields.nanos);
+  parse("2018-08-31T13:48:01,123456789", fields);
+  assertEqual((uint32_t) 123456789, fields.nanos);
+
+  // Digits beyond nanoseconds are ignored.
+  assertEqual((size_t) 32, parse("2018-08-31T13:48:01.123456789999", fields));
+  assertEqual((uint32_t) 123456789, fields.nanos);
+
+  // A fraction needs seconds and at least one digit.
+  assertEqual((size_t) 0, parse("2018-08-31T13:48:01.Z", fields));
+  assertEqual((size_t) 16, parse("2018-08-31T13:48.5", fields));
+}
+
+test(Iso8601Test, explicitLength) {
+  DateTimeFields fields;
+  const char buffer[] = "2018-08-31T13:48:01-07:00";
+
+  // The buffer is cut in the middle of the offset.
+  assertEqual((size_t) 0, parseDateTime(buffer, 21, fields));
+
+  // Or just after the seconds.
+  assertEqual((size_t) 19, parseDateTime(buffer, 19, fields));
+  assertFalse(fields.hasOffset);
+
+  // Or in the middle of the SIMD prefix.
+  assertEqual((size_t) 0, parseDateTime(buffer, 15, fields));
+  assertEqual((size_t) 0, parseDateTime(buffer, 0, fields));
+}
+
+test(Iso8601Test, errors) {
+  DateTimeFields fields;
+  assertEqual((size_t) 0, parse("", fields));
+  assertEqual((size_t) 0, parse("2018-08-31", fields));
+  assertEqual((size_t) 0, parse("2018-08-31X13:48:01Z", fields));
+  assertEqual((size_t) 0, parse("2018-0a-31T13:48:01Z", fields));
+  assertEqual((size_t) 0, parse("2018/08/31T13:48:01Z", fields));
+  assertEqual((size_t) 0, parse("2018-08-31T13:4:01Z", fields));
+  assertEqual((size_t) 0, parse("2018-08-31T13:48:0", fields));
+  assertEqual((size_t) 0, parse("2018-08-31T1348", fields));
+  assertEqual((size_t) 0, parse("20180831T13:48", fields));
+  assertEqual((size_t) 0, parse("2018-08-31T13:48:01+7", fields));
+
+  // Range checks.
+  assertEqual((size_t) 0, parse("2018-13-01T00:00", fields));
+  assertEqual((size_t) 0, parse("2018-00-01T00:00", fields));
+  assertEqual((size_t) 0, parse("2018-02-29T00:00", fields));
+  assertEqual((size_t) 16, parse("2020-02-29T00:00", fields));
+  assertEqual((size_t) 0, parse("2018-08-31T24:00", fields));
+  assertEqual((size_t) 0, parse("2018-08-31T23:60", fields));
+  assertEqual((size_t) 0, parse("2018-08-31T23:59:60", fields));
+  assertEqual((size_t) 0, parse("2018-08-31T23:59+24:00", fields));
+}
+
+// Compare every hour of a few years with the output of printTo().
+test(Iso8601Test, roundTrip) {
+  char buffer[32];
+  DateTimeFields fields;
+  acetime_t start = LocalDate::forComponents(2019, 1, 1).toEpochSeconds();
+  acetime_t until = LocalDate::forComponents(2021, 1, 1).toEpochSeconds();
+  for (acetime_t seconds = start; seconds < until; seconds += 3599) {
+    auto ldt = LocalDateTime::forEpochSeconds(seconds);
+    snprintf(buffer, sizeof(buffer), "%04d-%02d-%02dT%02d:%02d:%02dZ",
+        ldt.year(), ldt.month(), ldt.day(), ldt.hour(), ldt.minute(),
+        ldt.second());
+    assertEqual((size_t) 20, parse(buffer, fields));
+    assertTrue(ldt == LocalDateTime::forComponents(fields.year, fields.month,
+        fields.day, fields.hour, fields.minute, fields.second));
+  }
+}
+
+// --------------------------------------------------------------------------
+
+void setup() {
+#if defined(ARDUINO)
+  delay(1000); // wait for stability on some boards to prevent garbage SERIAL_PORT_MONITOR
+#endif
+  SERIAL_PORT_MONITOR.begin(115200); // ESP8266 default of 74880 not supported on Linux
+  while(!SERIAL_PORT_MONITOR); // for the Arduino Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
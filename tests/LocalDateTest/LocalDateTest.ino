@@ -13,9 +13,13 @@ using namespace ace_time::common;
 
 test(LocalDateTest, isError_year_out_of_range) {
   assertTrue(LocalDate::forComponents(0, 1, 1).isError());
+#if ACE_TIME_EPOCH_SECONDS_64
+  assertTrue(LocalDate::forComponents(10000, 1, 1).isError());
+#else
   assertTrue(LocalDate::forComponents(1872, 1, 1).isError());
   assertTrue(LocalDate::forComponents(2128, 1, 1).isError());
   assertTrue(LocalDate::forComponents(9999, 1, 1).isError());
+#endif
 }
 
 test(LocalDateTest, isError_month_out_of_range) {
@@ -31,6 +35,10 @@ test(LocalDateTest, isError_day_out_of_range) {
 test(LocalDateTest, isError_valid_at_boundaries) {
   assertFalse(LocalDate::forComponents(1873, 1, 1).isError());
   assertFalse(LocalDate::forComponents(2127, 12, 31).isError());
+#if ACE_TIME_EPOCH_SECONDS_64
+  assertFalse(LocalDate::forComponents(1, 1, 1).isError());
+  assertFalse(LocalDate::forComponents(9999, 12, 31).isError());
+#endif
 }
 
 test(LocalDateTest, accessors) {
@@ -200,6 +208,57 @@ test(LocalDateTest, toAndFromEpochDays) {
   assertTrue(ld == LocalDate::forEpochDays(46750));
 }
 
+// Verify every day in the range of LocalDate against a simple day counter,
+// independent of whether ACE_TIME_LOCAL_DATE_DIVISION_FREE is enabled.
+test(LocalDateTest, toAndFromEpochDays_allDays) {
+  LocalDate ld = LocalDate::forComponents(1873, 1, 1);
+  const LocalDate last = LocalDate::forComponents(2127, 12, 31);
+  acetime_t epochDays = -46385;
+  while (true) {
+    assertEqual(epochDays, ld.toEpochDays());
+    assertTrue(ld == LocalDate::forEpochDays(epochDays));
+    if (ld == last) break;
+
+    local_date_mutation::incrementOneDay(ld);
+    epochDays++;
+  }
+  assertEqual((acetime_t) 46750, epochDays);
+}
+
+test(LocalDateTest, extractYearMonthDays) {
+  const acetime_t epochDays[] = {
+    LocalDate::forComponents(1873, 1, 1).toEpochDays(),
+    LocalDate::forComponents(1900, 2, 28).toEpochDays(),
+    LocalDate::forComponents(1900, 3, 1).toEpochDays(),
+    LocalDate::forComponents(1999, 12, 31).toEpochDays(),
+    LocalDate::kInvalidEpochDays,
+    LocalDate::forComponents(2000, 1, 1).toEpochDays(),
+    LocalDate::forComponents(2000, 2, 29).toEpochDays(),
+    LocalDate::forComponents(2000, 3, 1).toEpochDays(),
+    LocalDate::forComponents(2100, 2, 28).toEpochDays(),
+    LocalDate::forComponents(2100, 3, 1).toEpochDays(),
+    LocalDate::forComponents(2127, 12, 31).toEpochDays(),
+  };
+  const size_t n = sizeof(epochDays) / sizeof(epochDays[0]);
+  int16_t years[n];
+  uint8_t months[n];
+  uint8_t days[n];
+
+  LocalDate::extractYearMonthDays(epochDays, years, months, days, n);
+  for (size_t i = 0; i < n; i++) {
+    if (epochDays[i] == LocalDate::kInvalidEpochDays) {
+      assertEqual(0, years[i]);
+      assertEqual(0, months[i]);
+      assertEqual(0, days[i]);
+    } else {
+      LocalDate ld = LocalDate::forEpochDays(epochDays[i]);
+      assertEqual(ld.year(), years[i]);
+      assertEqual(ld.month(), months[i]);
+      assertEqual(ld.day(), days[i]);
+    }
+  }
+}
+
 // Same as toAndFromEpochDays, shifted 30 years
 test(LocalDateTest, toAndFromUnixDays) {
   LocalDate ld;
@@ -402,7 +461,11 @@ test(LocalDateTest, incrementOneDay) {
 }
 
 test(LocalDateTest, incrementOneDay_error) {
+#if ACE_TIME_EPOCH_SECONDS_64
+  auto ld = LocalDate::forComponents(9999, 12, 31);
+#else
   auto ld = LocalDate::forComponents(2127, 12, 31);
+#endif
   local_date_mutation::incrementOneDay(ld);
   assertTrue(ld.isError());
 }
@@ -436,7 +499,11 @@ test(LocalDateTest, decrementOneDay) {
 }
 
 test(LocalDateTest, decrementOneDay_error) {
+#if ACE_TIME_EPOCH_SECONDS_64
+  auto ld = LocalDate::forComponents(1, 1, 1);
+#else
   auto ld = LocalDate::forComponents(1873, 1, 1);
+#endif
   local_date_mutation::decrementOneDay(ld);
   assertTrue(ld.isError());
 }
@@ -0,0 +1,287 @@
+#line 2 "MappedZoneDbTest.ino"
+
+/*
+ * Must be compiled with ACE_TIME_USE_MAPPED_ZONEDB=1 (see the Makefile), so
+ * that the extended:: brokers read the binary format. The database is created
+ * from the compiled zonedbx:: files by MappedZoneWriter.
+ */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <AUnit.h>
+#include <aunit/fake/FakePrint.h>
+#include <AceTime.h>
+#include "MappedZoneWriter.h"
+
+#if ! ACE_TIME_USE_MAPPED_ZONEDB
+  #error MappedZoneDbTest requires ACE_TIME_USE_MAPPED_ZONEDB=1
+#endif
+
+using namespace aunit;
+using namespace aunit::fake;
+using namespace ace_time;
+
+static const size_t kBufferSize = 256 * 1024;
+static uint8_t buffer[kBufferSize];
+static size_t bufferSize;
+
+static MappedZoneDb zoneDb;
+
+/** Return true if the broker reads the same fields as the struct. */
+static bool isSameZonePolicy(const extended::ZonePolicy* policy,
+    const extended::ZonePolicyBroker& broker) {
+  if (policy == nullptr) return broker.isNull();
+  if (broker.isNull()) return false;
+  if (broker.numRules() != policy->numRules) return false;
+  if (broker.numLetters() != policy->numLetters) return false;
+  for (uint8_t i = 0; i < policy->numRules; i++) {
+    const extended::ZoneRule& rule = policy->rules[i];
+    const extended::ZoneRuleBroker r = broker.rule(i);
+    if (r.fromYearTiny() != rule.fromYearTiny) return false;
+    if (r.toYearTiny() != rule.toYearTiny) return false;
+    if (r.inMonth() != (int8_t) rule.inMonth) return false;
+    if (r.onDayOfWeek() != (int8_t) rule.onDayOfWeek) return false;
+    if (r.onDayOfMonth() != rule.onDayOfMonth) return false;
+    if (r.atTimeCode() != rule.atTimeCode) return false;
+    if (r.atTimeModifier() != rule.atTimeModifier) return false;
+    if (r.deltaCode() != rule.deltaCode) return false;
+    if (r.letter() != rule.letter) return false;
+  }
+  for (uint8_t i = 0; i < policy->numLetters; i++) {
+    if (strcmp(broker.letter(i), policy->letters[i]) != 0) return false;
+  }
+  return true;
+}
+
+/** Return true if the broker reads the same fields as the struct. */
+static bool isSameZoneInfo(const extended::ZoneInfo* info,
+    const extended::ZoneInfoBroker& broker) {
+  if (strcmp(broker.name(), info->name) != 0) return false;
+  if (broker.zoneId() != info->zoneId) return false;
+  if (broker.startYear() != info->zoneContext->startYear) return false;
+  if (broker.untilYear() != info->zoneContext->untilYear) return false;
+  if (broker.numEras() != info->numEras) return false;
+  for (uint8_t i = 0; i < info->numEras; i++) {
+    const extended::ZoneEra& era = info->eras[i];
+    const extended::ZoneEraBroker e = broker.era(i);
+    if (e.offsetCode() != era.offsetCode) return false;
+    if (e.deltaCode() != era.deltaCode) return false;
+    if (strcmp(e.format(), era.format) != 0) return false;
+    if (e.untilYearTiny() != era.untilYearTiny) return false;
+    if (e.untilMonth() != era.untilMonth) return false;
+    if (e.untilDay() != era.untilDay) return false;
+    if (e.untilTimeCode() != era.untilTimeCode) return false;
+    if (e.untilTimeModifier() != era.untilTimeModifier) return false;
+    if (! isSameZonePolicy(era.zonePolicy, e.zonePolicy())) return false;
+  }
+  return true;
+}
+
+/**
+ * Return true if an ExtendedZoneProcessor reading the mapped ZoneInfo agrees
+ * with the precomputed table of the same zone, at every transition.
+ */
+static bool isSameAsPrecomputed(const extended::ZoneInfo* mappedInfo,
+    const PrecomputedZone& zone) {
+  ExtendedZoneProcessor processor(mappedInfo);
+  for (uint16_t i = 1; i < zone.getNumEntries(); i++) {
+    acetime_t seconds = zone.getEntryStartSeconds(i);
+    for (acetime_t s = seconds - 1; s <= seconds; s++) {
+      if (! zone.contains(s)) continue;
+      if (processor.getUtcOffset(s).toOffsetCode()
+          != zone.getUtcOffset(s).toOffsetCode()) return false;
+      if (processor.getDeltaOffset(s).toOffsetCode()
+          != zone.getDeltaOffset(s).toOffsetCode()) return false;
+      if (strcmp(processor.getAbbrev(s), zone.getAbbrev(s)) != 0) return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Return the letter of the first ZoneRule of the first ZonePolicy which has
+ * both rules and letters, as a writable byte of the buffer, and its
+ * numLetters. Return nullptr if there is no such ZonePolicy.
+ */
+static uint8_t* findRuleLetter(uint8_t& numLetters) {
+  const uint8_t* registry = (const uint8_t*) zoneDb.zoneRegistry();
+  for (uint16_t i = 0; i < zoneDb.registrySize(); i++) {
+    const uint8_t* info = mapped::readPointer(
+        registry + i * mapped::kOffsetSize);
+    const uint8_t* eras = mapped::readPointer(info + mapped::kZoneInfoEras);
+    for (uint8_t j = 0; j < info[mapped::kZoneInfoNumEras]; j++) {
+      const uint8_t* policy = mapped::readPointer(
+          eras + j * mapped::kZoneEraSize + mapped::kZoneEraZonePolicy);
+      if (policy == nullptr) continue;
+      numLetters = policy[mapped::kZonePolicyNumLetters];
+      if (policy[mapped::kZonePolicyNumRules] == 0 || numLetters == 0) {
+        continue;
+      }
+      const uint8_t* rules = mapped::readPointer(
+          policy + mapped::kZonePolicyRules);
+      return buffer + (rules + mapped::kZoneRuleLetter - buffer);
+    }
+  }
+  return nullptr;
+}
+
+// --------------------------------------------------------------------------
+
+test(MappedZoneDbTest, header) {
+  assertFalse(zoneDb.isError());
+  assertEqual(bufferSize, zoneDb.size());
+  assertEqual(zonedbx::kZoneRegistrySize, zoneDb.registrySize());
+  assertEqual(zonedbx::kTzDatabaseVersion, zoneDb.tzVersion());
+  assertEqual(zonedbx::kZoneContext.startYear, zoneDb.startYear());
+  assertEqual(zonedbx::kZoneContext.untilYear, zoneDb.untilYear());
+}
+
+test(MappedZoneDbTest, brokers) {
+  const extended::ZoneRegistryBroker registry(zoneDb.zoneRegistry());
+  for (uint16_t i = 0; i < zonedbx::kZoneRegistrySize; i++) {
+    const extended::ZoneInfoBroker broker(registry.zoneInfo(i));
+    assertTrue(isSameZoneInfo(zonedbx::kZoneRegistry[i], broker));
+  }
+}
+
+test(MappedZoneDbTest, openBuffer_corrupted) {
+  MappedZoneDb db;
+  assertTrue(db.isError());
+  assertFalse(db.openBuffer(buffer, bufferSize - 1));
+  assertFalse(db.openBuffer(buffer, mapped::kHeaderSize - 1));
+  assertFalse(db.openBuffer(nullptr, bufferSize));
+  assertTrue(db.isError());
+
+  buffer[mapped::kHeaderMagic] = 'X';
+  assertFalse(db.openBuffer(buffer, bufferSize));
+  buffer[mapped::kHeaderMagic] = 'A';
+
+  buffer[mapped::kHeaderVersion]++;
+  assertFalse(db.openBuffer(buffer, bufferSize));
+  buffer[mapped::kHeaderVersion]--;
+
+  buffer[mapped::kHeaderScope] = mapped::kScopeBasic;
+  assertFalse(db.openBuffer(buffer, bufferSize));
+  buffer[mapped::kHeaderScope] = mapped::kScopeExtended;
+
+  // Point the first ZoneInfo of the registry past the end of the buffer.
+  const uint8_t* registry = (const uint8_t*) zoneDb.zoneRegistry();
+  uint8_t* field = buffer + (registry - buffer);
+  uint8_t saved[mapped::kOffsetSize];
+  memcpy(saved, field, sizeof(saved));
+  field[3] = 0x7f;
+  assertFalse(MappedZoneDb::isValid(buffer, bufferSize));
+  memcpy(field, saved, sizeof(saved));
+
+  // A letter index past the end of the letters of its ZonePolicy, or a
+  // letter which is not ASCII.
+  uint8_t numLetters;
+  uint8_t* letter = findRuleLetter(numLetters);
+  assertTrue(letter != nullptr);
+  uint8_t savedLetter = *letter;
+  *letter = numLetters;
+  assertFalse(db.openBuffer(buffer, bufferSize));
+  *letter = numLetters - 1;
+  assertTrue(MappedZoneDb::isValid(buffer, bufferSize));
+  *letter = 0x80;
+  assertFalse(MappedZoneDb::isValid(buffer, bufferSize));
+  *letter = savedLetter;
+
+  assertTrue(db.openBuffer(buffer, bufferSize));
+  assertFalse(db.isError());
+  db.close();
+  assertTrue(db.isError());
+}
+
+test(MappedZoneDbTest, openFile) {
+  char fileName[] = "/tmp/MappedZoneDbTestXXXXXX";
+  int fd = mkstemp(fileName);
+  assertTrue(fd >= 0);
+  assertEqual((ssize_t) bufferSize, write(fd, buffer, bufferSize));
+  close(fd);
+
+  MappedZoneDb db;
+  assertTrue(db.openFile(fileName));
+  assertEqual(bufferSize, db.size());
+  assertTrue(buffer != db.data());
+
+  ExtendedZoneRegistrar registrar(db.registrySize(), db.zoneRegistry(),
+      db.zoneRegistryById());
+  const extended::ZoneInfo* info =
+      registrar.getZoneInfoForName("America/Los_Angeles");
+  assertTrue(info != nullptr);
+  assertTrue(isSameAsPrecomputed(info,
+      zonedbx::precomputed::kZoneAmerica_Los_Angeles));
+
+  db.close();
+  unlink(fileName);
+  assertFalse(db.openFile(fileName));
+  assertTrue(db.isError());
+}
+
+test(MappedZoneDbTest, registrar) {
+  ExtendedZoneRegistrar registrar(zoneDb.registrySize(),
+      zoneDb.zoneRegistry(), zoneDb.zoneRegistryById());
+  assertTrue(registrar.isSorted());
+  assertTrue(registrar.isSortedById());
+
+  const extended::ZoneInfo* info =
+      registrar.getZoneInfoForName("Europe/London");
+  assertTrue(info != nullptr);
+  assertEqual("Europe/London", extended::ZoneInfoBroker(info).name());
+  assertTrue(info == registrar.getZoneInfoForId(
+      zonedbx::kZoneEurope_London.zoneId));
+  assertTrue(registrar.getZoneInfoForName("Europe/Nowhere") == nullptr);
+}
+
+test(MappedZoneDbTest, ExtendedZoneProcessor) {
+  ExtendedZoneRegistrar registrar(zoneDb.registrySize(),
+      zoneDb.zoneRegistry());
+  const PrecomputedZone* const zones[] = {
+    &zonedbx::precomputed::kZoneAmerica_Los_Angeles,
+    &zonedbx::precomputed::kZoneAmerica_New_York,
+    &zonedbx::precomputed::kZoneEurope_London,
+    &zonedbx::precomputed::kZoneAustralia_Sydney,
+    &zonedbx::precomputed::kZoneAsia_Kolkata,
+  };
+  for (const PrecomputedZone* zone : zones) {
+    const extended::ZoneInfo* info = registrar.getZoneInfoForName(
+        zone->getZoneInfo()->name);
+    assertTrue(info != nullptr);
+    assertTrue(isSameAsPrecomputed(info, *zone));
+  }
+}
+
+test(MappedZoneDbTest, ExtendedZoneManager) {
+  ExtendedZoneManager<2> manager(zoneDb.registrySize(), zoneDb.zoneRegistry(),
+      zoneDb.zoneRegistryById());
+  TimeZone tz = manager.createForZoneName("America/New_York");
+  assertEqual(TimeZone::kTypeExtendedManaged, tz.getType());
+  assertEqual(zonedbx::kZoneAmerica_New_York.zoneId, tz.getZoneId());
+
+  FakePrint fakePrint;
+  tz.printTo(fakePrint);
+  assertEqual(F("America/New_York"), fakePrint.getBuffer());
+
+  ZonedDateTime dt = ZonedDateTime::forComponents(2019, 7, 4, 12, 0, 0, tz);
+  assertEqual(-4*60, dt.timeOffset().toMinutes());
+}
+
+// --------------------------------------------------------------------------
+
+void setup() {
+#if defined(ARDUINO)
+  delay(1000); // wait for stability on some boards to prevent garbage SERIAL_PORT_MONITOR
+#endif
+  SERIAL_PORT_MONITOR.begin(115200); // ESP8266 default of 74880 not supported on Linux
+  while(!SERIAL_PORT_MONITOR); // for the Arduino Leonardo/Micro only
+
+  MappedZoneWriter writer(buffer, kBufferSize);
+  bufferSize = writer.write(zonedbx::kZoneContext, zonedbx::kZoneRegistrySize,
+      zonedbx::kZoneRegistry, zonedbx::kZoneRegistryById);
+  zoneDb.openBuffer(buffer, bufferSize);
+}
+
+void loop() {
+  TestRunner::run();
+}
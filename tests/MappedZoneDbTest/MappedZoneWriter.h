@@ -0,0 +1,192 @@
+#ifndef MAPPED_ZONE_WRITER_H
+#define MAPPED_ZONE_WRITER_H
+
+#include <string.h>
+#include <AceTime.h>
+
+/**
+ * Serialize the extended::ZoneInfo records of the compiled zonedbx:: database
+ * into the binary format of internal/MappedZoneInfo.h, the same way as
+ * tools/bingenerator.py, so that the Mapped*Broker classes can be tested
+ * without the TZ Database files. The structs are read directly, which works
+ * only on Linux or MacOS where PROGMEM is ordinary memory.
+ */
+class MappedZoneWriter {
+  public:
+    MappedZoneWriter(uint8_t* buffer, size_t capacity):
+        mBuffer(buffer),
+        mCapacity(capacity) {}
+
+    /**
+     * Write the database and return its size, or 0 if the buffer is too
+     * small.
+     */
+    size_t write(const ace_time::extended::ZoneContext& context,
+        uint16_t numZones,
+        const ace_time::extended::ZoneInfo* const* registry,
+        const ace_time::extended::ZoneInfo* const* registryById) {
+      using namespace ace_time;
+      mSize = 0;
+      mNumPolicies = 0;
+      mOverflow = false;
+
+      size_t header = allocate(mapped::kHeaderSize);
+      memcpy(mBuffer + header, mapped::kMagic, sizeof(mapped::kMagic));
+      putUint16(header + mapped::kHeaderVersion, mapped::kVersion);
+      mBuffer[header + mapped::kHeaderScope] = mapped::kScopeExtended;
+      putUint16(header + mapped::kHeaderZoneContext
+          + mapped::kZoneContextStartYear, context.startYear);
+      putUint16(header + mapped::kHeaderZoneContext
+          + mapped::kZoneContextUntilYear, context.untilYear);
+      putOffset(header + mapped::kHeaderZoneContext
+          + mapped::kZoneContextTzVersion, writeString(context.tzVersion));
+      putUint16(header + mapped::kHeaderNumZones, numZones);
+
+      size_t infos = allocate(numZones * mapped::kZoneInfoSize);
+      size_t names = allocate(numZones * mapped::kOffsetSize);
+      size_t ids = allocate(numZones * mapped::kOffsetSize);
+      putOffset(header + mapped::kHeaderRegistry, names);
+      putOffset(header + mapped::kHeaderRegistryById, ids);
+
+      for (uint16_t i = 0; i < numZones; i++) {
+        size_t info = infos + i * mapped::kZoneInfoSize;
+        writeZoneInfo(info, registry[i], header + mapped::kHeaderZoneContext);
+        putOffset(names + i * mapped::kOffsetSize, info);
+      }
+      for (uint16_t i = 0; i < numZones; i++) {
+        for (uint16_t j = 0; j < numZones; j++) {
+          if (registry[j] == registryById[i]) {
+            putOffset(ids + i * mapped::kOffsetSize,
+                infos + j * mapped::kZoneInfoSize);
+            break;
+          }
+        }
+      }
+
+      putUint32(header + mapped::kHeaderFileSize, mSize);
+      return mOverflow ? 0 : mSize;
+    }
+
+  private:
+    static const uint16_t kMaxPolicies = 256;
+
+    void writeZoneInfo(size_t pos, const ace_time::extended::ZoneInfo* info,
+        size_t context) {
+      using namespace ace_time;
+      putOffset(pos + mapped::kZoneInfoName, writeString(info->name));
+      putUint32(pos + mapped::kZoneInfoZoneId, info->zoneId);
+      putOffset(pos + mapped::kZoneInfoZoneContext, context);
+      put(pos + mapped::kZoneInfoTransitionBufSize, info->transitionBufSize);
+      put(pos + mapped::kZoneInfoNumEras, info->numEras);
+
+      size_t eras = allocate(info->numEras * mapped::kZoneEraSize);
+      putOffset(pos + mapped::kZoneInfoEras, eras);
+      for (uint8_t i = 0; i < info->numEras; i++) {
+        const extended::ZoneEra& era = info->eras[i];
+        size_t e = eras + i * mapped::kZoneEraSize;
+        if (era.zonePolicy != nullptr) {
+          putOffset(e + mapped::kZoneEraZonePolicy,
+              writeZonePolicy(era.zonePolicy));
+        }
+        putOffset(e + mapped::kZoneEraFormat, writeString(era.format));
+        put(e + mapped::kZoneEraOffsetCode, era.offsetCode);
+        put(e + mapped::kZoneEraDeltaCode, era.deltaCode);
+        put(e + mapped::kZoneEraUntilYearTiny, era.untilYearTiny);
+        put(e + mapped::kZoneEraUntilMonth, era.untilMonth);
+        put(e + mapped::kZoneEraUntilDay, era.untilDay);
+        put(e + mapped::kZoneEraUntilTimeCode, era.untilTimeCode);
+        put(e + mapped::kZoneEraUntilTimeModifier, era.untilTimeModifier);
+      }
+    }
+
+    /** Write the policy once, and return its position. */
+    size_t writeZonePolicy(const ace_time::extended::ZonePolicy* policy) {
+      using namespace ace_time;
+      for (uint16_t i = 0; i < mNumPolicies; i++) {
+        if (mPolicies[i] == policy) return mPolicyPositions[i];
+      }
+
+      size_t pos = allocate(mapped::kZonePolicySize);
+      if (mNumPolicies < kMaxPolicies) {
+        mPolicies[mNumPolicies] = policy;
+        mPolicyPositions[mNumPolicies] = pos;
+        mNumPolicies++;
+      }
+      put(pos + mapped::kZonePolicyNumRules, policy->numRules);
+      put(pos + mapped::kZonePolicyNumLetters, policy->numLetters);
+
+      size_t rules = allocate(policy->numRules * mapped::kZoneRuleSize);
+      if (policy->numRules > 0) putOffset(pos + mapped::kZonePolicyRules, rules);
+      for (uint8_t i = 0; i < policy->numRules; i++) {
+        const extended::ZoneRule& rule = policy->rules[i];
+        size_t r = rules + i * mapped::kZoneRuleSize;
+        put(r + mapped::kZoneRuleFromYearTiny, rule.fromYearTiny);
+        put(r + mapped::kZoneRuleToYearTiny, rule.toYearTiny);
+        put(r + mapped::kZoneRuleInMonth, rule.inMonth);
+        put(r + mapped::kZoneRuleOnDayOfWeek, rule.onDayOfWeek);
+        put(r + mapped::kZoneRuleOnDayOfMonth, rule.onDayOfMonth);
+        put(r + mapped::kZoneRuleAtTimeCode, rule.atTimeCode);
+        put(r + mapped::kZoneRuleAtTimeModifier, rule.atTimeModifier);
+        put(r + mapped::kZoneRuleDeltaCode, rule.deltaCode);
+        put(r + mapped::kZoneRuleLetter, rule.letter);
+      }
+
+      size_t letters = allocate(policy->numLetters * mapped::kOffsetSize);
+      if (policy->numLetters > 0) {
+        putOffset(pos + mapped::kZonePolicyLetters, letters);
+      }
+      for (uint8_t i = 0; i < policy->numLetters; i++) {
+        putOffset(letters + i * mapped::kOffsetSize,
+            writeString(policy->letters[i]));
+      }
+      return pos;
+    }
+
+    size_t writeString(const char* s) {
+      size_t len = strlen(s) + 1;
+      size_t pos = allocate(len);
+      if (! mOverflow) memcpy(mBuffer + pos, s, len);
+      return pos;
+    }
+
+    size_t allocate(size_t size) {
+      size_t pos = mSize;
+      if (mSize + size > mCapacity) {
+        mOverflow = true;
+        return 0;
+      }
+      memset(mBuffer + pos, 0, size);
+      mSize += size;
+      return pos;
+    }
+
+    void put(size_t pos, uint8_t value) {
+      if (! mOverflow) mBuffer[pos] = value;
+    }
+
+    void putUint16(size_t pos, uint16_t value) {
+      put(pos, value & 0xff);
+      put(pos + 1, value >> 8);
+    }
+
+    void putUint32(size_t pos, uint32_t value) {
+      putUint16(pos, value & 0xffff);
+      putUint16(pos + 2, value >> 16);
+    }
+
+    /** Write the offset from pos to target into the field at pos. */
+    void putOffset(size_t pos, size_t target) {
+      putUint32(pos, (uint32_t) (int32_t) (target - pos));
+    }
+
+    uint8_t* const mBuffer;
+    size_t const mCapacity;
+    size_t mSize = 0;
+    bool mOverflow = false;
+
+    const ace_time::extended::ZonePolicy* mPolicies[kMaxPolicies];
+    size_t mPolicyPositions[kMaxPolicies];
+    uint16_t mNumPolicies = 0;
+};
+
+#endif
@@ -1,9 +1,11 @@
 #line 2 "OffsetDateTimeTest.ino"
 
 #include <AUnit.h>
+#include <aunit/fake/FakePrint.h>
 #include <AceTime.h>
 
 using namespace aunit;
+using namespace aunit::fake;
 using namespace ace_time;
 
 test(OffsetDateTimeTest, accessors) {
@@ -226,6 +228,39 @@ test(OffsetDateTimeTest, forEpochSeconds) {
   assertEqual(LocalDate::kMonday, dt.dayOfWeek());
 }
 
+test(OffsetDateTimeTest, forEpochSeconds_batch) {
+  const acetime_t epochSeconds[] = {
+    -1,
+    0,
+    10958 * (acetime_t) 86400 - 1,
+    10958 * (acetime_t) 86400,
+    10958 * (acetime_t) 86400 + 3600,
+    LocalDate::kInvalidEpochSeconds,
+    10958 * (acetime_t) 86400 + 7200,
+  };
+  const TimeOffset offsets[] = {
+    TimeOffset(),
+    TimeOffset::forHour(-8),
+    TimeOffset::forHour(-8),
+    TimeOffset::forHour(-8),
+    TimeOffset::forHourMinute(5, 30),
+    TimeOffset(),
+    TimeOffset::forError(),
+  };
+  const size_t n = sizeof(epochSeconds) / sizeof(epochSeconds[0]);
+  OffsetDateTime odts[n];
+
+  OffsetDateTime::forEpochSeconds(epochSeconds, offsets, odts, n);
+  for (size_t i = 0; i < n; i++) {
+    OffsetDateTime expected = OffsetDateTime::forEpochSeconds(
+        epochSeconds[i], offsets[i]);
+    assertEqual(expected.isError(), odts[i].isError());
+    if (! expected.isError()) {
+      assertTrue(expected == odts[i]);
+    }
+  }
+}
+
 test(OffsetDateTimeTest, convertToTimeOffset) {
   OffsetDateTime a = OffsetDateTime::forComponents(2018, 1, 1, 12, 0, 0,
       TimeOffset());
@@ -385,6 +420,90 @@ test(OffsetDateTimeTest, forDateString_errors) {
   assertTrue(dt.isError());
 }
 
+test(OffsetDateTimeTest, forIso8601) {
+  const char s[] = "2018-08-31T13:48:01-07:00";
+  auto dt = OffsetDateTime::forIso8601(s, sizeof(s) - 1);
+  assertTrue(dt == OffsetDateTime::forComponents(
+      2018, 8, 31, 13, 48, 1, TimeOffset::forHour(-7)));
+
+  // Not NUL-terminated, the length decides.
+  const char buffer[] = "2018-08-31T13:48:01.999Z|2018-08-31T13:48:01Z";
+  dt = OffsetDateTime::forIso8601(buffer, 24);
+  assertTrue(dt == OffsetDateTime::forComponents(
+      2018, 8, 31, 13, 48, 1, TimeOffset()));
+  assertTrue(OffsetDateTime::forIso8601(buffer, 25).isError());
+
+  const char basic[] = "20180831T134801+0530";
+  dt = OffsetDateTime::forIso8601(basic, sizeof(basic) - 1);
+  assertTrue(dt == OffsetDateTime::forComponents(
+      2018, 8, 31, 13, 48, 1, TimeOffset::forHourMinute(5, 30)));
+
+  // Missing or unsupported UTC offset, out of range.
+  assertTrue(OffsetDateTime::forIso8601("2018-08-31T13:48:01", 19).isError());
+  assertTrue(OffsetDateTime::forIso8601("2018-08-31T13:48+05:50", 22)
+      .isError());
+#if ACE_TIME_EPOCH_SECONDS_64
+  assertFalse(OffsetDateTime::forIso8601("2200-01-01T00:00Z", 17).isError());
+  assertTrue(OffsetDateTime::forIso8601("0000-01-01T00:00Z", 17).isError());
+#else
+  assertTrue(OffsetDateTime::forIso8601("2200-01-01T00:00Z", 17).isError());
+#endif
+  assertTrue(OffsetDateTime::forIso8601("", 0).isError());
+}
+
+test(OffsetDateTimeTest, forIso8601_batch) {
+  const char* const strings[] = {
+    "2018-08-31T13:48:01-07:00",
+    "2018-08-31 13:48:01X",
+    "2019-01-01T00:00Z",
+  };
+  const size_t lengths[] = {25, 20, 17};
+  OffsetDateTime odts[3];
+  OffsetDateTime::forIso8601(strings, lengths, odts, 3);
+  assertTrue(odts[0] == OffsetDateTime::forComponents(
+      2018, 8, 31, 13, 48, 1, TimeOffset::forHour(-7)));
+  assertTrue(odts[1].isError());
+  assertTrue(odts[2] == OffsetDateTime::forComponents(
+      2019, 1, 1, 0, 0, 0, TimeOffset()));
+}
+
+test(OffsetDateTimeTest, formatTo) {
+  char buf[32];
+  OffsetDateTime dt = OffsetDateTime::forComponents(
+      2018, 8, 31, 3, 4, 5, TimeOffset::forHourMinute(-7, -30));
+  assertEqual((size_t) 25, dt.formatTo(buf, sizeof(buf)));
+  assertEqual("2018-08-31T03:04:05-07:30", buf);
+
+  FakePrint fakePrint;
+  dt.printTo(fakePrint);
+  assertEqual(fakePrint.getBuffer(), buf);
+
+  // Exactly large enough, then 1 character short.
+  assertEqual((size_t) 25, dt.formatTo(buf, 26));
+  assertEqual((size_t) 0, dt.formatTo(buf, 25));
+  assertEqual("", buf);
+
+  assertEqual((size_t) 24, OffsetDateTime::forError().formatTo(
+      buf, sizeof(buf)));
+  assertEqual("<Invalid OffsetDateTime>", buf);
+}
+
+test(OffsetDateTimeTest, formatTo_batch) {
+  OffsetDateTime odts[2] = {
+    OffsetDateTime::forComponents(2018, 8, 31, 13, 48, 1,
+        TimeOffset::forHour(-7)),
+    OffsetDateTime::forComponents(2019, 1, 1, 0, 0, 0, TimeOffset()),
+  };
+  char buf[2 * 26 + 1];
+  assertEqual((size_t) 52, OffsetDateTime::formatTo(
+      odts, 2, buf, sizeof(buf), ','));
+  assertEqual("2018-08-31T13:48:01-07:00,2019-01-01T00:00:00+00:00,", buf);
+
+  assertEqual((size_t) 0, OffsetDateTime::formatTo(
+      odts, 2, buf, sizeof(buf) - 1));
+  assertEqual("", buf);
+}
+
 // --------------------------------------------------------------------------
 
 void setup() {
@@ -0,0 +1,150 @@
+#line 2 "PosixTzTest.ino"
+
+#include <AUnit.h>
+#include <AceTime.h>
+
+using namespace aunit;
+using namespace ace_time;
+using namespace ace_time::posix;
+
+/** Return the epochSeconds of the given UTC date and time. */
+static acetime_t utcSeconds(int16_t year, uint8_t month, uint8_t day,
+    uint8_t hour, uint8_t minute = 0) {
+  return LocalDateTime::forComponents(year, month, day, hour, minute, 0)
+      .toEpochSeconds();
+}
+
+// --------------------------------------------------------------------------
+// DateRule
+// --------------------------------------------------------------------------
+
+test(DateRuleTest, monthWeekDay) {
+  DateRule rule;
+  rule.type = DateRule::kTypeMonthWeekDay;
+  rule.month = 3;
+  rule.week = 2;
+  rule.dayOfWeek = 0;
+  rule.timeSeconds = 2 * 3600;
+  assertEqual(utcSeconds(2019, 3, 10, 2), rule.toLocalSeconds(2019));
+  assertEqual(utcSeconds(2020, 3, 8, 2), rule.toLocalSeconds(2020));
+
+  // Week 5 is the last week of the month.
+  rule.month = 10;
+  rule.week = 5;
+  assertEqual(utcSeconds(2019, 10, 27, 2), rule.toLocalSeconds(2019));
+  assertEqual(utcSeconds(2020, 10, 25, 2), rule.toLocalSeconds(2020));
+
+  // Times beyond 24 hours move into the next days.
+  rule.timeSeconds = 50 * 3600;
+  assertEqual(utcSeconds(2019, 10, 29, 2), rule.toLocalSeconds(2019));
+}
+
+test(DateRuleTest, julian) {
+  DateRule rule;
+  rule.type = DateRule::kTypeJulianNoLeap;
+  rule.day = 60;
+  rule.timeSeconds = 0;
+  assertEqual(utcSeconds(2019, 3, 1, 0), rule.toLocalSeconds(2019));
+  assertEqual(utcSeconds(2020, 3, 1, 0), rule.toLocalSeconds(2020));
+
+  rule.type = DateRule::kTypeJulian;
+  rule.day = 59;
+  assertEqual(utcSeconds(2019, 3, 1, 0), rule.toLocalSeconds(2019));
+  assertEqual(utcSeconds(2020, 2, 29, 0), rule.toLocalSeconds(2020));
+}
+
+// --------------------------------------------------------------------------
+// TzSpec
+// --------------------------------------------------------------------------
+
+test(TzSpecTest, parse) {
+  TzSpec spec;
+  assertTrue(spec.isError());
+
+  assertTrue(spec.parse("PST8PDT,M3.2.0,M11.1.0"));
+  assertFalse(spec.isError());
+  assertTrue(spec.hasDst());
+  assertEqual(-8 * 3600, spec.stdOffsetSeconds());
+  assertEqual(-7 * 3600, spec.dstOffsetSeconds());
+  assertEqual("PST", spec.stdAbbrev());
+  assertEqual("PDT", spec.dstAbbrev());
+  assertEqual(3, spec.dstStartRule().month);
+  assertEqual(11, spec.dstEndRule().month);
+  assertEqual(2 * 3600, (int) spec.dstEndRule().timeSeconds);
+
+  assertTrue(spec.parse("<+0530>-5:30"));
+  assertFalse(spec.hasDst());
+  assertEqual(5 * 3600 + 30 * 60, spec.stdOffsetSeconds());
+  assertEqual("+0530", spec.stdAbbrev());
+  assertEqual("", spec.dstAbbrev());
+
+  // Missing rules are the US rules.
+  assertTrue(spec.parse("EST5EDT"));
+  assertTrue(spec.hasDst());
+  assertEqual(-4 * 3600, spec.dstOffsetSeconds());
+  assertEqual(utcSeconds(2019, 3, 10, 7), spec.dstStartSeconds(2019));
+  assertEqual(utcSeconds(2019, 11, 3, 6), spec.dstEndSeconds(2019));
+
+  // Only the given number of characters are parsed.
+  assertTrue(spec.parse("UTC0\n", 4));
+  assertEqual(0, spec.stdOffsetSeconds());
+  assertEqual("UTC", spec.stdAbbrev());
+}
+
+test(TzSpecTest, parse_invalid) {
+  TzSpec spec;
+  assertFalse(spec.parse(""));
+  assertFalse(spec.parse("XX"));
+  assertFalse(spec.parse("PST"));
+  assertFalse(spec.parse("PST8PDT,M3.2.0"));
+  assertFalse(spec.parse("PST8PDT,M13.2.0,M11.1.0"));
+  assertFalse(spec.parse("PST8PDT,M3.2.0,M11.1.0x"));
+  assertFalse(spec.parse("<+0530-5:30"));
+  assertFalse(spec.parse("PST25"));
+  assertTrue(spec.isError());
+}
+
+test(TzSpecTest, isDst) {
+  TzSpec spec;
+
+  // Europe/London, at 01:00 UTC.
+  assertTrue(spec.parse("GMT0BST,M3.5.0/1,M10.5.0"));
+  assertEqual(utcSeconds(2019, 3, 31, 1), spec.dstStartSeconds(2019));
+  assertEqual(utcSeconds(2019, 10, 27, 1), spec.dstEndSeconds(2019));
+  assertFalse(spec.isDst(utcSeconds(2019, 3, 31, 1) - 1));
+  assertTrue(spec.isDst(utcSeconds(2019, 3, 31, 1)));
+  assertTrue(spec.isDst(utcSeconds(2019, 10, 27, 1) - 1));
+  assertFalse(spec.isDst(utcSeconds(2019, 10, 27, 1)));
+
+  // Australia/Sydney, in DST at the start of the year.
+  assertTrue(spec.parse("AEST-10AEDT,M10.1.0,M4.1.0/3"));
+  assertTrue(spec.isDst(utcSeconds(2019, 1, 15, 0)));
+  assertFalse(spec.isDst(utcSeconds(2019, 7, 1, 0)));
+  assertTrue(spec.isDst(utcSeconds(2019, 12, 31, 23)));
+
+  // Permanent DST, whose end coincides with the start of the next year.
+  assertTrue(spec.parse("<-02>2<-01>,0/0,J365/25"));
+  assertTrue(spec.isDst(utcSeconds(2019, 1, 1, 12)));
+  assertTrue(spec.isDst(utcSeconds(2019, 12, 31, 23)));
+
+  // Europe/Dublin, with negative DST in winter.
+  assertTrue(spec.parse("IST-1GMT0,M10.5.0,M3.5.0/1"));
+  assertEqual(3600, spec.stdOffsetSeconds());
+  assertEqual(0, spec.dstOffsetSeconds());
+  assertTrue(spec.isDst(utcSeconds(2019, 1, 15, 0)));
+  assertFalse(spec.isDst(utcSeconds(2019, 7, 1, 0)));
+}
+
+// --------------------------------------------------------------------------
+
+void setup() {
+#if defined(ARDUINO)
+  delay(1000); // wait for stability on some boards to prevent garbage SERIAL_PORT_MONITOR
+#endif
+  SERIAL_PORT_MONITOR.begin(115200); // ESP8266 default of 74880 not supported on Linux
+  while(!SERIAL_PORT_MONITOR); // for the Arduino Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
@@ -0,0 +1,189 @@
+#line 2 "PosixZoneProcessorTest.ino"
+
+#include <AUnit.h>
+#include <aunit/fake/FakePrint.h>
+#include <AceTime.h>
+
+using namespace aunit;
+using namespace aunit::fake;
+using namespace ace_time;
+
+/** Return the epochSeconds of the given UTC date and time. */
+static acetime_t utcSeconds(int16_t year, uint8_t month, uint8_t day,
+    uint8_t hour, uint8_t minute = 0) {
+  return LocalDateTime::forComponents(year, month, day, hour, minute, 0)
+      .toEpochSeconds();
+}
+
+// --------------------------------------------------------------------------
+
+test(PosixZoneProcessorTest, setPosixTz) {
+  PosixZoneProcessor processor;
+  assertTrue(processor.isError());
+  assertTrue(processor.getUtcOffset(0).isError());
+  assertEqual("", processor.getAbbrev(0));
+
+  assertTrue(processor.setPosixTz("PST8PDT,M3.2.0,M11.1.0"));
+  assertFalse(processor.isError());
+  assertTrue(processor.getZoneInfo() == nullptr);
+  assertEqual((uint32_t) 0, processor.getZoneId());
+
+  assertFalse(processor.setPosixTz("PST8PDT,M3.2.0"));
+  assertTrue(processor.isError());
+  assertTrue(processor.getOffsetDateTime(
+      LocalDateTime::forComponents(2019, 1, 1, 0, 0, 0)).isError());
+}
+
+test(PosixZoneProcessorTest, getUtcOffset) {
+  PosixZoneProcessor processor("PST8PDT,M3.2.0,M11.1.0");
+
+  acetime_t seconds = utcSeconds(2019, 3, 10, 10);
+  assertEqual(-8*60, processor.getUtcOffset(seconds - 1).toMinutes());
+  assertEqual(0, processor.getDeltaOffset(seconds - 1).toMinutes());
+  assertEqual("PST", processor.getAbbrev(seconds - 1));
+  assertEqual(-7*60, processor.getUtcOffset(seconds).toMinutes());
+  assertEqual(60, processor.getDeltaOffset(seconds).toMinutes());
+  assertEqual("PDT", processor.getAbbrev(seconds));
+
+  seconds = utcSeconds(2019, 11, 3, 9);
+  assertEqual(-7*60, processor.getUtcOffset(seconds - 1).toMinutes());
+  assertEqual(-8*60, processor.getUtcOffset(seconds).toMinutes());
+
+  // Without DST.
+  PosixZoneProcessor kolkata("<+0530>-5:30");
+  assertEqual(5*60+30, kolkata.getUtcOffset(0).toMinutes());
+  assertEqual("+0530", kolkata.getAbbrev(0));
+}
+
+test(PosixZoneProcessorTest, findZone) {
+  PosixZoneProcessor processor("PST8PDT,M3.2.0,M11.1.0");
+
+  // The cache covers the 2 transitions of each of the 3 years around 2019.
+  const PrecomputedZone& zone = processor.findZone(utcSeconds(2019, 7, 1, 0));
+  assertEqual(2019, processor.mYear);
+  assertEqual(7, zone.getNumEntries());
+  assertEqual(utcSeconds(2018, 3, 11, 10), zone.getEntryStartSeconds(1));
+  assertEqual(utcSeconds(2020, 11, 1, 9), zone.getEntryStartSeconds(6));
+
+  // Australia/Sydney starts the year in DST.
+  PosixZoneProcessor sydney("AEST-10AEDT,M10.1.0,M4.1.0/3");
+  const PrecomputedZone& zone2 = sydney.findZone(utcSeconds(2019, 7, 1, 0));
+  assertEqual(7, zone2.getNumEntries());
+  assertEqual(utcSeconds(2018, 3, 31, 16), zone2.getEntryStartSeconds(1));
+  assertEqual(0, zone2.getEntryDeltaCode(1));
+
+  // Permanent DST, whose end and start at the boundary of each year merge
+  // into a single entry covering the whole requested year.
+  PosixZoneProcessor permanent("<-02>2<-01>,0/0,J365/25");
+  const PrecomputedZone& zone3 = permanent.findZone(utcSeconds(2019, 7, 1, 0));
+  assertEqual(3, zone3.getNumEntries());
+  assertEqual(utcSeconds(2018, 1, 1, 2), zone3.getEntryStartSeconds(1));
+  assertEqual(4, zone3.getEntryDeltaCode(1));
+  assertEqual(utcSeconds(2021, 1, 1, 2), zone3.getEntryStartSeconds(2));
+  assertEqual(-60, permanent.getUtcOffset(utcSeconds(2019, 1, 1, 0))
+      .toMinutes());
+  assertEqual(-60, permanent.getUtcOffset(utcSeconds(2019, 12, 31, 23))
+      .toMinutes());
+}
+
+test(PosixZoneProcessorTest, compareWithExtended) {
+  // The rules of America/Los_Angeles since 2007.
+  PosixZoneProcessor processor("PST8PDT,M3.2.0,M11.1.0");
+  ExtendedZoneProcessor extendedProcessor(&zonedbx::kZoneAmerica_Los_Angeles);
+
+  acetime_t start = LocalDate::forComponents(2008, 1, 1).toEpochSeconds();
+  acetime_t until = LocalDate::forComponents(2050, 1, 1).toEpochSeconds();
+  for (acetime_t seconds = start; seconds < until; seconds += 3600) {
+    assertEqual(extendedProcessor.getUtcOffset(seconds).toMinutes(),
+        processor.getUtcOffset(seconds).toMinutes());
+    assertEqual(extendedProcessor.getAbbrev(seconds),
+        processor.getAbbrev(seconds));
+
+    auto ldt = LocalDateTime::forEpochSeconds(seconds);
+    assertTrue(extendedProcessor.getOffsetDateTime(ldt)
+        == processor.getOffsetDateTime(ldt));
+  }
+}
+
+test(PosixZoneProcessorTest, resolveLocalDateTime) {
+  PosixZoneProcessor processor("EST5EDT");
+
+  auto ldt = LocalDateTime::forComponents(2030, 3, 10, 2, 30, 0);
+  ResolvedDateTime resolved = processor.resolveLocalDateTime(
+      ldt, ResolvedDateTime::kPolicyReject);
+  assertEqual(ResolvedDateTime::kTypeGap, resolved.type);
+  assertTrue(resolved.odt.isError());
+
+  ldt = LocalDateTime::forComponents(2030, 11, 3, 1, 30, 0);
+  resolved = processor.resolveLocalDateTime(
+      ldt, ResolvedDateTime::kPolicyEarlier);
+  assertEqual(ResolvedDateTime::kTypeOverlap, resolved.type);
+  assertTrue(resolved.odt == OffsetDateTime::forComponents(
+      2030, 11, 3, 1, 30, 0, TimeOffset::forHour(-4)));
+}
+
+test(PosixZoneProcessorTest, printTo) {
+  FakePrint fakePrint;
+  PosixZoneProcessor processor("EST5EDT");
+  processor.printTo(fakePrint);
+  assertEqual("EST5EDT,M3.2.0,M11.1.0", fakePrint.getBuffer());
+  fakePrint.flush();
+  processor.printShortTo(fakePrint);
+  assertEqual("EST/EDT", fakePrint.getBuffer());
+  fakePrint.flush();
+
+  processor.setPosixTz("<+0530>-5:30");
+  processor.printTo(fakePrint);
+  assertEqual("<+0530>-5:30", fakePrint.getBuffer());
+  fakePrint.flush();
+
+  processor.setPosixTz("IST-1GMT0,M10.5.0,M3.5.0/1");
+  processor.printTo(fakePrint);
+  assertEqual("IST-1GMT0,M10.5.0,M3.5.0/1", fakePrint.getBuffer());
+  fakePrint.flush();
+
+  processor.setPosixTz("<-03>3<-02>,M3.5.0/-2,J60/25:30");
+  processor.printTo(fakePrint);
+  assertEqual("<-03>3<-02>,M3.5.0/-2,J60/25:30", fakePrint.getBuffer());
+}
+
+test(PosixZoneProcessorTest, TimeZone) {
+  PosixZoneProcessor processor("PST8PDT,M3.2.0,M11.1.0");
+  TimeZone tz = TimeZone::forPosixZone(&processor);
+  assertEqual(TimeZone::kTypePosix, tz.getType());
+  assertEqual((uint32_t) 0, tz.getZoneId());
+  assertEqual(TimeZoneData::kTypeError, tz.toTimeZoneData().type);
+
+  ZonedDateTime dt = ZonedDateTime::forComponents(2019, 7, 4, 12, 0, 0, tz);
+  assertEqual(-7*60, dt.timeOffset().toMinutes());
+
+  FakePrint fakePrint;
+  tz.printTo(fakePrint);
+  assertEqual("PST8PDT,M3.2.0,M11.1.0", fakePrint.getBuffer());
+  fakePrint.flush();
+  tz.printAbbrevTo(fakePrint, dt.toEpochSeconds());
+  assertEqual("PDT", fakePrint.getBuffer());
+
+  // Equal if the TZ strings are equal.
+  PosixZoneProcessor other("PST8PDT");
+  assertTrue(tz == TimeZone::forPosixZone(&other));
+  other.setPosixTz("EST5EDT");
+  assertTrue(tz != TimeZone::forPosixZone(&other));
+
+  PosixZoneProcessor invalid("PST8PDT,M3.2.0");
+  assertTrue(TimeZone::forPosixZone(&invalid).isError());
+}
+
+// --------------------------------------------------------------------------
+
+void setup() {
+#if defined(ARDUINO)
+  delay(1000); // wait for stability on some boards to prevent garbage SERIAL_PORT_MONITOR
+#endif
+  SERIAL_PORT_MONITOR.begin(115200); // ESP8266 default of 74880 not supported on Linux
+  while(!SERIAL_PORT_MONITOR); // for the Arduino Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
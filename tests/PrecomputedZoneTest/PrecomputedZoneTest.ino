@@ -0,0 +1,169 @@
+#line 2 "PrecomputedZoneTest.ino"
+
+#include <AUnit.h>
+#include <aunit/fake/FakePrint.h>
+#include <AceTime.h>
+
+using namespace aunit;
+using namespace aunit::fake;
+using namespace ace_time;
+
+// The zones in src/ace_time/zonedbx/precomputed_zones.txt.
+static const PrecomputedZone* const kPrecomputedZones[] = {
+  &zonedbx::precomputed::kZoneAmerica_Los_Angeles,
+  &zonedbx::precomputed::kZoneAmerica_New_York,
+  &zonedbx::precomputed::kZoneEurope_London,
+  &zonedbx::precomputed::kZoneAustralia_Sydney,
+  &zonedbx::precomputed::kZoneAsia_Kolkata,
+};
+
+static const uint8_t kNumPrecomputedZones =
+    sizeof(kPrecomputedZones) / sizeof(kPrecomputedZones[0]);
+
+/**
+ * Return true if the generated table has the same content as the table
+ * compiled at run time from the same ZoneInfo.
+ */
+static bool isSameTable(const PrecomputedZone& precomputedZone,
+    const CompiledZone& compiledZone) {
+  if (precomputedZone.getZoneInfo() != compiledZone.getZoneInfo()) return false;
+  if (precomputedZone.getStartSeconds() != compiledZone.getStartSeconds()) {
+    return false;
+  }
+  if (precomputedZone.getUntilSeconds() != compiledZone.getUntilSeconds()) {
+    return false;
+  }
+  if (precomputedZone.getNumEntries() != compiledZone.getNumEntries()) {
+    return false;
+  }
+  for (uint16_t i = 0; i < precomputedZone.getNumEntries(); i++) {
+    if (precomputedZone.getEntryStartSeconds(i)
+        != compiledZone.getEntryStartSeconds(i)) return false;
+    if (precomputedZone.getEntryOffsetCode(i)
+        != compiledZone.getEntryOffsetCode(i)) return false;
+    if (precomputedZone.getEntryDeltaCode(i)
+        != compiledZone.getEntryDeltaCode(i)) return false;
+    if (precomputedZone.getEntryAbbrevIndex(i)
+        != compiledZone.getEntryAbbrevIndex(i)) return false;
+  }
+  return true;
+}
+
+// --------------------------------------------------------------------------
+
+test(PrecomputedZoneTest, getUtcOffset) {
+  const PrecomputedZone& zone = zonedbx::precomputed::kZoneAmerica_Los_Angeles;
+  assertFalse(zone.isError());
+  assertTrue(&zonedbx::kZoneAmerica_Los_Angeles == zone.getZoneInfo());
+  assertEqual(101, zone.getNumEntries());
+  assertEqual(LocalDate::forComponents(2000, 1, 1).toEpochSeconds(),
+      zone.getStartSeconds());
+  assertEqual(LocalDate::forComponents(2050, 1, 1).toEpochSeconds(),
+      zone.getUntilSeconds());
+
+  acetime_t seconds = LocalDateTime::forComponents(2019, 3, 10, 1, 59, 59)
+      .toEpochSeconds() + 8 * 3600;
+  assertEqual(-8*60, zone.getUtcOffset(seconds).toMinutes());
+  assertEqual(0, zone.getDeltaOffset(seconds).toMinutes());
+  assertEqual("PST", zone.getAbbrev(seconds));
+
+  seconds++;
+  assertEqual(-7*60, zone.getUtcOffset(seconds).toMinutes());
+  assertEqual(60, zone.getDeltaOffset(seconds).toMinutes());
+  assertEqual("PDT", zone.getAbbrev(seconds));
+
+  seconds = zone.getStartSeconds() - 1;
+  assertTrue(zone.getUtcOffset(seconds).isError());
+  assertEqual("", zone.getAbbrev(seconds));
+}
+
+test(PrecomputedZoneTest, resolveLocalDateTime) {
+  const PrecomputedZone& zone = zonedbx::precomputed::kZoneAmerica_Los_Angeles;
+
+  auto ldt = LocalDateTime::forComponents(2019, 3, 10, 2, 30, 0);
+  ResolvedDateTime rdt = zone.resolveLocalDateTime(
+      ldt, ResolvedDateTime::kPolicyShiftForward);
+  assertEqual(ResolvedDateTime::kTypeGap, rdt.type);
+  assertTrue(rdt.odt == OffsetDateTime::forComponents(
+      2019, 3, 10, 3, 0, 0, TimeOffset::forHour(-7)));
+
+  ldt = LocalDateTime::forComponents(2019, 11, 3, 1, 30, 0);
+  rdt = zone.resolveLocalDateTime(ldt, ResolvedDateTime::kPolicyEarlier);
+  assertEqual(ResolvedDateTime::kTypeOverlap, rdt.type);
+  assertEqual(-7*60, rdt.odt.timeOffset().toMinutes());
+}
+
+test(PrecomputedZoneTest, empty) {
+  static const PrecomputedZone zone;
+  assertTrue(zone.isError());
+  assertTrue(zone.getUtcOffset(0).isError());
+  assertTrue(TimeZone::forPrecomputedZone(&zone).isError());
+}
+
+// Verify that the generated tables are up to date with the zonedbx files, and
+// that every query gives the same answer as the CompiledZone.
+test(PrecomputedZoneTest, matchesCompiledZone) {
+  for (uint8_t i = 0; i < kNumPrecomputedZones; i++) {
+    const PrecomputedZone& zone = *kPrecomputedZones[i];
+    CompiledZone compiledZone(zone.getZoneInfo());
+    assertTrue(isSameTable(zone, compiledZone));
+
+    for (acetime_t seconds = zone.getStartSeconds();
+        seconds < zone.getUntilSeconds();
+        seconds += 7 * 86400L + 1799) {
+      assertEqual(compiledZone.getUtcOffset(seconds).toMinutes(),
+          zone.getUtcOffset(seconds).toMinutes());
+      assertEqual(compiledZone.getDeltaOffset(seconds).toMinutes(),
+          zone.getDeltaOffset(seconds).toMinutes());
+      assertEqual(compiledZone.getAbbrev(seconds), zone.getAbbrev(seconds));
+
+      LocalDateTime ldt = LocalDateTime::forEpochSeconds(seconds);
+      assertTrue(compiledZone.getOffsetDateTime(ldt)
+          == zone.getOffsetDateTime(ldt));
+      ResolvedDateTime expected = compiledZone.resolveLocalDateTime(
+          ldt, ResolvedDateTime::kPolicyEarlier);
+      ResolvedDateTime actual = zone.resolveLocalDateTime(
+          ldt, ResolvedDateTime::kPolicyEarlier);
+      assertEqual(expected.type, actual.type);
+      assertTrue(expected.odt == actual.odt);
+    }
+  }
+}
+
+test(PrecomputedZoneTest, timeZone) {
+  TimeZone tz = TimeZone::forPrecomputedZone(
+      &zonedbx::precomputed::kZoneEurope_London);
+  assertEqual(TimeZone::kTypeCompiled, tz.getType());
+  assertTrue(tz.getZoneId() == TimeZone::forZoneInfo(
+      &zonedbx::kZoneEurope_London, (ExtendedZoneProcessor*) nullptr)
+      .getZoneId());
+
+  acetime_t seconds = LocalDateTime::forComponents(2019, 7, 1, 0, 0, 0)
+      .toEpochSeconds();
+  assertEqual(60, tz.getUtcOffset(seconds).toMinutes());
+
+  auto dt = ZonedDateTime::forComponents(2019, 7, 1, 12, 0, 0, tz);
+  assertEqual(60, dt.timeOffset().toMinutes());
+
+  FakePrint fakePrint;
+  tz.printTo(fakePrint);
+  assertEqual(F("Europe/London"), fakePrint.getBuffer());
+  fakePrint.flush();
+  tz.printAbbrevTo(fakePrint, seconds);
+  assertEqual(F("BST"), fakePrint.getBuffer());
+  fakePrint.flush();
+}
+
+// --------------------------------------------------------------------------
+
+void setup() {
+#if defined(ARDUINO)
+  delay(1000); // wait for stability on some boards to prevent garbage SERIAL_PORT_MONITOR
+#endif
+  SERIAL_PORT_MONITOR.begin(115200); // ESP8266 default of 74880 not supported on Linux
+  while(!SERIAL_PORT_MONITOR); // for the Arduino Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
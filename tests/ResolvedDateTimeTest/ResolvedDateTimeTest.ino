@@ -0,0 +1,258 @@
+#line 2 "ResolvedDateTimeTest.ino"
+
+#include <AUnit.h>
+#include <AceTime.h>
+
+using namespace aunit;
+using namespace ace_time;
+
+// --------------------------------------------------------------------------
+// Verify the 4 policies on the transitions of America/Los_Angeles in 2019.
+// The gap is 02:00-03:00 on Mar 10, the overlap is 01:00-02:00 on Nov 3.
+// --------------------------------------------------------------------------
+
+static bool isLosAngeles2019(const ZoneProcessor& processor) {
+  const TimeOffset pst = TimeOffset::forHour(-8);
+  const TimeOffset pdt = TimeOffset::forHour(-7);
+
+  // unique
+  auto ldt = LocalDateTime::forComponents(2019, 3, 10, 1, 59, 0);
+  ResolvedDateTime r = processor.resolveLocalDateTime(
+      ldt, ResolvedDateTime::kPolicyReject);
+  if (r.type != ResolvedDateTime::kTypeUnique) return false;
+  if (r.earlierOffset != pst || r.laterOffset != pst) return false;
+  if (r.odt != OffsetDateTime::forLocalDateTimeAndOffset(ldt, pst)) {
+    return false;
+  }
+
+  // gap
+  ldt = LocalDateTime::forComponents(2019, 3, 10, 2, 30, 0);
+  r = processor.resolveLocalDateTime(ldt, ResolvedDateTime::kPolicyEarlier);
+  if (r.type != ResolvedDateTime::kTypeGap) return false;
+  if (r.earlierOffset != pst || r.laterOffset != pdt) return false;
+  if (r.odt != OffsetDateTime::forComponents(2019, 3, 10, 1, 30, 0, pst)) {
+    return false;
+  }
+  r = processor.resolveLocalDateTime(ldt, ResolvedDateTime::kPolicyLater);
+  if (r.odt != OffsetDateTime::forComponents(2019, 3, 10, 3, 30, 0, pdt)) {
+    return false;
+  }
+  r = processor.resolveLocalDateTime(
+      ldt, ResolvedDateTime::kPolicyShiftForward);
+  if (r.odt != OffsetDateTime::forComponents(2019, 3, 10, 3, 0, 0, pdt)) {
+    return false;
+  }
+  r = processor.resolveLocalDateTime(ldt, ResolvedDateTime::kPolicyReject);
+  if (r.type != ResolvedDateTime::kTypeGap || ! r.odt.isError()) return false;
+
+  // overlap
+  ldt = LocalDateTime::forComponents(2019, 11, 3, 1, 30, 0);
+  r = processor.resolveLocalDateTime(ldt, ResolvedDateTime::kPolicyEarlier);
+  if (r.type != ResolvedDateTime::kTypeOverlap) return false;
+  if (r.earlierOffset != pdt || r.laterOffset != pst) return false;
+  if (r.odt != OffsetDateTime::forLocalDateTimeAndOffset(ldt, pdt)) {
+    return false;
+  }
+  r = processor.resolveLocalDateTime(ldt, ResolvedDateTime::kPolicyLater);
+  if (r.odt != OffsetDateTime::forLocalDateTimeAndOffset(ldt, pst)) {
+    return false;
+  }
+  r = processor.resolveLocalDateTime(
+      ldt, ResolvedDateTime::kPolicyShiftForward);
+  if (r.odt != OffsetDateTime::forLocalDateTimeAndOffset(ldt, pst)) {
+    return false;
+  }
+  r = processor.resolveLocalDateTime(ldt, ResolvedDateTime::kPolicyReject);
+  if (r.type != ResolvedDateTime::kTypeOverlap || ! r.odt.isError()) {
+    return false;
+  }
+
+  // just after the overlap
+  ldt = LocalDateTime::forComponents(2019, 11, 3, 2, 0, 0);
+  r = processor.resolveLocalDateTime(ldt, ResolvedDateTime::kPolicyEarlier);
+  if (r.type != ResolvedDateTime::kTypeUnique) return false;
+  if (r.odt != OffsetDateTime::forLocalDateTimeAndOffset(ldt, pst)) {
+    return false;
+  }
+
+  // out of range
+  ldt = LocalDateTime::forComponents(1998, 3, 10, 2, 30, 0);
+  r = processor.resolveLocalDateTime(ldt, ResolvedDateTime::kPolicyLater);
+  return r.isError() && r.odt.isError();
+}
+
+test(ResolvedDateTimeTest, BasicZoneProcessor) {
+  BasicZoneProcessor processor(&zonedb::kZoneAmerica_Los_Angeles);
+  assertTrue(isLosAngeles2019(processor));
+}
+
+test(ResolvedDateTimeTest, ExtendedZoneProcessor) {
+  ExtendedZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles);
+  assertTrue(isLosAngeles2019(processor));
+}
+
+test(ResolvedDateTimeTest, ExtendedZoneProcessorN) {
+  ExtendedZoneProcessorN<2> processor(&zonedbx::kZoneAmerica_Los_Angeles);
+  assertTrue(isLosAngeles2019(processor));
+}
+
+test(ResolvedDateTimeTest, FlatZoneProcessor) {
+  FlatZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles);
+  assertTrue(isLosAngeles2019(processor));
+}
+
+test(ResolvedDateTimeTest, TimeZone) {
+  CompiledZone compiledZone(&zonedbx::kZoneAmerica_Los_Angeles);
+  TimeZone compiled = TimeZone::forCompiledZone(&compiledZone);
+  auto ldt = LocalDateTime::forComponents(2019, 3, 10, 2, 30, 0);
+  ResolvedDateTime r = compiled.resolveLocalDateTime(
+      ldt, ResolvedDateTime::kPolicyLater);
+  assertEqual(ResolvedDateTime::kTypeGap, r.type);
+  assertTrue(r.odt == OffsetDateTime::forComponents(2019, 3, 10, 3, 30, 0,
+      TimeOffset::forHour(-7)));
+
+  ExtendedZoneProcessor processor;
+  TimeZone extended = TimeZone::forZoneInfo(
+      &zonedbx::kZoneAmerica_Los_Angeles, &processor);
+  ldt = LocalDateTime::forComponents(2019, 11, 3, 1, 30, 0);
+  r = extended.resolveLocalDateTime(ldt, ResolvedDateTime::kPolicyEarlier);
+  assertEqual(ResolvedDateTime::kTypeOverlap, r.type);
+  assertTrue(r.odt == OffsetDateTime::forLocalDateTimeAndOffset(
+      ldt, TimeOffset::forHour(-7)));
+
+  // A manual TimeZone has no transitions.
+  TimeZone manual = TimeZone::forTimeOffset(
+      TimeOffset::forHour(-8), TimeOffset::forHour(1));
+  r = manual.resolveLocalDateTime(ldt, ResolvedDateTime::kPolicyReject);
+  assertEqual(ResolvedDateTime::kTypeUnique, r.type);
+  assertTrue(r.odt == OffsetDateTime::forLocalDateTimeAndOffset(
+      ldt, TimeOffset::forHour(-7)));
+
+  assertTrue(TimeZone::forError().resolveLocalDateTime(
+      ldt, ResolvedDateTime::kPolicyLater).isError());
+}
+
+// --------------------------------------------------------------------------
+// Verify every transition of every zone against the epochSeconds of the
+// transition found with getUtcOffset().
+// --------------------------------------------------------------------------
+
+/**
+ * Verify the resolution of the local seconds around a transition at
+ * epochSeconds 'start' from offset 'before' to offset 'after'.
+ */
+static bool isValidAroundTransition(const ZoneProcessor& processor,
+    acetime_t start, TimeOffset before, TimeOffset after) {
+  const acetime_t kStep = 15 * 60;
+  const acetime_t kMargin = 3 * 3600;
+  bool isGap = before.toOffsetCode() < after.toOffsetCode();
+  acetime_t lower = start + (isGap ? before : after).toSeconds();
+  acetime_t upper = start + (isGap ? after : before).toSeconds();
+
+  for (acetime_t local = lower - kMargin; local < upper + kMargin;
+      local += kStep) {
+    auto ldt = LocalDateTime::forEpochSeconds(local);
+    bool isInTransition = lower <= local && local < upper;
+    for (uint8_t policy = ResolvedDateTime::kPolicyEarlier;
+        policy <= ResolvedDateTime::kPolicyShiftForward; policy++) {
+      ResolvedDateTime r = processor.resolveLocalDateTime(ldt, policy);
+      ResolvedDateTime expected;
+      if (! isInTransition) {
+        expected = ResolvedDateTime::forUnique(ldt,
+            (local < lower) ? before : after);
+      } else {
+        expected = ResolvedDateTime::forTransition(
+            ldt, before, after, start, policy);
+      }
+      if (r.type != expected.type) return false;
+      if (r.earlierOffset != expected.earlierOffset) return false;
+      if (r.laterOffset != expected.laterOffset) return false;
+      if (r.odt != expected.odt) return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Find the transitions of the processor from 2000 to 2049, by comparing the
+ * UTC offset of each day, then verify each of them.
+ */
+static bool isValidForAllTransitions(const ZoneProcessor& processor) {
+  const acetime_t kOneDay = 86400;
+  acetime_t startSeconds = LocalDate::forComponents(2000, 1, 3)
+      .toEpochSeconds();
+  acetime_t untilSeconds = LocalDate::forComponents(2049, 12, 29)
+      .toEpochSeconds();
+
+  TimeOffset prevOffset = processor.getUtcOffset(startSeconds);
+  for (acetime_t day = startSeconds + kOneDay; day < untilSeconds;
+      day += kOneDay) {
+    TimeOffset offset = processor.getUtcOffset(day);
+    if (offset == prevOffset) continue;
+
+    // Find the transition inside the previous day.
+    acetime_t start = day - kOneDay;
+    while (processor.getUtcOffset(start) == prevOffset) start += 60;
+    if (! isValidAroundTransition(processor, start, prevOffset, offset)) {
+      return false;
+    }
+    prevOffset = offset;
+  }
+  return true;
+}
+
+test(ResolvedDateTimeTest, BasicZoneProcessor_allZones) {
+  BasicZoneProcessor processor;
+  BasicZoneRegistrar registrar(
+      zonedb::kZoneRegistrySize, zonedb::kZoneRegistry);
+  for (uint16_t i = 0; i < zonedb::kZoneRegistrySize; i++) {
+    const basic::ZoneInfo* zoneInfo = registrar.getZoneInfoForIndex(i);
+    TimeZone::forZoneInfo(zoneInfo, &processor).getUtcOffset(0);
+    if (! isValidForAllTransitions(processor)) {
+      SERIAL_PORT_MONITOR.println(BasicZone(zoneInfo).name());
+      assertTrue(false);
+    }
+  }
+}
+
+test(ResolvedDateTimeTest, ExtendedZoneProcessor_allZones) {
+  ExtendedZoneProcessor processor;
+  ExtendedZoneRegistrar registrar(
+      zonedbx::kZoneRegistrySize, zonedbx::kZoneRegistry);
+  for (uint16_t i = 0; i < zonedbx::kZoneRegistrySize; i++) {
+    const extended::ZoneInfo* zoneInfo = registrar.getZoneInfoForIndex(i);
+    TimeZone::forZoneInfo(zoneInfo, &processor).getUtcOffset(0);
+    if (! isValidForAllTransitions(processor)) {
+      SERIAL_PORT_MONITOR.println(ExtendedZone(zoneInfo).name());
+      assertTrue(false);
+    }
+  }
+}
+
+test(ResolvedDateTimeTest, FlatZoneProcessor_allZones) {
+  FlatZoneProcessor processor;
+  ExtendedZoneRegistrar registrar(
+      zonedbx::kZoneRegistrySize, zonedbx::kZoneRegistry);
+  for (uint16_t i = 0; i < zonedbx::kZoneRegistrySize; i++) {
+    const extended::ZoneInfo* zoneInfo = registrar.getZoneInfoForIndex(i);
+    TimeZone::forZoneInfo(zoneInfo, &processor).getUtcOffset(0);
+    if (! isValidForAllTransitions(processor)) {
+      SERIAL_PORT_MONITOR.println(ExtendedZone(zoneInfo).name());
+      assertTrue(false);
+    }
+  }
+}
+
+// --------------------------------------------------------------------------
+
+void setup() {
+#if defined(ARDUINO)
+  delay(1000); // wait for stability on some boards to prevent garbage SERIAL_PORT_MONITOR
+#endif
+  SERIAL_PORT_MONITOR.begin(115200); // ESP8266 default of 74880 not supported on Linux
+  while(!SERIAL_PORT_MONITOR); // for the Arduino Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
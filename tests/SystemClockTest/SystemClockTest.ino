@@ -24,6 +24,7 @@ test(SystemClockLoopTest, invalidSeconds) {
       backupAndReferenceClock, backupAndReferenceClock, fakeMillis);
   acetime_t now = systemClock->getNow();
   assertEqual(LocalTime::kInvalidSeconds, now);
+  assertTrue(systemClock->getNowInstant().isError());
 }
 
 //---------------------------------------------------------------------------
@@ -118,6 +119,33 @@ testF(SystemClockLoopTest, getNow) {
   assertEqual((acetime_t) 171, systemClock->getNow());
 }
 
+testF(SystemClockLoopTest, getNowInstant) {
+  unsigned long nowMillis = 1;
+
+  fakeMillis->millis(nowMillis);
+  systemClock->setNow(100);
+  assertTrue(Instant::forEpochMillis(100, 0) == systemClock->getNowInstant());
+
+  // +999ms, same second as getNow()
+  nowMillis += 999;
+  fakeMillis->millis(nowMillis);
+  assertTrue(Instant::forEpochMillis(100, 999)
+      == systemClock->getNowInstant());
+  assertEqual((acetime_t) 100, systemClock->getNow());
+
+  // +1ms, next second
+  nowMillis += 1;
+  fakeMillis->millis(nowMillis);
+  assertTrue(Instant::forEpochMillis(101, 0) == systemClock->getNowInstant());
+
+  // +65432ms, causing rollover of internal uint16_t version of millis
+  nowMillis += 65432;
+  fakeMillis->millis(nowMillis);
+  assertTrue(Instant::forEpochMillis(166, 432)
+      == systemClock->getNowInstant());
+  assertEqual((acetime_t) 166, systemClock->getNow());
+}
+
 //---------------------------------------------------------------------------
 
 // Currently only one test uses this class, so strictly this isn't necessary
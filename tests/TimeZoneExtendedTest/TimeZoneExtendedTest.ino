@@ -69,6 +69,44 @@ test(TimeZoneExtendedTest, Los_Angeles) {
   assertEqual(F("PDT"), fakePrint.getBuffer());
 }
 
+test(TimeZoneExtendedTest, getUtcOffsets) {
+  TimeZone tz = extendedZoneManager.createForZoneInfo(
+      &zonedbx::kZoneAmerica_Los_Angeles);
+
+  // Sorted across several years, then a jump backwards, then an invalid
+  // value.
+  const size_t n = 64;
+  acetime_t epochSeconds[n];
+  acetime_t start = LocalDateTime::forComponents(2017, 1, 1, 0, 0, 0)
+      .toEpochSeconds();
+  for (size_t i = 0; i < n - 2; i++) {
+    epochSeconds[i] = start + i * (acetime_t) (23 * 86400L + 3599);
+  }
+  epochSeconds[n - 2] = start + 100 * (acetime_t) 86400;
+  epochSeconds[n - 1] = LocalDate::kInvalidEpochSeconds;
+
+  TimeOffset offsets[n];
+  tz.getUtcOffsets(epochSeconds, offsets, n);
+  for (size_t i = 0; i < n; i++) {
+    TimeOffset expected = tz.getUtcOffset(epochSeconds[i]);
+    assertEqual(expected.isError(), offsets[i].isError());
+    if (! expected.isError()) {
+      assertEqual(expected.toMinutes(), offsets[i].toMinutes());
+    }
+  }
+}
+
+test(TimeZoneExtendedTest, getUtcOffsets_manual) {
+  TimeZone tz = TimeZone::forTimeOffset(
+      TimeOffset::forHour(-8), TimeOffset::forHour(1));
+  const acetime_t epochSeconds[] = {0, 86400, 2 * 86400};
+  TimeOffset offsets[3];
+  tz.getUtcOffsets(epochSeconds, offsets, 3);
+  for (size_t i = 0; i < 3; i++) {
+    assertEqual(-7*60, offsets[i].toMinutes());
+  }
+}
+
 // --------------------------------------------------------------------------
 
 void setup() {
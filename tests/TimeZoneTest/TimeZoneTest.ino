@@ -18,6 +18,10 @@ test(TimeZoneTest, kType_distinct) {
   assertNotEqual(TimeZone::kTypeError, TimeZone::kTypeExtended);
   assertNotEqual(TimeZone::kTypeError, TimeZone::kTypeBasicManaged);
   assertNotEqual(TimeZone::kTypeError, TimeZone::kTypeExtendedManaged);
+  assertNotEqual(TimeZone::kTypeError, TimeZone::kTypeCompiled);
+  assertNotEqual(TimeZone::kTypeExtendedManaged, TimeZone::kTypeCompiled);
+  assertNotEqual(TimeZone::kTypeError, TimeZone::kTypePosix);
+  assertNotEqual(TimeZone::kTypeCompiled, TimeZone::kTypePosix);
 
   assertNotEqual(TimeZone::kTypeManual, TimeZone::kTypeBasic);
   assertNotEqual(TimeZone::kTypeManual, TimeZone::kTypeExtended);
@@ -336,6 +340,40 @@ test(TimeZoneTest, operatorEqualEqual_directZone) {
   assertTrue(basic != extended);
 }
 
+test(TimeZoneTest, formatTo) {
+  char buf[32];
+
+  TimeZone manual = TimeZone::forTimeOffset(TimeOffset::forHour(-8),
+      TimeOffset::forHour(1));
+  assertEqual((size_t) 12, manual.formatTo(buf, sizeof(buf)));
+  assertEqual("-08:00+01:00", buf);
+  assertEqual((size_t) 3, manual.formatAbbrevTo(buf, sizeof(buf), 0));
+  assertEqual("DST", buf);
+
+  TimeZone basic = TimeZone::forZoneInfo(
+      &zonedb::kZoneAmerica_Los_Angeles, &basicZoneProcessor);
+  basic.formatTo(buf, sizeof(buf));
+  assertEqual("America/Los_Angeles", buf);
+
+  TimeZone extended = extendedZoneManager.createForZoneInfo(
+      &zonedbx::kZoneAmerica_New_York);
+  extended.formatTo(buf, sizeof(buf));
+  assertEqual("America/New_York", buf);
+  acetime_t epochSeconds = LocalDate::forComponents(2018, 7, 1)
+      .toEpochSeconds();
+  extended.formatAbbrevTo(buf, sizeof(buf), epochSeconds);
+  assertEqual("EDT", buf);
+
+  PosixZoneProcessor posixZoneProcessor("PST8PDT,M3.2.0,M11.1.0");
+  TimeZone posix = TimeZone::forPosixZone(&posixZoneProcessor);
+  posix.formatTo(buf, sizeof(buf));
+  assertEqual("PST8PDT,M3.2.0,M11.1.0", buf);
+  assertEqual((size_t) 0, posix.formatTo(buf, 8));
+
+  TimeZone::forError().formatTo(buf, sizeof(buf));
+  assertEqual("<Error>", buf);
+}
+
 // --------------------------------------------------------------------------
 
 void setup() {
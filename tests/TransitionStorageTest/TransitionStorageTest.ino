@@ -211,10 +211,14 @@ test(TransitionStorageTest, findTransition) {
 
   // Add the actives to the Active pool.
   storage.addActiveCandidatesToActivePool();
+  storage.buildSearchKeys();
 
   // Check that we can find the transitions using the startEpochSeconds.
 
-  const Transition* t = storage.findTransition(1);
+  const Transition* t = storage.findTransition(-1);
+  assertTrue(t == nullptr);
+
+  t = storage.findTransition(1);
   assertEqual(0, t->transitionTime.yearTiny);
 
   t = storage.findTransition(9);
@@ -227,6 +231,60 @@ test(TransitionStorageTest, findTransition) {
   assertEqual(2, t->transitionTime.yearTiny);
 }
 
+test(TransitionStorageTest, findTransitionForDateTime) {
+  TransitionStorage<4> storage;
+  storage.init();
+
+  // Add 3 transitions to Candidate pool, in increasing startDateTime.
+  Transition* freeAgent = storage.getFreeAgent();
+  freeAgent->transitionTime = {0, 1, 2, 3, 'w'};
+  freeAgent->active = true;
+  freeAgent->startDateTime = {-1, 12, 31, 96, 'w'};
+  storage.addFreeAgentToCandidatePool();
+
+  freeAgent = storage.getFreeAgent();
+  freeAgent->transitionTime = {1, 2, 3, 4, 'w'};
+  freeAgent->active = true;
+  freeAgent->startDateTime = {0, 3, 10, 8, 'w'};
+  storage.addFreeAgentToCandidatePool();
+
+  freeAgent = storage.getFreeAgent();
+  freeAgent->transitionTime = {2, 3, 4, 5, 'w'};
+  freeAgent->active = true;
+  freeAgent->startDateTime = {0, 11, 3, 8, 'w'};
+  storage.addFreeAgentToCandidatePool();
+
+  // Add the actives to the Active pool.
+  storage.addActiveCandidatesToActivePool();
+  storage.buildSearchKeys();
+
+  // Check that we can find the transitions using the startDateTime.
+
+  const Transition* t = storage.findTransitionForDateTime(
+      LocalDateTime::forComponents(1999, 12, 31, 23, 59, 0));
+  assertTrue(t == nullptr);
+
+  t = storage.findTransitionForDateTime(
+      LocalDateTime::forComponents(2000, 1, 1, 0, 0, 0));
+  assertEqual(0, t->transitionTime.yearTiny);
+
+  t = storage.findTransitionForDateTime(
+      LocalDateTime::forComponents(2000, 3, 10, 1, 59, 0));
+  assertEqual(0, t->transitionTime.yearTiny);
+
+  t = storage.findTransitionForDateTime(
+      LocalDateTime::forComponents(2000, 3, 10, 2, 0, 0));
+  assertEqual(1, t->transitionTime.yearTiny);
+
+  t = storage.findTransitionForDateTime(
+      LocalDateTime::forComponents(2000, 11, 3, 2, 0, 0));
+  assertEqual(2, t->transitionTime.yearTiny);
+
+  t = storage.findTransitionForDateTime(
+      LocalDateTime::forComponents(2001, 1, 1, 0, 0, 0));
+  assertEqual(2, t->transitionTime.yearTiny);
+}
+
 test(TransitionStorageTest, resetCandidatePool) {
   TransitionStorage<4> storage;
   storage.init();
@@ -0,0 +1,110 @@
+#ifndef TZIF_WRITER_H
+#define TZIF_WRITER_H
+
+#include <string.h>
+#include <AceTime.h>
+
+/**
+ * Create a TZif file (RFC 8536) in memory from a list of local time types
+ * and transitions, so that TzifZoneProcessor can be tested without the
+ * zoneinfo files of the operating system. The transitions are given in
+ * AceTime epochSeconds. A version '2' file contains the 32-bit data block,
+ * followed by the 64-bit data block and the footer. A version 0 file
+ * contains only the 32-bit data block.
+ */
+class TzifWriter {
+  public:
+    static const uint8_t kMaxTypes = 8;
+    static const uint8_t kMaxTransitions = 16;
+
+    /** Seconds from the Unix epoch to the AceTime epoch. */
+    static const int64_t kSecondsSinceUnixEpoch = 946684800;
+
+    /** Add a local time type, and return its index. */
+    uint8_t addType(int32_t utcOffsetSeconds, bool isDst, const char* abbrev) {
+      mUtcOffsets[mNumTypes] = utcOffsetSeconds;
+      mIsDsts[mNumTypes] = isDst;
+      mAbbrevIndexes[mNumTypes] = mNumChars;
+      size_t len = strlen(abbrev) + 1;
+      memcpy(mChars + mNumChars, abbrev, len);
+      mNumChars += len;
+      return mNumTypes++;
+    }
+
+    /** Add a transition to the local time type at the given index. */
+    void addTransition(int64_t epochSeconds, uint8_t typeIndex) {
+      mTimes[mNumTransitions] = epochSeconds + kSecondsSinceUnixEpoch;
+      mTypeIndexes[mNumTransitions] = typeIndex;
+      mNumTransitions++;
+    }
+
+    /**
+     * Write the file into the buffer and return its size. The footer is
+     * written only for version '2' and above.
+     */
+    size_t write(uint8_t* buffer, char version, const char* footer = "") {
+      mBuffer = buffer;
+      mSize = 0;
+      writeBlock(version, 4);
+      if (version >= '2') {
+        writeBlock(version, 8);
+        putByte('\n');
+        for (const char* s = footer; *s; s++) putByte(*s);
+        putByte('\n');
+      }
+      return mSize;
+    }
+
+  private:
+    void writeBlock(char version, uint8_t timeSize) {
+      putByte('T');
+      putByte('Z');
+      putByte('i');
+      putByte('f');
+      putByte(version);
+      for (uint8_t i = 0; i < 15; i++) putByte(0);
+      putUint32(mNumTypes); // isutcnt
+      putUint32(mNumTypes); // isstdcnt
+      putUint32(0); // leapcnt
+      putUint32(mNumTransitions); // timecnt
+      putUint32(mNumTypes); // typecnt
+      putUint32(mNumChars); // charcnt
+
+      for (uint8_t i = 0; i < mNumTransitions; i++) {
+        if (timeSize == 8) putUint32((uint32_t) (mTimes[i] >> 32));
+        putUint32((uint32_t) mTimes[i]);
+      }
+      for (uint8_t i = 0; i < mNumTransitions; i++) putByte(mTypeIndexes[i]);
+      for (uint8_t i = 0; i < mNumTypes; i++) {
+        putUint32((uint32_t) mUtcOffsets[i]);
+        putByte(mIsDsts[i]);
+        putByte(mAbbrevIndexes[i]);
+      }
+      for (uint8_t i = 0; i < mNumChars; i++) putByte(mChars[i]);
+      for (uint8_t i = 0; i < 2 * mNumTypes; i++) putByte(0);
+    }
+
+    void putByte(uint8_t b) { mBuffer[mSize++] = b; }
+
+    void putUint32(uint32_t value) {
+      putByte(value >> 24);
+      putByte(value >> 16);
+      putByte(value >> 8);
+      putByte(value);
+    }
+
+    int32_t mUtcOffsets[kMaxTypes];
+    bool mIsDsts[kMaxTypes];
+    uint8_t mAbbrevIndexes[kMaxTypes];
+    uint8_t mNumTypes = 0;
+    char mChars[kMaxTypes * 8];
+    uint8_t mNumChars = 0;
+    int64_t mTimes[kMaxTransitions];
+    uint8_t mTypeIndexes[kMaxTransitions];
+    uint8_t mNumTransitions = 0;
+
+    uint8_t* mBuffer = nullptr;
+    size_t mSize = 0;
+};
+
+#endif
@@ -0,0 +1,316 @@
+#line 2 "TzifZoneProcessorTest.ino"
+
+/*
+ * The tests of the parser use TZif files created in memory by TzifWriter.
+ * The tests which read the zoneinfo files of the operating system are skipped
+ * if the files are missing.
+ */
+
+#include <AUnit.h>
+#include <aunit/fake/FakePrint.h>
+#include <AceTime.h>
+#include "TzifWriter.h"
+
+using namespace aunit;
+using namespace aunit::fake;
+using namespace ace_time;
+
+static const size_t kBufferSize = 2048;
+static uint8_t buffer[kBufferSize];
+
+/** Return the epochSeconds of the given UTC date and time. */
+static acetime_t utcSeconds(int16_t year, uint8_t month, uint8_t day,
+    uint8_t hour, uint8_t minute = 0) {
+  return LocalDateTime::forComponents(year, month, day, hour, minute, 0)
+      .toEpochSeconds();
+}
+
+/** Write America/Los_Angeles for 2018 and 2019, followed by the footer. */
+static size_t writeLosAngeles(char version) {
+  TzifWriter writer;
+  writer.addType(-28378, false, "LMT");
+  uint8_t pdt = writer.addType(-25200, true, "PDT");
+  uint8_t pst = writer.addType(-28800, false, "PST");
+  if (version >= '2') {
+    // 1883-11-18 20:00 UTC, before the range of acetime_t.
+    writer.addTransition(-3664324800LL, pst);
+  }
+  writer.addTransition(utcSeconds(2018, 3, 11, 10), pdt);
+  writer.addTransition(utcSeconds(2018, 11, 4, 9), pst);
+  writer.addTransition(utcSeconds(2019, 3, 10, 10), pdt);
+  writer.addTransition(utcSeconds(2019, 11, 3, 9), pst);
+  return writer.write(buffer, version, "PST8PDT,M3.2.0,M11.1.0");
+}
+
+// --------------------------------------------------------------------------
+// TzifZoneProcessor parser, using files in memory.
+// --------------------------------------------------------------------------
+
+test(TzifZoneProcessorTest, loadBuffer) {
+  TzifZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles);
+  size_t size = writeLosAngeles('2');
+  assertTrue(processor.loadBuffer(buffer, size));
+
+#if ACE_TIME_EPOCH_SECONDS_64
+  // The 1883 transition is within the range of acetime_t, and is kept.
+  assertEqual(6, processor.mTable.getNumEntries());
+#else
+  // The 1883 transition is dropped, and gives the type of the initial entry.
+  assertEqual(5, processor.mTable.getNumEntries());
+#endif
+  assertEqual("PST", processor.mTable.getAbbrev(utcSeconds(2000, 1, 1, 0)));
+  assertFalse(processor.mFooter.isError());
+  assertEqual(utcSeconds(2019, 11, 3, 9), processor.mFooterStartSeconds);
+
+  acetime_t seconds = utcSeconds(2019, 3, 10, 10);
+  assertEqual(-8*60, processor.getUtcOffset(seconds - 1).toMinutes());
+  assertEqual(0, processor.getDeltaOffset(seconds - 1).toMinutes());
+  assertEqual("PST", processor.getAbbrev(seconds - 1));
+  assertEqual(-7*60, processor.getUtcOffset(seconds).toMinutes());
+  assertEqual(60, processor.getDeltaOffset(seconds).toMinutes());
+  assertEqual("PDT", processor.getAbbrev(seconds));
+
+  // In the gap, the LocalDateTime is shifted forward by one hour.
+  auto ldt = LocalDateTime::forComponents(2019, 3, 10, 2, 30, 0);
+  assertTrue(processor.getOffsetDateTime(ldt) == OffsetDateTime::forComponents(
+      2019, 3, 10, 3, 30, 0, TimeOffset::forHour(-7)));
+
+  // In the overlap, the later offset is used, like ExtendedZoneProcessor.
+  ldt = LocalDateTime::forComponents(2019, 11, 3, 1, 30, 0);
+  assertTrue(processor.getOffsetDateTime(ldt) == OffsetDateTime::forComponents(
+      2019, 11, 3, 1, 30, 0, TimeOffset::forHour(-8)));
+}
+
+test(TzifZoneProcessorTest, loadBuffer_v1) {
+  TzifZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles);
+  size_t size = writeLosAngeles('\0');
+  assertTrue(processor.loadBuffer(buffer, size));
+
+  // The initial entry uses the first type, and there is no footer, so the
+  // last transition remains in effect.
+  assertEqual(5, processor.mTable.getNumEntries());
+  assertEqual("LMT", processor.mTable.getAbbrev(utcSeconds(2000, 1, 1, 0)));
+  assertTrue(processor.mFooter.isError());
+  assertEqual(-7*60,
+      processor.getUtcOffset(utcSeconds(2019, 7, 1, 0)).toMinutes());
+  assertEqual(-8*60,
+      processor.getUtcOffset(utcSeconds(2020, 7, 1, 0)).toMinutes());
+}
+
+test(TzifZoneProcessorTest, loadBuffer_invalid) {
+  TzifZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles);
+  assertFalse(processor.loadBuffer(nullptr, 0));
+
+  size_t size = writeLosAngeles('2');
+  buffer[0] = 'X';
+  assertFalse(processor.loadBuffer(buffer, size));
+  assertTrue(processor.mTable.isError());
+
+  // Invalid footer.
+  TzifWriter writer;
+  uint8_t pst = writer.addType(-28800, false, "PST");
+  writer.addTransition(utcSeconds(2018, 11, 4, 9), pst);
+  size = writer.write(buffer, '2', "PST8PDT,M3");
+  assertFalse(processor.loadBuffer(buffer, size));
+
+  // Transitions out of order.
+  uint8_t pdt = writer.addType(-25200, true, "PDT");
+  writer.addTransition(utcSeconds(2018, 3, 11, 10), pdt);
+  size = writer.write(buffer, '2', "PST8PDT,M3.2.0,M11.1.0");
+  assertFalse(processor.loadBuffer(buffer, size));
+
+  // Index of a local time type out of range.
+  TzifWriter writer2;
+  writer2.addType(-28800, false, "PST");
+  writer2.addTransition(utcSeconds(2018, 11, 4, 9), 1);
+  size = writer2.write(buffer, '2', "PST8");
+  assertFalse(processor.loadBuffer(buffer, size));
+}
+
+test(TzifZoneProcessorTest, loadBuffer_truncated) {
+  TzifZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles);
+  size_t size = writeLosAngeles('2');
+  for (size_t i = 0; i < size; i++) {
+    assertFalse(processor.loadBuffer(buffer, i));
+  }
+  assertTrue(processor.loadBuffer(buffer, size));
+}
+
+test(TzifZoneProcessorTest, footer) {
+  TzifZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles);
+  size_t size = writeLosAngeles('2');
+  assertTrue(processor.loadBuffer(buffer, size));
+
+  // 2020 and 2050 are calculated from the footer.
+  acetime_t seconds = utcSeconds(2020, 3, 8, 10);
+  assertEqual(-8*60, processor.getUtcOffset(seconds - 1).toMinutes());
+  assertEqual(-7*60, processor.getUtcOffset(seconds).toMinutes());
+  assertEqual("PDT", processor.getAbbrev(seconds));
+  assertEqual(2020, processor.mFooterYear);
+  seconds = utcSeconds(2050, 11, 6, 9);
+  assertEqual(-7*60, processor.getUtcOffset(seconds - 1).toMinutes());
+  assertEqual(-8*60, processor.getUtcOffset(seconds).toMinutes());
+  assertEqual("PST", processor.getAbbrev(seconds));
+  auto ldt = LocalDateTime::forComponents(2050, 3, 13, 2, 30, 0);
+  assertTrue(processor.getOffsetDateTime(ldt) == OffsetDateTime::forComponents(
+      2050, 3, 13, 3, 30, 0, TimeOffset::forHour(-7)));
+
+  // America/Godthab stopped DST at its last transition in March 2023, so
+  // the DST of the footer starts only in 2024.
+  TzifWriter writer;
+  uint8_t minus3 = writer.addType(-10800, false, "-03");
+  uint8_t minus2Dst = writer.addType(-7200, true, "-02");
+  uint8_t minus2 = writer.addType(-7200, false, "-02");
+  writer.addTransition(utcSeconds(2022, 3, 26, 1), minus2Dst);
+  writer.addTransition(utcSeconds(2022, 10, 29, 1), minus3);
+  writer.addTransition(utcSeconds(2023, 3, 26, 1), minus2);
+  size = writer.write(buffer, '2', "<-02>2<-01>,M3.5.0/-1,M10.5.0/0");
+  assertTrue(processor.loadBuffer(buffer, size));
+
+  seconds = utcSeconds(2023, 3, 26, 1);
+  assertEqual(-3*60, processor.getUtcOffset(seconds - 1).toMinutes());
+  assertEqual(-2*60, processor.getUtcOffset(seconds).toMinutes());
+  assertEqual(0, processor.getDeltaOffset(seconds).toMinutes());
+  assertEqual(-2*60,
+      processor.getUtcOffset(utcSeconds(2023, 7, 1, 0)).toMinutes());
+  assertEqual(0,
+      processor.getDeltaOffset(utcSeconds(2023, 7, 1, 0)).toMinutes());
+  seconds = utcSeconds(2024, 3, 31, 1);
+  assertEqual(-2*60, processor.getUtcOffset(seconds - 1).toMinutes());
+  assertEqual(-1*60, processor.getUtcOffset(seconds).toMinutes());
+  assertEqual("-01", processor.getAbbrev(seconds));
+
+  // Australia/Sydney, in the southern hemisphere, is in DST at the start of
+  // the year.
+  TzifWriter writer2;
+  uint8_t aedt = writer2.addType(39600, true, "AEDT");
+  uint8_t aest = writer2.addType(36000, false, "AEST");
+  writer2.addTransition(utcSeconds(2018, 4, 1, 6), aest);
+  writer2.addTransition(utcSeconds(2018, 10, 6, 16), aedt);
+  size = writer2.write(buffer, '2', "AEST-10AEDT,M10.1.0,M4.1.0/3");
+  assertTrue(processor.loadBuffer(buffer, size));
+  assertEqual(11*60,
+      processor.getUtcOffset(utcSeconds(2021, 1, 15, 0)).toMinutes());
+  assertEqual("AEDT", processor.getAbbrev(utcSeconds(2021, 1, 15, 0)));
+  assertEqual(10*60,
+      processor.getUtcOffset(utcSeconds(2021, 7, 1, 0)).toMinutes());
+  assertEqual("AEST", processor.getAbbrev(utcSeconds(2021, 7, 1, 0)));
+}
+
+test(TzifZoneProcessorTest, footer_only) {
+  TzifZoneProcessor processor(&zonedbx::kZoneAmerica_New_York);
+  TzifWriter writer;
+  writer.addType(-18000, false, "EST");
+  size_t size = writer.write(buffer, '2', "EST5EDT,M3.2.0,M11.1.0");
+  assertTrue(processor.loadBuffer(buffer, size));
+  assertEqual(1, processor.mTable.getNumEntries());
+
+  // Without transitions, the footer applies to all years.
+  assertEqual(-4*60,
+      processor.getUtcOffset(utcSeconds(1990, 7, 1, 0)).toMinutes());
+  assertEqual("EDT", processor.getAbbrev(utcSeconds(1990, 7, 1, 0)));
+  assertEqual(-5*60,
+      processor.getUtcOffset(utcSeconds(2030, 1, 1, 0)).toMinutes());
+  assertEqual("EST", processor.getAbbrev(utcSeconds(2030, 1, 1, 0)));
+
+  auto ldt = LocalDateTime::forComponents(2030, 11, 3, 1, 30, 0);
+  ResolvedDateTime resolved = processor.resolveLocalDateTime(
+      ldt, ResolvedDateTime::kPolicyLater);
+  assertEqual(ResolvedDateTime::kTypeOverlap, resolved.type);
+  assertTrue(resolved.odt == OffsetDateTime::forComponents(
+      2030, 11, 3, 1, 30, 0, TimeOffset::forHour(-5)));
+}
+
+// --------------------------------------------------------------------------
+// TzifZoneProcessor, using the zoneinfo files of the operating system.
+// --------------------------------------------------------------------------
+
+test(TzifZoneProcessorTest, missingFile) {
+  TzifZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles,
+      "/nonexistent/zoneinfo");
+  assertFalse(processor.isLoaded());
+  assertEqual(0, processor.getNumTransitions());
+  assertTrue(processor.getUtcOffset(0).isError());
+  assertEqual("", processor.getAbbrev(0));
+  assertTrue(processor.getOffsetDateTime(
+      LocalDateTime::forComponents(2019, 1, 1, 0, 0, 0)).isError());
+
+  TzifZoneProcessor nullProcessor;
+  assertFalse(nullProcessor.isLoaded());
+}
+
+// Verify that the system files agree with ExtendedZoneProcessor for a few
+// zones whose rules did not change after the TZ Database of zonedbx.
+test(TzifZoneProcessorTest, compareWithExtended) {
+  const extended::ZoneInfo* const zoneInfos[] = {
+    &zonedbx::kZoneAmerica_Los_Angeles,
+    &zonedbx::kZoneAmerica_New_York,
+    &zonedbx::kZoneEurope_London,
+    &zonedbx::kZoneAustralia_Sydney,
+    &zonedbx::kZoneAsia_Kolkata,
+  };
+  acetime_t start = LocalDate::forComponents(2000, 1, 1).toEpochSeconds();
+  acetime_t until = LocalDate::forComponents(2019, 1, 1).toEpochSeconds();
+
+  for (const extended::ZoneInfo* zoneInfo : zoneInfos) {
+    TzifZoneProcessor processor(zoneInfo);
+    if (! processor.isLoaded()) skipTestNow();
+    ExtendedZoneProcessor extendedProcessor(zoneInfo);
+
+    for (acetime_t seconds = start; seconds < until; seconds += 3600) {
+      assertEqual(extendedProcessor.getUtcOffset(seconds).toMinutes(),
+          processor.getUtcOffset(seconds).toMinutes());
+      assertEqual(extendedProcessor.getDeltaOffset(seconds).toMinutes(),
+          processor.getDeltaOffset(seconds).toMinutes());
+      assertEqual(extendedProcessor.getAbbrev(seconds),
+          processor.getAbbrev(seconds));
+
+      auto ldt = LocalDateTime::forEpochSeconds(seconds);
+      assertTrue(extendedProcessor.getOffsetDateTime(ldt)
+          == processor.getOffsetDateTime(ldt));
+    }
+  }
+}
+
+test(TzifZoneProcessorTest, TimeZone) {
+  TzifZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles);
+  TimeZone tz = TimeZone::forZoneInfo(&zonedbx::kZoneAmerica_Los_Angeles,
+      &processor);
+  assertEqual(TimeZone::kTypeExtended, tz.getType());
+  assertEqual(zonedbx::kZoneAmerica_Los_Angeles.zoneId, tz.getZoneId());
+  if (! processor.isLoaded()) skipTestNow();
+
+  ZonedDateTime dt = ZonedDateTime::forComponents(2019, 7, 4, 12, 0, 0, tz);
+  assertEqual(-7*60, dt.timeOffset().toMinutes());
+}
+
+test(TzifZoneProcessorTest, TzifZoneManager) {
+  TzifZoneManager<2> manager(zonedbx::kZoneRegistrySize,
+      zonedbx::kZoneRegistry);
+  TimeZone tz = manager.createForZoneName("America/New_York");
+  assertEqual(TimeZone::kTypeExtendedManaged, tz.getType());
+  assertEqual(zonedbx::kZoneAmerica_New_York.zoneId, tz.getZoneId());
+
+  FakePrint fakePrint;
+  tz.printTo(fakePrint);
+  assertEqual(F("America/New_York"), fakePrint.getBuffer());
+
+  TzifZoneProcessor processor(&zonedbx::kZoneAmerica_New_York);
+  if (! processor.isLoaded()) skipTestNow();
+  ZonedDateTime dt = ZonedDateTime::forComponents(2019, 7, 4, 12, 0, 0, tz);
+  assertEqual(-4*60, dt.timeOffset().toMinutes());
+}
+
+// --------------------------------------------------------------------------
+
+void setup() {
+#if defined(ARDUINO)
+  delay(1000); // wait for stability on some boards to prevent garbage SERIAL_PORT_MONITOR
+#endif
+  SERIAL_PORT_MONITOR.begin(115200); // ESP8266 default of 74880 not supported on Linux
+  while(!SERIAL_PORT_MONITOR); // for the Arduino Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
@@ -54,6 +54,74 @@ test(ExtendedZoneProcessorCacheTest, getZoneProcessor) {
   assertEqual((intptr_t) zoneProcessor1, (intptr_t) zoneProcessor4);
 }
 
+// --------------------------------------------------------------------------
+// ExtendedZoneProcessorCache with kEvictionLru
+// --------------------------------------------------------------------------
+
+test(ExtendedZoneProcessorCacheLruTest, getZoneProcessor) {
+  ExtendedZoneProcessorCache<2, ZoneProcessorCache::kEvictionLru> cache;
+
+  ZoneProcessor* zoneProcessor1 = cache.getZoneProcessor(
+      &zonedbx::kZoneAmerica_Los_Angeles);
+
+  ZoneProcessor* zoneProcessor2 = cache.getZoneProcessor(
+      &zonedbx::kZoneAmerica_New_York);
+  assertNotEqual((intptr_t) zoneProcessor1, (intptr_t) zoneProcessor2);
+
+  // Los_Angeles becomes the most recently used.
+  ZoneProcessor* zoneProcessor3 = cache.getZoneProcessor(
+      &zonedbx::kZoneAmerica_Los_Angeles);
+  assertEqual((intptr_t) zoneProcessor1, (intptr_t) zoneProcessor3);
+
+  // The 3rd unique ZoneInfo evicts New_York, not Los_Angeles.
+  ZoneProcessor* zoneProcessor4 = cache.getZoneProcessor(
+      &zonedbx::kZoneAmerica_Denver);
+  assertEqual((intptr_t) zoneProcessor2, (intptr_t) zoneProcessor4);
+  assertTrue(zoneProcessor1->getZoneInfo() ==
+      &zonedbx::kZoneAmerica_Los_Angeles);
+}
+
+// Compare the cache against a simple LRU model, over an access pattern where
+// a hot zone is interleaved with a long tail of other zones, which exercises
+// the removal of entries from the hash table.
+test(ExtendedZoneProcessorCacheLruTest, sameAsLruModel) {
+  const uint8_t kSize = 4;
+  ExtendedZoneProcessorCache<kSize, ZoneProcessorCache::kEvictionLru> cache;
+  ExtendedZoneRegistrar zoneRegistrar(
+      zonedbx::kZoneRegistrySize, zonedbx::kZoneRegistry);
+  const void* model[kSize] = {}; // most recently used first
+
+  for (uint16_t n = 0; n < 500; n++) {
+    uint16_t index = (n % 3 == 0) ? 0 : (n * 7) % 20;
+    const void* zoneInfo = zoneRegistrar.getZoneInfoForIndex(index);
+
+    // Update the model.
+    uint8_t i = 0;
+    while (i < kSize - 1 && model[i] != zoneInfo) i++;
+    bool isHit = (model[i] == zoneInfo);
+    for (; i > 0; i--) model[i] = model[i - 1];
+    model[0] = zoneInfo;
+
+    // Count the cached zones before the lookup.
+    uint8_t numCached = 0;
+    for (uint8_t j = 0; j < kSize; j++) {
+      if (model[j] != nullptr) numCached++;
+    }
+
+    ZoneProcessor* zoneProcessor = cache.getZoneProcessor(zoneInfo);
+    assertTrue(zoneProcessor->getZoneInfo() == zoneInfo);
+    if (isHit) {
+      assertTrue(zoneProcessor == cache.getZoneProcessor(zoneInfo));
+    }
+
+    // Every zone in the model must still be in the cache.
+    for (uint8_t j = 0; j < numCached; j++) {
+      assertTrue(cache.getZoneProcessor(model[numCached - 1 - j])
+          ->getZoneInfo() == model[numCached - 1 - j]);
+    }
+  }
+}
+
 // --------------------------------------------------------------------------
 
 void setup() {
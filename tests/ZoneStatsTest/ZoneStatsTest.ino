@@ -0,0 +1,150 @@
+#line 2 "ZoneStatsTest.ino"
+
+#include <AUnit.h>
+#include <AceTime.h>
+
+using namespace aunit;
+using namespace ace_time;
+
+// The stats are collected only if the entire library is compiled with
+// ACE_TIME_ZONE_STATS=1, which the Makefile does on Linux and MacOS.
+
+// --------------------------------------------------------------------------
+
+test(ZoneStatsTest, timingStatsMerge) {
+  using common::TimingStats;
+  TimingStats empty;
+  TimingStats a;
+  a.update(100); // exp decay avg 50
+  a.update(100); // exp decay avg 75
+  TimingStats b;
+  b.update(200); // exp decay avg 100
+
+  // An empty TimingStats does not change the exp decay average.
+  TimingStats merged;
+  merged.merge(empty);
+  merged.merge(a);
+  merged.merge(empty);
+  assertEqual(75, merged.getExpDecayAvg());
+  assertEqual(2, merged.getCount());
+  assertEqual(100, merged.getMin());
+  assertEqual(100, merged.getMax());
+
+  // Weighted by count, independent of the order of the merges.
+  merged.merge(b);
+  assertEqual(83, merged.getExpDecayAvg());
+  assertEqual(3, merged.getCount());
+  assertEqual(100, merged.getMin());
+  assertEqual(200, merged.getMax());
+  assertEqual(133, merged.getAvg());
+
+  b.merge(a);
+  assertEqual(83, b.getExpDecayAvg());
+}
+
+#if ACE_TIME_ZONE_STATS
+
+test(ZoneStatsTest, extendedZoneProcessor) {
+  ExtendedZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles);
+  acetime_t seconds2018 = LocalDateTime::forComponents(2018, 6, 1, 0, 0, 0)
+      .toEpochSeconds();
+  acetime_t seconds2019 = LocalDateTime::forComponents(2019, 6, 1, 0, 0, 0)
+      .toEpochSeconds();
+
+  processor.getUtcOffset(seconds2018); // miss
+  processor.getUtcOffset(seconds2018); // hit
+  processor.getUtcOffset(seconds2019); // miss
+  processor.getUtcOffset(seconds2019); // hit
+  processor.getUtcOffset(seconds2019); // hit
+
+  ZoneProcessorStats stats = processor.getStats();
+  assertEqual((uint32_t) 3, stats.hits);
+  assertEqual((uint32_t) 2, stats.misses);
+  assertEqual(2, stats.rebuildMicros.getCount());
+
+  // Merging into empty stats, as the ZoneProcessorCache does, preserves the
+  // exp decay average.
+  ZoneProcessorStats merged;
+  merged.merge(stats);
+  merged.merge(ZoneProcessorStats());
+  assertEqual(stats.rebuildMicros.getExpDecayAvg(),
+      merged.rebuildMicros.getExpDecayAvg());
+
+  processor.resetStats();
+  stats = processor.getStats();
+  assertEqual((uint32_t) 0, stats.hits);
+  assertEqual((uint32_t) 0, stats.misses);
+  assertEqual(0, stats.rebuildMicros.getCount());
+}
+
+test(ZoneStatsTest, basicZoneProcessor) {
+  BasicZoneProcessor processor(&zonedb::kZoneAmerica_Los_Angeles);
+  acetime_t seconds = LocalDateTime::forComponents(2018, 6, 1, 0, 0, 0)
+      .toEpochSeconds();
+
+  processor.getUtcOffset(seconds); // miss
+  processor.getUtcOffset(seconds); // hit
+
+  ZoneProcessorStats stats = processor.getStats();
+  assertEqual((uint32_t) 1, stats.hits);
+  assertEqual((uint32_t) 1, stats.misses);
+  assertEqual(1, stats.rebuildMicros.getCount());
+}
+
+test(ZoneStatsTest, zoneManager) {
+  ExtendedZoneManager<2> manager(
+      zonedbx::kZoneRegistrySize, zonedbx::kZoneRegistry);
+  acetime_t seconds = LocalDateTime::forComponents(2018, 6, 1, 0, 0, 0)
+      .toEpochSeconds();
+
+  TimeZone losAngeles = manager.createForZoneInfo(
+      &zonedbx::kZoneAmerica_Los_Angeles);
+  TimeZone newYork = manager.createForZoneInfo(&zonedbx::kZoneAmerica_New_York);
+  TimeZone denver = manager.createForZoneInfo(&zonedbx::kZoneAmerica_Denver);
+
+  losAngeles.getUtcOffset(seconds); // cache miss, processor miss
+  losAngeles.getUtcOffset(seconds); // cache hit, processor hit
+  newYork.getUtcOffset(seconds); // cache miss, processor miss
+  denver.getUtcOffset(seconds); // cache miss and eviction, processor miss
+
+  ZoneProcessorCacheStats stats = manager.getStats();
+  assertEqual((uint32_t) 1, stats.hits);
+  assertEqual((uint32_t) 3, stats.misses);
+  assertEqual((uint32_t) 1, stats.evictions);
+  assertEqual((uint32_t) 1, stats.processors.hits);
+  assertEqual((uint32_t) 3, stats.processors.misses);
+  assertEqual(3, stats.processors.rebuildMicros.getCount());
+
+  manager.resetStats();
+  stats = manager.getStats();
+  assertEqual((uint32_t) 0, stats.hits);
+  assertEqual((uint32_t) 0, stats.misses);
+  assertEqual((uint32_t) 0, stats.evictions);
+  assertEqual((uint32_t) 0, stats.processors.misses);
+}
+
+#else
+
+test(ZoneStatsTest, disabled) {
+  ExtendedZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles);
+  processor.getUtcOffset(0);
+  ZoneProcessorStats stats = processor.getStats();
+  assertEqual((uint32_t) 0, stats.hits);
+  assertEqual((uint32_t) 0, stats.misses);
+}
+
+#endif
+
+// --------------------------------------------------------------------------
+
+void setup() {
+#if defined(ARDUINO)
+  delay(1000); // wait for stability on some boards to prevent garbage SERIAL_PORT_MONITOR
+#endif
+  SERIAL_PORT_MONITOR.begin(115200); // ESP8266 default of 74880 not supported on Linux
+  while(!SERIAL_PORT_MONITOR); // for the Arduino Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
@@ -0,0 +1,171 @@
+#line 2 "ZoneTransitionIteratorTest.ino"
+
+#include <AUnit.h>
+#include <AceTime.h>
+
+using namespace aunit;
+using namespace ace_time;
+
+/** Return the epochSeconds of the given UTC date and time. */
+static acetime_t utcSeconds(int16_t year, uint8_t month, uint8_t day,
+    uint8_t hour, uint8_t minute = 0) {
+  return LocalDateTime::forComponents(year, month, day, hour, minute, 0)
+      .toEpochSeconds();
+}
+
+// --------------------------------------------------------------------------
+
+test(ZoneTransitionIteratorTest, next) {
+  ExtendedZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles);
+  ZoneTransitionIterator iter(processor, utcSeconds(2018, 6, 1, 0));
+  ZoneTransition transition;
+
+  assertTrue(iter.next(transition));
+  assertEqual(utcSeconds(2018, 11, 4, 9), transition.epochSeconds);
+  assertEqual(-7*60, transition.offsetBefore.toMinutes());
+  assertEqual(-8*60, transition.offsetAfter.toMinutes());
+  assertEqual("PST", transition.abbrev);
+
+  // Across the year boundary.
+  assertTrue(iter.next(transition));
+  assertEqual(utcSeconds(2019, 3, 10, 10), transition.epochSeconds);
+  assertEqual(-8*60, transition.offsetBefore.toMinutes());
+  assertEqual(-7*60, transition.offsetAfter.toMinutes());
+  assertEqual("PDT", transition.abbrev);
+  assertEqual(utcSeconds(2019, 3, 10, 10) + 1, iter.getCursor());
+
+  // A transition exactly at the cursor is returned by next().
+  iter.setCursor(utcSeconds(2019, 11, 3, 9));
+  assertTrue(iter.next(transition));
+  assertEqual(utcSeconds(2019, 11, 3, 9), transition.epochSeconds);
+
+  // The iteration ends at the end of the ZoneContext.
+  iter.setCursor(utcSeconds(2049, 11, 7, 9) + 1);
+  assertFalse(iter.next(transition));
+  assertEqual(utcSeconds(2049, 11, 7, 9) + 1, iter.getCursor());
+}
+
+test(ZoneTransitionIteratorTest, prev) {
+  ExtendedZoneProcessor processor(&zonedbx::kZoneAmerica_Los_Angeles);
+  ZoneTransitionIterator iter(processor, utcSeconds(2019, 3, 10, 10));
+  ZoneTransition transition;
+
+  // A transition exactly at the cursor is not returned by prev().
+  assertTrue(iter.prev(transition));
+  assertEqual(utcSeconds(2018, 11, 4, 9), transition.epochSeconds);
+  assertEqual(-7*60, transition.offsetBefore.toMinutes());
+  assertEqual(-8*60, transition.offsetAfter.toMinutes());
+  assertEqual(utcSeconds(2018, 11, 4, 9), iter.getCursor());
+
+  // next() after prev() returns the same transition.
+  ZoneTransition same;
+  assertTrue(iter.next(same));
+  assertEqual(transition.epochSeconds, same.epochSeconds);
+
+  // The iteration ends at the start of the ZoneContext.
+  iter.setCursor(utcSeconds(2000, 6, 1, 0));
+  assertTrue(iter.prev(transition));
+  assertEqual(utcSeconds(2000, 4, 2, 10), transition.epochSeconds);
+  assertFalse(iter.prev(transition));
+}
+
+test(ZoneTransitionIteratorTest, noTransitions) {
+  // Asia/Kolkata has no transitions in the range of the ZoneContext.
+  ExtendedZoneProcessor processor(&zonedbx::kZoneAsia_Kolkata);
+  ZoneTransitionIterator iter(processor, utcSeconds(2000, 1, 1, 0));
+  ZoneTransition transition;
+  assertFalse(iter.next(transition));
+  assertFalse(iter.prev(transition));
+
+  ExtendedZoneProcessor nullProcessor;
+  ZoneTransitionIterator nullIter(nullProcessor, 0);
+  assertFalse(nullIter.next(transition));
+  assertFalse(nullIter.prev(transition));
+}
+
+// Compare with a scan of getUtcOffset() every hour, which finds the
+// same transitions because they are all at least 1 hour apart.
+test(ZoneTransitionIteratorTest, compareWithScan) {
+  const extended::ZoneInfo* const zoneInfos[] = {
+    &zonedbx::kZoneAmerica_Los_Angeles,
+    &zonedbx::kZoneAustralia_Sydney,
+    &zonedbx::kZoneEurope_Moscow,
+    &zonedbx::kZoneAmerica_Sao_Paulo,
+  };
+  acetime_t start = utcSeconds(2000, 1, 1, 0);
+  acetime_t until = utcSeconds(2050, 1, 1, 0);
+
+  for (const extended::ZoneInfo* zoneInfo : zoneInfos) {
+    ExtendedZoneProcessor expected(zoneInfo);
+    ExtendedZoneProcessor processor(zoneInfo);
+    ZoneTransitionIterator iter(processor, start);
+    ZoneTransition transition;
+    bool hasNext = iter.next(transition);
+
+    TimeOffset offset = expected.getUtcOffset(start);
+    for (acetime_t seconds = start + 3600; seconds < until; seconds += 3600) {
+      TimeOffset nextOffset = expected.getUtcOffset(seconds);
+      if (nextOffset == offset) continue;
+
+      assertTrue(hasNext);
+      assertLess(seconds - 3600, transition.epochSeconds);
+      assertTrue(transition.epochSeconds <= seconds);
+      assertTrue(transition.offsetBefore == offset);
+      assertTrue(transition.offsetAfter == nextOffset);
+      assertEqual(expected.getAbbrev(transition.epochSeconds),
+          transition.abbrev);
+      hasNext = iter.next(transition);
+      offset = nextOffset;
+    }
+    assertTrue(! hasNext || transition.epochSeconds >= until);
+  }
+}
+
+// Iterating backward returns the same transitions as iterating forward, for
+// every zone.
+test(ZoneTransitionIteratorTest, forwardAndBackward_allZones) {
+  ExtendedZoneRegistrar registrar(
+      zonedbx::kZoneRegistrySize, zonedbx::kZoneRegistry);
+  const uint16_t kMaxTransitions = 128;
+  acetime_t forward[kMaxTransitions];
+
+  for (uint16_t i = 0; i < registrar.registrySize(); i++) {
+    ExtendedZoneProcessor processor(registrar.getZoneInfoForIndex(i));
+    ZoneTransitionIterator iter(processor, utcSeconds(1990, 1, 1, 0));
+    ZoneTransition transition;
+    uint16_t n = 0;
+    TimeOffset offset = TimeOffset::forError();
+    while (iter.next(transition)) {
+      assertLess(n, kMaxTransitions);
+      if (! offset.isError()) {
+        assertTrue(transition.offsetBefore == offset);
+      }
+      offset = transition.offsetAfter;
+      assertTrue(processor.getUtcOffset(transition.epochSeconds)
+          == transition.offsetAfter);
+      assertTrue(processor.getUtcOffset(transition.epochSeconds - 1)
+          == transition.offsetBefore);
+      forward[n++] = transition.epochSeconds;
+    }
+
+    while (iter.prev(transition)) {
+      assertLess((uint16_t) 0, n);
+      assertEqual(forward[--n], transition.epochSeconds);
+    }
+    assertEqual((uint16_t) 0, n);
+  }
+}
+
+// --------------------------------------------------------------------------
+
+void setup() {
+#if defined(ARDUINO)
+  delay(1000); // wait for stability on some boards to prevent garbage SERIAL_PORT_MONITOR
+#endif
+  SERIAL_PORT_MONITOR.begin(115200); // ESP8266 default of 74880 not supported on Linux
+  while(!SERIAL_PORT_MONITOR); // for the Arduino Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
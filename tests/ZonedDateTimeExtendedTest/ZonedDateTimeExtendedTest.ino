@@ -108,6 +108,28 @@ test(ZonedDateTimeExtendedTest, forComponents_afterOverlap) {
   assertTrue(expected == dt.localDateTime());
 }
 
+test(ZonedDateTimeExtendedTest, forEpochSeconds_batch) {
+  TimeZone tz = extendedZoneManager.createForZoneInfo(
+      &zonedbx::kZoneAmerica_Los_Angeles);
+
+  // More than one internal batch, crossing the 2018 DST transitions and the
+  // 2018/2019 year boundary.
+  const size_t n = 40;
+  acetime_t epochSeconds[n];
+  acetime_t start = LocalDateTime::forComponents(2018, 3, 1, 0, 0, 0)
+      .toEpochSeconds();
+  for (size_t i = 0; i < n; i++) {
+    epochSeconds[i] = start + i * (acetime_t) (9 * 86400L + 1800);
+  }
+
+  ZonedDateTime zdts[n];
+  ZonedDateTime::forEpochSeconds(epochSeconds, tz, zdts, n);
+  for (size_t i = 0; i < n; i++) {
+    auto expected = ZonedDateTime::forEpochSeconds(epochSeconds[i], tz);
+    assertTrue(expected == zdts[i]);
+  }
+}
+
 // Test the linked zones are same as the target zones.
 test(ZonedDateTimeExtendedTest, linked_zones) {
   assertEqual((intptr_t) &zonedbx::kZoneAmerica_Los_Angeles,
@@ -0,0 +1,80 @@
+#ifndef VALIDATION_TEST_TZIF_TRANSITION_TEST_H
+#define VALIDATION_TEST_TZIF_TRANSITION_TEST_H
+
+#include <AUnit.h>
+#include "ValidationDataType.h"
+#include "ace_time/common/logging.h"
+
+#define DEBUG 0
+
+class TransitionTest: public aunit::TestOnce {
+  protected:
+    void assertValid(const ValidationData* testData) {
+      if (DEBUG) {
+        enableVerbosity(aunit::Verbosity::kAssertionPassed);
+      }
+      assertTrue(true);
+
+      const extended::ZoneInfo* zoneInfo = testData->zoneInfo;
+      TzifZoneProcessor zoneProcessor(zoneInfo);
+      assertTrue(zoneProcessor.isLoaded());
+      TimeZone tz = TimeZone::forZoneInfo(zoneInfo, &zoneProcessor);
+
+      // The same zone calculated from the zonedbx:: ZoneRules.
+      ExtendedZoneProcessor extendedProcessor;
+      TimeZone extendedTz = TimeZone::forZoneInfo(zoneInfo,
+          &extendedProcessor);
+
+      // Assert that each epoch_second produces the expected yMdhms
+      // components when converted through ZonedDataTime class.
+      for (uint16_t i = 0; i < testData->numItems; i++) {
+        const ValidationItem& item = testData->items[i];
+        acetime_t epochSeconds = item.epochSeconds;
+        if (DEBUG) {
+          ace_time::logging::println("==== test index: %d", i);
+          if (sizeof(acetime_t) == sizeof(int)) {
+            ace_time::logging::print("epochSeconds: %d", epochSeconds);
+          } else {
+            ace_time::logging::print("epochSeconds: %ld", epochSeconds);
+          }
+          ace_time::logging::println("; %d-%d-%dT%d:%d:%d",
+            item.year,
+            item.month,
+            item.day,
+            item.hour,
+            item.minute,
+            item.second);
+        }
+
+        TimeOffset timeOffset = tz.getUtcOffset(epochSeconds);
+
+        // Verify timeOffset, against the validation data and the
+        // ExtendedZoneProcessor.
+        assertEqual(item.timeOffsetMinutes, timeOffset.toMinutes());
+        assertEqual(extendedTz.getUtcOffset(epochSeconds).toMinutes(),
+            timeOffset.toMinutes());
+
+        // Verify date components
+        ZonedDateTime dt = ZonedDateTime::forEpochSeconds(epochSeconds, tz);
+        assertEqual(item.year, dt.year());
+        assertEqual(item.month, dt.month());
+        assertEqual(item.day, dt.day());
+        assertEqual(item.hour, dt.hour());
+        assertEqual(item.minute, dt.minute());
+        assertEqual(item.second, dt.second());
+
+        // Verify the reverse conversion from the date components.
+        ZonedDateTime extendedDt = ZonedDateTime::forComponents(
+            item.year, item.month, item.day, item.hour, item.minute,
+            item.second, extendedTz);
+        ZonedDateTime tzifDt = ZonedDateTime::forComponents(
+            item.year, item.month, item.day, item.hour, item.minute,
+            item.second, tz);
+        assertEqual(extendedDt.toEpochSeconds(), tzifDt.toEpochSeconds());
+      }
+    }
+};
+
+#undef DEBUG
+
+#endif
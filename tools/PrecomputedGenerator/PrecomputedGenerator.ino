@@ -0,0 +1,249 @@
+/*
+ * Generate the precomputed.h and precomputed.cpp files which define a
+ * PrecomputedZone for each zone name read from the stdin, one name per line
+ * (e.g. "America/Los_Angeles"). The tables are compiled by a CompiledZone from
+ * the extended::ZoneInfo of the zonedbx:: database which is linked into this
+ * program, so the output contains exactly the same entries that
+ * FlatZoneProcessor would build at run time.
+ *
+ * Runs only on Linux or MacOS using UnixHostDuino:
+ *
+ *  $ cd $ACE_TIME/tools/PrecomputedGenerator
+ *  $ make
+ *  $ cd $ACE_TIME/src/ace_time/zonedbx
+ *  $ ../../../tools/PrecomputedGenerator/PrecomputedGenerator.out \
+ *      < precomputed_zones.txt
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <AceTime.h>
+
+using namespace ace_time;
+
+/** Maximum number of zones read from the stdin. */
+static const uint16_t kMaxZones = 64;
+
+/** Maximum length of a zone name, including the NUL terminator. */
+static const uint8_t kMaxNameSize = 64;
+
+/** Maximum length of a normalized C++ identifier. */
+static const uint8_t kMaxIdSize = 96;
+
+static const char kHeaderFile[] = "precomputed.h";
+static const char kSourceFile[] = "precomputed.cpp";
+
+static char zoneNames[kMaxZones][kMaxNameSize];
+static uint16_t numZones = 0;
+
+/** Static to avoid placing a large object on the stack. */
+static CompiledZone compiledZone;
+
+/**
+ * Convert the zone name into the suffix of the identifier used by the
+ * zonedbx:: files, e.g. "America/Port-au-Prince" becomes
+ * "America_Port_au_Prince" and "Etc/GMT+1" becomes "Etc_GMT_PLUS_1".
+ */
+static void normalizeName(const char* name, char* id) {
+  char* end = id + kMaxIdSize - 1;
+  for (const char* p = name; *p != '\0' && id < end; p++) {
+    if (*p == '/' || *p == '-') {
+      *id++ = '_';
+    } else if (*p == '+') {
+      for (const char* q = "_PLUS_"; *q != '\0' && id < end; q++) *id++ = *q;
+    } else {
+      *id++ = *p;
+    }
+  }
+  *id = '\0';
+}
+
+/** Read the zone names from the stdin, skipping blank lines and comments. */
+static void readZoneNames() {
+  char line[kMaxNameSize];
+  while (fgets(line, sizeof(line), stdin) != nullptr) {
+    size_t len = strcspn(line, " \t\r\n");
+    line[len] = '\0';
+    if (len == 0 || line[0] == '#') continue;
+    if (numZones >= kMaxZones) {
+      fprintf(stderr, "Too many zones, max %u\n", kMaxZones);
+      exit(1);
+    }
+    strncpy(zoneNames[numZones], line, kMaxNameSize);
+    numZones++;
+  }
+}
+
+static void printPreamble(FILE* f) {
+  fprintf(f,
+      "// This file was generated by the following program:\n"
+      "//\n"
+      "//  $ ../../../tools/PrecomputedGenerator/PrecomputedGenerator.out"
+      " < precomputed_zones.txt\n"
+      "//\n"
+      "// using the zonedbx:: files of TZ Database version %s,"
+      " start_year %d, until_year %d.\n"
+      "//\n"
+      "// DO NOT EDIT\n\n",
+      zonedbx::kTzDatabaseVersion,
+      zonedbx::kZoneContext.startYear,
+      zonedbx::kZoneContext.untilYear);
+}
+
+static void printHeader(FILE* f) {
+  printPreamble(f);
+  fprintf(f,
+      "#ifndef ACE_TIME_ZONEDBX_PRECOMPUTED_H\n"
+      "#define ACE_TIME_ZONEDBX_PRECOMPUTED_H\n"
+      "\n"
+      "#include <ace_time/PrecomputedZone.h>\n"
+      "\n"
+      "namespace ace_time {\n"
+      "namespace zonedbx {\n"
+      "namespace precomputed {\n"
+      "\n"
+      "// Zones: %u\n",
+      numZones);
+  for (uint16_t i = 0; i < numZones; i++) {
+    char id[kMaxIdSize];
+    normalizeName(zoneNames[i], id);
+    fprintf(f, "extern const PrecomputedZone kZone%s; // %s\n",
+        id, zoneNames[i]);
+  }
+  fprintf(f,
+      "\n"
+      "}\n"
+      "}\n"
+      "}\n"
+      "\n"
+      "#endif\n");
+}
+
+/** Print the tables of the zone which was compiled into compiledZone. */
+static void printZone(FILE* f, const char* name, const char* id) {
+  uint16_t numEntries = compiledZone.getNumEntries();
+  fprintf(f,
+      "//---------------------------------------------------------------------------\n"
+      "// Zone name: %s\n"
+      "// Entries: %u\n"
+      "// Abbrevs: %u\n"
+      "//---------------------------------------------------------------------------\n"
+      "\n",
+      name, numEntries, compiledZone.getNumAbbrevs());
+
+  fprintf(f, "static const acetime_t kStartEpochSeconds%s[%u] = {\n",
+      id, numEntries);
+  for (uint16_t i = 0; i < numEntries; i++) {
+    fprintf(f, "  %ld,\n", (long) compiledZone.getEntryStartSeconds(i));
+  }
+  fprintf(f, "};\n\n");
+
+  fprintf(f, "static const int8_t kOffsetCodes%s[%u] = {\n", id, numEntries);
+  for (uint16_t i = 0; i < numEntries; i++) {
+    fprintf(f, "%s%d,%s", (i % 16 == 0) ? "  " : " ",
+        compiledZone.getEntryOffsetCode(i),
+        (i % 16 == 15 || i + 1 == numEntries) ? "\n" : "");
+  }
+  fprintf(f, "};\n\n");
+
+  fprintf(f, "static const int8_t kDeltaCodes%s[%u] = {\n", id, numEntries);
+  for (uint16_t i = 0; i < numEntries; i++) {
+    fprintf(f, "%s%d,%s", (i % 16 == 0) ? "  " : " ",
+        compiledZone.getEntryDeltaCode(i),
+        (i % 16 == 15 || i + 1 == numEntries) ? "\n" : "");
+  }
+  fprintf(f, "};\n\n");
+
+  fprintf(f, "static const uint8_t kAbbrevIndexes%s[%u] = {\n", id,
+      numEntries);
+  for (uint16_t i = 0; i < numEntries; i++) {
+    fprintf(f, "%s%u,%s", (i % 16 == 0) ? "  " : " ",
+        compiledZone.getEntryAbbrevIndex(i),
+        (i % 16 == 15 || i + 1 == numEntries) ? "\n" : "");
+  }
+  fprintf(f, "};\n\n");
+
+  fprintf(f, "static const char* const kAbbrevs%s[%u] = {\n", id,
+      compiledZone.getNumAbbrevs());
+  for (uint8_t i = 0; i < compiledZone.getNumAbbrevs(); i++) {
+    fprintf(f, "  \"%s\",\n", compiledZone.getAbbrevAt(i));
+  }
+  fprintf(f, "};\n\n");
+
+  fprintf(f,
+      "const PrecomputedZone kZone%s(\n"
+      "  &zonedbx::kZone%s /*zoneInfo*/,\n"
+      "  %ld /*startSeconds*/,\n"
+      "  %ld /*untilSeconds*/,\n"
+      "  %u /*numEntries*/,\n"
+      "  kStartEpochSeconds%s /*startEpochSeconds*/,\n"
+      "  kOffsetCodes%s /*offsetCodes*/,\n"
+      "  kDeltaCodes%s /*deltaCodes*/,\n"
+      "  kAbbrevIndexes%s /*abbrevIndexes*/,\n"
+      "  kAbbrevs%s /*abbrevs*/\n"
+      ");\n\n",
+      id, id,
+      (long) compiledZone.getStartSeconds(),
+      (long) compiledZone.getUntilSeconds(),
+      numEntries, id, id, id, id, id);
+}
+
+static void printSource(FILE* f) {
+  printPreamble(f);
+  fprintf(f,
+      "#include <ace_time/zonedbx/zone_infos.h>\n"
+      "#include \"precomputed.h\"\n"
+      "\n"
+      "namespace ace_time {\n"
+      "namespace zonedbx {\n"
+      "namespace precomputed {\n"
+      "\n");
+
+  ExtendedZoneRegistrar registrar(
+      zonedbx::kZoneRegistrySize, zonedbx::kZoneRegistry);
+  for (uint16_t i = 0; i < numZones; i++) {
+    const extended::ZoneInfo* zoneInfo =
+        registrar.getZoneInfoForName(zoneNames[i]);
+    if (zoneInfo == nullptr) {
+      fprintf(stderr, "Zone '%s' not found in zonedbx::\n", zoneNames[i]);
+      exit(1);
+    }
+
+    compiledZone = CompiledZone(zoneInfo);
+    if (compiledZone.isError()) {
+      fprintf(stderr, "Zone '%s' could not be compiled\n", zoneNames[i]);
+      exit(1);
+    }
+
+    char id[kMaxIdSize];
+    normalizeName(zoneNames[i], id);
+    printZone(f, zoneNames[i], id);
+  }
+
+  fprintf(f,
+      "}\n"
+      "}\n"
+      "}\n");
+}
+
+static void writeFile(const char* fileName, void (*printer)(FILE*)) {
+  FILE* f = fopen(fileName, "w");
+  if (f == nullptr) {
+    fprintf(stderr, "Unable to open '%s'\n", fileName);
+    exit(1);
+  }
+  printer(f);
+  fclose(f);
+}
+
+void setup() {
+  readZoneNames();
+  writeFile(kHeaderFile, printHeader);
+  writeFile(kSourceFile, printSource);
+  fprintf(stderr, "Generated %s and %s for %u zones\n",
+      kHeaderFile, kSourceFile, numZones);
+  exit(0);
+}
+
+void loop() {}
@@ -995,6 +995,14 @@ const {scope}::ZoneInfo* const kZoneRegistry[{numZones}] {progmem} = {{
 {zoneRegistryItems}
 }};
 
+//---------------------------------------------------------------------------
+// Zone registry. Sorted by zoneId, for a binary search in
+// ZoneRegistrar::getZoneInfoForId().
+//---------------------------------------------------------------------------
+const {scope}::ZoneInfo* const kZoneRegistryById[{numZones}] {progmem} = {{
+{zoneRegistryByIdItems}
+}};
+
 }}
 }}
 """
@@ -1021,6 +1029,8 @@ const uint16_t kZoneRegistrySize = {numZones};
 
 extern const {scope}::ZoneInfo* const kZoneRegistry[{numZones}];
 
+extern const {scope}::ZoneInfo* const kZoneRegistryById[{numZones}];
+
 }}
 }}
 #endif
@@ -1041,6 +1051,14 @@ extern const {scope}::ZoneInfo* const kZoneRegistry[{numZones}];
         for zone_name, eras in sorted(self.zones_map.items()):
             name = normalize_name(zone_name)
             zone_registry_items += f'  &kZone{name}, // {zone_name}\n'
+
+        zone_registry_by_id_items = ''
+        for zone_id, zone_name in sorted(
+                (hash_name(zone_name), zone_name)
+                for zone_name in self.zones_map.keys()):
+            name = normalize_name(zone_name)
+            zone_registry_by_id_items += (
+                f'  &kZone{name}, // 0x{zone_id:08x}, {zone_name}\n')
         return self.ZONE_REGISTRY_CPP_FILE.format(
             invocation=self.invocation,
             tz_version=self.tz_version,
@@ -1049,6 +1067,7 @@ extern const {scope}::ZoneInfo* const kZoneRegistry[{numZones}];
             dbHeaderNamespace=self.db_header_namespace,
             numZones=len(self.zones_map),
             zoneRegistryItems=zone_registry_items,
+            zoneRegistryByIdItems=zone_registry_by_id_items,
             progmem='ACE_TIME_PROGMEM')
 
     def generate_registry_h(self):
@@ -0,0 +1,260 @@
+# Copyright 2019 Brian T. Park
+#
+# MIT License
+"""
+Generate the binary zone database file which is loaded at runtime by the
+MappedZoneDb class. The layout is described in
+src/ace_time/internal/MappedZoneInfo.h. The records contain the same fields,
+with the same encoding, as the zone_infos.cpp and zone_policies.cpp files
+generated by argenerator.py, but every pointer is replaced by a 32-bit offset
+relative to the location of the offset itself, so the file can be mapped at
+any address.
+"""
+
+import logging
+import os
+import struct
+from collections import OrderedDict
+import transformer
+from transformer import div_to_zero
+from transformer import hash_name
+from argenerator import to_tiny_year
+from extractor import EPOCH_YEAR
+from extractor import MAX_UNTIL_YEAR
+from extractor import MAX_UNTIL_YEAR_TINY
+
+
+class BinaryGenerator:
+    """Generate the zonedbx.bin file for MappedZoneDb.
+    """
+    ZONEDBX_BIN_FILE_NAME = 'zonedbx.bin'
+
+    # Must match internal/MappedZoneInfo.h
+    MAGIC = b'ACTZ'
+    VERSION = 1
+    SCOPE_EXTENDED = 2
+    OFFSET_SIZE = 4
+
+    HEADER_SIZE = 32
+    HEADER_ZONE_CONTEXT = 12
+    ZONE_INFO_SIZE = 20
+    ZONE_ERA_SIZE = 16
+    ZONE_POLICY_SIZE = 12
+    ZONE_RULE_SIZE = 9
+
+    def __init__(self, invocation, tz_version, scope, start_year, until_year,
+                 zones_map, rules_map, buf_sizes):
+        if scope != 'extended':
+            raise Exception(
+                "Binary zonedb supports only scope 'extended', not '%s'"
+                % scope)
+        self.invocation = invocation
+        self.tz_version = tz_version
+        self.scope = scope
+        self.start_year = start_year
+        self.until_year = until_year
+        self.zones_map = zones_map
+        self.rules_map = rules_map
+        self.buf_sizes = buf_sizes
+
+        self.letters_map = {}  # map{policy_name: map{letter: index}}
+        self.data = bytearray()
+        self.policy_positions = {}  # map{policy_name: position}
+
+    def generate_files(self, output_dir):
+        full_filename = os.path.join(output_dir, self.ZONEDBX_BIN_FILE_NAME)
+        with open(full_filename, 'wb') as output_file:
+            output_file.write(self.generate_bin())
+        logging.info("Created %s", full_filename)
+
+    def generate_bin(self):
+        """Return the content of the binary zone database as bytes.
+        """
+        self._collect_letter_strings()
+        self.data = bytearray()
+        self.policy_positions = {}
+
+        zone_names = sorted(self.zones_map.keys())
+        num_zones = len(zone_names)
+        if num_zones == 0 or num_zones > 0xffff:
+            raise Exception('Invalid number of zones: %d' % num_zones)
+
+        # Header
+        header = self._allocate(self.HEADER_SIZE)
+        self.data[header:header + 4] = self.MAGIC
+        self._put_uint16(header + 4, self.VERSION)
+        self.data[header + 6] = self.SCOPE_EXTENDED
+        context = header + self.HEADER_ZONE_CONTEXT
+        self._put_int16(context + 0, self.start_year)
+        self._put_int16(context + 2, self.until_year)
+        self._put_offset(context + 4, self._write_string(self.tz_version))
+        self._put_uint16(header + 20, num_zones)
+
+        # ZoneInfo records, and the 2 registries which point to them.
+        infos = self._allocate(num_zones * self.ZONE_INFO_SIZE)
+        registry = self._allocate(num_zones * self.OFFSET_SIZE)
+        registry_by_id = self._allocate(num_zones * self.OFFSET_SIZE)
+        self._put_offset(header + 24, registry)
+        self._put_offset(header + 28, registry_by_id)
+
+        info_positions = {}
+        for i, zone_name in enumerate(zone_names):
+            info = infos + i * self.ZONE_INFO_SIZE
+            info_positions[zone_name] = info
+            self._write_info(info, zone_name, self.zones_map[zone_name],
+                             context)
+            self._put_offset(registry + i * self.OFFSET_SIZE, info)
+
+        for i, (zone_id, zone_name) in enumerate(sorted(
+                (hash_name(zone_name), zone_name)
+                for zone_name in zone_names)):
+            self._put_offset(registry_by_id + i * self.OFFSET_SIZE,
+                             info_positions[zone_name])
+
+        self._put_uint32(header + 8, len(self.data))
+        logging.info('Binary zonedb: %d zones, %d policies, %d bytes',
+                     num_zones, len(self.policy_positions), len(self.data))
+        return bytes(self.data)
+
+    def _collect_letter_strings(self):
+        """Collect the LETTERs which are more than one letter long, the same
+        way as ZonePoliciesGenerator.collect_letter_strings().
+        """
+        letters_map = {}
+        for policy, rules in self.rules_map.items():
+            letters = set()
+            for rule in rules:
+                if len(rule.letter) > 1:
+                    letters.add(rule.letter)
+            if letters:
+                indexed_letters_map = OrderedDict()
+                for letter in sorted(letters):
+                    transformer.add_string(indexed_letters_map, letter)
+                letters_map[policy] = indexed_letters_map
+        self.letters_map = letters_map
+
+    def _write_info(self, info, zone_name, eras, context):
+        self._put_offset(info + 0, self._write_string(zone_name))
+        self._put_uint32(info + 4, hash_name(zone_name))
+        self._put_offset(info + 8, context)
+        self.data[info + 16] = self.buf_sizes[zone_name]
+        self.data[info + 17] = len(eras)
+
+        era_array = self._allocate(len(eras) * self.ZONE_ERA_SIZE)
+        self._put_offset(info + 12, era_array)
+        for i, era in enumerate(eras):
+            self._write_era(era_array + i * self.ZONE_ERA_SIZE, era)
+
+    def _write_era(self, pos, era):
+        policy_name = era.rules
+        if policy_name == '-' or policy_name == ':':
+            delta_code = div_to_zero(era.rulesDeltaSecondsTruncated, 15 * 60)
+        else:
+            self._put_offset(pos + 0, self._write_policy(policy_name))
+            delta_code = 0
+
+        until_year = era.untilYear
+        if until_year == MAX_UNTIL_YEAR:
+            until_year_tiny = MAX_UNTIL_YEAR_TINY
+        else:
+            until_year_tiny = until_year - EPOCH_YEAR
+        until_month = era.untilMonth if era.untilMonth else 1
+        until_day = era.untilDay if era.untilDay else 1
+        until_time_code = div_to_zero(era.untilSecondsTruncated, 15 * 60)
+        offset_code = div_to_zero(era.offsetSecondsTruncated, 15 * 60)
+
+        # Replace %s with just a % for C++
+        format = era.format.replace('%s', '%')
+
+        self._put_offset(pos + 4, self._write_string(format))
+        self._put_int8(pos + 8, offset_code)
+        self._put_int8(pos + 9, delta_code)
+        self._put_int8(pos + 10, until_year_tiny)
+        self.data[pos + 11] = until_month
+        self.data[pos + 12] = until_day
+        self.data[pos + 13] = until_time_code
+        self.data[pos + 14] = ord(era.untilTimeModifier)
+
+    def _write_policy(self, policy_name):
+        """Write the ZonePolicy once, and return its position.
+        """
+        pos = self.policy_positions.get(policy_name)
+        if pos is not None:
+            return pos
+
+        rules = self.rules_map[policy_name]
+        indexed_letters = self.letters_map.get(policy_name)
+        num_letters = len(indexed_letters) if indexed_letters else 0
+
+        pos = self._allocate(self.ZONE_POLICY_SIZE)
+        self.policy_positions[policy_name] = pos
+        self.data[pos + 8] = len(rules)
+        self.data[pos + 9] = num_letters
+
+        rule_array = self._allocate(len(rules) * self.ZONE_RULE_SIZE)
+        if rules:
+            self._put_offset(pos + 0, rule_array)
+        for i, rule in enumerate(rules):
+            self._write_rule(rule_array + i * self.ZONE_RULE_SIZE, rule,
+                             indexed_letters)
+
+        if num_letters:
+            letter_array = self._allocate(num_letters * self.OFFSET_SIZE)
+            self._put_offset(pos + 4, letter_array)
+            for letter, index in indexed_letters.items():
+                self._put_offset(letter_array + index * self.OFFSET_SIZE,
+                                 self._write_string(letter))
+        return pos
+
+    def _write_rule(self, pos, rule, indexed_letters):
+        if len(rule.letter) == 1:
+            letter = ord(rule.letter)
+        elif len(rule.letter) > 1:
+            index = indexed_letters.get(rule.letter)
+            if index == None:
+                raise Exception('Could not find index for letter (%s)'
+                                % rule.letter)
+            if index >= 32:
+                raise Exception('Number of indexed letters >= 32')
+            letter = index
+        else:
+            raise Exception('len(%s) == 0; should not happen' % rule.letter)
+
+        self._put_int8(pos + 0, to_tiny_year(rule.fromYear))
+        self._put_int8(pos + 1, to_tiny_year(rule.toYear))
+        self.data[pos + 2] = rule.inMonth
+        self.data[pos + 3] = rule.onDayOfWeek
+        self._put_int8(pos + 4, rule.onDayOfMonth)
+        self.data[pos + 5] = div_to_zero(rule.atSecondsTruncated, 15 * 60)
+        self.data[pos + 6] = ord(rule.atTimeModifier)
+        self._put_int8(pos + 7,
+                       div_to_zero(rule.deltaSecondsTruncated, 15 * 60))
+        self.data[pos + 8] = letter
+
+    def _write_string(self, s):
+        encoded = s.encode('utf-8') + b'\0'
+        pos = self._allocate(len(encoded))
+        self.data[pos:pos + len(encoded)] = encoded
+        return pos
+
+    def _allocate(self, size):
+        pos = len(self.data)
+        self.data.extend(bytes(size))
+        return pos
+
+    def _put_int8(self, pos, value):
+        struct.pack_into('<b', self.data, pos, value)
+
+    def _put_int16(self, pos, value):
+        struct.pack_into('<h', self.data, pos, value)
+
+    def _put_uint16(self, pos, value):
+        struct.pack_into('<H', self.data, pos, value)
+
+    def _put_uint32(self, pos, value):
+        struct.pack_into('<I', self.data, pos, value)
+
+    def _put_offset(self, pos, target):
+        """Write the offset from pos to target into the field at pos.
+        """
+        struct.pack_into('<i', self.data, pos, target - pos)
@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+#
+# Copyright 2019 Brian T. Park
+#
+# MIT License
+
+import struct
+import unittest
+from bingenerator import BinaryGenerator
+from extractor import ZoneEraRaw
+from extractor import ZoneRuleRaw
+from extractor import MAX_UNTIL_YEAR
+from extractor import MAX_UNTIL_YEAR_TINY
+from extractor import MAX_YEAR
+from extractor import MAX_YEAR_TINY
+from transformer import hash_name
+
+
+def read_offset(data, pos):
+    """Return the target of the self-relative offset at pos, or None."""
+    offset = struct.unpack_from('<i', data, pos)[0]
+    return None if offset == 0 else pos + offset
+
+
+def read_string(data, pos):
+    end = data.index(b'\0', pos)
+    return data[pos:end].decode('utf-8')
+
+
+def make_rule(from_year, to_year, in_month, at_seconds, delta_seconds,
+              letter):
+    return ZoneRuleRaw({
+        'fromYear': from_year,
+        'toYear': to_year,
+        'inMonth': in_month,
+        'onDayOfWeek': 7,
+        'onDayOfMonth': 8,
+        'atTimeModifier': 'w',
+        'atSecondsTruncated': at_seconds,
+        'deltaSecondsTruncated': delta_seconds,
+        'letter': letter,
+    })
+
+
+def make_era(offset_seconds, rules, format, until_year,
+             rules_delta_seconds=None):
+    return ZoneEraRaw({
+        'offsetSecondsTruncated': offset_seconds,
+        'rules': rules,
+        'rulesDeltaSecondsTruncated': rules_delta_seconds,
+        'format': format,
+        'untilYear': until_year,
+        'untilMonth': None,
+        'untilDay': None,
+        'untilSecondsTruncated': 0,
+        'untilTimeModifier': 'w',
+    })
+
+
+class TestBinaryGenerator(unittest.TestCase):
+    def setUp(self):
+        rules_map = {
+            'US': [
+                make_rule(2007, MAX_YEAR, 3, 7200, 3600, 'D'),
+                make_rule(2007, MAX_YEAR, 11, 7200, 0, 'S'),
+            ],
+            'Test': [
+                make_rule(2000, 2000, 1, 0, 0, 'AA'),
+                make_rule(2001, 2001, 1, 0, 1800, 'BB'),
+            ],
+        }
+        zones_map = {
+            'America/Los_Angeles': [
+                make_era(-8 * 3600, 'US', 'P%sT', MAX_UNTIL_YEAR),
+            ],
+            'Etc/Test': [
+                make_era(3600, '-', 'TST', 2010, 1800),
+                make_era(-3600, 'Test', '%s', MAX_UNTIL_YEAR),
+            ],
+            'America/New_York': [
+                make_era(-5 * 3600, 'US', 'E%sT', MAX_UNTIL_YEAR),
+            ],
+        }
+        buf_sizes = {
+            'America/Los_Angeles': 7,
+            'America/New_York': 7,
+            'Etc/Test': 5,
+        }
+        generator = BinaryGenerator('test', '2019b', 'extended', 2000, 2050,
+                                    zones_map, rules_map, buf_sizes)
+        self.data = generator.generate_bin()
+
+    def zone_info(self, index):
+        registry = read_offset(self.data, 24)
+        return read_offset(self.data, registry + 4 * index)
+
+    def test_header(self):
+        data = self.data
+        self.assertEqual(b'ACTZ', data[0:4])
+        self.assertEqual((1, 2), struct.unpack_from('<HB', data, 4))
+        self.assertEqual(len(data), struct.unpack_from('<I', data, 8)[0])
+        self.assertEqual((2000, 2050), struct.unpack_from('<hh', data, 12))
+        self.assertEqual('2019b', read_string(data, read_offset(data, 16)))
+        self.assertEqual(3, struct.unpack_from('<H', data, 20)[0])
+
+    def test_registries(self):
+        data = self.data
+        names = [read_string(data, read_offset(data, self.zone_info(i)))
+                 for i in range(3)]
+        self.assertEqual(
+            ['America/Los_Angeles', 'America/New_York', 'Etc/Test'], names)
+
+        registry_by_id = read_offset(data, 28)
+        ids = [struct.unpack_from('<I', data,
+                                  read_offset(data, registry_by_id + 4 * i)
+                                  + 4)[0]
+               for i in range(3)]
+        self.assertEqual(sorted(hash_name(name) for name in names), ids)
+
+    def test_zone_info(self):
+        data = self.data
+        info = self.zone_info(2)  # Etc/Test
+        self.assertEqual(hash_name('Etc/Test'),
+                         struct.unpack_from('<I', data, info + 4)[0])
+        self.assertEqual(12, read_offset(data, info + 8))
+        self.assertEqual((5, 2), struct.unpack_from('<BB', data, info + 16))
+
+        eras = read_offset(data, info + 12)
+        self.assertIsNone(read_offset(data, eras))
+        self.assertEqual('TST', read_string(data, read_offset(data, eras + 4)))
+        self.assertEqual((4, 2, 10, 1, 1, 0, ord('w')),
+                         struct.unpack_from('<bbbBBBB', data, eras + 8))
+
+        era = eras + 16
+        self.assertEqual('%', read_string(data, read_offset(data, era + 4)))
+        self.assertEqual((-4, 0, MAX_UNTIL_YEAR_TINY),
+                         struct.unpack_from('<bbb', data, era + 8))
+
+        # Multi-character letters are indexes into the letters array.
+        policy = read_offset(data, era)
+        self.assertEqual((2, 2), struct.unpack_from('<BB', data, policy + 8))
+        rules = read_offset(data, policy)
+        self.assertEqual((0, 0, 1, 7, 8, 0, ord('w'), 0, 0),
+                         struct.unpack_from('<bbBBbBBbB', data, rules))
+        self.assertEqual(1, data[rules + 9 + 8])
+        letters = read_offset(data, policy + 4)
+        self.assertEqual('AA', read_string(data, read_offset(data, letters)))
+        self.assertEqual('BB',
+                         read_string(data, read_offset(data, letters + 4)))
+
+    def test_shared_policy(self):
+        data = self.data
+        la_eras = read_offset(data, self.zone_info(0) + 12)
+        ny_eras = read_offset(data, self.zone_info(1) + 12)
+        policy = read_offset(data, la_eras)
+        self.assertEqual(policy, read_offset(data, ny_eras))
+        self.assertIsNone(read_offset(data, policy + 4))
+
+        rules = read_offset(data, policy)
+        self.assertEqual((7, MAX_YEAR_TINY, 3, 7, 8, 8, ord('w'), 4, ord('D')),
+                         struct.unpack_from('<bbBBbBBbB', data, rules))
+
+    def test_basic_scope_fails(self):
+        with self.assertRaises(Exception):
+            BinaryGenerator('test', '2019b', 'basic', 2000, 2050, {}, {}, {})
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -34,7 +34,8 @@ class Transformer:
             zones_map (dict): Zone names to ZoneEras
             rules_map (dict): Policy names to ZoneRules
             links_map (dict): Link name to Zone Name
-            language (str): target language ('python', 'arduino', 'java')
+            language (str): target language ('python', 'arduino', 'java',
+                'binary')
             scope (str): scope of database (basic, or extended)
             start_year (int): include only years on or after start_year
             until_year (int): include only years valid before until_year
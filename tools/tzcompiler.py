@@ -17,6 +17,7 @@ from argenerator import ArduinoGenerator
 from pygenerator import PythonGenerator
 from ingenerator import InlineGenerator
 from javagenerator import JavaGenerator
+from bingenerator import BinaryGenerator
 from validator import Validator
 from bufestimator import BufSizeEstimator
 from tdgenerator import TestDataGenerator
@@ -97,9 +98,10 @@ def main():
     # python: generate Python files
     # arduino: generate C++ files for Arduino
     # java: generate Java files
+    # binary: generate the zonedbx.bin file for MappedZoneDb
     parser.add_argument(
         '--language',
-        help='Target language (arduino|python|java)',
+        help='Target language (arduino|python|java|binary)',
         required=True)
 
     # Scope (of the zones in the database):
@@ -187,7 +189,7 @@ def main():
     if args.granularity:
         granularity = args.granularity
     else:
-        if args.language in ['arduino']:
+        if args.language in ['arduino', 'binary']:
             granularity = 900
         else:
             granularity = 60
@@ -285,6 +287,18 @@ def main():
                 scope=args.scope,
                 zones_map=transformer.zones_map)
             generator.generate_files(args.output_dir)
+        elif args.language == 'binary':
+            logging.info('======== Creating binary zonedb file')
+            generator = BinaryGenerator(
+                invocation=invocation,
+                tz_version=args.tz_version,
+                scope=args.scope,
+                start_year=args.start_year,
+                until_year=args.until_year,
+                zones_map=transformer.zones_map,
+                rules_map=transformer.rules_map,
+                buf_sizes=buf_sizes)
+            generator.generate_files(args.output_dir)
         else:
             raise Exception("Unrecognized language '%s'" % args.language)
     elif args.action == 'unittest':